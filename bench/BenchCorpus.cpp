@@ -0,0 +1,103 @@
+/*
+ * BenchCorpus.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "BenchCorpus.h"
+#include "Board.h"
+#include "PuzzleIO.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <dirent.h>
+
+namespace {
+
+const char * const BUCKET_NAMES[NUM_BENCH_BUCKETS] = {
+	"trivial", "easy", "medium", "hard"
+};
+const uint64_t BUCKET_MAX_NODES[NUM_BENCH_BUCKETS - 1] = {1, 10, 100};
+
+bool endsWith(const std::string & text, const std::string & suffix){
+	return text.size() >= suffix.size() &&
+			text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/* Adds the puzzle to corpus if it is a valid one-line puzzle. */
+void addPuzzle(std::vector<BenchPuzzle> & corpus, const std::string & name,
+		const std::string & line){
+	uint8_t givens[Board::NUM_CELLS];
+	if(!parsePuzzleLine(line.data(), line.size(), givens)){
+		std::cerr << "Skipping '" << name << "': not a puzzle." << std::endl;
+		return;
+	}
+	BenchPuzzle puzzle;
+	puzzle.name = name;
+	puzzle.line = line;
+	corpus.push_back(puzzle);
+}
+
+} // namespace
+
+std::vector<BenchPuzzle> loadBenchCorpus(const std::string & path){
+	std::vector<BenchPuzzle> corpus;
+
+	DIR * dir = opendir(path.c_str());
+	if(dir != nullptr){
+		std::vector<std::string> files;
+		for(struct dirent * entry = readdir(dir); entry != nullptr;
+				entry = readdir(dir)){
+			std::string file(entry->d_name);
+			if(file[0] != '.' && endsWith(file, ".txt") &&
+					!endsWith(file, ".soln.txt"))
+				files.push_back(file);
+		}
+		closedir(dir);
+		std::sort(files.begin(), files.end());
+
+		// A puzzle file's rows, joined, are the one-line format.
+		for(const std::string & file : files){
+			std::ifstream in(path + "/" + file);
+			std::string line;
+			std::string row;
+			while(std::getline(in, row))
+				line += row.substr(0, row.find_last_not_of("\r\n") + 1);
+			addPuzzle(corpus, file, line);
+		}
+		return corpus;
+	}
+
+	std::ifstream in(path);
+	if(!in){
+		std::ostringstream o;
+		o << "Could not read '" << path << "': " << strerror(errno) << ".";
+		throw std::runtime_error(o.str());
+	}
+
+	std::string line;
+	for(int number = 1; std::getline(in, line); ++number){
+		if(line.empty() || line == "\r")
+			continue;
+		std::ostringstream name;
+		name << path << ":" << number;
+		addPuzzle(corpus, name.str(), line);
+	}
+	return corpus;
+}
+
+int getBenchBucket(uint64_t nodes){
+	int bucket = 0;
+	while(bucket < NUM_BENCH_BUCKETS - 1 && nodes > BUCKET_MAX_NODES[bucket])
+		++bucket;
+	return bucket;
+}
+
+const char * getBenchBucketName(int bucket){
+	return BUCKET_NAMES[bucket];
+}
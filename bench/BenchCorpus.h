@@ -0,0 +1,54 @@
+/** \file BenchCorpus.h
+ *
+ * \brief Defines the puzzle corpus loader and the difficulty buckets shared by
+ * the benchmarks.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef BENCHCORPUS_H_
+#define BENCHCORPUS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \struct BenchPuzzle
+ * \brief One puzzle of a benchmark corpus.
+ */
+struct BenchPuzzle {
+	/** \brief The file, or file and line number, the puzzle came from. */
+	std::string name;
+
+	/** \brief The puzzle in the one-line format. */
+	std::string line;
+};
+
+/**
+ * \brief Loads a benchmark corpus: every puzzle file (NNN.*.txt, but not
+ * NNN.soln.txt) of a directory, in name order, or every line of a file of
+ * one-line puzzles. Puzzles that cannot be read are skipped with a warning on
+ * std::cerr.
+ *
+ * \throws std::runtime_error if path cannot be read.
+ */
+std::vector<BenchPuzzle> loadBenchCorpus(const std::string & path);
+
+/**
+ * \brief Number of difficulty buckets the benchmarks sort puzzles into, by
+ * the search nodes the default Solver needs.
+ */
+const int NUM_BENCH_BUCKETS = 4;
+
+/**
+ * \brief Returns the bucket of a puzzle whose search took the given nodes:
+ * trivial 1, easy up to 10, medium up to 100, hard more.
+ */
+int getBenchBucket(uint64_t nodes);
+
+/** \brief Returns the name of a bucket, such as "easy". */
+const char * getBenchBucketName(int bucket);
+
+#endif /* BENCHCORPUS_H_ */
@@ -0,0 +1,174 @@
+/*
+ * PerfCounters.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "PerfCounters.h"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+const char * const COUNTER_NAMES[PerfCounters::NUM_COUNTERS] = {
+	"cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses"
+};
+
+uint64_t nowNanoseconds(){
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t nowTicks(){
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/* Fills attr for the given counter. */
+void describeEvent(PerfCounters::Counter counter, perf_event_attr & attr){
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+
+	const uint64_t cacheReadMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+			(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	switch(counter){
+		case PerfCounters::CYCLES:
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = PERF_COUNT_HW_CPU_CYCLES;
+			break;
+		case PerfCounters::INSTRUCTIONS:
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+			break;
+		case PerfCounters::BRANCH_MISSES:
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+			break;
+		case PerfCounters::L1D_MISSES:
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = PERF_COUNT_HW_CACHE_L1D | cacheReadMiss;
+			break;
+		default:
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = PERF_COUNT_HW_CACHE_LL | cacheReadMiss;
+			break;
+	}
+}
+
+} // namespace
+
+void PerfCounters::Sample::add(const Sample & other){
+	for(int i = 0; i < NUM_COUNTERS; ++i)
+		values[i] += other.values[i];
+	nanoseconds += other.nanoseconds;
+	ticks += other.ticks;
+}
+
+PerfCounters::PerfCounters() :
+		leader_(-1),
+		startNanoseconds_(0),
+		startTicks_(0)
+{
+	std::ostringstream unavailable;
+	int opened = 0;
+	int error = 0;
+
+	for(int i = 0; i < NUM_COUNTERS; ++i){
+		perf_event_attr attr;
+		describeEvent(static_cast<Counter>(i), attr);
+		fds_[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1,
+				leader_, 0));
+		slots_[i] = -1;
+		if(fds_[i] < 0){
+			error = errno;
+			unavailable << (unavailable.tellp() > 0 ? ", " : "")
+					<< COUNTER_NAMES[i] << " (" << strerror(errno) << ")";
+			continue;
+		}
+		if(leader_ < 0)
+			leader_ = fds_[i];
+		slots_[i] = opened++;
+	}
+
+	std::ostringstream o;
+	if(opened > 0)
+		o << "perf_event_open counters";
+	else
+		o << "no hardware counters (" << strerror(error) << "); steady_clock";
+#if defined(__x86_64__) || defined(__i386__)
+	o << (opened > 0 ? " with" : " and") << " rdtsc";
+#endif
+	if(opened > 0 && unavailable.tellp() > 0)
+		o << ". Unavailable: " << unavailable.str();
+	description_ = o.str() + ".";
+}
+
+PerfCounters::~PerfCounters(){
+	for(int i = 0; i < NUM_COUNTERS; ++i)
+		if(fds_[i] >= 0)
+			close(fds_[i]);
+}
+
+bool PerfCounters::isAvailable(Counter counter) const {
+	return fds_[counter] >= 0;
+}
+
+bool PerfCounters::anyAvailable() const {
+	return leader_ >= 0;
+}
+
+const std::string & PerfCounters::getDescription() const {
+	return description_;
+}
+
+void PerfCounters::start(){
+	if(leader_ >= 0){
+		ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+	startNanoseconds_ = nowNanoseconds();
+	startTicks_ = nowTicks();
+}
+
+PerfCounters::Sample PerfCounters::stop(){
+	uint64_t ticks = nowTicks();
+	uint64_t nanoseconds = nowNanoseconds();
+	Sample sample;
+
+	if(leader_ >= 0){
+		ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+		// A group read is the number of counters, then each value.
+		uint64_t buffer[1 + NUM_COUNTERS];
+		if(read(leader_, buffer, sizeof(buffer)) > 0)
+			for(int i = 0; i < NUM_COUNTERS; ++i)
+				if(slots_[i] >= 0 && static_cast<uint64_t>(slots_[i]) <
+						buffer[0])
+					sample.values[i] = buffer[1 + slots_[i]];
+	}
+
+	sample.nanoseconds = nanoseconds - startNanoseconds_;
+	sample.ticks = ticks - startTicks_;
+	return sample;
+}
+
+const char * PerfCounters::getName(Counter counter){
+	return COUNTER_NAMES[counter];
+}
@@ -0,0 +1,144 @@
+/** \file PerfCounters.h
+ *
+ * \brief Defines the class PerfCounters, which reads hardware performance
+ * counters around a region of code.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+
+#include <cstdint>
+#include <string>
+
+/**
+ * \class PerfCounters
+ * \brief Counts cycles, instructions, branch misses and cache misses of this
+ * thread between start() and stop(), using perf_event_open.
+ *
+ * Counters the kernel or the hardware will not provide (perf_event_paranoid,
+ * containers and virtual machines often refuse some or all of them) are marked
+ * unavailable, and the rest still work. Elapsed time is always measured, with
+ * steady_clock and, on x86, the time-stamp counter, so that there is something
+ * to compare when no hardware counter is available.
+ *
+ * The counters are opened as one group, so that they are enabled, disabled and
+ * read together with a single system call each. That overhead is still a few
+ * microseconds, so regions should be long: a whole phase over many puzzles,
+ * not one puzzle.
+ */
+class PerfCounters {
+public:
+	/**
+	 * \enum Counter
+	 * \brief The hardware counters, in the order of Sample::values.
+	 */
+	enum Counter {
+		CYCLES,
+		INSTRUCTIONS,
+		BRANCH_MISSES,
+		L1D_MISSES,
+		LLC_MISSES,
+		NUM_COUNTERS
+	};
+
+	/**
+	 * \struct Sample
+	 * \brief What was counted between one start() and stop().
+	 */
+	struct Sample {
+		/** \brief The hardware counts, valid where isAvailable() says so. */
+		uint64_t values[NUM_COUNTERS];
+
+		/** \brief Elapsed steady_clock time. */
+		uint64_t nanoseconds;
+
+		/** \brief Elapsed time-stamp counter ticks, or 0 where there is no
+		 * time-stamp counter. */
+		uint64_t ticks;
+
+		Sample() : values(), nanoseconds(0), ticks(0) {}
+
+		/** \brief Adds the counts of other to this. */
+		void add(const Sample & other);
+	};
+
+public:
+	/**
+	 * \brief Constructor; opens whichever counters are available.
+	 */
+	PerfCounters();
+
+	/**
+	 * \brief Destructor; closes the counters.
+	 */
+	~PerfCounters();
+
+	/** \brief Returns whether the given counter could be opened. */
+	bool isAvailable(Counter counter) const;
+
+	/** \brief Returns whether any hardware counter could be opened. */
+	bool anyAvailable() const;
+
+	/**
+	 * \brief Returns a one-line description of what is being measured, and
+	 * why any counters are missing.
+	 */
+	const std::string & getDescription() const;
+
+	/** \brief Resets and starts the counters. */
+	void start();
+
+	/** \brief Stops the counters and returns what they counted since
+	 * start(). */
+	Sample stop();
+
+	/** \brief Returns the short name of the given counter. */
+	static const char * getName(Counter counter);
+
+private:
+	// Not copyable, as it owns the counters' file descriptors.
+	PerfCounters(const PerfCounters &);
+	PerfCounters & operator=(const PerfCounters &);
+
+	/**
+	 * \var fds_
+	 * \brief The file descriptor of each counter, or -1 if unavailable.
+	 */
+	int fds_[NUM_COUNTERS];
+
+	/**
+	 * \var slots_
+	 * \brief The position of each available counter in a group read.
+	 */
+	int slots_[NUM_COUNTERS];
+
+	/**
+	 * \var leader_
+	 * \brief The file descriptor of the group leader, or -1 if no counter
+	 * is available.
+	 */
+	int leader_;
+
+	/**
+	 * \var description_
+	 * \brief See getDescription().
+	 */
+	std::string description_;
+
+	/**
+	 * \var startNanoseconds_
+	 * \brief steady_clock time at start().
+	 */
+	uint64_t startNanoseconds_;
+
+	/**
+	 * \var startTicks_
+	 * \brief Time-stamp counter at start().
+	 */
+	uint64_t startTicks_;
+};
+
+#endif /* PERFCOUNTERS_H_ */
@@ -0,0 +1,411 @@
+/**
+ * \file benchCompare.cpp
+ *
+ * Compares two saved benchmark runs, of the latency or the primitives mode,
+ * with bootstrapped confidence intervals, failing when a change is a
+ * significant regression past a threshold.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+int benchCompare(const std::string & baselineFile,
+		const std::string & currentFile, double threshold, double confidence);
+
+extern std::map<std::string, std::vector<double> > loadPrimitiveResults(
+		const std::string & file);
+
+namespace {
+
+/* Resamples drawn for each confidence interval. */
+const int RESAMPLES = 2000;
+
+/* A parsed JSON value; only what the results files use is kept. */
+struct Json {
+	enum Type {
+		NUL,
+		BOOLEAN,
+		NUMBER,
+		STRING,
+		ARRAY,
+		OBJECT
+	};
+
+	Type type;
+	double number;
+	std::string text;
+	std::vector<Json> items;
+	std::vector<std::pair<std::string, Json> > members;
+
+	Json() : type(NUL), number(0) {}
+
+	/* The member with the given name, or null if there is none. */
+	const Json * find(const std::string & name) const {
+		for(const auto & member : members)
+			if(member.first == name)
+				return &member.second;
+		return nullptr;
+	}
+};
+
+/* A recursive descent parser of the JSON in text. */
+class JsonParser {
+public:
+	JsonParser(const std::string & text, const std::string & file) :
+			text_(text), file_(file), at_(0) {}
+
+	Json parse(){
+		Json value = parseValue();
+		skipSpace();
+		if(at_ != text_.size())
+			fail("text after the value");
+		return value;
+	}
+
+private:
+	void fail(const std::string & what) const {
+		throw std::runtime_error("Bad JSON in '" + file_ + "' at byte " +
+				std::to_string(at_) + ": " + what + ".");
+	}
+
+	void skipSpace(){
+		while(at_ < text_.size() && isspace(
+				static_cast<unsigned char>(text_[at_])))
+			++at_;
+	}
+
+	bool take(char c){
+		skipSpace();
+		if(at_ < text_.size() && text_[at_] == c){
+			++at_;
+			return true;
+		}
+		return false;
+	}
+
+	void expect(char c){
+		if(!take(c))
+			fail(std::string("expected '") + c + "'");
+	}
+
+	bool takeWord(const char * word){
+		std::size_t length = std::char_traits<char>::length(word);
+		if(text_.compare(at_, length, word) != 0)
+			return false;
+		at_ += length;
+		return true;
+	}
+
+	std::string parseString(){
+		expect('"');
+		std::string result;
+		while(at_ < text_.size() && text_[at_] != '"'){
+			char c = text_[at_++];
+			if(c == '\\'){
+				if(at_ >= text_.size())
+					break;
+				c = text_[at_++];
+				// \uXXXX just loses its backslash; the files written have none.
+				c = c == 'n' ? '\n' : c == 't' ? '\t' : c == 'r' ? '\r' : c;
+			}
+			result += c;
+		}
+		expect('"');
+		return result;
+	}
+
+	Json parseValue(){
+		skipSpace();
+		Json value;
+		if(at_ >= text_.size())
+			fail("unexpected end");
+		char c = text_[at_];
+		if(c == '{'){
+			value.type = Json::OBJECT;
+			++at_;
+			if(take('}'))
+				return value;
+			do{
+				std::string name = parseString();
+				expect(':');
+				value.members.push_back(std::make_pair(name, parseValue()));
+			} while(take(','));
+			expect('}');
+		}
+		else if(c == '['){
+			value.type = Json::ARRAY;
+			++at_;
+			if(take(']'))
+				return value;
+			do
+				value.items.push_back(parseValue());
+			while(take(','));
+			expect(']');
+		}
+		else if(c == '"'){
+			value.type = Json::STRING;
+			value.text = parseString();
+		}
+		else if(takeWord("true") || takeWord("false")){
+			value.type = Json::BOOLEAN;
+			value.number = c == 't';
+		}
+		else if(takeWord("null"))
+			value.type = Json::NUL;
+		else{
+			const char * start = text_.c_str() + at_;
+			char * end;
+			value.type = Json::NUMBER;
+			value.number = strtod(start, &end);
+			if(end == start)
+				fail("expected a value");
+			at_ += end - start;
+		}
+		return value;
+	}
+
+	const std::string & text_;
+	const std::string & file_;
+	std::size_t at_;
+};
+
+/* The samples of one measure from one run. */
+struct Metric {
+	bool higherIsBetter;
+
+	/* If not empty, the puzzle each sample is of, so that two runs can be
+	 * compared puzzle by puzzle. */
+	std::vector<std::string> keys;
+
+	std::vector<double> samples;
+
+	Metric() : higherIsBetter(false) {}
+};
+
+typedef std::map<std::string, Metric> Metrics;
+
+std::vector<double> getNumbers(const Json * array){
+	std::vector<double> numbers;
+	if(array != nullptr)
+		for(const Json & item : array->items)
+			numbers.push_back(item.number);
+	return numbers;
+}
+
+/* The bucket each puzzle of the baseline was in, by name. */
+typedef std::map<std::string, std::string> BucketAssignment;
+
+/*
+ * Reads the metrics of a latency run saved as JSON. Each puzzle counts in the
+ * bucket that buckets gives it, so that a change to the search does not move
+ * puzzles between the buckets of the two runs; a puzzle that buckets does not
+ * name is added to it with the bucket it was saved with.
+ */
+Metrics loadLatencyResults(const std::string & file, const std::string & text,
+		BucketAssignment & buckets){
+	Json root = JsonParser(text, file).parse();
+	const Json * puzzles = root.find("puzzles");
+	if(puzzles == nullptr || puzzles->type != Json::ARRAY)
+		throw std::runtime_error("No puzzles in '" + file + "'.");
+
+	Metrics metrics;
+	for(const Json & puzzle : puzzles->items){
+		const Json * name = puzzle.find("name");
+		const Json * bucket = puzzle.find("bucket");
+		const Json * nodes = puzzle.find("nodes");
+		const Json * latency = puzzle.find("latency_ns");
+		if(name == nullptr || bucket == nullptr || nodes == nullptr ||
+				latency == nullptr)
+			throw std::runtime_error("A puzzle in '" + file + "' lacks its "
+					"name, bucket, nodes or latency.");
+		auto assigned = buckets.insert(std::make_pair(name->text,
+				bucket->text)).first;
+
+		for(const std::string & prefix : {assigned->second + " ",
+				std::string("all ")}){
+			Metric & latencies = metrics[prefix + "ns/puzzle"];
+			latencies.keys.push_back(name->text);
+			latencies.samples.push_back(latency->number);
+			Metric & searched = metrics[prefix + "nodes/puzzle"];
+			searched.keys.push_back(name->text);
+			searched.samples.push_back(nodes->number);
+		}
+	}
+
+	Metric & rate = metrics["all puzzles/s"];
+	rate.higherIsBetter = true;
+	rate.samples = getNumbers(root.find("puzzles_per_second"));
+	return metrics;
+}
+
+Metrics loadResults(const std::string & file, BucketAssignment & buckets){
+	std::ifstream in(file);
+	if(!in)
+		throw std::runtime_error("Could not read results file '" + file + "'.");
+	std::stringstream contents;
+	contents << in.rdbuf();
+	std::string text = contents.str();
+
+	// The primitives mode saves tab-separated samples after a # header.
+	if(!text.empty() && text[0] == '#'){
+		Metrics metrics;
+		for(const auto & row : loadPrimitiveResults(file))
+			metrics[row.first].samples = row.second;
+		return metrics;
+	}
+	return loadLatencyResults(file, text, buckets);
+}
+
+double mean(const std::vector<double> & samples){
+	double sum = 0;
+	for(double sample : samples)
+		sum += sample;
+	return samples.empty() ? 0 : sum / samples.size();
+}
+
+/* The ratio of current to baseline, and its confidence interval. */
+struct Change {
+	double baseline;
+	double current;
+	double ratio;
+	double low;
+	double high;
+};
+
+/*
+ * Bootstraps the ratio of the means. Samples of the same puzzle are paired,
+ * so that a corpus's spread of difficulty does not swamp a change to every
+ * puzzle; otherwise the two runs are resampled independently.
+ */
+Change compare(const Metric & before, const Metric & after,
+		double confidence, std::mt19937 & random){
+	std::vector<double> baseline = before.samples;
+	std::vector<double> current = after.samples;
+	bool paired = !before.keys.empty() && !after.keys.empty();
+	if(paired){
+		std::map<std::string, double> byKey;
+		for(std::size_t i = 0; i < after.keys.size(); ++i)
+			byKey[after.keys[i]] = after.samples[i];
+		std::vector<double> pairedBaseline;
+		std::vector<double> pairedCurrent;
+		for(std::size_t i = 0; i < before.keys.size(); ++i){
+			auto found = byKey.find(before.keys[i]);
+			if(found == byKey.end())
+				continue;
+			pairedBaseline.push_back(before.samples[i]);
+			pairedCurrent.push_back(found->second);
+		}
+		// With no puzzle in common, the runs can only be resampled apart.
+		paired = !pairedBaseline.empty();
+		if(paired){
+			baseline.swap(pairedBaseline);
+			current.swap(pairedCurrent);
+		}
+	}
+
+	Change change;
+	change.baseline = mean(baseline);
+	change.current = mean(current);
+	change.ratio = change.current / change.baseline;
+	change.low = change.high = change.ratio;
+	if(baseline.size() < 2 || current.size() < 2)
+		return change;
+
+	std::vector<double> ratios;
+	std::uniform_int_distribution<std::size_t> pickBaseline(0,
+			baseline.size() - 1);
+	std::uniform_int_distribution<std::size_t> pickCurrent(0,
+			current.size() - 1);
+	for(int r = 0; r < RESAMPLES; ++r){
+		double baselineSum = 0;
+		double currentSum = 0;
+		for(std::size_t i = 0; i < baseline.size(); ++i){
+			std::size_t picked = pickBaseline(random);
+			baselineSum += baseline[picked];
+			if(paired)
+				currentSum += current[picked];
+		}
+		if(!paired)
+			for(std::size_t i = 0; i < current.size(); ++i)
+				currentSum += current[pickCurrent(random)];
+		ratios.push_back(currentSum / current.size() /
+				(baselineSum / baseline.size()));
+	}
+	std::sort(ratios.begin(), ratios.end());
+	double tail = (1 - confidence) / 2;
+	change.low = ratios[static_cast<std::size_t>(tail * (RESAMPLES - 1))];
+	change.high = ratios[static_cast<std::size_t>(
+			(1 - tail) * (RESAMPLES - 1))];
+	return change;
+}
+
+std::string formatPercent(double ratio){
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(1) << std::showpos
+			<< (ratio - 1) * 100 << "%";
+	return out.str();
+}
+
+} // namespace
+
+int benchCompare(const std::string & baselineFile,
+		const std::string & currentFile, double threshold, double confidence){
+	if(!(confidence > 0 && confidence < 1))
+		throw std::invalid_argument("The confidence must be between 0 and 1.");
+	// The current run's puzzles go in the baseline's buckets.
+	BucketAssignment buckets;
+	Metrics baseline = loadResults(baselineFile, buckets);
+	Metrics current = loadResults(currentFile, buckets);
+
+	std::cout << "Change from '" << baselineFile << "' to '" << currentFile
+			<< "', " << confidence * 100 << "% intervals from "
+			<< RESAMPLES << " resamples.\n"
+			<< "metric                         baseline      current   change"
+			"      interval\n";
+
+	// A fixed seed, so the same two files always give the same verdict.
+	std::mt19937 random(49);
+	int regressions = 0;
+	for(const auto & entry : baseline){
+		auto found = current.find(entry.first);
+		const Metric & before = entry.second;
+		if(found == current.end() || before.samples.empty() ||
+				found->second.samples.empty() || mean(before.samples) == 0)
+			continue;
+
+		Change change = compare(before, found->second, confidence, random);
+		bool worse = before.higherIsBetter ? change.high < 1 : change.low > 1;
+		bool better = before.higherIsBetter ? change.low > 1 : change.high < 1;
+		bool regression = worse && std::abs(change.ratio - 1) > threshold;
+		regressions += regression;
+
+		std::cout << std::left << std::setw(27) << entry.first << std::right
+				<< std::fixed << std::setprecision(2)
+				<< std::setw(13) << change.baseline
+				<< std::setw(13) << change.current
+				<< std::setw(9) << formatPercent(change.ratio)
+				<< "  [" << formatPercent(change.low) << ", "
+				<< formatPercent(change.high) << "]"
+				<< (regression ? "  REGRESSION" : worse ? "  worse" :
+						better ? "  better" : "") << "\n";
+	}
+
+	std::cout << regressions << " significant regressions of more than "
+			<< threshold * 100 << "%." << std::endl;
+	return regressions == 0 ? 0 : 1;
+}
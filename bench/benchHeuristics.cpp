@@ -0,0 +1,124 @@
+/**
+ * \file benchHeuristics.cpp
+ *
+ * Compares the search heuristics by the nodes they need to solve a corpus.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "BenchCorpus.h"
+#include "Heuristics.h"
+#include "PuzzleIO.h"
+#include "Solver.h"
+#include "Verifier.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+int benchHeuristics(const std::string & path);
+
+namespace {
+
+/* Nodes before the first restart, for the row that uses restarts. */
+const uint64_t RESTART_NODES = 64;
+
+struct Totals {
+	uint64_t solved;
+	uint64_t nodes;
+	uint64_t maxNodes;
+	uint64_t backtracks;
+	uint64_t restarts;
+	double milliseconds;
+};
+
+/* Solves every puzzle of corpus with solver, checking each solution. Returns
+ * false if any puzzle was not solved correctly. */
+bool run(Solver & solver, const std::vector<BenchPuzzle> & corpus,
+		Totals & totals){
+	totals = Totals();
+	bool allValid = true;
+
+	for(const BenchPuzzle & puzzle : corpus){
+		uint8_t givens[Board::NUM_CELLS];
+		parsePuzzleLine(puzzle.line.data(), puzzle.line.size(), givens);
+		Board board;
+		if(!board.load(givens))
+			continue;
+
+		auto start = std::chrono::steady_clock::now();
+		Solver::Status status = solver.solve(board);
+		totals.milliseconds += std::chrono::duration<double, std::milli>(
+				std::chrono::steady_clock::now() - start).count();
+
+		const Solver::Stats & stats = solver.getStats();
+		totals.nodes += stats.nodes;
+		totals.maxNodes = std::max(totals.maxNodes, stats.nodes);
+		totals.backtracks += stats.backtracks;
+		totals.restarts += stats.restarts;
+		if(status != Solver::SOLVED)
+			continue;
+
+		uint8_t solution[Board::NUM_CELLS];
+		for(int i = 0; i < Board::NUM_CELLS; ++i)
+			solution[i] = static_cast<uint8_t>(board.getValue(i));
+		VerifyResult result = verifySolution(solution, givens);
+		if(result != VALID){
+			std::cerr << solver.getHeuristic().getName() << " got '"
+					<< puzzle.name << "' wrong: " << describe(result) << "."
+					<< std::endl;
+			allValid = false;
+			continue;
+		}
+		++totals.solved;
+	}
+
+	return allValid;
+}
+
+void printRow(const std::string & name, const Totals & totals,
+		std::size_t puzzles){
+	std::cout << std::left << std::setw(22) << name << std::right
+			<< std::setw(8) << totals.solved
+			<< std::setw(12) << totals.nodes
+			<< std::setw(10) << std::fixed << std::setprecision(1)
+			<< (puzzles == 0 ? 0.0 :
+					static_cast<double>(totals.nodes) / puzzles)
+			<< std::setw(10) << totals.maxNodes
+			<< std::setw(12) << totals.backtracks
+			<< std::setw(10) << totals.restarts
+			<< std::setw(10) << std::setprecision(2) << totals.milliseconds
+			<< "\n";
+}
+
+} // namespace
+
+int benchHeuristics(const std::string & path){
+	std::vector<BenchPuzzle> corpus = loadBenchCorpus(path);
+	std::cout << corpus.size() << " puzzles from '" << path << "'.\n"
+			<< "heuristic               solved       nodes  mean/pzl  max/pzl"
+			"  backtracks  restarts        ms\n";
+
+	bool allValid = true;
+	std::unique_ptr<Solver> solver(new Solver());
+	Totals totals;
+	for(const char * const * name = getHeuristicNames(); *name != nullptr;
+			++name){
+		solver->setHeuristic(makeHeuristic(*name));
+		allValid &= run(*solver, corpus, totals);
+		printRow(*name, totals, corpus.size());
+	}
+
+	// Randomized value order pays off only with restarts.
+	solver->setHeuristic(makeHeuristic("degree+random"));
+	solver->setRestarts(RESTART_NODES, 1);
+	allValid &= run(*solver, corpus, totals);
+	printRow("degree+random/restart", totals, corpus.size());
+
+	std::cout << std::flush;
+	return allValid ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+/**
+ * \file benchLatency.cpp
+ *
+ * Times solving each puzzle of a corpus over many repetitions, reports the
+ * times per difficulty bucket, and saves them as JSON for the compare mode.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "BenchCorpus.h"
+#include "PuzzleIO.h"
+#include "Solver.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int benchLatency(const std::string & path, int repeat,
+		const std::string & saveFile);
+
+namespace {
+
+/* One puzzle that is timed, and its samples. */
+struct TimedPuzzle {
+	std::string name;
+	uint8_t givens[Board::NUM_CELLS];
+
+	/* Search nodes the puzzle takes. */
+	double nodes;
+
+	int bucket;
+
+	/* Nanoseconds to load and solve the puzzle, one sample per repetition. */
+	std::vector<double> latencies;
+};
+
+/* The puzzles of one bucket, or of the whole corpus, and their samples. */
+struct Bucket {
+	std::string name;
+	std::vector<const TimedPuzzle *> puzzles;
+
+	/* Mean nanoseconds a puzzle, one sample per repetition. */
+	std::vector<double> latencies;
+};
+
+double median(std::vector<double> samples){
+	if(samples.empty())
+		return 0.0;
+	std::sort(samples.begin(), samples.end());
+	std::size_t middle = samples.size() / 2;
+	return samples.size() % 2 == 1 ? samples[middle] :
+			(samples[middle - 1] + samples[middle]) / 2;
+}
+
+/* Times loading and solving the puzzle once, adding the time to its samples.
+ * Returns the nanoseconds taken. */
+double timePuzzle(TimedPuzzle & puzzle, Solver & solver){
+	Board board;
+	auto start = std::chrono::steady_clock::now();
+	if(board.load(puzzle.givens))
+		solver.solve(board);
+	double nanoseconds = std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count();
+	puzzle.latencies.push_back(nanoseconds);
+	return nanoseconds;
+}
+
+/* text as a JSON string. */
+std::string quote(const std::string & text){
+	std::string quoted = "\"";
+	for(char c : text){
+		if(c == '"' || c == '\\')
+			quoted += '\\';
+		if(static_cast<unsigned char>(c) >= 0x20)
+			quoted += c;
+	}
+	return quoted + "\"";
+}
+
+void writeNumbers(std::ostream & out, const std::vector<double> & numbers){
+	out << "[";
+	for(std::size_t i = 0; i < numbers.size(); ++i)
+		out << (i == 0 ? "" : ", ") << numbers[i];
+	out << "]";
+}
+
+/* Saves each puzzle's bucket, nodes and median latency by name, so that the
+ * compare mode can pair the puzzles of two runs and keep the baseline's
+ * buckets. */
+void saveResults(const std::string & file, const std::string & path,
+		int repeat, const std::vector<TimedPuzzle> & puzzles,
+		const std::vector<double> & rates){
+	std::ofstream out(file);
+	out << std::setprecision(10) << "{\"benchmark\": \"latency\", \"corpus\": "
+			<< quote(path) << ", \"repeat\": " << repeat
+			<< ",\n \"puzzles_per_second\": ";
+	writeNumbers(out, rates);
+	out << ",\n \"puzzles\": [";
+	for(std::size_t i = 0; i < puzzles.size(); ++i){
+		const TimedPuzzle & puzzle = puzzles[i];
+		out << (i == 0 ? "\n" : ",\n") << "  {\"name\": " << quote(puzzle.name)
+				<< ", \"bucket\": " << quote(getBenchBucketName(puzzle.bucket))
+				<< ", \"nodes\": " << puzzle.nodes
+				<< ", \"latency_ns\": " << median(puzzle.latencies) << "}";
+	}
+	out << "]}\n";
+	if(!out)
+		throw std::runtime_error("Could not write results file '" + file +
+				"'.");
+}
+
+} // namespace
+
+int benchLatency(const std::string & path, int repeat,
+		const std::string & saveFile){
+	if(repeat < 2)
+		repeat = 2;
+	std::vector<BenchPuzzle> corpus = loadBenchCorpus(path);
+	std::unique_ptr<Solver> solver(new Solver());
+
+	/* Sort the puzzles into buckets by how hard the search finds them; this
+	 * first pass also warms up the caches and branch predictors. */
+	std::vector<TimedPuzzle> puzzles;
+	for(const BenchPuzzle & line : corpus){
+		TimedPuzzle puzzle;
+		Board board;
+		parsePuzzleLine(line.line.data(), line.line.size(), puzzle.givens);
+		if(!board.load(puzzle.givens) ||
+				solver->solve(board) != Solver::SOLVED){
+			std::cerr << "Skipping '" << line.name << "': no solution."
+					<< std::endl;
+			continue;
+		}
+		puzzle.name = line.name;
+		puzzle.nodes = static_cast<double>(solver->getStats().nodes);
+		puzzle.bucket = getBenchBucket(solver->getStats().nodes);
+		puzzles.push_back(puzzle);
+	}
+	if(puzzles.empty())
+		throw std::runtime_error("No puzzles to time in '" + path + "'.");
+
+	std::vector<double> rates;
+	for(int r = 0; r < repeat; ++r){
+		double nanoseconds = 0;
+		for(TimedPuzzle & puzzle : puzzles)
+			nanoseconds += timePuzzle(puzzle, *solver);
+		rates.push_back(puzzles.size() * 1e9 / nanoseconds);
+	}
+
+	std::vector<Bucket> buckets(NUM_BENCH_BUCKETS + 1);
+	for(int b = 0; b < NUM_BENCH_BUCKETS; ++b)
+		buckets[b].name = getBenchBucketName(b);
+	buckets.back().name = "all";
+	for(const TimedPuzzle & puzzle : puzzles){
+		buckets[puzzle.bucket].puzzles.push_back(&puzzle);
+		buckets.back().puzzles.push_back(&puzzle);
+	}
+	buckets.erase(std::remove_if(buckets.begin(), buckets.end(),
+			[](const Bucket & bucket){ return bucket.puzzles.empty(); }),
+			buckets.end());
+	for(Bucket & bucket : buckets)
+		for(int r = 0; r < repeat; ++r){
+			double nanoseconds = 0;
+			for(const TimedPuzzle * puzzle : bucket.puzzles)
+				nanoseconds += puzzle->latencies[r];
+			bucket.latencies.push_back(nanoseconds / bucket.puzzles.size());
+		}
+
+	std::cout << buckets.back().puzzles.size() << " puzzles from '" << path
+			<< "', " << repeat << " repetitions.\n"
+			<< "bucket    puzzles  median ns/pzl   min ns/pzl  mean nodes"
+			"    puzzles/s\n";
+	for(const Bucket & bucket : buckets){
+		double nodes = 0;
+		for(const TimedPuzzle * puzzle : bucket.puzzles)
+			nodes += puzzle->nodes;
+		double latency = median(bucket.latencies);
+		std::cout << std::left << std::setw(9) << bucket.name << std::right
+				<< std::setw(8) << bucket.puzzles.size()
+				<< std::fixed << std::setprecision(1)
+				<< std::setw(15) << latency
+				<< std::setw(13) << *std::min_element(
+						bucket.latencies.begin(), bucket.latencies.end())
+				<< std::setw(12) << nodes / bucket.puzzles.size()
+				<< std::setw(13) << std::setprecision(0) << 1e9 / latency
+				<< "\n";
+	}
+	std::cout << std::flush;
+
+	if(!saveFile.empty())
+		saveResults(saveFile, path, repeat, puzzles, rates);
+	return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * \file benchMain.cpp
+ *
+ * Entry point of the benchmark executable.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Puzzle.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+extern int benchHeuristics(const std::string & path);
+extern int benchProfile(const std::string & path, int repeat);
+extern int benchPrimitives(const std::string & puzzleFile,
+		const std::string & saveFile, const std::string & compareFile);
+extern int benchLatency(const std::string & path, int repeat,
+		const std::string & saveFile);
+extern int benchCompare(const std::string & baselineFile,
+		const std::string & currentFile, double threshold, double confidence);
+
+static void printUsage(const char * program){
+	std::cerr << "Usage:\n"
+			<< "  " << program << " heuristics <directory|puzzle file>\n"
+			<< "      Compare the search heuristics by nodes and time, on "
+			"puzzle files in a\n"
+			<< "      directory or one-line puzzles in a file such as "
+			"bench/hard.txt.\n"
+			<< "  " << program << " profile <directory|puzzle file> "
+			"[--repeat N]\n"
+			<< "      Measure cycles, instructions, branch and cache misses of "
+			"the parse,\n"
+			<< "      propagate, search and verify phases, per difficulty "
+			"bucket.\n"
+			<< "  " << program << " primitives [--puzzle FILE] "
+			"[--save FILE] [--compare FILE]\n"
+			<< "      Time the Square and Puzzle primitives in ns/op; save the "
+			"samples, or\n"
+			<< "      compare with samples saved by another build.\n"
+			<< "  " << program << " latency <directory|puzzle file> "
+			"[--repeat N] [--save FILE]\n"
+			<< "      Time solving the puzzles N times (default 20), per "
+			"difficulty bucket;\n"
+			<< "      save the samples as JSON.\n"
+			<< "  " << program << " compare <baseline> <current> "
+			"[--threshold PCT] [--confidence C]\n"
+			<< "      Compare two saved latency or primitives runs with "
+			"bootstrapped C\n"
+			<< "      intervals (default 0.95); exit with 1 if anything got "
+			"significantly\n"
+			<< "      worse by more than PCT percent (default 5)."
+			<< std::endl;
+}
+
+int main(int argc, char * argv[]){
+	std::string mode(argc > 1 ? argv[1] : "");
+	std::string path;
+	int repeat = 0;
+	double threshold = 5;
+	double confidence = 0.95;
+	std::string puzzleFile;
+	std::string saveFile;
+	std::string compareFile;
+
+	/* The path comes first, except in primitives mode which has none; compare
+	 * takes the two results files. */
+	int first = 2;
+	if(mode == "heuristics" || mode == "profile" || mode == "latency"){
+		if(argc < 3){
+			printUsage(argv[0]);
+			return 2;
+		}
+		path = argv[2];
+		first = 3;
+	}
+	else if(mode == "compare"){
+		if(argc < 4){
+			printUsage(argv[0]);
+			return 2;
+		}
+		path = argv[2];
+		compareFile = argv[3];
+		first = 4;
+	}
+	else if(mode != "primitives"){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	for(int i = first; i < argc; ++i){
+		std::string option(argv[i]);
+		if((mode == "profile" || mode == "latency") && option == "--repeat" &&
+				i + 1 < argc)
+			repeat = atoi(argv[++i]);
+		else if(mode == "primitives" && option == "--puzzle" && i + 1 < argc)
+			puzzleFile = argv[++i];
+		else if((mode == "primitives" || mode == "latency") &&
+				option == "--save" && i + 1 < argc)
+			saveFile = argv[++i];
+		else if(mode == "compare" && option == "--threshold" && i + 1 < argc)
+			threshold = atof(argv[++i]);
+		else if(mode == "compare" && option == "--confidence" && i + 1 < argc)
+			confidence = atof(argv[++i]);
+		else if(mode == "primitives" && option == "--compare" && i + 1 < argc)
+			compareFile = argv[++i];
+		else{
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	try{
+		if(mode == "profile")
+			return benchProfile(path, repeat > 0 ? repeat : 100);
+		if(mode == "latency")
+			return benchLatency(path, repeat > 0 ? repeat : 20, saveFile);
+		if(mode == "compare")
+			return benchCompare(path, compareFile, threshold / 100,
+					confidence);
+		if(mode == "primitives")
+			return benchPrimitives(puzzleFile, saveFile, compareFile);
+		return benchHeuristics(path);
+	}
+	catch(Puzzle::PuzzleFileException & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+}
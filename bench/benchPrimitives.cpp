@@ -0,0 +1,301 @@
+/**
+ * \file benchPrimitives.cpp
+ *
+ * Microbenchmarks of the Square and Puzzle primitives, of moves on a
+ * LivePuzzle, of checking a move against a cached solution and of hints, in
+ * nanoseconds per operation, with saving and comparison of results between
+ * builds.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "HintEngine.h"
+#include "LatencyHistogram.h"
+#include "LivePuzzle.h"
+#include "Puzzle.h"
+#include "SolutionCache.h"
+#include "Solver.h"
+#include "Square.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int benchPrimitives(const std::string & puzzleFile,
+		const std::string & saveFile, const std::string & compareFile);
+std::map<std::string, std::vector<double> > loadPrimitiveResults(
+		const std::string & file);
+
+namespace {
+
+/* Samples taken of each operation, and the time each sample aims for. */
+const int SAMPLES = 15;
+const double SAMPLE_NANOSECONDS = 5e6;
+
+/* First line of a results file. */
+const char * const RESULTS_HEADER = "# Sudoku_solver primitives, ns/op samples";
+
+struct Result {
+	std::string name;
+	std::vector<double> samples;
+};
+
+double median(std::vector<double> samples){
+	if(samples.empty())
+		return 0.0;
+	std::sort(samples.begin(), samples.end());
+	std::size_t middle = samples.size() / 2;
+	return samples.size() % 2 == 1 ? samples[middle] :
+			(samples[middle - 1] + samples[middle]) / 2;
+}
+
+/* Stops the compiler from optimising away the computation of value. */
+template<typename T>
+inline void keep(const T & value){
+	asm volatile("" : : "r"(&value) : "memory");
+}
+
+double nowNanoseconds(){
+	return std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Times op(i) for i from 0 to count - 1, SAMPLES times. setup(count) runs
+ * untimed before each sample, to give op fresh state. count is first doubled
+ * until a sample takes long enough to time reliably.
+ */
+template<typename Setup, typename Op>
+Result measure(const std::string & name, Setup setup, Op op){
+	std::size_t count = 64;
+	for(;;){
+		setup(count);
+		double start = nowNanoseconds();
+		for(std::size_t i = 0; i < count; ++i)
+			op(i);
+		if(nowNanoseconds() - start >= SAMPLE_NANOSECONDS / 4 ||
+				count >= (std::size_t(1) << 24))
+			break;
+		count *= 2;
+	}
+	count = std::max<std::size_t>(count * 4, 1);
+
+	Result result;
+	result.name = name;
+	for(int sample = 0; sample < SAMPLES; ++sample){
+		setup(count);
+		double start = nowNanoseconds();
+		for(std::size_t i = 0; i < count; ++i)
+			op(i);
+		result.samples.push_back((nowNanoseconds() - start) / count);
+	}
+	return result;
+}
+
+void noSetup(std::size_t){}
+
+std::vector<Result> runAll(const Puzzle & puzzle){
+	std::vector<Result> results;
+	std::vector<Square> squares;
+	const std::set<int> restriction = {1, 2, 3};
+	const Square unset(4, 5);
+	const Square set(4, 5, 7);
+	Square target;
+
+	// Fills squares with count unset Squares.
+	auto freshSquares = [&squares, &unset](std::size_t count){
+		squares.assign(count, unset);
+	};
+
+	results.push_back(measure("Square()", noSetup, [](std::size_t i){
+		Square square(i % Square::PUZZLE_SIZE, 3);
+		keep(square);
+	}));
+	results.push_back(measure("Square(value)", noSetup, [](std::size_t i){
+		Square square(3, i % Square::PUZZLE_SIZE, 1 + i % Square::PUZZLE_SIZE);
+		keep(square);
+	}));
+	results.push_back(measure("Square::setValue", freshSquares,
+			[&squares](std::size_t i){
+		keep(squares[i].setValue(1 + i % Square::PUZZLE_SIZE));
+	}));
+	results.push_back(measure("Square::restrictValues", freshSquares,
+			[&squares, &restriction](std::size_t i){
+		keep(squares[i].restrictValues(restriction));
+	}));
+	results.push_back(measure("Square::getPossibleValues", noSetup,
+			[&unset](std::size_t){
+		CandidateView values = unset.getPossibleValues();
+		keep(values);
+	}));
+	results.push_back(measure("Square copy", noSetup,
+			[&unset, &set](std::size_t i){
+		Square copy(i % 2 == 0 ? unset : set);
+		keep(copy);
+	}));
+	results.push_back(measure("Square assignment", noSetup,
+			[&unset, &set, &target](std::size_t i){
+		target = i % 2 == 0 ? unset : set;
+		keep(target);
+	}));
+	results.push_back(measure("Puzzle copy", noSetup,
+			[&puzzle](std::size_t){
+		Puzzle copy(puzzle);
+		keep(copy);
+	}));
+	results.push_back(measure("Puzzle::operator()", noSetup,
+			[&puzzle](std::size_t i){
+		keep(puzzle(i % Puzzle::PUZZLE_SIZE,
+				(i / Puzzle::PUZZLE_SIZE) % Puzzle::PUZZLE_SIZE).isSet());
+	}));
+
+	/* Moves of the puzzle's solution, in cell order, each onto a LivePuzzle
+	 * that starts again from the puzzle once it is full. */
+	Board board;
+	std::unique_ptr<Solver> solver(new Solver());
+	if(board.load(puzzle) && solver->solve(board) == Solver::SOLVED){
+		const LivePuzzle start(puzzle);
+		LivePuzzle live(start);
+		CandidateDiff diff;
+		int cell = 0;
+		auto restart = [&live, &start, &cell](std::size_t){
+			live = start;
+			cell = 0;
+		};
+		results.push_back(measure("LivePuzzle::applyMove", restart,
+				[&](std::size_t){
+			if(cell == Board::NUM_CELLS){
+				live = start;
+				cell = 0;
+			}
+			keep(live.applyMove(Board::rowOf(cell), Board::colOf(cell),
+					board.getValue(cell), diff));
+			++cell;
+		}));
+
+		/* Checking a board against the puzzle's solution: the search the
+		 * cache saves, then a check answered from the cache. */
+		uint8_t givens[Board::NUM_CELLS];
+		const Board & loaded = start.getBoard();
+		for(int i = 0; i < Board::NUM_CELLS; ++i){
+			const Square & square = puzzle(Board::rowOf(i), Board::colOf(i));
+			givens[i] = static_cast<uint8_t>(
+					square.isSet() ? square.getValue() : 0);
+		}
+		results.push_back(measure("Solver::countSolutions", noSetup,
+				[&](std::size_t){
+			keep(solver->countSolutions(loaded, 2));
+		}));
+		SolutionCache cache;
+		results.push_back(measure("SolutionCache::check", noSetup,
+				[&](std::size_t i){
+			keep(cache.check(i % 64, givens, loaded));
+		}));
+	}
+
+	// What the CLI adds to every solve: two clock reads and a record.
+	LatencyHistogram latency;
+	results.push_back(measure("LatencyHistogram::record", noSetup,
+			[&](std::size_t){
+		auto start = std::chrono::steady_clock::now();
+		latency.record(std::chrono::steady_clock::now() - start);
+	}));
+	keep(latency.getCount());
+
+	// The first hint for the puzzle as given.
+	Hint hint;
+	results.push_back(measure("HintEngine::findHint", noSetup,
+			[&](std::size_t){
+		keep(HintEngine::findHint(puzzle, hint));
+	}));
+
+	return results;
+}
+
+void saveResults(const std::string & file, const std::vector<Result> & results){
+	std::ofstream out(file);
+	out << RESULTS_HEADER << "\n";
+	for(const Result & result : results){
+		out << result.name;
+		for(double sample : result.samples)
+			out << "\t" << sample;
+		out << "\n";
+	}
+	if(!out)
+		throw std::runtime_error("Could not write results file '" + file +
+				"'.");
+}
+
+} // namespace
+
+/* Reads a results file written by saveResults(). */
+std::map<std::string, std::vector<double> > loadPrimitiveResults(
+		const std::string & file){
+	std::ifstream in(file);
+	if(!in)
+		throw std::runtime_error("Could not read results file '" + file + "'.");
+
+	std::map<std::string, std::vector<double> > results;
+	std::string line;
+	while(std::getline(in, line)){
+		if(line.empty() || line[0] == '#')
+			continue;
+		// The name is everything before the first tab; the samples follow.
+		std::size_t tab = line.find('\t');
+		if(tab == std::string::npos)
+			continue;
+		std::istringstream samples(line.substr(tab + 1));
+		std::vector<double> & values = results[line.substr(0, tab)];
+		for(double value; samples >> value; )
+			values.push_back(value);
+	}
+	return results;
+}
+
+int benchPrimitives(const std::string & puzzleFile,
+		const std::string & saveFile, const std::string & compareFile){
+	std::unique_ptr<Puzzle> puzzle(puzzleFile.empty() ? new Puzzle() :
+			new Puzzle(puzzleFile));
+	std::map<std::string, std::vector<double> > baseline;
+	if(!compareFile.empty())
+		baseline = loadPrimitiveResults(compareFile);
+
+	std::vector<Result> results = runAll(*puzzle);
+
+	std::cout << "operation                  median ns/op    min ns/op";
+	if(!compareFile.empty())
+		std::cout << "  baseline ns/op  speed-up";
+	std::cout << "\n";
+
+	for(const Result & result : results){
+		double current = median(result.samples);
+		std::cout << std::left << std::setw(27) << result.name << std::right
+				<< std::fixed << std::setprecision(2)
+				<< std::setw(13) << current
+				<< std::setw(13) << *std::min_element(result.samples.begin(),
+						result.samples.end());
+		if(!compareFile.empty()){
+			auto found = baseline.find(result.name);
+			if(found == baseline.end() || found->second.empty())
+				std::cout << std::setw(16) << "-" << std::setw(10) << "-";
+			else{
+				double before = median(found->second);
+				std::cout << std::setw(16) << before << std::setw(9)
+						<< before / current << "x";
+			}
+		}
+		std::cout << "\n";
+	}
+	std::cout << std::flush;
+
+	if(!saveFile.empty())
+		saveResults(saveFile, results);
+	return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * \file benchProfile.cpp
+ *
+ * Profiles the phases of solving (parse, propagate, search and verify) with
+ * hardware performance counters, per difficulty bucket.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "BenchCorpus.h"
+#include "PerfCounters.h"
+#include "Propagator.h"
+#include "PuzzleIO.h"
+#include "Solver.h"
+#include "Verifier.h"
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+int benchProfile(const std::string & path, int repeat);
+
+namespace {
+
+enum Phase {
+	PARSE,
+	PROPAGATE,
+	SEARCH,
+	VERIFY,
+	NUM_PHASES
+};
+
+const char * const PHASE_NAMES[NUM_PHASES] = {
+	"parse", "propagate", "search", "verify"
+};
+
+/* The puzzles of one bucket, and the state each phase leaves for the next. */
+struct Bucket {
+	std::vector<std::string> lines;
+	std::vector<uint8_t> givens;
+	std::vector<Board> propagated;
+	std::vector<uint8_t> solutions;
+	PerfCounters::Sample samples[NUM_PHASES];
+};
+
+/* Runs each phase over every puzzle of bucket, repeat times, inside the
+ * counters. Only the last repetition's results are kept; they are the same
+ * every time. */
+void profileBucket(Bucket & bucket, int repeat, PerfCounters & counters,
+		Solver & solver){
+	std::size_t count = bucket.lines.size();
+	bucket.givens.resize(count * Board::NUM_CELLS);
+	bucket.propagated.resize(count);
+	bucket.solutions.resize(count * Board::NUM_CELLS);
+
+	counters.start();
+	for(int r = 0; r < repeat; ++r)
+		for(std::size_t i = 0; i < count; ++i)
+			parsePuzzleLine(bucket.lines[i].data(), bucket.lines[i].size(),
+					&bucket.givens[i * Board::NUM_CELLS]);
+	bucket.samples[PARSE].add(counters.stop());
+
+	counters.start();
+	for(int r = 0; r < repeat; ++r)
+		for(std::size_t i = 0; i < count; ++i)
+			if(bucket.propagated[i].load(&bucket.givens[i * Board::NUM_CELLS]))
+				Propagator::propagate(bucket.propagated[i]);
+	bucket.samples[PROPAGATE].add(counters.stop());
+
+	Board board;
+	counters.start();
+	for(int r = 0; r < repeat; ++r){
+		for(std::size_t i = 0; i < count; ++i){
+			board = bucket.propagated[i];
+			solver.solve(board);
+			for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+				bucket.solutions[i * Board::NUM_CELLS + cell] =
+						static_cast<uint8_t>(board.getValue(cell));
+		}
+	}
+	bucket.samples[SEARCH].add(counters.stop());
+
+	volatile int valid = 0;
+	counters.start();
+	for(int r = 0; r < repeat; ++r)
+		for(std::size_t i = 0; i < count; ++i)
+			valid += verifySolution(&bucket.solutions[i * Board::NUM_CELLS],
+					&bucket.givens[i * Board::NUM_CELLS]) == VALID;
+	bucket.samples[VERIFY].add(counters.stop());
+}
+
+void printSample(const std::string & bucket, const char * phase,
+		const PerfCounters::Sample & sample, double operations,
+		const PerfCounters & counters){
+	std::cout << std::left << std::setw(9) << bucket << std::setw(11) << phase
+			<< std::right << std::fixed << std::setprecision(1)
+			<< std::setw(10) << sample.nanoseconds / operations
+			<< std::setw(11) << sample.ticks / operations;
+
+	for(int i = 0; i < PerfCounters::NUM_COUNTERS; ++i){
+		PerfCounters::Counter counter = static_cast<PerfCounters::Counter>(i);
+		if(counters.isAvailable(counter))
+			std::cout << std::setw(14) << sample.values[i] / operations;
+		else
+			std::cout << std::setw(14) << "-";
+	}
+
+	if(counters.isAvailable(PerfCounters::CYCLES) &&
+			counters.isAvailable(PerfCounters::INSTRUCTIONS) &&
+			sample.values[PerfCounters::CYCLES] != 0)
+		std::cout << std::setw(7) << std::setprecision(2)
+				<< static_cast<double>(
+						sample.values[PerfCounters::INSTRUCTIONS]) /
+						sample.values[PerfCounters::CYCLES];
+	else
+		std::cout << std::setw(7) << "-";
+	std::cout << "\n";
+}
+
+} // namespace
+
+int benchProfile(const std::string & path, int repeat){
+	if(repeat < 1)
+		repeat = 1;
+	std::vector<BenchPuzzle> corpus = loadBenchCorpus(path);
+	std::unique_ptr<Solver> solver(new Solver());
+
+	// Sort the puzzles into buckets by how hard the search finds them.
+	Bucket buckets[NUM_BENCH_BUCKETS];
+	for(const BenchPuzzle & puzzle : corpus){
+		uint8_t givens[Board::NUM_CELLS];
+		Board board;
+		parsePuzzleLine(puzzle.line.data(), puzzle.line.size(), givens);
+		if(!board.load(givens) || solver->solve(board) != Solver::SOLVED){
+			std::cerr << "Skipping '" << puzzle.name << "': no solution."
+					<< std::endl;
+			continue;
+		}
+		buckets[getBenchBucket(solver->getStats().nodes)].lines.push_back(
+				puzzle.line);
+	}
+
+	PerfCounters counters;
+	std::cout << corpus.size() << " puzzles from '" << path << "', "
+			<< repeat << " repetitions; " << counters.getDescription()
+			<< "\nPer puzzle:\n"
+			<< "bucket   phase             ns      ticks";
+	for(int i = 0; i < PerfCounters::NUM_COUNTERS; ++i)
+		std::cout << std::setw(14)
+				<< PerfCounters::getName(static_cast<PerfCounters::Counter>(i));
+	std::cout << "    IPC\n";
+
+	Bucket all;
+	for(int b = 0; b < NUM_BENCH_BUCKETS; ++b){
+		Bucket & bucket = buckets[b];
+		if(bucket.lines.empty())
+			continue;
+		profileBucket(bucket, repeat, counters, *solver);
+
+		double operations = static_cast<double>(bucket.lines.size()) * repeat;
+		for(int phase = 0; phase < NUM_PHASES; ++phase){
+			printSample(phase == 0 ? getBenchBucketName(b) : "",
+					PHASE_NAMES[phase],
+					bucket.samples[phase], operations, counters);
+			all.samples[phase].add(bucket.samples[phase]);
+		}
+		all.lines.insert(all.lines.end(), bucket.lines.begin(),
+				bucket.lines.end());
+	}
+
+	double operations = static_cast<double>(all.lines.size()) * repeat;
+	if(operations > 0)
+		for(int phase = 0; phase < NUM_PHASES; ++phase)
+			printSample(phase == 0 ? "all" : "", PHASE_NAMES[phase],
+					all.samples[phase], operations, counters);
+
+	std::cout << "Buckets by search nodes: trivial 1, easy up to 10, medium "
+			"up to 100, hard more." << std::endl;
+	return 0;
+}
@@ -0,0 +1,49 @@
+# Runs the instrumented binaries of a SUDOKU_PGO=GENERATE build on the puzzles/
+# corpus, so that a SUDOKU_PGO=USE build can be optimised for it.
+#
+# Expects SOLVER, BENCH, SOURCE_DIR and PROFILE_DIR, and LLVM_PROFDATA when the
+# compiler is Clang.
+
+file(GLOB puzzles "${SOURCE_DIR}/puzzles/*.txt")
+list(FILTER puzzles EXCLUDE REGEX "\\.soln\\.txt$")
+
+# Each puzzle file as a file, and all of them as one-line puzzles for the
+# streaming and batch modes.
+set(lines "")
+foreach(puzzle ${puzzles})
+	execute_process(COMMAND ${SOLVER} ${puzzle} OUTPUT_QUIET ERROR_QUIET)
+	execute_process(COMMAND ${SOLVER} --parallel ${puzzle} --count 100
+		OUTPUT_QUIET ERROR_QUIET)
+	file(STRINGS ${puzzle} rows)
+	string(REPLACE ";" "" line "${rows}")
+	string(APPEND lines "${line}\n")
+endforeach()
+file(READ "${SOURCE_DIR}/bench/hard.txt" hard)
+string(APPEND lines "${hard}")
+
+set(batch "${PROFILE_DIR}/training.txt")
+file(WRITE ${batch} "")
+foreach(i RANGE 200)
+	file(APPEND ${batch} "${lines}")
+endforeach()
+
+execute_process(COMMAND ${SOLVER} --stream INPUT_FILE ${batch}
+	OUTPUT_QUIET ERROR_QUIET)
+execute_process(COMMAND ${SOLVER} --batch ${batch} ${PROFILE_DIR}/training.out
+	OUTPUT_QUIET ERROR_QUIET)
+execute_process(COMMAND ${SOLVER} --verify ${SOURCE_DIR}/puzzles
+	OUTPUT_QUIET ERROR_QUIET)
+execute_process(COMMAND ${BENCH} heuristics ${SOURCE_DIR}/bench/hard.txt
+	OUTPUT_QUIET ERROR_QUIET)
+execute_process(COMMAND ${BENCH} profile ${batch} --repeat 2
+	OUTPUT_QUIET ERROR_QUIET)
+
+if(LLVM_PROFDATA)
+	file(GLOB raw "${PROFILE_DIR}/*.profraw")
+	if(raw)
+		execute_process(COMMAND ${LLVM_PROFDATA} merge
+			-output=${PROFILE_DIR}/sudoku.profdata ${raw})
+	endif()
+endif()
+
+message(STATUS "Profiles written to ${PROFILE_DIR}.")
@@ -0,0 +1,80 @@
+/** \file FuzzInput.h
+ *
+ * \brief Helpers shared by the fuzz targets: checking an invariant, and
+ * handing a fuzz input to code that reads from a file.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef FUZZINPUT_H_
+#define FUZZINPUT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+/**
+ * \brief Aborts, so the fuzzer keeps the input, if cond is false.
+ *
+ * Unlike assert() this is kept whatever the build type.
+ */
+#define FUZZ_CHECK(cond) \
+	do{ \
+		if(!(cond)){ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, \
+					#cond); \
+			abort(); \
+		} \
+	} while(0)
+
+/**
+ * \brief Returns a file descriptor positioned at the start of a file holding
+ * the size bytes of data, and nothing else.
+ *
+ * The same temporary file is reused for every input of the process, so it
+ * must not be used after the next call.
+ */
+inline int fuzzInputFd(const void * data, std::size_t size){
+	static int fd = -1;
+	if(fd < 0){
+		FILE * file = tmpfile();
+		if(file == nullptr)
+			throw std::runtime_error("Could not create a temporary file.");
+		fd = dup(fileno(file));
+		fclose(file);
+	}
+	FUZZ_CHECK(ftruncate(fd, 0) == 0);
+	FUZZ_CHECK(pwrite(fd, data, size, 0) == static_cast<ssize_t>(size));
+	FUZZ_CHECK(lseek(fd, 0, SEEK_SET) == 0);
+	return fd;
+}
+
+/**
+ * \brief Returns the name of a temporary file holding the size bytes of data,
+ * for code that opens a file by name. The same file is reused, as for
+ * fuzzInputFd().
+ */
+inline std::string fuzzInputFile(const void * data, std::size_t size){
+	static std::string name;
+	if(name.empty()){
+		char path[] = "/tmp/sudokuFuzzXXXXXX";
+		int fd = mkstemp(path);
+		if(fd < 0)
+			throw std::runtime_error("Could not create a temporary file.");
+		close(fd);
+		name = path;
+		atexit([]{ unlink(name.c_str()); });
+	}
+	FILE * file = fopen(name.c_str(), "wb");
+	FUZZ_CHECK(file != nullptr);
+	FUZZ_CHECK(fwrite(data, 1, size, file) == size);
+	fclose(file);
+	return name;
+}
+
+#endif /* FUZZINPUT_H_ */
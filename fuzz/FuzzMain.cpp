@@ -0,0 +1,157 @@
+/**
+ * \file FuzzMain.cpp
+ *
+ * A main() for the fuzz targets when they are not built with libFuzzer: runs
+ * the target over files given on the command line, the files in directories
+ * given on it, or standard input if there are none. This is how AFL runs a
+ * target (with @@ or on standard input) and how a crash found by either
+ * fuzzer is replayed. With --mutate N, each input is also run with N random
+ * changes, for a quick search without a fuzzer.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include <algorithm>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, std::size_t size);
+
+namespace {
+
+/* Where a failing input is saved, so that it can be replayed. */
+const char CRASH_FILE[] = "fuzz-crash.bin";
+
+/* The input being run, for the crash handler. */
+const std::vector<uint8_t> * current = nullptr;
+
+/* Saves the input being run and dies of the same signal. Only calls that are
+ * safe in a signal handler are made. */
+void saveCrash(int signal){
+	if(current != nullptr){
+		int fd = open(CRASH_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if(fd >= 0){
+			if(write(fd, current->data(), current->size()) < 0){}
+			close(fd);
+		}
+		const char note[] = "Failing input saved to fuzz-crash.bin.\n";
+		if(write(STDERR_FILENO, note, sizeof(note) - 1) < 0){}
+	}
+	std::signal(signal, SIG_DFL);
+	raise(signal);
+}
+
+void run(const std::vector<uint8_t> & input){
+	current = &input;
+	LLVMFuzzerTestOneInput(input.data(), input.size());
+	current = nullptr;
+}
+
+/* Makes one random change to input: a byte replaced, inserted or erased, or
+ * the input cut short, with bytes a puzzle parser cares about favoured. */
+void mutate(std::vector<uint8_t> & input, std::mt19937 & random){
+	static const uint8_t INTERESTING[] = {'\n', '\r', '.', '#', '0', '1', '5',
+			'9', ' ', 0, 0x7f, 0xff};
+	auto pick = [&random](std::size_t count){
+		return std::uniform_int_distribution<std::size_t>(0, count - 1)(random);
+	};
+	uint8_t byte = random() % 2 == 0 ?
+			INTERESTING[pick(sizeof(INTERESTING))] :
+			static_cast<uint8_t>(random());
+	switch(input.empty() ? 1 : random() % 4){
+	case 0:
+		input[pick(input.size())] = byte;
+		break;
+	case 1:
+		input.insert(input.begin() + pick(input.size() + 1), byte);
+		break;
+	case 2:{
+		std::size_t at = pick(input.size());
+		input.erase(input.begin() + at, input.begin() + at +
+				std::min<std::size_t>(1 + pick(16), input.size() - at));
+		break;
+	}
+	default:
+		input.resize(pick(input.size()));
+	}
+}
+
+/* Adds path, or the files in it if it is a directory, to files. */
+void addInputs(const std::string & path, std::vector<std::string> & files){
+	struct stat status;
+	if(stat(path.c_str(), &status) != 0 || !S_ISDIR(status.st_mode)){
+		files.push_back(path);
+		return;
+	}
+	std::vector<std::string> entries;
+	if(DIR * dir = opendir(path.c_str())){
+		while(dirent * entry = readdir(dir))
+			if(entry->d_name[0] != '.')
+				entries.push_back(path + "/" + entry->d_name);
+		closedir(dir);
+	}
+	std::sort(entries.begin(), entries.end());
+	for(const std::string & entry : entries)
+		addInputs(entry, files);
+}
+
+} // namespace
+
+int main(int argc, char * argv[]){
+	int mutations = 0;
+	std::vector<std::string> files;
+	for(int i = 1; i < argc; ++i){
+		if(strcmp(argv[i], "--mutate") == 0 && i + 1 < argc)
+			mutations = atoi(argv[++i]);
+		else
+			addInputs(argv[i], files);
+	}
+	for(int signal : {SIGABRT, SIGSEGV, SIGBUS, SIGFPE, SIGILL})
+		std::signal(signal, saveCrash);
+
+	std::vector<std::vector<uint8_t> > inputs;
+	if(files.empty())
+		inputs.push_back(std::vector<uint8_t>(
+				std::istreambuf_iterator<char>(std::cin),
+				std::istreambuf_iterator<char>()));
+	for(const std::string & file : files){
+		std::ifstream in(file, std::ios::binary);
+		if(!in){
+			std::cerr << "Could not read '" << file << "'." << std::endl;
+			return 1;
+		}
+		inputs.push_back(std::vector<uint8_t>(
+				std::istreambuf_iterator<char>(in),
+				std::istreambuf_iterator<char>()));
+	}
+
+	// A fixed seed, so a run can be repeated exactly.
+	std::mt19937 random(50);
+	for(const std::vector<uint8_t> & input : inputs){
+		run(input);
+		std::vector<uint8_t> mutant = input;
+		for(int i = 0; i < mutations; ++i){
+			// Changes pile up, but are started afresh now and then.
+			if(random() % 8 == 0)
+				mutant = input;
+			mutate(mutant, random);
+			run(mutant);
+		}
+	}
+	std::cout << inputs.size() << " inputs and " << inputs.size() * mutations
+			<< " mutants run." << std::endl;
+	return 0;
+}
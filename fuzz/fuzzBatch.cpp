@@ -0,0 +1,74 @@
+/**
+ * \file fuzzBatch.cpp
+ *
+ * Fuzz target for the batch parsers: the input as a text corpus, read record
+ * by record and solved by stream mode, and as a batch checkpoint.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "FuzzInput.h"
+#include "BatchPipeline.h"
+#include "PuzzleIO.h"
+#include "StreamMode.h"
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/* Search nodes each puzzle may take, so that no input is slow to run. */
+const uint64_t MAX_NODES = 2000;
+
+/* Reads the input as a text corpus, returning the number of records. */
+uint64_t checkCorpus(int fd, std::size_t size){
+	CorpusReader reader(fd, TEXT_FORMAT);
+	uint8_t givens[Board::NUM_CELLS];
+	bool valid;
+	uint64_t records = 0;
+	uint64_t offset = 0;
+	while(reader.next(givens, valid)){
+		++records;
+		if(valid)
+			for(uint8_t given : givens)
+				FUZZ_CHECK(given <= Board::PUZZLE_SIZE);
+		FUZZ_CHECK(reader.getOffset() > offset && reader.getOffset() <= size);
+		offset = reader.getOffset();
+	}
+	return records;
+}
+
+/* A checkpoint that parses is written back as the same line. */
+void checkCheckpoint(const uint8_t * data, std::size_t size){
+	std::string text(reinterpret_cast<const char *>(data), size);
+	try{
+		BatchCheckpoint checkpoint = BatchCheckpoint::fromString(text);
+		std::string written = checkpoint.toString();
+		FUZZ_CHECK(BatchCheckpoint::fromString(written).toString() == written);
+	}
+	catch(const std::invalid_argument &){
+	}
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, std::size_t size){
+	static int devNull = open("/dev/null", O_WRONLY);
+	FUZZ_CHECK(devNull >= 0);
+
+	int fd = fuzzInputFd(data, size);
+	uint64_t records = checkCorpus(fd, size);
+
+	// Stream mode sees the same records, and gives each one outcome.
+	FUZZ_CHECK(lseek(fd, 0, SEEK_SET) == 0);
+	Solver::Limits limits;
+	limits.maxNodes = MAX_NODES;
+	StreamStats stats = runStreamMode(fd, devNull, limits);
+	FUZZ_CHECK(stats.records == records);
+	FUZZ_CHECK(stats.solved + stats.unsolvable + stats.invalid +
+			stats.timedOut == records);
+
+	checkCheckpoint(data, size);
+	return 0;
+}
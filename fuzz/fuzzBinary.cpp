@@ -0,0 +1,70 @@
+/**
+ * \file fuzzBinary.cpp
+ *
+ * Fuzz target for the binary formats: the input as the records of a binary
+ * corpus, and as a corpus index.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "FuzzInput.h"
+#include "CorpusIndex.h"
+#include "PuzzleIO.h"
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/* The input after a binary header reads as one record per BINARY_RECORD_SIZE
+ * bytes, and every record that unpacks packs back to the same bytes. */
+void checkRecords(const uint8_t * data, std::size_t size){
+	std::vector<uint8_t> file(BINARY_MAGIC, BINARY_MAGIC + BINARY_HEADER_SIZE);
+	file.insert(file.end(), data, data + size);
+	int fd = fuzzInputFd(file.data(), file.size());
+	FUZZ_CHECK(detectCorpusFormat(fd) == BINARY_FORMAT);
+	FUZZ_CHECK(lseek(fd, BINARY_HEADER_SIZE, SEEK_SET) ==
+			static_cast<off_t>(BINARY_HEADER_SIZE));
+
+	CorpusReader reader(fd, BINARY_FORMAT);
+	uint8_t givens[Board::NUM_CELLS];
+	bool valid;
+	std::size_t records = 0;
+	while(reader.next(givens, valid)){
+		const uint8_t * record = data + records * BINARY_RECORD_SIZE;
+		bool whole = size - records * BINARY_RECORD_SIZE >= BINARY_RECORD_SIZE;
+		++records;
+		uint8_t unpacked[Board::NUM_CELLS];
+		FUZZ_CHECK(valid == (whole && unpackPuzzleRecord(record, unpacked)));
+		if(!valid)
+			continue;
+		FUZZ_CHECK(memcmp(givens, unpacked, sizeof(givens)) == 0);
+		uint8_t packed[BINARY_RECORD_SIZE];
+		packPuzzleRecord(givens, packed);
+		FUZZ_CHECK(memcmp(packed, record, BINARY_RECORD_SIZE) == 0);
+	}
+	FUZZ_CHECK(records == (size + BINARY_RECORD_SIZE - 1) / BINARY_RECORD_SIZE);
+}
+
+/* An index either is rejected or has increasing offsets within the file. */
+void checkIndex(const uint8_t * data, std::size_t size){
+	int fd = fuzzInputFd(data, size);
+	try{
+		CorpusIndex index = readCorpusIndex(fd);
+		FUZZ_CHECK(index.stride > 0);
+		for(std::size_t i = 0; i < index.offsets.size(); ++i)
+			FUZZ_CHECK(index.offsets[i] < index.fileSize &&
+					(i == 0 || index.offsets[i] > index.offsets[i - 1]));
+	}
+	catch(const std::runtime_error &){
+	}
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, std::size_t size){
+	checkRecords(data, size);
+	checkIndex(data, size);
+	return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * \file fuzzPuzzleText.cpp
+ *
+ * Fuzz target for the text parsers: each line of the input as a one-line
+ * puzzle, and the whole input as a puzzle file read by class Puzzle.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "FuzzInput.h"
+#include "Board.h"
+#include "Puzzle.h"
+#include "PuzzleIO.h"
+#include "Verifier.h"
+#include <cstring>
+
+namespace {
+
+/* A line that parses loads, when its givens agree, into a Board that formats
+ * to a line keeping every given. */
+void checkLine(const char * line, std::size_t length){
+	uint8_t givens[Board::NUM_CELLS];
+	if(!parsePuzzleLine(line, length, givens))
+		return;
+	for(uint8_t given : givens)
+		FUZZ_CHECK(given <= Board::PUZZLE_SIZE);
+
+	Board board;
+	if(!board.load(givens))
+		return;
+	char formatted[Board::NUM_CELLS];
+	formatPuzzleLine(board, formatted);
+	uint8_t again[Board::NUM_CELLS];
+	FUZZ_CHECK(parsePuzzleLine(formatted, Board::NUM_CELLS, again));
+	for(int i = 0; i < Board::NUM_CELLS; ++i)
+		FUZZ_CHECK(givens[i] == 0 || again[i] == givens[i]);
+}
+
+/* A puzzle file either loads or is rejected with a PuzzleFileException whose
+ * message is complete. */
+void checkPuzzleFile(const uint8_t * data, std::size_t size){
+	std::string filename = fuzzInputFile(data, size);
+	try{
+		Puzzle puzzle(filename);
+		uint8_t grid[Board::NUM_CELLS];
+		gridOf(puzzle, grid);
+		int unset = 0;
+		for(uint8_t value : grid){
+			FUZZ_CHECK(value <= Board::PUZZLE_SIZE);
+			unset += value == 0;
+		}
+		FUZZ_CHECK(puzzle.getNumLeftToSolve() == unset);
+	}
+	catch(const Puzzle::PuzzleFileException & e){
+		const char * message = e.what();
+		std::size_t length = strlen(message);
+		FUZZ_CHECK(length > 0 && message[length - 1] == '.');
+	}
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, std::size_t size){
+	const char * text = reinterpret_cast<const char *>(data);
+	const char * end = text + size;
+	for(const char * line = text; line < end;){
+		const char * newline = static_cast<const char *>(
+				memchr(line, '\n', end - line));
+		if(newline == nullptr)
+			newline = end;
+		checkLine(line, newline - line);
+		line = newline + 1;
+	}
+
+	checkPuzzleFile(data, size);
+	return 0;
+}
@@ -0,0 +1,365 @@
+/** \file BatchPipeline.h
+ *
+ * \brief Defines the class BatchPipeline, which solves a file of one-line
+ * puzzles with separate reader, solver and writer threads.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef BATCHPIPELINE_H_
+#define BATCHPIPELINE_H_
+
+#include "Board.h"
+#include "LatencyHistogram.h"
+#include "PuzzleIO.h"
+#include "RingBuffer.h"
+#include "Solver.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * \struct QueueMetrics
+ * \brief Occupancy counters for one of the queues between pipeline stages.
+ *
+ * The depth is sampled every time an element is taken off the queue. A queue
+ * that is usually near capacity sits in front of the bottleneck stage; a queue
+ * that is usually empty means the stage after it is starved.
+ */
+struct QueueMetrics {
+	/** \brief Number of elements the queue can hold. */
+	std::size_t capacity;
+
+	/** \brief Number of depth samples taken. */
+	uint64_t samples;
+
+	/** \brief Sum of the sampled depths. */
+	uint64_t depthSum;
+
+	/** \brief Largest depth sampled. */
+	std::size_t maxDepth;
+
+	/** \brief Number of times a producer found the queue full and had to
+	 * wait. */
+	uint64_t producerStalls;
+
+	/** \brief Number of times a consumer found the queue empty and had to
+	 * wait. */
+	uint64_t consumerStalls;
+
+	QueueMetrics() : capacity(0), samples(0), depthSum(0), maxDepth(0),
+			producerStalls(0), consumerStalls(0) {}
+
+	/** \brief Returns the mean sampled depth. */
+	double getAverageDepth() const {
+		return samples == 0 ? 0.0 : static_cast<double>(depthSum) / samples;
+	}
+
+	/** \brief Adds the counters of other to this. */
+	void merge(const QueueMetrics & other);
+};
+
+/**
+ * \struct PipelineStats
+ * \brief Counts and queue metrics for one run of a \ref BatchPipeline.
+ */
+struct PipelineStats {
+	/** \brief Number of puzzle records read (blank lines are not counted). */
+	uint64_t records;
+
+	/** \brief Number of puzzles solved. */
+	uint64_t solved;
+
+	/** \brief Number of puzzles with no solution. */
+	uint64_t unsolvable;
+
+	/** \brief Number of lines that were not valid one-line puzzles. */
+	uint64_t invalid;
+
+	/** \brief Number of puzzles given up on at the Solver's limits. */
+	uint64_t timedOut;
+
+	/** \brief Total search nodes over all puzzles. */
+	uint64_t nodes;
+
+	/** \brief Free slots, from the writer back to the reader. */
+	QueueMetrics freeQueue;
+
+	/** \brief Parsed puzzles, from the reader to the solvers. */
+	QueueMetrics solveQueue;
+
+	/** \brief Finished puzzles, from the solvers to the writer. */
+	QueueMetrics writeQueue;
+
+	PipelineStats() : records(0), solved(0), unsolvable(0), invalid(0),
+			timedOut(0), nodes(0) {}
+};
+
+/**
+ * \struct BatchCheckpoint
+ * \brief How far a batch run has durably got, from which another can resume.
+ *
+ * The input offset counts from where the first run started reading, and the
+ * output offset from the start of the output file. A checkpoint is only saved
+ * once the output it covers has been flushed to disk, so after a crash the
+ * output holds at least that much; anything after outputOffset is from records
+ * the checkpoint does not cover and is cut off on resuming.
+ */
+struct BatchCheckpoint {
+	/** \brief Number of records written. */
+	uint64_t records;
+
+	/** \brief Number of those that were solved. */
+	uint64_t solved;
+
+	/** \brief Number of those with no solution. */
+	uint64_t unsolvable;
+
+	/** \brief Number of those that were not valid puzzles. */
+	uint64_t invalid;
+
+	/** \brief Number of those given up on at the Solver's limits. */
+	uint64_t timedOut;
+
+	/** \brief Total search nodes over those records. */
+	uint64_t nodes;
+
+	/** \brief Bytes of input taken up by the records written. */
+	uint64_t inputOffset;
+
+	/** \brief Bytes of output written for them. */
+	uint64_t outputOffset;
+
+	/** \brief Names the input, so that a checkpoint is not resumed against
+	 * another; set by the caller and kept by the pipeline. */
+	std::string input;
+
+	BatchCheckpoint() : records(0), solved(0), unsolvable(0), invalid(0),
+			timedOut(0), nodes(0), inputOffset(0), outputOffset(0) {}
+
+	/**
+	 * \brief Returns the checkpoint as one line of text: the six counts, the
+	 * two offsets, then the input name.
+	 */
+	std::string toString() const;
+
+	/**
+	 * \brief Parses a line written by toString().
+	 *
+	 * Throws a std::invalid_argument exception if it is not one.
+	 */
+	static BatchCheckpoint fromString(const std::string & text);
+
+	/**
+	 * \brief Replaces the file at path with this checkpoint, atomically: it
+	 * is written to a temporary file beside path, synced, and renamed over
+	 * path. If that fails, a std::runtime_error is thrown and the file at path
+	 * is left as it was.
+	 */
+	void save(const std::string & path) const;
+
+	/**
+	 * \brief Reads a checkpoint saved by save(). Throws a std::runtime_error
+	 * if the file cannot be read and a std::invalid_argument if it does not
+	 * hold a checkpoint.
+	 */
+	static BatchCheckpoint load(const std::string & path);
+};
+
+/**
+ * \brief Positions files to resume from a checkpoint: inFd, at the start of
+ * the input, is moved on past the records the checkpoint covers, and the output
+ * on outFd is cut back to what those records wrote and positioned at its end.
+ *
+ * Throws a std::runtime_error if the output is shorter than the checkpoint
+ * says, or either file cannot be positioned.
+ */
+void seekToCheckpoint(int inFd, int outFd, const BatchCheckpoint & checkpoint);
+
+/**
+ * \class BatchPipeline
+ * \brief Solves one-line puzzles with parsing, solving and output running
+ * concurrently.
+ *
+ * A reader thread parses lines into puzzle slots, a number of solver threads
+ * solve them and a writer thread formats the results in input order. The
+ * slots are allocated once; the stages hand slot indices to each other
+ * through lock-free ring buffers, and the writer hands written slots back to
+ * the reader. For text input, the output is the same as for runStreamMode().
+ */
+class BatchPipeline {
+public:
+	/**
+	 * \struct Options
+	 * \brief Settings for a BatchPipeline.
+	 */
+	struct Options {
+		/** \brief Number of solver threads; 0 means one per hardware
+		 * thread. */
+		int solverThreads;
+
+		/** \brief Number of puzzle slots, which bounds the number of
+		 * puzzles in flight. */
+		std::size_t slots;
+
+		/** \brief Limits on the search for each puzzle, so one hard puzzle
+		 * cannot hold up a solver thread. */
+		Solver::Limits limits;
+
+		/** \brief Format of the input, which is read from its current
+		 * position: for a binary file, just past its header. */
+		CorpusFormat format;
+
+		/** \brief Number of bytes of input to read at most, to solve one
+		 * shard of a file. */
+		uint64_t inputLimit;
+
+		/** \brief Bytes already read from the input, as readCompression()
+		 * reads them from a pipe, which come before the rest of it. */
+		std::string inputPrefix;
+
+		/** \brief Where to save a BatchCheckpoint as the run goes, or empty
+		 * for none. The output must then be a file, as it is synced before
+		 * each checkpoint is saved. */
+		std::string checkpointPath;
+
+		/** \brief Number of records written between checkpoints; syncing
+		 * costs milliseconds, so this should be many thousands. A final
+		 * checkpoint is saved at the end of the run. */
+		uint64_t checkpointEvery;
+
+		/** \brief If not null, receives the time each solve takes. */
+		LatencyHistogram * latency;
+
+		Options() : solverThreads(0), slots(1024), format(TEXT_FORMAT),
+				inputLimit(ChunkedReader::NO_LIMIT), checkpointEvery(100000),
+				latency(nullptr) {}
+	};
+
+public:
+	/**
+	 * \brief Creates a pipeline and allocates its slots and queues.
+	 */
+	explicit BatchPipeline(const Options & options = Options());
+
+	/**
+	 * \brief Solves every puzzle read from inFd, writing the results to
+	 * outFd.
+	 *
+	 * If reading or writing fails, the pipeline is shut down and the
+	 * exception is rethrown here.
+	 *
+	 * \param start The checkpoint being resumed from, with the files already
+	 * positioned by seekToCheckpoint(), or an empty one with just the input
+	 * name for a fresh run. The counts returned, and those of the checkpoints
+	 * saved, carry on from it.
+	 */
+	PipelineStats run(int inFd, int outFd,
+			const BatchCheckpoint & start = BatchCheckpoint());
+
+	/**
+	 * \brief Returns the current depths of the free, solve and write queues.
+	 * May be called from any thread while run() is in progress.
+	 */
+	void getQueueDepths(std::size_t & freeDepth, std::size_t & solveDepth,
+			std::size_t & writeDepth) const;
+
+	/** \brief Returns the number of solver threads run() uses. */
+	int getSolverThreads() const;
+
+private:
+	/**
+	 * \enum SlotStatus
+	 * \brief How far a slot's puzzle has got through the pipeline.
+	 */
+	enum SlotStatus {
+		PARSED,
+		INVALID,
+		SOLVED,
+		UNSOLVABLE,
+		TIMED_OUT
+	};
+
+	/**
+	 * \struct Slot
+	 * \brief Preallocated storage for one puzzle in flight.
+	 */
+	struct Slot {
+		/** \brief Position of the puzzle in the input. */
+		uint64_t sequence;
+
+		/** \brief How far the puzzle has got. */
+		SlotStatus status;
+
+		/** \brief The puzzle, replaced by its solution once solved. */
+		Board board;
+
+		/** \brief Search nodes used to solve the puzzle. */
+		uint64_t nodes;
+
+		/** \brief Bytes of input read by the run up to the end of the
+		 * puzzle's record. */
+		uint64_t inputEnd;
+	};
+
+	/** \brief Marks the end of input on the solve queue. */
+	static const uint32_t END_OF_INPUT = UINT32_MAX;
+
+	void readerStage(int inFd);
+	void solverStage();
+	void writerStage(int outFd, BatchCheckpoint progress);
+
+	/** \brief Syncs the output, then saves progress as the checkpoint. */
+	void saveCheckpoint(BoundedWriter & writer, int outFd,
+			const BatchCheckpoint & progress);
+
+	/**
+	 * \brief Adds the counters a stage kept for each queue to stats_. Any of
+	 * the arguments may be null.
+	 */
+	void mergeMetrics(const QueueMetrics * freeQueue,
+			const QueueMetrics * solveQueue, const QueueMetrics * writeQueue);
+
+	/** \brief Records an exception thrown in a stage and stops the others. */
+	void abort(std::exception_ptr error);
+
+	int solverThreads_;
+	Solver::Limits limits_;
+	CorpusFormat format_;
+	uint64_t inputLimit_;
+	std::string inputPrefix_;
+	std::string checkpointPath_;
+	uint64_t checkpointEvery_;
+	LatencyHistogram * latency_;
+	std::vector<Slot> slots_;
+
+	SpscRing<uint32_t> freeQueue_;
+	MpmcRing<uint32_t> solveQueue_;
+	MpmcRing<uint32_t> writeQueue_;
+
+	/** \brief Set by the reader once every record has been handed on. */
+	std::atomic<bool> readerDone_;
+
+	/** \brief Number of records read; final once readerDone_ is set. */
+	std::atomic<uint64_t> records_;
+
+	/** \brief Set when a stage fails, to stop the others. */
+	std::atomic<bool> aborted_;
+
+	/** \brief Guards stats_ and error_. */
+	std::mutex mutex_;
+
+	/** \brief Statistics for the current run, merged in by the stages as
+	 * they finish. */
+	PipelineStats stats_;
+
+	/** \brief The first exception thrown by a stage, if any. */
+	std::exception_ptr error_;
+};
+
+#endif /* BATCHPIPELINE_H_ */
@@ -0,0 +1,502 @@
+/** \file Board.h
+ *
+ * \brief Defines the class Board, the compact candidate-mask representation of
+ * a Sudoku puzzle used by the solver.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#include <cstdint>
+#include <iostream>
+
+class Puzzle;
+
+/**
+ * \struct CellSet
+ * \brief A set of cell indices, one bit per cell.
+ */
+struct CellSet {
+	/** \brief Cells 0-63 in the first word, the rest in the second. */
+	uint64_t words[2];
+
+	constexpr CellSet() : words{0, 0} {}
+
+	/** \brief Returns whether the set has no cells. */
+	constexpr bool isEmpty() const { return (words[0] | words[1]) == 0; }
+
+	/** \brief Returns whether the set has the given cell. */
+	constexpr bool contains(int cell) const {
+		return (words[cell >> 6] >> (cell & 63)) & 1;
+	}
+
+	/** \brief Adds the given cell to the set. */
+	constexpr void insert(int cell) {
+		words[cell >> 6] |= uint64_t(1) << (cell & 63);
+	}
+
+	/** \brief Removes the given cell from the set. */
+	constexpr void erase(int cell) {
+		words[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+	}
+
+	/** \brief Removes every cell of other from the set. */
+	constexpr void eraseAll(const CellSet & other) {
+		words[0] &= ~other.words[0];
+		words[1] &= ~other.words[1];
+	}
+
+	/** \brief Returns the lowest cell in the set, or -1 if it is empty. */
+	constexpr int first() const {
+		if(words[0] != 0)
+			return __builtin_ctzll(words[0]);
+		if(words[1] != 0)
+			return 64 + __builtin_ctzll(words[1]);
+		return -1;
+	}
+
+	/** \brief Returns the lowest cell in the set after the given one, or -1
+	 * if there is none. */
+	constexpr int next(int cell) const {
+		++cell;
+		if(cell < 64){
+			uint64_t rest = words[0] & (~uint64_t(0) << cell);
+			if(rest != 0)
+				return __builtin_ctzll(rest);
+			cell = 64;
+		}
+		if(cell >= 128)
+			return -1;
+		uint64_t rest = words[1] & (~uint64_t(0) << (cell - 64));
+		return rest != 0 ? 64 + __builtin_ctzll(rest) : -1;
+	}
+};
+
+/**
+ * \class Board
+ * \brief Solver-side state of a Sudoku puzzle.
+ *
+ * Where a \ref Puzzle holds 81 \ref Square objects, each with its row, column
+ * and possible values, a Board holds one 9-bit candidate mask per cell (bit v-1
+ * is set when the value v is still possible, as in a \ref Square) and the value
+ * of each set cell. The whole
+ * state is a few hundred bytes and is cheap to copy, which is what the
+ * backtracking search relies on.
+ *
+ * Cells are addressed by index, being row * PUZZLE_SIZE + col. Assigning a
+ * value to a cell removes it from the candidates of the cell's peers (the other
+ * cells in its row, column and box), and any cell that is left with a single
+ * candidate is set in turn.
+ *
+ * The unset cells are also kept in buckets by number of candidates, so the
+ * search can find the cell with the fewest candidates without scanning the
+ * Board. Eliminating candidates only marks the cell as changed, which is a
+ * single OR; refreshBuckets() then moves just the changed cells. Keeping the
+ * buckets exact on every elimination made loading a puzzle half as slow again.
+ *
+ * Everything but loading from a Puzzle is constexpr, so a puzzle can be loaded
+ * and solved (see Solver::solveConstant()) in a constant expression.
+ */
+class Board {
+public:
+	/**
+	 * \var PUZZLE_SIZE
+	 * \brief The size of the Sudoku puzzle.
+	 */
+	static const int PUZZLE_SIZE = 9;
+
+	/**
+	 * \var BOX_SIZE
+	 * \brief The size of a box (3x3 sub-grid) of the puzzle.
+	 */
+	static const int BOX_SIZE = 3;
+
+	/**
+	 * \var NUM_CELLS
+	 * \brief The number of cells in the puzzle.
+	 */
+	static const int NUM_CELLS = PUZZLE_SIZE * PUZZLE_SIZE;
+
+	/**
+	 * \var NUM_UNITS
+	 * \brief The number of units (rows, columns and boxes) in the puzzle.
+	 * Units 0-8 are the rows, 9-17 the columns and 18-26 the boxes.
+	 */
+	static const int NUM_UNITS = 3 * PUZZLE_SIZE;
+
+	/**
+	 * \var NUM_PEERS
+	 * \brief The number of peers each cell has.
+	 */
+	static const int NUM_PEERS = 20;
+
+	/**
+	 * \var ALL_CANDIDATES
+	 * \brief Candidate mask with every value from 1 to PUZZLE_SIZE set.
+	 */
+	static const uint16_t ALL_CANDIDATES = (1u << PUZZLE_SIZE) - 1;
+
+public:
+	/**
+	 * \brief Default constructor; creates an empty Board, where every cell is
+	 * unset and has every value as a candidate.
+	 */
+	constexpr Board();
+
+	/** @name Loading */
+	/**@{*/
+
+	/**
+	 * \brief Resets the Board and loads the given values into it.
+	 *
+	 * \param givens Array of NUM_CELLS values, in cell order; 0 is an empty
+	 * cell and 1 to PUZZLE_SIZE a given. Any other value causes a
+	 * std::out_of_range exception to be thrown.
+	 *
+	 * \returns false if the givens contradict each other, true otherwise.
+	 */
+	constexpr bool load(const uint8_t givens[NUM_CELLS]);
+
+	/**
+	 * \brief Resets the Board and loads the given Puzzle into it.
+	 *
+	 * Set Squares become givens, and unset Squares keep only their possible
+	 * values as candidates.
+	 *
+	 * \returns false if the Puzzle contradicts itself, true otherwise.
+	 */
+	bool load(const Puzzle & puzzle);
+
+	/**@}*/
+
+	/** @name Mutators */
+	/**@{*/
+
+	/**
+	 * \brief Sets the given cell to the given value, propagating the
+	 * consequences to its peers.
+	 *
+	 * \returns false if this leads to a contradiction (some cell is left with
+	 * no candidates), in which case the Board is left in an undefined state.
+	 */
+	constexpr bool assign(int cell, int value);
+
+	/**
+	 * \brief Removes the candidates in mask from the given cell, propagating
+	 * the consequences if the cell is left with a single candidate.
+	 *
+	 * \returns false if this leads to a contradiction, in which case the Board
+	 * is left in an undefined state.
+	 */
+	constexpr bool eliminate(int cell, uint16_t mask);
+
+	/**
+	 * \brief Moves the cells whose candidates changed since the last call
+	 * into the right candidate-count buckets.
+	 */
+	constexpr void refreshBuckets();
+
+	/**@}*/
+
+	/** @name Inspectors */
+	/**@{*/
+
+	/** \brief Returns the candidate mask of the given cell. */
+	constexpr uint16_t getCandidates(int cell) const {
+		return candidates_[cell];
+	}
+
+	/** \brief Returns the value of the given cell, or 0 if it is unset. */
+	constexpr int getValue(int cell) const { return values_[cell]; }
+
+	/** \brief Returns the number of cells that are left to solve. */
+	constexpr int getNumLeftToSolve() const { return numLeftToSolve_; }
+
+	/** \brief Returns whether every cell of the Board is set. */
+	constexpr bool isSolved() const { return numLeftToSolve_ == 0; }
+
+	/** \brief Returns the unset cells with exactly count candidates, count
+	 * being from 2 to PUZZLE_SIZE, as of the last refreshBuckets(). */
+	constexpr const CellSet & getCellsWithCount(int count) const {
+		return buckets_[count - 2];
+	}
+
+	/** \brief Returns the cells whose candidates changed since the last
+	 * refreshBuckets(). */
+	constexpr const CellSet & getChangedCells() const { return changed_; }
+
+	/**
+	 * \brief Returns the lowest numbered of the unset cells with the fewest
+	 * candidates, or -1 if the Board is solved, as of the last
+	 * refreshBuckets().
+	 */
+	constexpr int findFewestCandidates() const {
+		for(int count = 2; count <= PUZZLE_SIZE; ++count){
+			int cell = buckets_[count - 2].first();
+			if(cell >= 0)
+				return cell;
+		}
+		return -1;
+	}
+
+	/**@}*/
+
+	/** @name Mask and table utilities */
+	/**@{*/
+
+	/** \brief Returns the candidate mask for a single value. */
+	static constexpr uint16_t maskOf(int value) {
+		return static_cast<uint16_t>(1u << (value - 1));
+	}
+
+	/** \brief Returns the lowest value present in a non-empty mask. */
+	static constexpr int lowestValue(uint16_t mask) {
+		return __builtin_ctz(mask) + 1;
+	}
+
+	/** \brief Returns the number of values present in a mask. */
+	static constexpr int countCandidates(uint16_t mask) {
+		return __builtin_popcount(mask);
+	}
+
+	/** \brief Returns the row of the given cell. */
+	static constexpr int rowOf(int cell) { return cell / PUZZLE_SIZE; }
+
+	/** \brief Returns the column of the given cell. */
+	static constexpr int colOf(int cell) { return cell % PUZZLE_SIZE; }
+
+	/** \brief Returns the box of the given cell, numbered left to right and
+	 * top to bottom. */
+	static constexpr int boxOf(int cell) {
+		return (rowOf(cell) / BOX_SIZE) * BOX_SIZE + colOf(cell) / BOX_SIZE;
+	}
+
+	/** \brief Returns the NUM_PEERS peers of the given cell. */
+	static constexpr const int * getPeers(int cell);
+
+	/** \brief Returns the PUZZLE_SIZE cells of the given unit. */
+	static constexpr const int * getUnit(int unit);
+
+	/**@}*/
+
+private:
+	/**
+	 * \brief Removes the candidates in mask from the given cell, setting it
+	 * if it is left with a single candidate, but does not propagate.
+	 *
+	 * \returns false if the cell is left with no candidates.
+	 */
+	constexpr bool removeCandidates(int cell, uint16_t mask);
+
+	/** \brief Throws the std::out_of_range for an invalid given. */
+	[[noreturn]] static void throwInvalidGiven(int value, int cell);
+
+	/**
+	 * \var candidates_
+	 * \brief Candidate mask for each cell. A set cell has only its value.
+	 */
+	uint16_t candidates_[NUM_CELLS];
+
+	/**
+	 * \var values_
+	 * \brief Value of each cell, or 0 if the cell is unset.
+	 */
+	uint8_t values_[NUM_CELLS];
+
+	/**
+	 * \var numLeftToSolve_
+	 * \brief Number of cells that are unset.
+	 */
+	int numLeftToSolve_;
+
+	/**
+	 * \var buckets_
+	 * \brief The unset cells, by number of candidates: bucket i holds the
+	 * cells with i + 2.
+	 */
+	CellSet buckets_[PUZZLE_SIZE - 1];
+
+	/**
+	 * \var changed_
+	 * \brief Cells whose candidates changed since the last refreshBuckets().
+	 */
+	CellSet changed_;
+};
+
+/**
+ * \struct BoardTables
+ * \brief The unit and peer tables, computed at compile time.
+ */
+struct BoardTables {
+	/** \brief The cells of each unit. */
+	int units[Board::NUM_UNITS][Board::PUZZLE_SIZE];
+
+	/** \brief The peers of each cell, in cell order. */
+	int peers[Board::NUM_CELLS][Board::NUM_PEERS];
+
+	constexpr BoardTables() : units(), peers() {
+		for(int i = 0; i < Board::PUZZLE_SIZE; ++i){
+			for(int j = 0; j < Board::PUZZLE_SIZE; ++j){
+				units[i][j] = i * Board::PUZZLE_SIZE + j;
+				units[Board::PUZZLE_SIZE + i][j] = j * Board::PUZZLE_SIZE + i;
+
+				int boxRow = (i / Board::BOX_SIZE) * Board::BOX_SIZE +
+						j / Board::BOX_SIZE;
+				int boxCol = (i % Board::BOX_SIZE) * Board::BOX_SIZE +
+						j % Board::BOX_SIZE;
+				units[2 * Board::PUZZLE_SIZE + i][j] =
+						boxRow * Board::PUZZLE_SIZE + boxCol;
+			}
+		}
+
+		for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+			int count = 0;
+			for(int other = 0; other < Board::NUM_CELLS; ++other){
+				if(other == cell)
+					continue;
+				if(Board::rowOf(other) == Board::rowOf(cell) ||
+						Board::colOf(other) == Board::colOf(cell) ||
+						Board::boxOf(other) == Board::boxOf(cell))
+					peers[cell][count++] = other;
+			}
+		}
+	}
+};
+
+/**
+ * \struct BoardTablesInstance
+ * \brief Holds the one BoardTables.
+ *
+ * There are no inline variables before C++17, but a static member of a class
+ * template can be defined in a header, giving one copy for the program.
+ */
+template<typename Unused = void>
+struct BoardTablesInstance {
+	static constexpr BoardTables TABLES{};
+};
+
+template<typename Unused>
+constexpr BoardTables BoardTablesInstance<Unused>::TABLES;
+
+constexpr Board::Board() :
+		candidates_(), values_(), numLeftToSolve_(NUM_CELLS), buckets_(),
+		changed_()
+{
+	for(int i = 0; i < NUM_CELLS; ++i){
+		candidates_[i] = ALL_CANDIDATES;
+		buckets_[PUZZLE_SIZE - 2].insert(i);
+	}
+}
+
+constexpr bool Board::load(const uint8_t givens[NUM_CELLS]){
+	*this = Board();
+
+	for(int i = 0; i < NUM_CELLS; ++i){
+		if(givens[i] == 0)
+			continue;
+
+		if(givens[i] > PUZZLE_SIZE)
+			throwInvalidGiven(givens[i], i);
+
+		if(!assign(i, givens[i]))
+			return false;
+	}
+
+	return true;
+}
+
+constexpr bool Board::assign(int cell, int value){
+	uint16_t mask = maskOf(value);
+
+	// Either already set to this value, or this value is not a candidate.
+	if(values_[cell] != 0)
+		return values_[cell] == value;
+	if((candidates_[cell] & mask) == 0)
+		return false;
+
+	return eliminate(cell, candidates_[cell] & ~mask);
+}
+
+constexpr bool Board::eliminate(int cell, uint16_t mask){
+	bool wasSet = values_[cell] != 0;
+	if(!removeCandidates(cell, mask))
+		return false;
+	if(wasSet || values_[cell] == 0)
+		return true;
+
+	/* The cell has just been set, so its value has to be removed from every
+	 * peer, and so on for each peer that this sets. This is done with a stack
+	 * rather than by recursion, which the compiler inlines poorly. */
+	uint8_t pending[NUM_CELLS] = {};
+	int numPending = 0;
+	pending[numPending++] = static_cast<uint8_t>(cell);
+
+	while(numPending != 0){
+		int set = pending[--numPending];
+		uint16_t value = candidates_[set];
+		const int * peers = getPeers(set);
+
+		for(int i = 0; i < NUM_PEERS; ++i){
+			int peer = peers[i];
+			bool wasSet = values_[peer] != 0;
+			if(!removeCandidates(peer, value))
+				return false;
+			if(!wasSet && values_[peer] != 0)
+				pending[numPending++] = static_cast<uint8_t>(peer);
+		}
+	}
+
+	return true;
+}
+
+constexpr bool Board::removeCandidates(int cell, uint16_t mask){
+	mask &= candidates_[cell];
+	if(mask == 0)
+		return true;
+
+	uint16_t remaining = candidates_[cell] & ~mask;
+	candidates_[cell] = remaining;
+	changed_.insert(cell);
+
+	if(remaining == 0)
+		return false;
+
+	// Down to one candidate: the cell is set.
+	if((remaining & (remaining - 1)) == 0){
+		values_[cell] = static_cast<uint8_t>(lowestValue(remaining));
+		--numLeftToSolve_;
+	}
+
+	return true;
+}
+
+constexpr void Board::refreshBuckets(){
+	if(changed_.isEmpty())
+		return;
+
+	for(int i = 0; i < PUZZLE_SIZE - 1; ++i)
+		buckets_[i].eraseAll(changed_);
+	for(int cell = changed_.first(); cell >= 0; cell = changed_.next(cell))
+		if(values_[cell] == 0)
+			buckets_[countCandidates(candidates_[cell]) - 2].insert(cell);
+	changed_ = CellSet();
+}
+
+constexpr const int * Board::getPeers(int cell){
+	return BoardTablesInstance<>::TABLES.peers[cell];
+}
+
+constexpr const int * Board::getUnit(int unit){
+	return BoardTablesInstance<>::TABLES.units[unit];
+}
+
+/**
+ * \brief Prints the Board in the puzzle file format: PUZZLE_SIZE lines of
+ * PUZZLE_SIZE characters, with unset cells printed as #.
+ */
+std::ostream & operator<<(std::ostream & ostream, const Board & board);
+
+#endif /* BOARD_H_ */
@@ -0,0 +1,140 @@
+/** \file CandidateView.h
+ *
+ * \brief Defines the class CandidateView, a read-only set of candidate values
+ * held in a bit mask.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef CANDIDATEVIEW_H_
+#define CANDIDATEVIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <set>
+
+/**
+ * \class CandidateView
+ * \brief The possible values of a \ref Square, as a value type that needs no
+ * memory of its own.
+ *
+ * Bit v-1 of the mask is set when the value v is possible, as in a \ref Board.
+ * A CandidateView iterates over its values in increasing order, like the
+ * std::set<int> that \ref Square used to return, and compares equal to a
+ * std::set<int> with the same values. Converting to a std::set<int> is still
+ * possible for code that needs one, but is the only operation that allocates.
+ */
+class CandidateView {
+public:
+	/**
+	 * \class const_iterator
+	 * \brief Forward iterator over the values, in increasing order.
+	 */
+	class const_iterator {
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef int value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const int * pointer;
+		typedef int reference;
+
+		/** \brief An iterator over the values left in the given mask. */
+		explicit const_iterator(uint16_t rest = 0) : rest_(rest) {}
+
+		int operator*() const { return lowestValue(rest_); }
+
+		const_iterator & operator++(){
+			rest_ &= rest_ - 1;
+			return *this;
+		}
+
+		const_iterator operator++(int){
+			const_iterator old(*this);
+			++*this;
+			return old;
+		}
+
+		bool operator==(const const_iterator & other) const {
+			return rest_ == other.rest_;
+		}
+
+		bool operator!=(const const_iterator & other) const {
+			return rest_ != other.rest_;
+		}
+
+	private:
+		/** \brief The values not yet visited. */
+		uint16_t rest_;
+	};
+
+	/** \brief Creates a view of the values in the given mask. */
+	explicit CandidateView(uint16_t mask = 0) : mask_(mask) {}
+
+	/** \brief Returns the mask, with bit v-1 set for each value v. */
+	uint16_t getMask() const { return mask_; }
+
+	/** \brief Returns the number of values. */
+	int size() const { return __builtin_popcount(mask_); }
+
+	/** \brief Returns whether there are no values. */
+	bool empty() const { return mask_ == 0; }
+
+	/**
+	 * \brief Returns whether the given value is one of the values; values
+	 * outside 1 to 16 never are.
+	 */
+	bool contains(int value) const {
+		return value >= 1 && value <= 16 && (mask_ >> (value - 1) & 1) != 0;
+	}
+
+	const_iterator begin() const { return const_iterator(mask_); }
+	const_iterator end() const { return const_iterator(); }
+
+	/** \brief Copies the values into a std::set<int>, which allocates. */
+	operator std::set<int>() const {
+		return std::set<int>(begin(), end());
+	}
+
+	bool operator==(const CandidateView & other) const {
+		return mask_ == other.mask_;
+	}
+
+	bool operator!=(const CandidateView & other) const {
+		return mask_ != other.mask_;
+	}
+
+	/** \brief Returns whether the std::set<int> holds exactly these values. */
+	bool operator==(const std::set<int> & values) const {
+		uint16_t mask = 0;
+		for(int value : values){
+			if(!contains(value))
+				return false;
+			mask |= static_cast<uint16_t>(1u << (value - 1));
+		}
+		return mask == mask_;
+	}
+
+	bool operator!=(const std::set<int> & values) const {
+		return !(*this == values);
+	}
+
+private:
+	/** \brief The value of the lowest set bit of a non-zero mask. */
+	static int lowestValue(uint16_t mask){
+		return __builtin_ctz(mask) + 1;
+	}
+
+	uint16_t mask_;
+};
+
+inline bool operator==(const std::set<int> & values, CandidateView view){
+	return view == values;
+}
+
+inline bool operator!=(const std::set<int> & values, CandidateView view){
+	return view != values;
+}
+
+#endif /* CANDIDATEVIEW_H_ */
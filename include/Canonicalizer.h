@@ -0,0 +1,152 @@
+/** \file Canonicalizer.h
+ *
+ * \brief Defines the class Canonicalizer, which maps every puzzle to one
+ * representative of its class under the Sudoku symmetries, and the packed key
+ * that the representatives are compared by.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef CANONICALIZER_H_
+#define CANONICALIZER_H_
+
+#include "Board.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \struct CanonicalKey
+ * \brief A grid packed four bits to a cell, for hashing and comparing.
+ */
+struct CanonicalKey {
+	/** \brief Number of cells packed into each word. */
+	static const int CELLS_PER_WORD = 16;
+
+	/** \brief Number of words needed for a grid. */
+	static const int NUM_WORDS =
+			(Board::NUM_CELLS + CELLS_PER_WORD - 1) / CELLS_PER_WORD;
+
+	/** \brief The packed cells, the first in the low bits of words[0]. */
+	uint64_t words[NUM_WORDS];
+
+	/** \brief Packs a grid of NUM_CELLS values, 0 for an empty cell. */
+	static CanonicalKey pack(const uint8_t grid[Board::NUM_CELLS]);
+
+	/** \brief Unpacks the key into a grid of NUM_CELLS values. */
+	void unpack(uint8_t grid[Board::NUM_CELLS]) const;
+
+	bool operator==(const CanonicalKey & other) const;
+
+	/** \brief Returns a well-mixed hash of the key. */
+	std::size_t hash() const;
+};
+
+/**
+ * \struct CanonicalKeyHash
+ * \brief Hash function object for CanonicalKey, for unordered containers.
+ */
+struct CanonicalKeyHash {
+	std::size_t operator()(const CanonicalKey & key) const {
+		return key.hash();
+	}
+};
+
+/**
+ * \class Canonicalizer
+ * \brief Finds the canonical form of a puzzle under the Sudoku symmetry group.
+ *
+ * The group is generated by transposition, permutations of the bands and of
+ * the rows within each band, permutations of the stacks and of the columns
+ * within each stack, and relabelling of the digits. Two puzzles are
+ * isomorphic exactly when they have the same canonical form, which is the
+ * image of the puzzle that is least when read in cell order, with the digits
+ * relabelled in order of first appearance and an empty cell counting as
+ * greater than any digit.
+ *
+ * Rather than try every transform, the form is built one row at a time. The
+ * first row only depends on which row is chosen and on the column order, and
+ * its least image puts the fullest stacks first and the givens first within
+ * each stack, so only the column orders that do that are kept. Each later row
+ * keeps only the partial transforms that give the least row so far, which
+ * soon leaves a handful; interchangeable empty rows are tried once, and the
+ * search ends as soon as every given has been placed.
+ *
+ * The working state is kept between calls, so a Canonicalizer should be used
+ * by one thread at a time and reused for many puzzles.
+ */
+class Canonicalizer {
+public:
+	Canonicalizer();
+
+	/**
+	 * \brief Writes the canonical form of givens to canonical, both being
+	 * NUM_CELLS values with 0 for an empty cell.
+	 */
+	void canonicalize(const uint8_t givens[Board::NUM_CELLS],
+			uint8_t canonical[Board::NUM_CELLS]);
+
+	/**
+	 * \brief Returns the number of partial transforms looked at by the last
+	 * call to canonicalize(), a measure of how well the search was pruned.
+	 */
+	uint64_t getStates() const;
+
+private:
+	/**
+	 * \struct State
+	 * \brief A partial transform: the source rows of the rows built so far,
+	 * the column order and the digit labels given so far.
+	 */
+	struct State {
+		/** \brief Whether the grid is transposed first. */
+		uint8_t transposed;
+
+		/** \brief Number of labels given so far. */
+		uint8_t numLabels;
+
+		/** \brief Source rows already used, one bit each. */
+		uint16_t usedRows;
+
+		/** \brief Source row of each row built so far. */
+		uint8_t rows[Board::PUZZLE_SIZE];
+
+		/** \brief Source column of each column. */
+		uint8_t cols[Board::PUZZLE_SIZE];
+
+		/** \brief Label of each source digit, 0 if not given one yet. */
+		uint8_t labels[Board::PUZZLE_SIZE + 1];
+	};
+
+	/** \brief Starts the search with every state whose first row is least,
+	 * writing that row to canonical. */
+	void startStates(uint8_t canonical[Board::NUM_CELLS]);
+
+	/** \brief Adds the state that starts from the given row of grid t, with
+	 * the stacks in the order given and the columns of each stack in the
+	 * order of the permutation of three whose index is given. */
+	void addStartState(int t, int row, const int stacks[Board::BOX_SIZE],
+			const int within[Board::BOX_SIZE]);
+
+	/** \brief Extends every state by one row, keeping those whose row is
+	 * least, and writes that row to canonical. */
+	void extendStates(int row, uint8_t canonical[Board::NUM_CELLS]);
+
+	/** \brief The grid and its transpose. */
+	uint8_t grids_[2][Board::NUM_CELLS];
+
+	/** \brief Number of givens in each row of each grid. */
+	int rowGivens_[2][Board::PUZZLE_SIZE];
+
+	/** \brief The states kept for the rows built so far. */
+	std::vector<State> states_;
+
+	/** \brief The states being kept for the next row. */
+	std::vector<State> next_;
+
+	/** \brief Number of states looked at so far. */
+	uint64_t statesSeen_;
+};
+
+#endif /* CANONICALIZER_H_ */
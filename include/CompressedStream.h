@@ -0,0 +1,218 @@
+/** \file CompressedStream.h
+ *
+ * \brief Defines gzip and zstd compressed files of puzzles and solutions, read
+ * and written by a thread of their own through a pipe.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef COMPRESSEDSTREAM_H_
+#define COMPRESSEDSTREAM_H_
+
+#include "PuzzleIO.h"
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \enum Compression
+ * \brief How a file is compressed.
+ */
+enum Compression {
+	/** Not compressed. */
+	NO_COMPRESSION,
+	/** gzip, or raw zlib on input; needs zlib at build time. */
+	GZIP_COMPRESSION,
+	/** zstd; needs libzstd at build time. */
+	ZSTD_COMPRESSION
+};
+
+/** \brief Returns whether the compression was built in. NO_COMPRESSION always
+ * is. */
+bool isCompressionAvailable(Compression compression);
+
+/** \brief Returns "none", "gzip" or "zstd". */
+const char * getCompressionName(Compression compression);
+
+/**
+ * \brief Returns the compression with the given name, as getCompressionName()
+ * gives it. Throws a std::invalid_argument exception for any other name.
+ */
+Compression parseCompressionName(const std::string & name);
+
+/**
+ * \brief Number of bytes at the start of a file that tell its compression.
+ */
+const std::size_t COMPRESSION_HEADER_SIZE = 4;
+
+/**
+ * \brief Returns the compression of the file open on fd, from its first bytes,
+ * or NO_COMPRESSION if it cannot be read from the start (a pipe, say). The
+ * file position is not moved.
+ */
+Compression detectCompression(int fd);
+
+/**
+ * \brief Returns the compression of the input on fd, which may be a pipe,
+ * from its next COMPRESSION_HEADER_SIZE bytes, or fewer at its end.
+ *
+ * The bytes are read, and put in header: pass them on to DecompressingInput,
+ * or to \ref BatchPipeline::Options::inputPrefix, so that they are not lost.
+ * If reading fails, a std::runtime_error is thrown.
+ */
+Compression readCompression(int fd, std::string & header);
+
+/**
+ * \brief Returns the compression a file should be written with, from the
+ * suffix of its path: .gz for gzip, .zst for zstd.
+ */
+Compression getCompressionForPath(const std::string & path);
+
+/**
+ * \brief Size of the blocks in which compressed files are read and written,
+ * and of the pipes that carry the uncompressed data.
+ */
+const std::size_t COMPRESSED_BLOCK_SIZE = 1 << 20;
+
+/**
+ * \class DecompressingInput
+ * \brief Decompresses a file on a thread of its own, writing what it
+ * decompresses to a pipe that can be read like the uncompressed file.
+ *
+ * The thread reads the file and writes to the pipe in blocks of
+ * COMPRESSED_BLOCK_SIZE, so that reading the file, decompressing it and
+ * parsing what comes out of the pipe all overlap. The puzzle format is
+ * detected from the first bytes decompressed, before the thread starts; for a
+ * binary file the header is not passed on, so the pipe starts at the first
+ * record, as \ref CorpusReader expects.
+ *
+ * If the file cannot be read or is not valid compressed data, the pipe ends
+ * early, and the error is thrown from finish().
+ */
+class DecompressingInput {
+public:
+	/**
+	 * \brief Starts decompressing the file open on fd, which is not closed.
+	 *
+	 * header holds any bytes already read from fd, as readCompression()
+	 * gives them, which are decompressed first.
+	 *
+	 * Throws a std::runtime_error if the compression was not built in, or
+	 * if the pipe or the thread cannot be created, or if the start of the file
+	 * cannot be decompressed.
+	 */
+	DecompressingInput(int fd, Compression compression,
+			const std::string & header = std::string());
+
+	/**
+	 * \brief Stops the thread, if finish() has not been called, and closes the
+	 * pipe.
+	 */
+	~DecompressingInput();
+
+	DecompressingInput(const DecompressingInput &) = delete;
+	DecompressingInput & operator=(const DecompressingInput &) = delete;
+
+	/** \brief Returns the end of the pipe to read the decompressed data
+	 * from. */
+	int getFd() const;
+
+	/** \brief Returns the format of the decompressed file. */
+	CorpusFormat getFormat() const;
+
+	/**
+	 * \brief Waits for the thread, once the pipe has been read to its end,
+	 * and throws a std::runtime_error if decompressing failed.
+	 */
+	void finish();
+
+private:
+	/** \brief Decompresses into output_ until it holds at least size bytes
+	 * or the file ends. Returns false if output_ is left empty. */
+	bool fillOutput(std::size_t size);
+
+	/** \brief Body of the thread. */
+	void run();
+
+	class Decoder;
+
+	int fd_;
+	std::unique_ptr<Decoder> decoder_;
+	CorpusFormat format_;
+
+	/** \brief Compressed bytes read, and the start of those not yet
+	 * decoded. */
+	std::vector<char> input_;
+	std::size_t inputBegin_;
+	std::size_t inputEnd_;
+	bool inputDone_;
+
+	/** \brief Decompressed bytes not yet written to the pipe. */
+	std::vector<char> output_;
+	std::size_t outputBegin_;
+	std::size_t outputEnd_;
+
+	int readFd_;
+	int writeFd_;
+	std::thread thread_;
+	std::exception_ptr error_;
+};
+
+/**
+ * \class CompressingOutput
+ * \brief Compresses what is written to a pipe, on a thread of its own, into a
+ * file.
+ *
+ * Writing to getFd() blocks while the thread is busy, so a slow compressor
+ * slows the writer down rather than output piling up in memory.
+ */
+class CompressingOutput {
+public:
+	/**
+	 * \brief Starts compressing into the file open on fd, which is not
+	 * closed. gzip is written at level 1 and zstd at level 3, both of which
+	 * keep up with the solver on solution text.
+	 *
+	 * Throws a std::runtime_error if the compression was not built in, or
+	 * if the pipe or the thread cannot be created.
+	 */
+	CompressingOutput(int fd, Compression compression);
+
+	/**
+	 * \brief Calls finish(), ignoring errors, if it has not been called.
+	 */
+	~CompressingOutput();
+
+	CompressingOutput(const CompressingOutput &) = delete;
+	CompressingOutput & operator=(const CompressingOutput &) = delete;
+
+	/** \brief Returns the end of the pipe to write the uncompressed data
+	 * to. */
+	int getFd() const;
+
+	/**
+	 * \brief Closes the pipe, waits for the thread to end the compressed
+	 * stream, and throws a std::runtime_error if compressing or writing
+	 * failed.
+	 */
+	void finish();
+
+private:
+	/** \brief Body of the thread. */
+	void run();
+
+	class Encoder;
+
+	int fd_;
+	std::unique_ptr<Encoder> encoder_;
+	int readFd_;
+	int writeFd_;
+	std::thread thread_;
+	std::exception_ptr error_;
+};
+
+#endif /* COMPRESSEDSTREAM_H_ */
@@ -0,0 +1,75 @@
+/** \file CorpusChecker.h
+ *
+ * \brief Defines the functions that check puzzle/solution pairs in bulk, from a
+ * directory of puzzle files or from a batch file.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef CORPUSCHECKER_H_
+#define CORPUSCHECKER_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/**
+ * \struct CheckReport
+ * \brief Counts of the outcomes of a corpus check.
+ */
+struct CheckReport {
+	/** \brief Number of pairs checked, counting a puzzle file without a
+	 * solution file that could not be read. */
+	uint64_t checked;
+
+	/** \brief Number of pairs whose solution is valid for its puzzle. */
+	uint64_t valid;
+
+	/** \brief Number of pairs whose solution is not valid for its puzzle. */
+	uint64_t mismatched;
+
+	/** \brief Number of pairs where either file or line could not be read. */
+	uint64_t malformed;
+
+	/** \brief Number of puzzle or solution files without a partner. */
+	uint64_t unpaired;
+
+	CheckReport() : checked(0), valid(0), mismatched(0), malformed(0),
+			unpaired(0) {}
+
+	/** \brief Returns whether every pair checked was valid. */
+	bool allValid() const { return mismatched == 0 && malformed == 0; }
+};
+
+/**
+ * \brief Checks every puzzle/solution pair in a directory.
+ *
+ * Files are paired by the part of their name before the first dot: the
+ * solution of NNN.d.txt or NNN.ve.txt is NNN.soln.txt. Each pair is read with
+ * the \ref Puzzle file constructor and checked with verifySolution(), using up
+ * to threads threads. A puzzle file without a solution file is still read, so
+ * that it is reported if it is malformed. One line is written to report for
+ * every pair that is mismatched or malformed and every file without a
+ * partner.
+ *
+ * \throws std::runtime_error if the directory cannot be read.
+ */
+CheckReport checkDirectory(const std::string & directory, int threads,
+		std::ostream & report);
+
+/**
+ * \brief Checks every puzzle/solution pair in a batch file.
+ *
+ * Each non-blank line holds a puzzle and its solution in the one-line format,
+ * separated by whitespace or a comma. The file is processed in blocks, so
+ * memory use does not depend on its length. One line, naming the line number,
+ * is written to report for every pair that is mismatched or malformed.
+ *
+ * \param fd File descriptor to read the batch file from.
+ * \param name Name of the batch file, for the report.
+ */
+CheckReport checkBatchFile(int fd, const std::string & name, int threads,
+		std::ostream & report);
+
+#endif /* CORPUSCHECKER_H_ */
@@ -0,0 +1,121 @@
+/** \file CorpusIndex.h
+ *
+ * \brief Defines the sidecar index of a file of puzzles, which finds record K
+ * without reading the records before it, and the shards located with it.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef CORPUSINDEX_H_
+#define CORPUSINDEX_H_
+
+#include "PuzzleIO.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \struct CorpusIndex
+ * \brief The byte offset of every stride-th record of a file of puzzles.
+ *
+ * To find record K, the reader starts from the offset of record K / stride and
+ * skips K % stride records; for a binary file no records need skipping, as
+ * they are all the same size. The index also holds the size of the file it was
+ * built from, so that an index left behind by an older file is not trusted.
+ *
+ * On disk, beside the file as getIndexPath() names it, the index is a header
+ * of INDEX_MAGIC, then the version, the format (0 for text, 1 for binary), the
+ * file size, the number of records, the stride and the number of offsets,
+ * followed by the offsets. The version and format are 32-bit, everything else
+ * is 64-bit, and all are little-endian.
+ */
+struct CorpusIndex {
+	/** \brief Format of the indexed file. */
+	CorpusFormat format;
+
+	/** \brief Size of the indexed file in bytes. */
+	uint64_t fileSize;
+
+	/** \brief Number of records in the file. */
+	uint64_t records;
+
+	/** \brief Number of records between offsets. */
+	uint64_t stride;
+
+	/** \brief Offset of record i * stride, for each i up to the last
+	 * record. */
+	std::vector<uint64_t> offsets;
+
+	CorpusIndex() : format(TEXT_FORMAT), fileSize(0), records(0), stride(1) {}
+};
+
+/**
+ * \struct ShardRange
+ * \brief The records of one shard of a file of puzzles, and where they are.
+ */
+struct ShardRange {
+	/** \brief First record of the shard. */
+	uint64_t firstRecord;
+
+	/** \brief One past the last record of the shard. */
+	uint64_t endRecord;
+
+	/** \brief Offset of the first record. */
+	uint64_t beginOffset;
+
+	/** \brief Offset just past the last record, or of the first byte of the
+	 * next shard. */
+	uint64_t endOffset;
+
+	ShardRange() : firstRecord(0), endRecord(0), beginOffset(0),
+			endOffset(0) {}
+};
+
+/** \brief The first bytes of an index file, "SUDOKUIX". */
+extern const char INDEX_MAGIC[];
+
+/** \brief Default number of records between the offsets of an index. */
+const uint64_t DEFAULT_INDEX_STRIDE = 1024;
+
+/** \brief Returns the path of the index for the file of puzzles at path. */
+std::string getIndexPath(const std::string & path);
+
+/**
+ * \brief Builds the index of the file of puzzles open on fd, in one pass.
+ *
+ * The file is read with pread(), so its position does not move. If reading
+ * fails or stride is 0, a std::runtime_error is thrown.
+ */
+CorpusIndex buildCorpusIndex(int fd, uint64_t stride = DEFAULT_INDEX_STRIDE);
+
+/**
+ * \brief Writes the index to fd. If writing fails, a std::runtime_error is
+ * thrown.
+ */
+void writeCorpusIndex(int fd, const CorpusIndex & index);
+
+/**
+ * \brief Reads an index written by writeCorpusIndex(). If it cannot be read or
+ * is not a valid index, a std::runtime_error is thrown.
+ */
+CorpusIndex readCorpusIndex(int fd);
+
+/**
+ * \brief Returns the offset of the given record of the file open on fd, or the
+ * size of the file for a record past the last.
+ */
+uint64_t locateRecord(int fd, const CorpusIndex & index, uint64_t record);
+
+/**
+ * \brief Locates shard number shard of shards: the records are split into
+ * shards runs as evenly as possible, in order, so that separate processes can
+ * each take one with no other coordination.
+ *
+ * If the file open on fd is not the size the index was built for, or shard is
+ * not less than shards, a std::runtime_error is thrown.
+ */
+ShardRange locateShard(int fd, const CorpusIndex & index, uint64_t shard,
+		uint64_t shards);
+
+#endif /* CORPUSINDEX_H_ */
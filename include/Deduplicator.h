@@ -0,0 +1,60 @@
+/** \file Deduplicator.h
+ *
+ * \brief Defines the function that removes isomorphic duplicates from a file of
+ * one-line puzzles.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef DEDUPLICATOR_H_
+#define DEDUPLICATOR_H_
+
+#include <cstdint>
+
+/**
+ * \struct DedupReport
+ * \brief Counts from one run of dedupBatchFile().
+ */
+struct DedupReport {
+	/** \brief Number of puzzle lines read (blank lines are not counted). */
+	uint64_t records;
+
+	/** \brief Number of puzzles not isomorphic to an earlier one. */
+	uint64_t unique;
+
+	/** \brief Number of puzzles isomorphic to an earlier one. */
+	uint64_t duplicates;
+
+	/** \brief Number of classes with more than one puzzle. */
+	uint64_t groups;
+
+	/** \brief Number of lines that were not valid one-line puzzles. */
+	uint64_t invalid;
+
+	DedupReport() : records(0), unique(0), duplicates(0), groups(0),
+			invalid(0) {}
+};
+
+/**
+ * \brief Removes puzzles that are isomorphic to an earlier puzzle from a file
+ * of one-line puzzles.
+ *
+ * Every puzzle is reduced to its canonical form with a \ref Canonicalizer, on
+ * up to threads threads (0 means one per hardware thread), and looked up in a
+ * hash set of the forms seen so far. The set is split into shards, each with
+ * its own lock, so that the threads seldom wait for each other. The file is
+ * read in blocks; the memory used grows with the number of classes, not the
+ * length of the file.
+ *
+ * The first puzzle of each class is written to uniqueFd as it was read, in
+ * input order. Each class with more than one puzzle is written to groupsFd as
+ * a line holding its canonical form, with # for an empty cell, then the line
+ * numbers of its puzzles, the one kept first; the groups are in the order of
+ * their first lines. Invalid lines are counted and dropped.
+ *
+ * \throws std::runtime_error if reading or writing fails.
+ */
+DedupReport dedupBatchFile(int inFd, int uniqueFd, int groupsFd, int threads);
+
+#endif /* DEDUPLICATOR_H_ */
@@ -0,0 +1,178 @@
+/** \file Difficulty.h
+ *
+ * \brief Defines the difficulty rating of puzzles from what it takes to solve
+ * them, the tiers the ratings are sorted into, and the rating of a whole
+ * corpus in parallel.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef DIFFICULTY_H_
+#define DIFFICULTY_H_
+
+#include "Board.h"
+#include "HintEngine.h"
+#include "LatencyHistogram.h"
+#include "PuzzleIO.h"
+#include "Solver.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \struct DifficultyMetrics
+ * \brief What it takes to solve one puzzle, by logic and by search.
+ *
+ * The logical solve applies the cheapest \ref Hint the \ref HintEngine finds,
+ * one step at a time, until the grid is full or no technique applies. The
+ * search counts the solutions, up to two, with a \ref Solver, so that its
+ * counters include proving the solution unique.
+ */
+struct DifficultyMetrics {
+	/**
+	 * \enum Status
+	 * \brief Whether the puzzle can be rated.
+	 *
+	 * RATED: the puzzle has one solution.
+	 * INVALID: the record is not a valid puzzle.
+	 * UNSOLVABLE: the puzzle has no solution.
+	 * MULTIPLE: the puzzle has more than one solution.
+	 * TIMED_OUT: the search ran into the Solver's Limits.
+	 */
+	enum Status {
+		RATED,
+		INVALID,
+		UNSOLVABLE,
+		MULTIPLE,
+		TIMED_OUT
+	};
+
+	Status status;
+
+	/** \brief Whether the techniques alone fill the grid. */
+	bool solvedByLogic;
+
+	/** \brief The dearest technique the logical solve used. */
+	Hint::Technique hardest;
+
+	/** \brief Number of hints the logical solve applied. */
+	int steps;
+
+	/** \brief Search nodes the Solver visited. */
+	uint64_t nodes;
+
+	/** \brief Branches of the search that led to a contradiction. */
+	uint64_t backtracks;
+
+	/** \brief Deepest level of the search. */
+	int depth;
+
+	DifficultyMetrics() : status(INVALID), solvedByLogic(false),
+			hardest(Hint::NAKED_SINGLE), steps(0), nodes(0), backtracks(0),
+			depth(0) {}
+};
+
+/**
+ * \struct DifficultyTier
+ * \brief A named range of difficulty: a puzzle is in the tier if it is within
+ * all of the tier's bounds.
+ */
+struct DifficultyTier {
+	/** \brief Label written for the puzzles of the tier. */
+	std::string name;
+
+	/** \brief If set, the puzzle must be solved by logic with no technique
+	 * dearer than maxTechnique. */
+	bool needsLogic;
+
+	/** \brief The dearest technique allowed, if needsLogic is set. */
+	Hint::Technique maxTechnique;
+
+	/** \brief Most logical steps allowed. */
+	int maxSteps;
+
+	/** \brief Most search nodes allowed. */
+	uint64_t maxNodes;
+
+	/** \brief Deepest search allowed. */
+	int maxDepth;
+
+	DifficultyTier() : needsLogic(false), maxTechnique(Hint::X_WING),
+			maxSteps(INT32_MAX), maxNodes(UINT64_MAX), maxDepth(INT32_MAX) {}
+};
+
+/**
+ * \brief The default tiers, named after the suffixes of the files in puzzles/:
+ * ve (singles only), e (up to claiming), m (up to an x-wing), d (needs search,
+ * at most 1000 nodes) and vd (the rest).
+ */
+extern const char DEFAULT_TIERS[];
+
+/**
+ * \brief Parses a list of tiers, easiest first.
+ *
+ * The tiers are separated by commas, and each is its name followed by any of
+ * technique=T, steps=N, nodes=N and depth=N, each after a colon. T is a
+ * technique name from Hint::getTechniqueName(), with _ or - for spaces.
+ * For example "ve:technique=hidden_single,d:nodes=1000,vd". Throws a
+ * std::invalid_argument exception if the list is empty or malformed.
+ */
+std::vector<DifficultyTier> parseTiers(const std::string & text);
+
+/**
+ * \brief Measures what it takes to solve the given puzzle, searching within
+ * the solver's Limits.
+ */
+DifficultyMetrics measureDifficulty(const uint8_t givens[Board::NUM_CELLS],
+		Solver & solver);
+
+/**
+ * \brief Returns the index of the first tier whose bounds hold for a RATED
+ * puzzle, or -1 if there is none.
+ */
+int findTier(const DifficultyMetrics & metrics,
+		const std::vector<DifficultyTier> & tiers);
+
+/**
+ * \struct RatingReport
+ * \brief Counts from one run of rateCorpus().
+ */
+struct RatingReport {
+	/** \brief Number of records read. */
+	uint64_t records;
+
+	/** \brief Number of records of each status, by DifficultyMetrics::Status;
+	 * RATED counts the records in a tier. */
+	uint64_t statuses[DifficultyMetrics::TIMED_OUT + 1];
+
+	/** \brief Number of rated records in each tier. */
+	std::vector<uint64_t> tiers;
+
+	/** \brief Number of rated records in no tier. */
+	uint64_t untiered;
+
+	RatingReport() : records(0), statuses(), untiered(0) {}
+};
+
+/**
+ * \brief Rates every puzzle of a corpus, on up to threads threads (0 means
+ * one per hardware thread), writing one line per record to outFd.
+ *
+ * inFd is read from its current position in the given format. The output
+ * starts with a line beginning with #, naming the columns; then each record
+ * gets a tab-separated line of its number, counting from 0 as a \ref
+ * CorpusIndex does, its tier (or invalid, unsolvable, multiple, timed-out or
+ * untiered), the dearest technique (or search, if logic alone does not
+ * solve it), the logical steps, the search nodes, the backtracks and the
+ * search depth. The lines are in input order. If latency is not null, the
+ * time each rating takes is recorded in it.
+ *
+ * \throws std::runtime_error if reading or writing fails.
+ */
+RatingReport rateCorpus(int inFd, CorpusFormat format, int outFd,
+		const std::vector<DifficultyTier> & tiers, int threads,
+		const Solver::Limits & limits = Solver::Limits(),
+		LatencyHistogram * latency = nullptr);
+
+#endif /* DIFFICULTY_H_ */
@@ -0,0 +1,66 @@
+/** \file Engine.h
+ *
+ * \brief Defines the class Engine, the interface shared by the ways of solving
+ * a \ref Board, and the factory for the built-in engines.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef ENGINE_H_
+#define ENGINE_H_
+
+#include "Board.h"
+#include "Solver.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * \class Engine
+ * \brief Solves a Board by some method, within Solver::Limits.
+ *
+ * An Engine may keep state between calls, so each thread needs its own.
+ */
+class Engine {
+public:
+	virtual ~Engine() {}
+
+	/**
+	 * \brief Solves the given Board.
+	 *
+	 * \param board A Board that was loaded successfully. On SOLVED it is
+	 * replaced by the solution; otherwise it is left unchanged.
+	 */
+	virtual Solver::Status solve(Board & board) = 0;
+
+	/** \brief Sets the Limits on each later call to solve(). */
+	virtual void setLimits(const Solver::Limits & limits) = 0;
+
+	/**
+	 * \brief Returns the search nodes used by the last call to solve(): the
+	 * Boards visited by a backtracking search, or the decisions of a SAT
+	 * solver.
+	 */
+	virtual uint64_t getNodes() const = 0;
+
+	/** \brief Returns the name makeEngine() knows this Engine by. */
+	virtual std::string getName() const = 0;
+};
+
+/**
+ * \brief Returns the names of the built-in engines, for listing, ending with
+ * a null pointer.
+ *
+ * - backtrack: the Solver, with its default Heuristic.
+ * - sat: encodes the Board as CNF and solves it with the CdclSolver.
+ */
+const char * const * getEngineNames();
+
+/**
+ * \brief Creates the engine with the given name, or returns null if there is
+ * no such engine.
+ */
+std::unique_ptr<Engine> makeEngine(const std::string & name);
+
+#endif /* ENGINE_H_ */
@@ -0,0 +1,242 @@
+/** \file Enumerator.h
+ *
+ * \brief Defines the class Enumerator, which streams every solution of a
+ * puzzle to a callback.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef ENUMERATOR_H_
+#define ENUMERATOR_H_
+
+#include "Board.h"
+#include "Heuristics.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \class Enumerator
+ * \brief Finds the solutions of a Board one at a time, handing each to a
+ * callback as soon as it is found.
+ *
+ * The search is the same depth-first search as the \ref Solver's, so the
+ * solutions come in the order Solver::countSolutions() finds them. It runs on
+ * a stack of Boards allocated once with the Enumerator, and each solution is
+ * passed by reference to the Board on that stack, so nothing is copied or
+ * allocated per solution; a caller that wants to keep a solution copies it.
+ *
+ * A run stops after a number of solutions or an amount of time, and leaves a
+ * Checkpoint from which resume() carries on with the next solution. A
+ * Checkpoint is the index of the alternative being tried at each level of the
+ * search, so it is only valid for the same Board and a Heuristic that makes
+ * the same choices again; randomized heuristics do not.
+ */
+class Enumerator {
+public:
+	/**
+	 * \enum Status
+	 * \brief Why a run of the Enumerator ended.
+	 *
+	 * EXHAUSTED: every solution has been found.
+	 * LIMIT_REACHED: the run found Options::limit solutions.
+	 * OUT_OF_TIME: the run used up Options::timeBudget.
+	 * STOPPED: the callback asked to stop.
+	 */
+	enum Status {
+		EXHAUSTED,
+		LIMIT_REACHED,
+		OUT_OF_TIME,
+		STOPPED
+	};
+
+	/**
+	 * \struct Options
+	 * \brief Settings for an Enumerator.
+	 */
+	struct Options {
+		/** \brief Solutions found before a run stops. */
+		uint64_t limit;
+
+		/** \brief Time a run may take before it stops, or zero for no
+		 * limit. */
+		std::chrono::steady_clock::duration timeBudget;
+
+		Options() : limit(UINT64_MAX), timeBudget(0) {}
+	};
+
+	/**
+	 * \struct Checkpoint
+	 * \brief Where a run stopped, from which another can resume.
+	 */
+	struct Checkpoint {
+		/** \brief Name of the Heuristic the search was made with. */
+		std::string heuristic;
+
+		/** \brief Solutions found by this run and the runs it resumed. */
+		uint64_t solutions;
+
+		/** \brief Whether every solution has been found. */
+		bool finished;
+
+		/** \brief For each level of the search, the number of its
+		 * alternatives that have been started; empty to start afresh. */
+		std::vector<uint8_t> path;
+
+		Checkpoint() : solutions(0), finished(false) {}
+
+		/**
+		 * \brief Returns the Checkpoint as one line of text: the heuristic,
+		 * the number of solutions, then "done", "start" or one digit per
+		 * level of the path.
+		 */
+		std::string toString() const;
+
+		/**
+		 * \brief Parses a line written by toString().
+		 *
+		 * Throws a std::invalid_argument exception if it is not one.
+		 */
+		static Checkpoint fromString(const std::string & text);
+	};
+
+	/**
+	 * \struct Stats
+	 * \brief Counters for the last run.
+	 */
+	struct Stats {
+		/** \brief Number of search nodes visited, including the ones
+		 * replayed to resume. */
+		uint64_t nodes;
+
+		/** \brief Number of solutions found. */
+		uint64_t solutions;
+
+		Stats() : nodes(0), solutions(0) {}
+	};
+
+	/**
+	 * \brief Receives each solution; returns false to stop the run.
+	 */
+	typedef std::function<bool(const Board & solution)> Callback;
+
+public:
+	/**
+	 * \brief Constructor; the Enumerator branches on the cell with the
+	 * fewest candidates.
+	 */
+	explicit Enumerator(const Options & options = Options());
+
+	/**
+	 * \brief Sets the Heuristic that chooses each Branch; null restores the
+	 * default.
+	 */
+	void setHeuristic(std::unique_ptr<Heuristic> heuristic);
+
+	/**
+	 * \brief Finds the solutions of the given Board, from the first.
+	 *
+	 * \param board A Board that was loaded successfully.
+	 */
+	Status enumerate(const Board & board, const Callback & callback);
+
+	/**
+	 * \brief Writes a copy of each solution to out, which is an output
+	 * iterator over Boards.
+	 */
+	template<typename OutputIterator>
+	Status enumerateInto(const Board & board, OutputIterator out){
+		return enumerate(board, [&out](const Board & solution){
+			*out++ = solution;
+			return true;
+		});
+	}
+
+	/**
+	 * \brief Finds the solutions of the given Board that come after the
+	 * given Checkpoint.
+	 *
+	 * Throws a std::invalid_argument exception if the Checkpoint was made
+	 * with another Heuristic, or does not fit the Board.
+	 */
+	Status resume(const Board & board, const Checkpoint & checkpoint,
+			const Callback & callback);
+
+	/**
+	 * \brief Returns the Checkpoint at which the last run stopped.
+	 */
+	const Checkpoint & getCheckpoint() const;
+
+	/**
+	 * \brief Returns the counters for the last run.
+	 */
+	const Stats & getStats() const;
+
+private:
+	/**
+	 * \brief Sets up the search stack for board, replaying the given path of
+	 * a Checkpoint, and returns the depth to carry on from; -1 means the
+	 * search is already over, and status is set to STOPPED if the callback
+	 * stopped it at a solved board.
+	 */
+	int start(const Board & board, const std::vector<uint8_t> & path,
+			const Callback & callback, Status & status);
+
+	/**
+	 * \brief The search behind enumerate() and resume(), from the given
+	 * depth of the stack set up by start(). If it stops before the end,
+	 * depth is left at the deepest level still to finish.
+	 */
+	Status run(int & depth, const Callback & callback);
+
+	/**
+	 * \struct Frame
+	 * \brief One level of the search.
+	 */
+	struct Frame {
+		/** \brief Board at this level, before branching. */
+		Board board;
+
+		/** \brief The alternatives tried at this level. */
+		Branch branch;
+
+		/** \brief The next alternative of branch to try. */
+		int next;
+	};
+
+	/**
+	 * \var frames_
+	 * \brief The search stack, as in the Solver.
+	 */
+	Frame frames_[Board::NUM_CELLS + 1];
+
+	/**
+	 * \var options_
+	 * \brief Limits on each run.
+	 */
+	Options options_;
+
+	/**
+	 * \var heuristic_
+	 * \brief Chooses the Branch at each level.
+	 */
+	std::unique_ptr<Heuristic> heuristic_;
+
+	/**
+	 * \var checkpoint_
+	 * \brief Where the last run stopped.
+	 */
+	Checkpoint checkpoint_;
+
+	/**
+	 * \var stats_
+	 * \brief Counters for the last run.
+	 */
+	Stats stats_;
+};
+
+#endif /* ENUMERATOR_H_ */
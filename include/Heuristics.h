@@ -0,0 +1,94 @@
+/** \file Heuristics.h
+ *
+ * \brief Defines the branching heuristics that decide which choice the
+ * \ref Solver tries next.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef HEURISTICS_H_
+#define HEURISTICS_H_
+
+#include "Board.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * \struct Branch
+ * \brief The alternatives the search tries at one level: each one places a
+ * value in a cell, and exactly one of them holds in any solution.
+ *
+ * A branch on a cell has one alternative per candidate of the cell; a branch
+ * on a unit has one alternative per cell of the unit where a value can still
+ * go.
+ */
+struct Branch {
+	/** \brief Number of alternatives. */
+	int count;
+
+	/** \brief The cell of each alternative. */
+	int cells[Board::PUZZLE_SIZE];
+
+	/** \brief The value of each alternative. */
+	uint8_t values[Board::PUZZLE_SIZE];
+
+	/** \brief Sets the Branch to the candidates of the given cell, lowest
+	 * value first. */
+	void setCell(const Board & board, int cell);
+
+	/** \brief Sets the Branch to the cells of the given unit where value is a
+	 * candidate, in unit order. */
+	void setUnitValue(const Board & board, int unit, int value);
+};
+
+/**
+ * \class Heuristic
+ * \brief Chooses the Branch the search takes at each level.
+ *
+ * A Heuristic may keep state, such as a random number generator, so each
+ * Solver needs its own.
+ */
+class Heuristic {
+public:
+	virtual ~Heuristic() {}
+
+	/**
+	 * \brief Sets branch to the alternatives to try for the given Board,
+	 * which is neither solved nor contradicted, and whose buckets have been
+	 * refreshed.
+	 */
+	virtual void chooseBranch(const Board & board, Branch & branch) = 0;
+
+	/**
+	 * \brief Called when the search restarts; randomized heuristics take a
+	 * new seed, others do nothing.
+	 */
+	virtual void restart(uint64_t seed) { (void)seed; }
+
+	/** \brief Returns the name makeHeuristic() knows this Heuristic by. */
+	virtual std::string getName() const = 0;
+};
+
+/**
+ * \brief Returns the names of the built-in heuristics, for listing.
+ *
+ * A name is a cell choice, optionally followed by "+lcv" and then "+random":
+ * - index: the first unset cell; the naive order.
+ * - mrv: the first unset cell with the fewest candidates (the default).
+ * - degree: as mrv, breaking ties by the most unset peers.
+ * - unit: as degree, unless some value has fewer places left in a unit than
+ *   that cell has candidates, in which case the value's places are branched on.
+ * - +lcv: tries first the values that remove the fewest peer candidates.
+ * - +random: shuffles the alternatives, with a new order on every restart.
+ */
+const char * const * getHeuristicNames();
+
+/**
+ * \brief Creates the heuristic with the given name, or returns null if there
+ * is no such heuristic.
+ */
+std::unique_ptr<Heuristic> makeHeuristic(const std::string & name);
+
+#endif /* HEURISTICS_H_ */
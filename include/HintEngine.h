@@ -0,0 +1,124 @@
+/** \file HintEngine.h
+ *
+ * \brief Defines the class HintEngine, which finds the next logical step of a
+ * partly filled puzzle.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef HINTENGINE_H_
+#define HINTENGINE_H_
+
+#include "Board.h"
+#include <cstdint>
+
+class Puzzle;
+
+/**
+ * \struct Hint
+ * \brief One logical deduction: either a value placed in a cell, or values
+ * removed from the candidates of some cells.
+ */
+struct Hint {
+	/**
+	 * \enum Technique
+	 * \brief The techniques, from the cheapest to find to the dearest.
+	 *
+	 * CONTRADICTION: a cell has no candidates, or a unit has no place left
+	 * for a value; the grid has a mistake in it.
+	 * NAKED_SINGLE: a cell has one candidate.
+	 * HIDDEN_SINGLE: a value has one place in a unit.
+	 * POINTING: a value's places in a box are all in one row or column, so
+	 * it is not a candidate elsewhere in that row or column.
+	 * CLAIMING: a value's places in a row or column are all in one box, so
+	 * it is not a candidate elsewhere in that box.
+	 * NAKED_PAIR: two cells of a unit have the same two candidates, which
+	 * no other cell of the unit can take.
+	 * HIDDEN_PAIR: two values have the same two places in a unit, so those
+	 * cells can take no other value.
+	 * NAKED_TRIPLE: three cells of a unit have three candidates between
+	 * them, which no other cell of the unit can take.
+	 * X_WING: a value has the same two places in each of two rows (or
+	 * columns), so it is not a candidate elsewhere in those columns (or
+	 * rows).
+	 */
+	enum Technique {
+		CONTRADICTION,
+		NAKED_SINGLE,
+		HIDDEN_SINGLE,
+		POINTING,
+		CLAIMING,
+		NAKED_PAIR,
+		HIDDEN_PAIR,
+		NAKED_TRIPLE,
+		X_WING
+	};
+
+	/** \brief The technique that makes the deduction. */
+	Technique technique;
+
+	/** \brief The unit the deduction is made in, or -1 for an X_WING. */
+	int unit;
+
+	/** \brief For a single, the cell to set; otherwise -1. */
+	int cell;
+
+	/** \brief For a single, the value to set it to; for the techniques on
+	 * one value, that value; otherwise 0. */
+	int value;
+
+	/** \brief Number of cells that make up the pattern. */
+	int numCells;
+
+	/** \brief The cells that make up the pattern, in cell order. */
+	uint8_t cells[Board::PUZZLE_SIZE];
+
+	/** \brief For an elimination, the cells that lose candidates. */
+	CellSet targets;
+
+	/** \brief For an elimination, the candidates each target loses (where
+	 * it has them). */
+	uint16_t removed;
+
+	/** \brief Returns the name of a technique, such as "hidden single". */
+	static const char * getTechniqueName(Technique technique);
+};
+
+/**
+ * \class HintEngine
+ * \brief Finds the cheapest deduction that a partly filled grid allows.
+ *
+ * The techniques are tried from the cheapest up, and the search stops at the
+ * first deduction found, so a grid with a single to place costs one pass over
+ * the cells. The unit and peer tables are the Board's, which are computed at
+ * compile time, and nothing is allocated, so a hint takes microseconds.
+ *
+ * Unlike a Board, the grid is taken as it is: a cell with one candidate is not
+ * set, as that is a hint in itself.
+ */
+class HintEngine {
+public:
+	/**
+	 * \brief Finds the first hint for a grid given as the value of each cell
+	 * (0 if unset) and the candidates of each unset cell.
+	 *
+	 * \returns false if no technique applies, as when the grid is full.
+	 */
+	static bool findHint(const uint8_t values[Board::NUM_CELLS],
+			const uint16_t candidates[Board::NUM_CELLS], Hint & hint);
+
+	/**
+	 * \brief Finds the first hint for a Puzzle, where the candidates of each
+	 * unset Square are its possible values less the values of its peers.
+	 */
+	static bool findHint(const Puzzle & puzzle, Hint & hint);
+
+	/**
+	 * \brief Finds the first hint for a Board, whose naked singles are
+	 * already set.
+	 */
+	static bool findHint(const Board & board, Hint & hint);
+};
+
+#endif /* HINTENGINE_H_ */
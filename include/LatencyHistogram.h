@@ -0,0 +1,149 @@
+/** \file LatencyHistogram.h
+ *
+ * \brief Defines the class LatencyHistogram, which records how long each solve
+ * takes in log-linear buckets, and LatencyReporter, which prints it as a run
+ * goes.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef LATENCYHISTOGRAM_H_
+#define LATENCYHISTOGRAM_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * \class LatencyHistogram
+ * \brief A count of durations, in nanoseconds, in buckets whose width grows
+ * with their value, as in an HDR histogram.
+ *
+ * Durations below 2 * SUB_BUCKETS nanoseconds have a bucket each; above that,
+ * each power of two is split into SUB_BUCKETS buckets, so a quantile is within
+ * 1 / SUB_BUCKETS of the true value however long the durations. The buckets
+ * are relaxed atomic counters, so any number of threads can record at once
+ * without a lock, and the histogram can be read, or merged into another, while
+ * they do.
+ */
+class LatencyHistogram {
+public:
+	/** \brief Number of buckets each power of two is split into. */
+	static const int SUB_BUCKETS = 64;
+
+	/** \brief Number of buckets, enough for any uint64_t. */
+	static const int BUCKETS = 59 * SUB_BUCKETS;
+
+	/** \brief Creates an empty histogram. */
+	LatencyHistogram();
+
+	/** \brief Adds a duration. May be called from any thread. */
+	void record(uint64_t nanos);
+
+	/** \brief Adds a duration measured with the steady clock. */
+	void record(std::chrono::steady_clock::duration duration){
+		record(static_cast<uint64_t>(std::chrono::duration_cast<
+				std::chrono::nanoseconds>(duration).count()));
+	}
+
+	/** \brief Adds the counts of another histogram, which may still be
+	 * recording. */
+	void merge(const LatencyHistogram & other);
+
+	/** \brief Returns the number of durations recorded. */
+	uint64_t getCount() const;
+
+	/** \brief Returns the mean duration, or 0 if there are none. */
+	double getMean() const;
+
+	/** \brief Returns the longest duration, or 0 if there are none. */
+	uint64_t getMax() const;
+
+	/**
+	 * \brief Returns a duration that the given fraction of the durations are
+	 * no longer than: the top of the bucket the quantile falls in, but never
+	 * more than getMax(). 0 if there are none.
+	 */
+	uint64_t getQuantile(double quantile) const;
+
+	/**
+	 * \brief Returns a line of the count, the rate over the given number of
+	 * seconds and the p50, p90, p99, p999 and max durations, in readable
+	 * units.
+	 */
+	std::string formatSummary(double seconds) const;
+
+	/**
+	 * \brief Returns the histogram as a JSON object: the count, the seconds
+	 * and rate, the mean, quantiles and max in nanoseconds, and the non-empty
+	 * buckets as [top, count] pairs.
+	 */
+	std::string formatJson(double seconds) const;
+
+	/** \brief Returns the bucket a duration falls in. */
+	static int getBucket(uint64_t nanos);
+
+	/** \brief Returns the longest duration that falls in a bucket. */
+	static uint64_t getBucketTop(int bucket);
+
+private:
+	/** \brief The number of durations in each bucket. */
+	std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+
+	/** \brief The sum of the durations, for the mean. */
+	std::atomic<uint64_t> total_;
+
+	std::atomic<uint64_t> max_;
+};
+
+/**
+ * \class LatencyReporter
+ * \brief Writes a summary line of a histogram at a fixed interval, from its
+ * own thread, until it is stopped or destroyed.
+ *
+ * Each line gives the time since the reporter started, the rate since the
+ * previous line, and the summary of every duration so far.
+ */
+class LatencyReporter {
+public:
+	/** \brief Starts reporting on histogram to out, which nothing else may
+	 * write to until the reporter stops. An interval of zero reports
+	 * nothing. */
+	LatencyReporter(const LatencyHistogram & histogram, std::ostream & out,
+			std::chrono::milliseconds interval);
+
+	/** \brief Stops reporting. */
+	~LatencyReporter();
+
+	/** \brief Stops reporting, waiting for the thread to finish. */
+	void stop();
+
+	/** \brief Returns the seconds since the reporter started. */
+	double getSeconds() const;
+
+	LatencyReporter(const LatencyReporter &) = delete;
+	LatencyReporter & operator=(const LatencyReporter &) = delete;
+
+private:
+	/** \brief Body of the thread. */
+	void run();
+
+	const LatencyHistogram & histogram_;
+	std::ostream & out_;
+	std::chrono::milliseconds interval_;
+	std::chrono::steady_clock::time_point start_;
+
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	bool stopping_;
+	std::thread thread_;
+};
+
+#endif /* LATENCYHISTOGRAM_H_ */
@@ -0,0 +1,102 @@
+/** \file LivePuzzle.h
+ *
+ * \brief Defines the class LivePuzzle, which applies moves to a puzzle one at
+ * a time and reports the candidates each move changed.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef LIVEPUZZLE_H_
+#define LIVEPUZZLE_H_
+
+#include "Board.h"
+#include <cstdint>
+
+class Puzzle;
+
+/**
+ * \struct CandidateChange
+ * \brief The new candidate mask of one cell.
+ */
+struct CandidateChange {
+	/** \brief Index of the cell, being row * PUZZLE_SIZE + col. */
+	uint8_t cell;
+
+	/** \brief Candidate mask of the cell; bit v-1 is set when the value v is
+	 * still possible. A set cell has only its value. */
+	uint16_t mask;
+};
+
+/**
+ * \struct CandidateDiff
+ * \brief The cells whose candidates changed, in cell order.
+ */
+struct CandidateDiff {
+	/** \brief Number of changes. */
+	int count;
+
+	/** \brief The changes; only the first count are meaningful. */
+	CandidateChange changes[Board::NUM_CELLS];
+
+	CandidateDiff() : count(0) {}
+};
+
+/**
+ * \class LivePuzzle
+ * \brief A puzzle being filled in move by move, as in an interactive
+ * front end.
+ *
+ * The state is a \ref Board, so a move is an assignment to it: the value is
+ * removed from the candidates of the cell's peers, and any peer left with one
+ * candidate is set in turn. Rather than the whole grid, a move returns just
+ * the cells whose masks it changed, which the Board already tracks for its
+ * candidate-count buckets; a move costs well under a microsecond.
+ */
+class LivePuzzle {
+public:
+	/**
+	 * \brief Starts from the given Puzzle.
+	 *
+	 * Throws a std::invalid_argument exception if the Puzzle contradicts
+	 * itself.
+	 */
+	explicit LivePuzzle(const Puzzle & puzzle);
+
+	/**
+	 * \brief Starts from the given Board.
+	 */
+	explicit LivePuzzle(const Board & board);
+
+	/**
+	 * \brief Sets the cell at row and col to value.
+	 *
+	 * \param diff Receives the cells whose candidates changed, with their new
+	 * masks.
+	 *
+	 * \returns false, leaving the LivePuzzle unchanged and diff empty, if
+	 * value is not a candidate of the cell or leads to a contradiction.
+	 * Throws a std::out_of_range exception if row, col or value is out of
+	 * range.
+	 */
+	bool applyMove(int row, int col, int value, CandidateDiff & diff);
+
+	/**
+	 * \brief Sets snapshot to every cell with its mask, for a client that is
+	 * starting out.
+	 */
+	void getSnapshot(CandidateDiff & snapshot) const;
+
+	/** \brief Returns the current state. */
+	const Board & getBoard() const;
+
+private:
+	/**
+	 * \var board_
+	 * \brief The current state, with its buckets kept refreshed so that its
+	 * changed cells are those of the last move.
+	 */
+	Board board_;
+};
+
+#endif /* LIVEPUZZLE_H_ */
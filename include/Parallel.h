@@ -0,0 +1,33 @@
+/** \file Parallel.h
+ *
+ * \brief Defines runParallel(), which shares a loop of independent jobs out
+ * among threads, and resolveThreads(), which picks how many threads to use.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * \brief Returns the number of threads to use for a requested number, where
+ * one that is not positive means one per hardware thread.
+ */
+int resolveThreads(int requested);
+
+/**
+ * \brief Runs work(thread, i) for every i below count, on up to threads
+ * threads numbered from 0, or one per hardware thread if threads is not
+ * positive.
+ *
+ * Each thread takes the next i in turn, so jobs of uneven length even out.
+ * The calling thread is thread 0, and the call returns once every job is done.
+ */
+void runParallel(std::size_t count, int threads,
+		const std::function<void(int, std::size_t)> & work);
+
+#endif /* PARALLEL_H_ */
@@ -0,0 +1,232 @@
+/** \file ParallelSolver.h
+ *
+ * \brief Defines the class ParallelSolver, which searches a single puzzle with
+ * several threads.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef PARALLELSOLVER_H_
+#define PARALLELSOLVER_H_
+
+#include "Board.h"
+#include "Heuristics.h"
+#include "Solver.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * \class ParallelSolver
+ * \brief Splits the search tree of one puzzle into tasks and runs them on a
+ * work-stealing pool of \ref Solver "Solvers".
+ *
+ * The top of the tree is expanded breadth first, in the order the sequential
+ * Solver would visit it, until there are enough subtrees to keep every thread
+ * busy. Each subtree becomes a task holding one Board snapshot, numbered by
+ * its position in that order. The tasks are dealt round robin onto one queue
+ * per thread; a thread takes the lowest numbered task of its own queue, and
+ * when that is empty steals the highest numbered task of another.
+ *
+ * The results do not depend on the number of threads or on scheduling:
+ * - solve() returns the solution from the lowest numbered task that has one,
+ *   which is the solution the sequential Solver would find. Once a task finds
+ *   a solution, every higher numbered task is cancelled; lower numbered ones
+ *   run on in case they hold an earlier solution.
+ * - countSolutions() returns the exact count when it is below the limit, and
+ *   the limit otherwise. All tasks are cancelled once the finished ones have
+ *   found limit solutions between them.
+ */
+class ParallelSolver {
+public:
+	/**
+	 * \struct Options
+	 * \brief Settings for a ParallelSolver.
+	 */
+	struct Options {
+		/** \brief Number of threads, or 0 for one per hardware thread. */
+		int threads;
+
+		/** \brief The tree is split until there are at least this many tasks
+		 * per thread, if it is that big. */
+		int tasksPerThread;
+
+		/** \brief The tree is never split deeper than this. */
+		int maxSplitDepth;
+
+		Options() : threads(0), tasksPerThread(16), maxSplitDepth(8) {}
+	};
+
+	/**
+	 * \struct Stats
+	 * \brief Counters for the last call to solve() or countSolutions().
+	 */
+	struct Stats {
+		/** \brief Search nodes visited, while splitting and in all tasks. */
+		uint64_t nodes;
+
+		/** \brief Number of tasks the tree was split into. */
+		uint64_t tasks;
+
+		/** \brief Number of tasks skipped or stopped by cancellation. */
+		uint64_t cancelledTasks;
+
+		/** \brief Number of tasks run by a thread other than the one they
+		 * were dealt to. */
+		uint64_t steals;
+
+		/** \brief Depth at which the tree was split. */
+		int splitDepth;
+
+		Stats() : nodes(0), tasks(0), cancelledTasks(0), steals(0),
+				splitDepth(0) {}
+	};
+
+public:
+	/**
+	 * \brief Constructor. Allocates one Solver per thread.
+	 */
+	explicit ParallelSolver(const Options & options = Options());
+
+	/**
+	 * \brief Solves the given Board.
+	 *
+	 * \param board A Board that was loaded successfully. If it can be solved,
+	 * it is replaced by the same solution Solver::solve() would find;
+	 * otherwise it is left unchanged.
+	 */
+	Solver::Status solve(Board & board);
+
+	/**
+	 * \brief Counts the solutions of the given Board, stopping at limit.
+	 */
+	uint64_t countSolutions(const Board & board, uint64_t limit);
+
+	/**
+	 * \brief Returns the counters for the last call to solve() or
+	 * countSolutions().
+	 */
+	const Stats & getStats() const;
+
+	/**
+	 * \brief Returns the number of threads searches are run on.
+	 */
+	int getThreads() const;
+
+private:
+	/**
+	 * \struct TaskQueue
+	 * \brief One thread's share of the tasks, as indices into tasks_.
+	 *
+	 * Padded so that neighbouring queues' locks do not share a cache line.
+	 */
+	struct TaskQueue {
+		std::mutex mutex;
+		std::deque<std::size_t> tasks;
+		char padding[64];
+	};
+
+	/**
+	 * \struct WorkerStats
+	 * \brief Counters kept by one thread during a search.
+	 */
+	struct WorkerStats {
+		uint64_t nodes;
+		uint64_t cancelledTasks;
+		uint64_t steals;
+	};
+
+	/**
+	 * \brief Expands the top of the tree under root into tasks_, and deals
+	 * them onto the queues. Returns false if root is contradicted.
+	 */
+	bool split(const Board & root);
+
+	/**
+	 * \brief Takes the next task for the given thread. Returns false once
+	 * every queue is empty.
+	 */
+	bool nextTask(int thread, std::size_t & task, WorkerStats & stats);
+
+	/**
+	 * \brief Runs worker on threads_ threads, the calling thread being one
+	 * of them, and adds their counters to stats_.
+	 */
+	template<typename Worker>
+	void runWorkers(Worker worker);
+
+	/**
+	 * \brief Lowers firstSolved_ to task, if that is lower, and then cancels
+	 * every task after it.
+	 */
+	void solvedTask(std::size_t task);
+
+	/**
+	 * \var threads_
+	 * \brief Number of threads searches are run on.
+	 */
+	const int threads_;
+
+	/**
+	 * \var options_
+	 * \brief Settings, with threads resolved.
+	 */
+	const Options options_;
+
+	/**
+	 * \var solvers_
+	 * \brief One Solver per thread.
+	 */
+	std::vector<std::unique_ptr<Solver> > solvers_;
+
+	/**
+	 * \var splitHeuristic_
+	 * \brief Chooses the branches while splitting; the same as the Solvers'
+	 * default, so that the tasks come out in their search order.
+	 */
+	std::unique_ptr<Heuristic> splitHeuristic_;
+
+	/**
+	 * \var queues_
+	 * \brief One task queue per thread.
+	 */
+	std::vector<TaskQueue> queues_;
+
+	/**
+	 * \var tasks_
+	 * \brief The Board at the root of each task's subtree, in search order.
+	 */
+	std::vector<Board> tasks_;
+
+	/**
+	 * \var cancelled_
+	 * \brief One cancel flag per task.
+	 */
+	std::unique_ptr<std::atomic<bool>[]> cancelled_;
+
+	/**
+	 * \var firstSolved_
+	 * \brief The lowest numbered task known to hold a solution, or
+	 * tasks_.size() if none is known yet.
+	 */
+	std::atomic<std::size_t> firstSolved_;
+
+	/**
+	 * \var solutions_
+	 * \brief Solutions found by finished tasks in countSolutions().
+	 */
+	std::atomic<uint64_t> solutions_;
+
+	/**
+	 * \var stats_
+	 * \brief Counters for the last search.
+	 */
+	Stats stats_;
+};
+
+#endif /* PARALLELSOLVER_H_ */
@@ -0,0 +1,158 @@
+/** \file Propagator.h
+ *
+ * \brief Defines the unit-scan kernel and the class Propagator, which applies
+ * single-candidate deductions to a \ref Board.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef PROPAGATOR_H_
+#define PROPAGATOR_H_
+
+#include "Board.h"
+#include <cstdint>
+
+/**
+ * \struct UnitScan
+ * \brief How often each value appears among the candidate masks of a unit.
+ */
+struct UnitScan {
+	/** \brief Values that are a candidate of at least one cell. */
+	uint16_t atLeastOnce;
+
+	/** \brief Values that are a candidate of exactly one cell. */
+	uint16_t exactlyOnce;
+
+	/** \brief Values that are a candidate of exactly two cells. */
+	uint16_t exactlyTwice;
+};
+
+/**
+ * \brief Scans the PUZZLE_SIZE candidate masks of a unit.
+ *
+ * Three accumulators record the values seen at least once, twice and three
+ * times; each mask updates them with three ORs and two ANDs, so a whole unit
+ * costs a few dozen bitwise operations with no branches. "Exactly once" and
+ * "exactly twice" then fall out as at-least-once minus at-least-twice and
+ * at-least-twice minus at-least-three-times.
+ */
+constexpr UnitScan scanUnit(const uint16_t masks[Board::PUZZLE_SIZE]){
+	uint16_t once = 0;
+	uint16_t twice = 0;
+	uint16_t thrice = 0;
+
+	for(int i = 0; i < Board::PUZZLE_SIZE; ++i){
+		thrice |= twice & masks[i];
+		twice |= once & masks[i];
+		once |= masks[i];
+	}
+
+	UnitScan scan = {once, static_cast<uint16_t>(once & ~twice),
+			static_cast<uint16_t>(twice & ~thrice)};
+	return scan;
+}
+
+/**
+ * \class Propagator
+ * \brief Applies naked and hidden single deductions to a Board until neither
+ * finds anything more.
+ *
+ * Naked singles (cells left with one candidate) are set by the Board itself as
+ * soon as they appear. The Propagator adds hidden singles: a value that is a
+ * candidate of only one cell of a unit, and is not yet placed in that unit,
+ * must go in that cell. Every solver engine runs this after each assignment.
+ *
+ * Like the Board, it is usable in constant expressions.
+ */
+class Propagator {
+public:
+	/**
+	 * \brief Gathers the candidate masks of the given unit, and returns the
+	 * mask of the values already placed in it.
+	 */
+	static constexpr uint16_t gatherUnit(const Board & board, int unit,
+			uint16_t masks[Board::PUZZLE_SIZE]);
+
+	/**
+	 * \brief Returns the hidden singles of the given unit: the values that
+	 * only one of its cells can take, but which are not placed yet.
+	 *
+	 * \param missing Receives the values that no cell of the unit can take,
+	 * which means the Board is contradicted.
+	 */
+	static constexpr uint16_t findHiddenSingles(const Board & board, int unit,
+			uint16_t & missing);
+
+	/**
+	 * \brief Places every hidden single of every unit, repeating until a
+	 * full pass over the units places nothing.
+	 *
+	 * \returns false if the Board turns out to be contradicted, in which case
+	 * it is left in an undefined state.
+	 */
+	static constexpr bool propagate(Board & board);
+};
+
+constexpr uint16_t Propagator::gatherUnit(const Board & board, int unit,
+		uint16_t masks[Board::PUZZLE_SIZE]){
+	const int * cells = Board::getUnit(unit);
+	uint16_t placed = 0;
+
+	for(int i = 0; i < Board::PUZZLE_SIZE; ++i){
+		masks[i] = board.getCandidates(cells[i]);
+		// A set cell's mask is its value, so no branch is needed here.
+		placed |= board.getValue(cells[i]) != 0 ? masks[i] : 0;
+	}
+
+	return placed;
+}
+
+constexpr uint16_t Propagator::findHiddenSingles(const Board & board,
+		int unit, uint16_t & missing){
+	uint16_t masks[Board::PUZZLE_SIZE] = {};
+	uint16_t placed = gatherUnit(board, unit, masks);
+	UnitScan scan = scanUnit(masks);
+
+	missing = Board::ALL_CANDIDATES & ~scan.atLeastOnce;
+	return scan.exactlyOnce & ~placed;
+}
+
+constexpr bool Propagator::propagate(Board & board){
+	bool changed = true;
+
+	while(changed && !board.isSolved()){
+		changed = false;
+
+		for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+			uint16_t missing = 0;
+			uint16_t hidden = findHiddenSingles(board, unit, missing);
+			if(missing != 0)
+				return false;
+			if(hidden == 0)
+				continue;
+
+			const int * cells = Board::getUnit(unit);
+			while(hidden != 0){
+				uint16_t bit = hidden & -hidden;
+				hidden &= ~bit;
+
+				/* An earlier assignment in this loop may have taken the
+				 * value's last place in the unit; the next scan of the unit
+				 * will notice. */
+				for(int i = 0; i < Board::PUZZLE_SIZE; ++i){
+					if(board.getCandidates(cells[i]) & bit){
+						if(!board.assign(cells[i], Board::lowestValue(bit)))
+							return false;
+						break;
+					}
+				}
+			}
+			changed = true;
+		}
+	}
+
+	return true;
+}
+
+#endif /* PROPAGATOR_H_ */
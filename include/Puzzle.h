@@ -129,8 +129,11 @@ public:
 		 * is given.
 		 * If the reason was INVALID_VALUE, then the value and the line it was
 		 * in is returned.
+		 * The string is built when the exception is created, so this also
+		 * overrides std::exception::what() for a caller that catches the
+		 * base class.
 		 */
-		virtual const char * what();
+		virtual const char * what() const throw();
 
 		/** @name Getters. */
 		/**@{*/
@@ -222,6 +225,12 @@ public:
 				int length = 0,
 				char invalidValue = '?');
 
+		/**
+		 * \brief Writes whatMessage_ from the other members; called by the
+		 * constructor.
+		 */
+		void formatMessage();
+
 	protected:
 		/**
 		 *  \brief Length of the smaller strings used by this class.
@@ -230,7 +239,7 @@ public:
 
 		/**
 		 * \brief String that explains why this exception was thrown; created
-		 * when what() is called.
+		 * by formatMessage().
 		 */
 		char whatMessage_[256];
 
@@ -284,9 +293,16 @@ public:
 	 * \brief Copy constructor.
 	 *
 	 * The new puzzle is initialised to an exact copy of 'other', with its own
-	 * set of Squares.
+	 * set of Squares. The Squares are copied directly, not default constructed
+	 * first, and as they own no memory the whole copy is a plain member copy.
 	 */
-	Puzzle(const Puzzle & other);
+	Puzzle(const Puzzle & other) = default;
+
+	/**
+	 * \brief Move constructor; the same as copying, as a Puzzle owns no
+	 * memory.
+	 */
+	Puzzle(Puzzle && other) = default;
 
 	/**@}*/
 
@@ -322,7 +338,13 @@ public:
 	 * This \ref Puzzle is set to be an exact copy for the 'other' Puzzle, with
 	 * its own set of Square's initialised to a copy of other's set of Squares.
 	 */
-	Puzzle & operator=(const Puzzle & other);
+	Puzzle & operator=(const Puzzle & other) = default;
+
+	/**
+	 * \brief Move assignment; the same as copying, as a Puzzle owns no
+	 * memory.
+	 */
+	Puzzle & operator=(Puzzle && other) = default;
 
 private:
 	Square squares_[NUM_SQUARES];
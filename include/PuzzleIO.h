@@ -0,0 +1,354 @@
+/** \file PuzzleIO.h
+ *
+ * \brief Defines the one-line and binary puzzle formats and the buffered
+ * readers and writer used to stream puzzles through the solver.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef PUZZLEIO_H_
+#define PUZZLEIO_H_
+
+#include "Board.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** @name One-line puzzle format
+ *
+ * A puzzle on one line is NUM_CELLS characters in cell order: a digit from 1 to
+ * PUZZLE_SIZE for a given, and #, . or 0 for an empty cell. A trailing carriage
+ * return is ignored.
+ */
+/**@{*/
+
+/**
+ * \brief Parses a puzzle in the one-line format.
+ *
+ * \param line The characters of the line, without its newline.
+ * \param length The number of characters in line.
+ * \param givens Receives NUM_CELLS values, 0 for an empty cell.
+ *
+ * \returns false if the line is not a valid one-line puzzle.
+ */
+bool parsePuzzleLine(const char * line, std::size_t length,
+		uint8_t givens[Board::NUM_CELLS]);
+
+/**
+ * \brief Writes the Board in the one-line format, with unset cells as #.
+ *
+ * \param out Receives exactly NUM_CELLS characters; no newline or null
+ * character is written.
+ */
+void formatPuzzleLine(const Board & board, char out[Board::NUM_CELLS]);
+
+/**
+ * \brief Output line, with its newline, written in place of a solution for a
+ * puzzle that has none.
+ */
+extern const char UNSOLVABLE_LINE[];
+
+/**
+ * \brief Output line, with its newline, written in place of a solution for a
+ * line that is not a valid puzzle.
+ */
+extern const char INVALID_LINE[];
+
+/**
+ * \brief Output line, with its newline, written in place of a solution for a
+ * puzzle whose search ran into the Solver's limits.
+ */
+extern const char TIMED_OUT_LINE[];
+
+/**@}*/
+
+/** @name Binary puzzle format
+ *
+ * A binary puzzle file starts with the BINARY_HEADER_SIZE bytes of
+ * BINARY_MAGIC, followed by one record of BINARY_RECORD_SIZE bytes per puzzle.
+ * A record packs the cells four bits each in cell order, the first of each
+ * pair in the low bits of its byte, with 0 for an empty cell; the high bits of
+ * the last byte are 0. As every record has the same size, puzzle K starts at
+ * byte BINARY_HEADER_SIZE + K * BINARY_RECORD_SIZE, and as there are no
+ * multi-byte fields the format is the same on every machine.
+ */
+/**@{*/
+
+/** \brief The first bytes of a binary puzzle file, "SUDOKUB1". */
+extern const char BINARY_MAGIC[];
+
+/** \brief Size of the header of a binary puzzle file. */
+const std::size_t BINARY_HEADER_SIZE = 8;
+
+/** \brief Size of each record of a binary puzzle file. */
+const std::size_t BINARY_RECORD_SIZE = (Board::NUM_CELLS + 1) / 2;
+
+/** \brief Packs the givens, 0 for an empty cell, into a record. */
+void packPuzzleRecord(const uint8_t givens[Board::NUM_CELLS],
+		uint8_t record[BINARY_RECORD_SIZE]);
+
+/**
+ * \brief Unpacks a record into givens.
+ *
+ * \returns false if the record holds a value over PUZZLE_SIZE or its unused
+ * bits are not 0.
+ */
+bool unpackPuzzleRecord(const uint8_t record[BINARY_RECORD_SIZE],
+		uint8_t givens[Board::NUM_CELLS]);
+
+/**
+ * \enum CorpusFormat
+ * \brief The format of a file of puzzles.
+ */
+enum CorpusFormat {
+	/** One-line puzzles, one per line; blank lines are not records. */
+	TEXT_FORMAT,
+	/** The binary format. */
+	BINARY_FORMAT
+};
+
+/**
+ * \brief Returns BINARY_FORMAT if the file starts with BINARY_MAGIC, and
+ * TEXT_FORMAT otherwise, including when the file cannot be read from the start
+ * (a pipe, say). The file position is not moved.
+ */
+CorpusFormat detectCorpusFormat(int fd);
+
+/**@}*/
+
+/**
+ * \brief Returns what, followed by the description of errno, as the message
+ * of the std::runtime_error thrown when a call on a file fails.
+ */
+std::string errorMessage(const std::string & what);
+
+/**
+ * \class ChunkedReader
+ * \brief Splits the bytes read from a file descriptor into lines, reading in
+ * large chunks into a fixed-size buffer.
+ *
+ * Lines are returned as pointers into the buffer, so they are only valid until
+ * the next call to nextLine(). A line that does not fit in the buffer is
+ * returned truncated to the buffer size once the rest of it has been read and
+ * discarded; memory use never grows past twice the chunk size, whatever the
+ * input.
+ */
+class ChunkedReader {
+public:
+	/**
+	 * \var DEFAULT_CHUNK_SIZE
+	 * \brief Default size of the read buffer.
+	 */
+	static const std::size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+	/**
+	 * \var NO_LIMIT
+	 * \brief Byte limit that reads the input to its end.
+	 */
+	static const uint64_t NO_LIMIT = UINT64_MAX;
+
+	/**
+	 * \brief Creates a reader for the given file descriptor, which is not
+	 * closed by the reader.
+	 *
+	 * \param limit The number of bytes to read at most, from the current
+	 * position of the file descriptor; the input is taken to end there, as for
+	 * reading one shard of a file.
+	 */
+	explicit ChunkedReader(int fd, std::size_t chunkSize = DEFAULT_CHUNK_SIZE,
+			uint64_t limit = NO_LIMIT);
+
+	/**
+	 * \brief Puts bytes already read from the file descriptor, such as the
+	 * ones readCompression() reads, before the rest of the input.
+	 *
+	 * They count as read, and towards the limit. Only to be called before
+	 * anything is read; a std::invalid_argument is thrown if they do not fit
+	 * in the buffer or the limit.
+	 */
+	void prepend(const std::string & bytes);
+
+	/**
+	 * \brief Gets the next line, without its newline.
+	 *
+	 * Blocks on the file descriptor if no complete line is buffered. A final
+	 * line without a newline is still returned. If reading fails, a
+	 * std::runtime_error is thrown.
+	 *
+	 * \returns false once the input is exhausted.
+	 */
+	bool nextLine(const char *& line, std::size_t & length);
+
+	/**
+	 * \brief Gets the next size bytes, for reading fixed-size records.
+	 *
+	 * Blocks on the file descriptor until size bytes are buffered; at the
+	 * end of input, fewer may be returned. size must not be more than the
+	 * chunk size. If reading fails, a std::runtime_error is thrown.
+	 *
+	 * \returns false once the input is exhausted.
+	 */
+	bool nextBlock(const char *& data, std::size_t size, std::size_t & length);
+
+	/**
+	 * \brief Returns whether nextLine() can return without reading from the
+	 * file descriptor.
+	 */
+	bool hasBufferedLine();
+
+	/**
+	 * \brief Returns the total number of bytes read so far.
+	 */
+	uint64_t getBytesRead() const;
+
+	/**
+	 * \brief Returns the number of bytes taken up by the lines and blocks
+	 * returned so far, which is where reading them again would end.
+	 */
+	uint64_t getBytesConsumed() const;
+
+private:
+	/**
+	 * \brief Moves any partial line to the start of the buffer and reads more
+	 * after it. Returns false at end of input.
+	 */
+	bool fill();
+
+	/** \brief The file descriptor being read. */
+	int fd_;
+
+	/** \brief The read buffer. */
+	std::vector<char> buffer_;
+
+	/** \brief Start of the unconsumed bytes in buffer_. */
+	std::size_t begin_;
+
+	/** \brief End of the valid bytes in buffer_. */
+	std::size_t end_;
+
+	/** \brief Position of the next newline at or after begin_, if it has
+	 * been found. */
+	std::size_t newline_;
+
+	/** \brief Whether the end of input has been reached. */
+	bool eof_;
+
+	/** \brief Holds the start of an over-long line while the rest of it is
+	 * skipped; empty until there is one. */
+	std::vector<char> spare_;
+
+	/** \brief Total number of bytes read. */
+	uint64_t bytesRead_;
+
+	/** \brief Number of bytes to read at most. */
+	uint64_t limit_;
+};
+
+/**
+ * \class CorpusReader
+ * \brief Reads the puzzles of a file in either \ref CorpusFormat, one record
+ * at a time.
+ *
+ * Reading starts at the current position of the file descriptor, which must be
+ * the start of a record: for a binary file, not the start of the header. Blank
+ * lines of a text file are skipped, and a partial record at the end of a binary
+ * file is returned as an invalid record.
+ */
+class CorpusReader {
+public:
+	/**
+	 * \brief Creates a reader for the given file descriptor, which is not
+	 * closed by the reader, reading at most limit bytes.
+	 *
+	 * \param prefix Bytes already read from the file descriptor, which come
+	 * before the rest of it; see ChunkedReader::prepend().
+	 */
+	CorpusReader(int fd, CorpusFormat format,
+			uint64_t limit = ChunkedReader::NO_LIMIT,
+			const std::string & prefix = std::string());
+
+	/**
+	 * \brief Gets the next record.
+	 *
+	 * \param givens Receives the puzzle, if it is valid.
+	 * \param valid Set to whether the record was a valid puzzle.
+	 *
+	 * \returns false once the input is exhausted. If reading fails, a
+	 * std::runtime_error is thrown.
+	 */
+	bool next(uint8_t givens[Board::NUM_CELLS], bool & valid);
+
+	/**
+	 * \brief Returns the number of bytes taken up by the records returned so
+	 * far; reading again from that far on gives the records after them.
+	 */
+	uint64_t getOffset() const;
+
+private:
+	CorpusFormat format_;
+
+	/** \brief Reads the records, as lines or as blocks. */
+	ChunkedReader reader_;
+};
+
+/**
+ * \class BoundedWriter
+ * \brief Buffers output for a file descriptor in a fixed-size buffer.
+ *
+ * When the buffer is full it is written out before more is accepted; as the
+ * write blocks until the reader on the other end has taken the data, a slow
+ * consumer slows the producer down instead of output piling up in memory.
+ */
+class BoundedWriter {
+public:
+	/**
+	 * \var DEFAULT_CAPACITY
+	 * \brief Default size of the output buffer.
+	 */
+	static const std::size_t DEFAULT_CAPACITY = 1 << 16;
+
+	/**
+	 * \brief Creates a writer for the given file descriptor, which is not
+	 * closed by the writer.
+	 */
+	explicit BoundedWriter(int fd, std::size_t capacity = DEFAULT_CAPACITY);
+
+	/**
+	 * \brief Flushes any buffered output, ignoring errors.
+	 */
+	~BoundedWriter();
+
+	/**
+	 * \brief Appends data to the buffer, flushing it first if it would
+	 * overflow.
+	 */
+	void write(const char * data, std::size_t length);
+
+	/**
+	 * \brief Writes out the whole buffer, blocking until the file descriptor
+	 * has accepted it. If writing fails, a std::runtime_error is thrown.
+	 */
+	void flush();
+
+	/**
+	 * \brief Returns the number of bytes waiting in the buffer.
+	 */
+	std::size_t getBufferedSize() const;
+
+private:
+	/** \brief Writes length bytes to the file descriptor. */
+	void writeAll(const char * data, std::size_t length);
+
+	/** \brief The file descriptor being written. */
+	int fd_;
+
+	/** \brief The output buffer. */
+	std::vector<char> buffer_;
+
+	/** \brief Number of bytes used in buffer_. */
+	std::size_t size_;
+};
+
+#endif /* PUZZLEIO_H_ */
@@ -0,0 +1,230 @@
+/** \file RingBuffer.h
+ *
+ * \brief Defines the bounded lock-free queues used to connect the stages of
+ * the batch pipeline.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef RINGBUFFER_H_
+#define RINGBUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * \brief Returns the smallest power of two that is at least value (and at
+ * least 2).
+ */
+inline std::size_t roundUpToPowerOfTwo(std::size_t value){
+	std::size_t result = 2;
+	while(result < value)
+		result <<= 1;
+	return result;
+}
+
+/**
+ * \class SpscRing
+ * \brief Bounded queue for exactly one producer thread and one consumer
+ * thread.
+ *
+ * Neither side ever blocks: tryPush() fails when the queue is full and
+ * tryPop() fails when it is empty. Each side keeps a cached copy of the other
+ * side's index, so the shared indices are only read when the cached one says
+ * the queue is full or empty.
+ */
+template<typename T>
+class SpscRing {
+public:
+	/**
+	 * \brief Creates a queue that can hold at least capacity elements; the
+	 * capacity is rounded up to a power of two.
+	 */
+	explicit SpscRing(std::size_t capacity) :
+			buffer_(roundUpToPowerOfTwo(capacity)),
+			mask_(buffer_.size() - 1),
+			head_(0), tailCache_(0), tail_(0), headCache_(0) {}
+
+	/**
+	 * \brief Appends value to the queue. Must only be called by the producer.
+	 *
+	 * \returns false if the queue is full.
+	 */
+	bool tryPush(const T & value){
+		std::size_t tail = tail_.load(std::memory_order_relaxed);
+		if(tail - headCache_ == buffer_.size()){
+			headCache_ = head_.load(std::memory_order_acquire);
+			if(tail - headCache_ == buffer_.size())
+				return false;
+		}
+		buffer_[tail & mask_] = value;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * \brief Takes the oldest value off the queue. Must only be called by the
+	 * consumer.
+	 *
+	 * \returns false if the queue is empty.
+	 */
+	bool tryPop(T & value){
+		std::size_t head = head_.load(std::memory_order_relaxed);
+		if(head == tailCache_){
+			tailCache_ = tail_.load(std::memory_order_acquire);
+			if(head == tailCache_)
+				return false;
+		}
+		value = buffer_[head & mask_];
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * \brief Returns the number of elements in the queue. Only approximate
+	 * while the queue is in use.
+	 */
+	std::size_t sizeApprox() const {
+		std::size_t head = head_.load(std::memory_order_relaxed);
+		std::size_t tail = tail_.load(std::memory_order_relaxed);
+		return tail >= head ? tail - head : 0;
+	}
+
+	/** \brief Returns the number of elements the queue can hold. */
+	std::size_t capacity() const { return buffer_.size(); }
+
+private:
+	/* The consumer's and the producer's fields are kept on separate cache
+	 * lines. */
+	std::vector<T> buffer_;
+	const std::size_t mask_;
+
+	char padConsumer_[64];
+	std::atomic<std::size_t> head_;
+	std::size_t tailCache_;
+
+	char padProducer_[64];
+	std::atomic<std::size_t> tail_;
+	std::size_t headCache_;
+	char padEnd_[64];
+};
+
+/**
+ * \class MpmcRing
+ * \brief Bounded queue for any number of producer and consumer threads.
+ *
+ * This is Dmitry Vyukov's bounded MPMC queue: each cell carries a sequence
+ * number that tells producers and consumers whether it is free or full for
+ * their turn, so each operation is a single compare-and-swap on the shared
+ * index when uncontended.
+ */
+template<typename T>
+class MpmcRing {
+public:
+	/**
+	 * \brief Creates a queue that can hold at least capacity elements; the
+	 * capacity is rounded up to a power of two.
+	 */
+	explicit MpmcRing(std::size_t capacity) :
+			capacity_(roundUpToPowerOfTwo(capacity)),
+			mask_(capacity_ - 1),
+			cells_(new Cell[capacity_]),
+			enqueuePos_(0),
+			dequeuePos_(0)
+	{
+		for(std::size_t i = 0; i < capacity_; ++i)
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Appends value to the queue.
+	 *
+	 * \returns false if the queue is full.
+	 */
+	bool tryPush(const T & value){
+		Cell * cell;
+		std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+		for(;;){
+			cell = &cells_[pos & mask_];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t difference = static_cast<intptr_t>(sequence) -
+					static_cast<intptr_t>(pos);
+			if(difference == 0){
+				if(enqueuePos_.compare_exchange_weak(pos, pos + 1,
+						std::memory_order_relaxed))
+					break;
+			}
+			else if(difference < 0)
+				return false;
+			else
+				pos = enqueuePos_.load(std::memory_order_relaxed);
+		}
+		cell->value = value;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * \brief Takes the oldest value off the queue.
+	 *
+	 * \returns false if the queue is empty.
+	 */
+	bool tryPop(T & value){
+		Cell * cell;
+		std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+		for(;;){
+			cell = &cells_[pos & mask_];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t difference = static_cast<intptr_t>(sequence) -
+					static_cast<intptr_t>(pos + 1);
+			if(difference == 0){
+				if(dequeuePos_.compare_exchange_weak(pos, pos + 1,
+						std::memory_order_relaxed))
+					break;
+			}
+			else if(difference < 0)
+				return false;
+			else
+				pos = dequeuePos_.load(std::memory_order_relaxed);
+		}
+		value = cell->value;
+		cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * \brief Returns the number of elements in the queue. Only approximate
+	 * while the queue is in use.
+	 */
+	std::size_t sizeApprox() const {
+		std::size_t dequeue = dequeuePos_.load(std::memory_order_relaxed);
+		std::size_t enqueue = enqueuePos_.load(std::memory_order_relaxed);
+		return enqueue >= dequeue ? enqueue - dequeue : 0;
+	}
+
+	/** \brief Returns the number of elements the queue can hold. */
+	std::size_t capacity() const { return capacity_; }
+
+private:
+	struct Cell {
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	const std::size_t capacity_;
+	const std::size_t mask_;
+	std::unique_ptr<Cell[]> cells_;
+
+	char padEnqueue_[64];
+	std::atomic<std::size_t> enqueuePos_;
+	char padDequeue_[64];
+	std::atomic<std::size_t> dequeuePos_;
+	char padEnd_[64];
+};
+
+#endif /* RINGBUFFER_H_ */
@@ -0,0 +1,236 @@
+/** \file SatSolver.h
+ *
+ * \brief Defines the CNF encoding of a Sudoku, its DIMACS output, and the class
+ * CdclSolver, a small conflict-driven clause learning SAT solver.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef SATSOLVER_H_
+#define SATSOLVER_H_
+
+#include "Board.h"
+#include "Solver.h"
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+class Puzzle;
+
+/**
+ * \struct Cnf
+ * \brief A formula in conjunctive normal form, with literals as in DIMACS:
+ * variable v true is v, false is -v, counting variables from 1.
+ */
+struct Cnf {
+	/** \brief Number of variables. */
+	int numVars;
+
+	/** \brief The clauses, each a disjunction of literals. */
+	std::vector<std::vector<int> > clauses;
+
+	Cnf() : numVars(0) {}
+
+	/**
+	 * \brief Writes the formula in DIMACS CNF format: a "p cnf" header, then
+	 * one clause per line ending in 0.
+	 */
+	void writeDimacs(std::ostream & out) const;
+};
+
+/** @name Sudoku encoding
+ *
+ * Each cell and value has a variable, true when the cell holds the value. The
+ * clauses say that every cell holds exactly one value and every unit holds
+ * each value exactly once, and fix the givens. A variant adds units of its own,
+ * such as the two diagonals: the cells of an extra unit must all differ, and if
+ * it has PUZZLE_SIZE cells it must hold every value.
+ */
+/**@{*/
+
+/** \brief Returns the variable for the given cell holding the given value. */
+inline int getSatVariable(int cell, int value){
+	return cell * Board::PUZZLE_SIZE + value;
+}
+
+/** \brief Returns the two diagonals as extra units, for X-Sudoku. */
+std::vector<std::vector<int> > getDiagonalUnits();
+
+/**
+ * \brief Encodes a Board: set cells are fixed, and the values an unset cell
+ * has lost are ruled out.
+ */
+Cnf encodeSudoku(const Board & board,
+		const std::vector<std::vector<int> > & extraUnits =
+		std::vector<std::vector<int> >());
+
+/**
+ * \brief Encodes a Puzzle: set Squares are fixed, and values that are not
+ * possible for an unset Square are ruled out. Unlike loading a Board, this
+ * never fails; a contradictory Puzzle gives an unsatisfiable formula.
+ */
+Cnf encodeSudoku(const Puzzle & puzzle,
+		const std::vector<std::vector<int> > & extraUnits =
+		std::vector<std::vector<int> >());
+
+/**@}*/
+
+/**
+ * \class CdclSolver
+ * \brief A conflict-driven clause learning SAT solver.
+ *
+ * Each clause watches two of its literals, so an assignment only visits the
+ * clauses watching the literal it makes false. A conflict is analysed back to
+ * its first unique implication point, the clause learnt from it is added, and
+ * the search jumps back to the level where that clause becomes unit. Decisions
+ * take the unassigned variable with the highest activity, which is bumped for
+ * the variables in each conflict and decays over time, with the value it last
+ * had. The search restarts after a number of conflicts that follows the Luby
+ * sequence, keeping what it has learnt.
+ *
+ * Learnt clauses are never deleted; the solver is meant for formulas the size
+ * of a Sudoku, not for industrial instances.
+ */
+class CdclSolver {
+public:
+	/**
+	 * \enum Result
+	 * \brief The outcome of solve().
+	 */
+	enum Result {
+		SATISFIABLE,
+		UNSATISFIABLE,
+		/** The search ran into its limits or was cancelled. */
+		UNKNOWN
+	};
+
+	/**
+	 * \struct Stats
+	 * \brief Counters for the last call to solve().
+	 */
+	struct Stats {
+		/** \brief Number of decisions. */
+		uint64_t decisions;
+
+		/** \brief Number of literals assigned by propagation. */
+		uint64_t propagations;
+
+		/** \brief Number of conflicts, each of which learnt a clause. */
+		uint64_t conflicts;
+
+		/** \brief Number of restarts. */
+		uint64_t restarts;
+
+		Stats() : decisions(0), propagations(0), conflicts(0), restarts(0) {}
+	};
+
+	CdclSolver();
+
+	/**
+	 * \brief Replaces the formula to solve, forgetting any learnt clauses.
+	 */
+	void load(const Cnf & cnf);
+
+	/**
+	 * \brief Searches for a satisfying assignment.
+	 *
+	 * \param limits The decisions count as nodes for maxNodes; the clock and
+	 * cancel flag are checked every checkInterval decisions.
+	 */
+	Result solve(const Solver::Limits & limits = Solver::Limits());
+
+	/**
+	 * \brief After SATISFIABLE, returns the value of the given variable,
+	 * counting from 1.
+	 */
+	bool getValue(int var) const;
+
+	/** \brief Returns the counters for the last call to solve(). */
+	const Stats & getStats() const;
+
+private:
+	/** \brief Value of a literal: 1 true, 0 false, -1 unassigned. */
+	int valueOf(int lit) const;
+
+	/** \brief Adds a clause of internal literals with at least two of them,
+	 * watching the first two, and returns its index. */
+	int addClause(const std::vector<int> & lits);
+
+	/** \brief Makes lit true at the current level, implied by the clause
+	 * reason, or by none if reason is -1. */
+	void enqueue(int lit, int reason);
+
+	/** \brief Propagates the trail; returns a conflicting clause, or -1. */
+	int propagate();
+
+	/** \brief Learns a clause from the conflict, putting it in learnt_ with
+	 * its asserting literal first, and returns the level to jump back to. */
+	int analyze(int conflict);
+
+	/** \brief Undoes every assignment above the given level. */
+	void cancelUntil(int level);
+
+	/** \brief Returns the unassigned variable to decide next, or -1. */
+	int pickVariable() const;
+
+	void bumpActivity(int var);
+
+	/** \brief Returns the value of the Luby sequence (1, 1, 2, 1, 1, 2, 4,
+	 * ...) at the given index, counting from 0. */
+	static uint64_t luby(uint64_t index);
+
+	/** \brief Number of variables; internal literals are 2 * var for true
+	 * and 2 * var + 1 for false, with var counting from 0. */
+	int numVars_;
+
+	/** \brief Whether a clause was found empty when loading. */
+	bool emptyClause_;
+
+	/** \brief The clauses, original then learnt; the first two literals of
+	 * each are watched, and the first of a reason is the literal implied. */
+	std::vector<std::vector<int> > clauses_;
+
+	/** \brief Indices of the clauses watching each literal. */
+	std::vector<std::vector<int> > watches_;
+
+	/** \brief Unit clauses from loading, applied at the start of solve(). */
+	std::vector<int> units_;
+
+	/** \brief Value of each variable: 1, 0, or -1 if unassigned. */
+	std::vector<int8_t> values_;
+
+	/** \brief Value each variable last had, for deciding it again. */
+	std::vector<int8_t> phases_;
+
+	/** \brief Decision level each variable was assigned at. */
+	std::vector<int> levels_;
+
+	/** \brief Clause that implied each variable, or -1 for a decision. */
+	std::vector<int> reasons_;
+
+	/** \brief Activity of each variable. */
+	std::vector<double> activity_;
+
+	/** \brief Amount the next bump adds; grows as activities decay. */
+	double activityIncrement_;
+
+	/** \brief Assigned literals, in order. */
+	std::vector<int> trail_;
+
+	/** \brief Start of each decision level in trail_. */
+	std::vector<int> trailLimits_;
+
+	/** \brief Next position of trail_ to propagate. */
+	std::size_t propagated_;
+
+	/** \brief Marks for analyze(). */
+	std::vector<uint8_t> seen_;
+
+	/** \brief The clause being learnt. */
+	std::vector<int> learnt_;
+
+	Stats stats_;
+};
+
+#endif /* SATSOLVER_H_ */
@@ -0,0 +1,186 @@
+/** \file SolutionCache.h
+ *
+ * \brief Defines the class SolutionCache, which keeps the solution of each
+ * interactive session's puzzle so that checking a move needs no search.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef SOLUTIONCACHE_H_
+#define SOLUTIONCACHE_H_
+
+#include "Board.h"
+#include "Solver.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * \class SolutionCache
+ * \brief The solutions of the puzzles being played in many sessions at once,
+ * within a bound on memory.
+ *
+ * A front end checks after every move whether the board is still on the way
+ * to the puzzle's unique solution. The first check for a session solves the
+ * givens, counting up to two solutions, and keeps the result with a copy of
+ * the givens; every later check compares the set cells with the kept
+ * solution, which costs a pass over the cells instead of a search. The
+ * givens are compared on every check too, so a session that starts another
+ * puzzle, or edits its givens, is solved again rather than checked against a
+ * stale solution.
+ *
+ * Sessions are spread over SHARDS independently locked shards by their
+ * identifier, so checks for different sessions rarely wait for each other,
+ * and a solve is done with no lock held. Each shard evicts its least recently
+ * used session once its share of the memory bound is reached.
+ */
+class SolutionCache {
+public:
+	/**
+	 * \enum Uniqueness
+	 * \brief What the search found for a session's givens.
+	 *
+	 * UNIQUE: exactly one solution.
+	 * NO_SOLUTION: the givens cannot be completed.
+	 * MULTIPLE_SOLUTIONS: more than one solution, so a move cannot be checked
+	 * against the solution.
+	 * UNDECIDED: the search ran into the Limits before either was known.
+	 */
+	enum Uniqueness {
+		UNIQUE,
+		NO_SOLUTION,
+		MULTIPLE_SOLUTIONS,
+		UNDECIDED
+	};
+
+	/**
+	 * \enum Verdict
+	 * \brief The outcome of check().
+	 *
+	 * CONSISTENT: every set cell agrees with the unique solution.
+	 * INCONSISTENT: a set cell does not, or the givens have no solution.
+	 * UNKNOWN: the givens do not have a unique solution, or it could not be
+	 * found within the Limits, so the board has to be solved to tell.
+	 */
+	enum Verdict {
+		CONSISTENT,
+		INCONSISTENT,
+		UNKNOWN
+	};
+
+	/**
+	 * \struct Stats
+	 * \brief Counters over the life of a SolutionCache.
+	 */
+	struct Stats {
+		/** \brief Checks answered from a kept solution. */
+		uint64_t hits;
+
+		/** \brief Checks for a session with no kept solution. */
+		uint64_t misses;
+
+		/** \brief Checks for a session whose givens had changed. */
+		uint64_t invalidations;
+
+		/** \brief Sessions evicted to stay within the memory bound. */
+		uint64_t evictions;
+
+		/** \brief Sessions kept now. */
+		std::size_t sessions;
+
+		Stats() : hits(0), misses(0), invalidations(0), evictions(0),
+				sessions(0) {}
+	};
+
+	/** \brief Number of independently locked shards. */
+	static const int SHARDS = 16;
+
+	/** \brief Default bound on memory: 16 MiB, 65536 sessions on a 64-bit
+	 * machine. */
+	static const std::size_t DEFAULT_MAX_BYTES = 16 << 20;
+
+	/**
+	 * \brief Creates an empty cache.
+	 *
+	 * \param maxBytes The memory the kept sessions may use, estimated with
+	 * getSessionBytes(); each shard keeps at least one session, whatever the
+	 * bound.
+	 * \param limits Limits on the search for each new session's solution.
+	 */
+	explicit SolutionCache(std::size_t maxBytes = DEFAULT_MAX_BYTES,
+			const Solver::Limits & limits = Solver::Limits());
+
+	/**
+	 * \brief Checks board against the solution of givens, the puzzle being
+	 * played in the given session. May be called from any thread.
+	 *
+	 * \param givens The puzzle as given, 0 for an empty cell; the cells set
+	 * since are only in board.
+	 */
+	Verdict check(uint64_t session, const uint8_t givens[Board::NUM_CELLS],
+			const Board & board);
+
+	/**
+	 * \brief Finds the solution of givens for the given session, from the
+	 * cache if it holds it, solving and keeping it otherwise. An UNDECIDED
+	 * result is not kept, so the next lookup tries the search again.
+	 *
+	 * \param solution If not null and the givens have a unique solution,
+	 * receives its NUM_CELLS values.
+	 */
+	Uniqueness lookup(uint64_t session, const uint8_t givens[Board::NUM_CELLS],
+			uint8_t * solution = nullptr);
+
+	/** \brief Forgets the given session, as when it ends. */
+	void endSession(uint64_t session);
+
+	/** \brief Returns the counters, summed over the shards. */
+	Stats getStats() const;
+
+	/** \brief Returns the estimated memory each kept session uses, with the
+	 * overhead of the containers it is in. */
+	static std::size_t getSessionBytes();
+
+private:
+	/**
+	 * \struct Entry
+	 * \brief A kept session.
+	 */
+	struct Entry {
+		uint64_t session;
+		uint8_t givens[Board::NUM_CELLS];
+		uint8_t solution[Board::NUM_CELLS];
+		Uniqueness uniqueness;
+	};
+
+	/**
+	 * \struct Shard
+	 * \brief Sessions, most recently used first, and their index, under one
+	 * lock.
+	 */
+	struct Shard {
+		mutable std::mutex mutex;
+		std::list<Entry> entries;
+		std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+		Stats stats;
+	};
+
+	/** \brief Returns the shard that holds the given session. */
+	Shard & getShard(uint64_t session);
+
+	/** \brief Solves givens into entry. */
+	void solve(Entry & entry) const;
+
+	Solver::Limits limits_;
+
+	/** \brief Number of sessions each shard keeps at most. */
+	std::size_t shardCapacity_;
+
+	std::unique_ptr<Shard[]> shards_;
+};
+
+#endif /* SOLUTIONCACHE_H_ */
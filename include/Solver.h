@@ -0,0 +1,305 @@
+/** \file Solver.h
+ *
+ * \brief Defines the class Solver, a backtracking solver over \ref Board.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef SOLVER_H_
+#define SOLVER_H_
+
+#include "Board.h"
+#include "Heuristics.h"
+#include "Propagator.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+/**
+ * \class Solver
+ * \brief Depth-first backtracking solver.
+ *
+ * The search is iterative: each level of the search keeps a copy of the
+ * \ref Board, the \ref Branch taken there and how many of its alternatives
+ * have been tried. The stack of levels is allocated once with the Solver, so a
+ * Solver can be reused for any number of puzzles without allocating; it is
+ * part of the Solver, which is therefore large and best kept on the heap.
+ *
+ * After every assignment the \ref Propagator places any singles, and at each
+ * level the Solver's \ref Heuristic chooses the Branch; by default this is
+ * the unset cell with the fewest candidates. solve() can also restart the
+ * search after a number of nodes, doubling that number each time, which pays
+ * off with a randomized Heuristic on puzzles where an early wrong choice is
+ * expensive.
+ *
+ * So that no one puzzle can hold up a worker, a Solver can also be given
+ * \ref Limits: a time budget and a number of nodes per call, and a cancel flag
+ * to watch. A search that runs into one stops with its counters so far.
+ */
+class Solver {
+public:
+	/**
+	 * \enum Status
+	 * \brief The outcome of a call to solve().
+	 *
+	 * SOLVED: the Board was solved.
+	 * UNSOLVABLE: the Board has no solution.
+	 * CANCELLED: the search was stopped by a cancel flag before either was
+	 * known.
+	 * TIMED_OUT: the search ran out of time or nodes before either was known.
+	 */
+	enum Status {
+		SOLVED,
+		UNSOLVABLE,
+		CANCELLED,
+		TIMED_OUT
+	};
+
+	/**
+	 * \struct Limits
+	 * \brief Bounds on each call to solve() or countSolutions().
+	 */
+	struct Limits {
+		/** \brief Time a call may take, or zero for no limit. */
+		std::chrono::steady_clock::duration timeBudget;
+
+		/** \brief Search nodes a call may visit, restarts included. */
+		uint64_t maxNodes;
+
+		/** \brief If not null, the search stops once this becomes true. */
+		const std::atomic<bool> * cancel;
+
+		/** \brief The clock and cancel are checked once every this many
+		 * nodes. */
+		uint64_t checkInterval;
+
+		Limits() : timeBudget(0), maxNodes(UINT64_MAX), cancel(nullptr),
+				checkInterval(64) {}
+	};
+
+	/**
+	 * \struct Stats
+	 * \brief Counters describing the work done by the last call to solve().
+	 */
+	struct Stats {
+		/** \brief Number of search nodes (Boards) visited. */
+		uint64_t nodes;
+
+		/** \brief Number of branches that led to a contradiction. */
+		uint64_t backtracks;
+
+		/** \brief Deepest level of the search reached. */
+		int maxDepth;
+
+		/** \brief Number of times the search was restarted. */
+		uint64_t restarts;
+
+		/** \brief Whether the search was stopped by a cancel flag. */
+		bool cancelled;
+
+		/** \brief Whether the search was stopped by the time or node limit. */
+		bool timedOut;
+
+		Stats() : nodes(0), backtracks(0), maxDepth(0), restarts(0),
+				cancelled(false), timedOut(false) {}
+	};
+
+public:
+	/**
+	 * \brief Default constructor; the Solver branches on the cell with the
+	 * fewest candidates, and does not restart.
+	 */
+	Solver();
+
+	/**
+	 * \brief Sets the Heuristic that chooses each Branch; null restores the
+	 * default.
+	 */
+	void setHeuristic(std::unique_ptr<Heuristic> heuristic);
+
+	/** \brief Returns the Heuristic that chooses each Branch. */
+	Heuristic & getHeuristic() const;
+
+	/**
+	 * \brief Makes solve() restart after firstNodes nodes, then twice as many,
+	 * and so on, calling Heuristic::restart() with a seed derived from seed
+	 * before each attempt. 0 turns restarts off.
+	 *
+	 * countSolutions() never restarts, as it has to visit the whole tree.
+	 */
+	void setRestarts(uint64_t firstNodes, uint64_t seed);
+
+	/**
+	 * \brief Sets the Limits on each later call.
+	 */
+	void setLimits(const Limits & limits);
+
+	/** \brief Returns the Limits on each call. */
+	const Limits & getLimits() const;
+
+	/**
+	 * \brief Solves the given Board.
+	 *
+	 * \param board A Board that was loaded successfully. If it can be solved,
+	 * it is replaced by its (first found) solution; otherwise it is left
+	 * unchanged.
+	 */
+	Status solve(Board & board);
+
+	/**
+	 * \brief Solves the given Board, giving up if cancel becomes true.
+	 *
+	 * cancel is read once per search node, so the search stops within one
+	 * node of it being set. On CANCELLED or TIMED_OUT the Board is left
+	 * unchanged.
+	 */
+	Status solve(Board & board, const std::atomic<bool> & cancel);
+
+	/**
+	 * \brief Counts the solutions of the given Board, stopping at limit.
+	 *
+	 * Solutions are found in the same order as solve() finds them, so the
+	 * first one, if any, is the one solve() would return.
+	 *
+	 * \param firstSolution If not null and there is a solution, receives the
+	 * first one found.
+	 * \param cancel If not null, the count stops (and is incomplete) once it
+	 * becomes true; getStats().cancelled then says so, as
+	 * getStats().timedOut does if the count runs into the Limits.
+	 * \returns The number of solutions, but no more than limit.
+	 */
+	uint64_t countSolutions(const Board & board, uint64_t limit,
+			Board * firstSolution = nullptr,
+			const std::atomic<bool> * cancel = nullptr);
+
+	/**
+	 * \brief Returns the counters for the last call to solve().
+	 */
+	const Stats & getStats() const;
+
+	/**
+	 * \brief Solves the given Board with no Solver object, usable in a
+	 * constant expression.
+	 *
+	 * This is the plain search: it branches on the cell with the fewest
+	 * candidates, recursing once per level, and keeps no counters. It finds
+	 * the same first solution as solve() with the default Heuristic, so a
+	 * puzzle and its solution can be checked with a static_assert.
+	 *
+	 * \param board If it can be solved, it is replaced by its solution;
+	 * otherwise it is left unchanged.
+	 */
+	static constexpr Status solveConstant(Board & board);
+
+private:
+	/**
+	 * \brief solve(), with restarts if they are on. On SOLVED, board is
+	 * replaced by the solution.
+	 */
+	Status solveWithRestarts(Board & board, const std::atomic<bool> * cancel);
+
+	/**
+	 * \brief Resets stats_ and starts the clock for limits_.
+	 */
+	void startCall();
+
+	/**
+	 * \brief The search behind solve() and countSolutions(): finds up to
+	 * limit solutions of board, copying the first to firstSolution if it is
+	 * not null, and returns how many it found. Adds its counters to stats_.
+	 *
+	 * \param nodeLimit The search gives up after this many nodes, setting
+	 * hitNodeLimit. It also stops, setting stats_.cancelled or
+	 * stats_.timedOut, when it runs into limits_.
+	 */
+	uint64_t search(const Board & board, uint64_t limit, Board * firstSolution,
+			const std::atomic<bool> * cancel, uint64_t nodeLimit,
+			bool & hitNodeLimit);
+
+	/**
+	 * \struct Frame
+	 * \brief One level of the search.
+	 */
+	struct Frame {
+		/** \brief Board at this level, before branching. */
+		Board board;
+
+		/** \brief The alternatives tried at this level. */
+		Branch branch;
+
+		/** \brief The next alternative of branch to try. */
+		int next;
+	};
+
+	/**
+	 * \var frames_
+	 * \brief The search stack. Every level sets at least one cell, so the
+	 * search can never be deeper than NUM_CELLS.
+	 */
+	Frame frames_[Board::NUM_CELLS + 1];
+
+	/**
+	 * \var heuristic_
+	 * \brief Chooses the Branch at each level.
+	 */
+	std::unique_ptr<Heuristic> heuristic_;
+
+	/**
+	 * \var restartNodes_
+	 * \brief Nodes before the first restart, or 0 for no restarts.
+	 */
+	uint64_t restartNodes_;
+
+	/**
+	 * \var restartSeed_
+	 * \brief Seed from which each restart's seed is derived.
+	 */
+	uint64_t restartSeed_;
+
+	/**
+	 * \var limits_
+	 * \brief Bounds on each call.
+	 */
+	Limits limits_;
+
+	/**
+	 * \var deadline_
+	 * \brief When the current call runs out of time, if limits_ has a time
+	 * budget.
+	 */
+	std::chrono::steady_clock::time_point deadline_;
+
+	/**
+	 * \var stats_
+	 * \brief Counters for the last call to solve().
+	 */
+	Stats stats_;
+};
+
+constexpr Solver::Status Solver::solveConstant(Board & board){
+	Board work = board;
+	if(!Propagator::propagate(work))
+		return UNSOLVABLE;
+	if(work.isSolved()){
+		board = work;
+		return SOLVED;
+	}
+
+	work.refreshBuckets();
+	int cell = work.findFewestCandidates();
+	for(uint16_t rest = work.getCandidates(cell); rest != 0;
+			rest &= rest - 1){
+		Board next = work;
+		if(next.assign(cell, Board::lowestValue(rest)) &&
+				solveConstant(next) == SOLVED){
+			board = next;
+			return SOLVED;
+		}
+	}
+
+	return UNSOLVABLE;
+}
+
+#endif /* SOLVER_H_ */
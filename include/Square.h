@@ -9,10 +9,13 @@
 #ifndef SQUARE_H_
 #define SQUARE_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <set>
 #include <initializer_list>
 #include <iostream>
 #include <string>
+#include "CandidateView.h"
 #include "Position.h"
 
 /**
@@ -24,6 +27,9 @@
  * a value between 1 and \ref PUZZLE_SIZE, or it can be unset and have many
  * possible values. Squares also have a row and a column, which must both be
  * between 0 and \ref PUZZLE_SIZE. For now, \ref PUZZLE_SIZE is set to 9.
+ *
+ * The possible values are kept in a bit mask, so a Square never allocates and
+ * copying or moving one is a copy of a few bytes.
  */
 class Square {
 public:
@@ -88,7 +94,13 @@ public:
 	 *
 	 * The new \ref Square will be set to an exact copy of other.
 	 */
-	Square(const Square & other);
+	Square(const Square & other) = default;
+
+	/**
+	 * \brief Move constructor; the same as copying, as a Square owns no
+	 * memory.
+	 */
+	Square(Square && other) = default;
 
 	/**@}*/ //Constructors.
 
@@ -152,8 +164,14 @@ public:
 	 * std::logic_error will be thrown. */
 	int getValue() const;
 
-	/** \brief Returns a set::set<int> of this Square's possible values. */
-	std::set<int> getPossibleValues() const;
+	/**
+	 * \brief Returns a view of this Square's possible values.
+	 *
+	 * The view iterates like the std::set<int> this used to return, compares
+	 * equal to one with the same values, and converts to one where a
+	 * std::set<int> is still wanted.
+	 */
+	CandidateView getPossibleValues() const;
 	/**@}*/
 
 	/** @name Miscellaneous. */
@@ -175,14 +193,40 @@ public:
 	 * at least two possible values. Return's true if by the end of this
 	 * method, the Square is set.
 	 */
-	bool restrictValues(std::set<int> vals);
+	bool restrictValues(const std::set<int> & vals);
+
+	/**
+	 * \brief Restricts the possible values by the given values, in the order
+	 * given; otherwise the same as restrictValues(const std::set<int> &).
+	 */
+	bool restrictValues(std::initializer_list<int> vals);
+
+	/**
+	 * \brief Restricts the possible values by the count values starting at
+	 * vals, in that order; otherwise the same as
+	 * restrictValues(const std::set<int> &).
+	 */
+	bool restrictValues(const int * vals, std::size_t count);
+
+	/**
+	 * \brief Restricts the possible values by the values of a
+	 * CandidateView, in increasing order; otherwise the same as
+	 * restrictValues(const std::set<int> &).
+	 */
+	bool restrictValues(CandidateView vals);
 
 	/**
 	 * \brief Assignment operator.
 	 *
 	 * This Square will be set to an exact copy of the other square.
 	 */
-	Square & operator=(const Square & other);
+	Square & operator=(const Square & other) = default;
+
+	/**
+	 * \brief Move assignment; the same as copying, as a Square owns no
+	 * memory.
+	 */
+	Square & operator=(Square && other) = default;
 
 	/**
 	 * \brief Checks the given co-ordinate (either a row or a col), and throws
@@ -198,7 +242,10 @@ public:
 	 * a row or a column; the only effect this has is on the what() message for
 	 * the exception.
 	 */
-	static void checkThrowCoordinate(int coord, rowcol rc);
+	static void checkThrowCoordinate(int coord, rowcol rc){
+		if(coord < 0 || coord >= PUZZLE_SIZE)
+			throwInvalidCoordinate(coord, rc);
+	}
 
 	/**
 	 * \brief Checks whether the given value is valid, and if not, throws a
@@ -209,7 +256,10 @@ public:
 	 * std::out_of_range exception will be thrown with a appropriate what()
 	 * message.
 	 */
-	static void checkThrowValue(int value);
+	static void checkThrowValue(int value){
+		if(value < 1 || value > PUZZLE_SIZE)
+			throwInvalidValue(value);
+	}
 
 	/**
 	 * \brief Returns a string representation of the Square.
@@ -223,6 +273,20 @@ public:
 	/**@}*/ // Miscellaneous.
 
 private:
+	/**
+	 * \brief Removes one value from the possible values, for
+	 * restrictValues(), setting this Square if one value is left.
+	 *
+	 * \returns True if this removal set the Square.
+	 */
+	bool restrictValue(int value);
+
+	/** \brief Throws the std::out_of_range for an invalid row or col. */
+	[[noreturn]] static void throwInvalidCoordinate(int coord, rowcol rc);
+
+	/** \brief Throws the std::out_of_range for an invalid value. */
+	[[noreturn]] static void throwInvalidValue(int value);
+
 	/**
 	 * \var row_
 	 * \brief Row that this Square is located in the Sudoku puzzle.
@@ -250,10 +314,10 @@ private:
 
 	/**
 	 * \var possibleValues_
-	 * \brief Holds all the values that this Square could be. If this Square is
-	 * set, then it will only have its value.
+	 * \brief Holds all the values that this Square could be, with bit v-1 set
+	 * for the value v. If this Square is set, then it will only have its value.
 	 */
-	std::set<int> possibleValues_;
+	uint16_t possibleValues_;
 };
 
 /**
@@ -0,0 +1,59 @@
+/** \file StreamMode.h
+ *
+ * \brief Defines the streaming mode, which solves one-line puzzles from a file
+ * descriptor as they arrive.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef STREAMMODE_H_
+#define STREAMMODE_H_
+
+#include "LatencyHistogram.h"
+#include "Solver.h"
+#include <cstdint>
+
+/**
+ * \struct StreamStats
+ * \brief Counts of the records processed by runStreamMode().
+ */
+struct StreamStats {
+	/** \brief Number of puzzle records read (blank lines are not counted). */
+	uint64_t records;
+
+	/** \brief Number of puzzles solved. */
+	uint64_t solved;
+
+	/** \brief Number of puzzles with no solution. */
+	uint64_t unsolvable;
+
+	/** \brief Number of lines that were not valid one-line puzzles. */
+	uint64_t invalid;
+
+	/** \brief Number of puzzles given up on at the Solver's limits. */
+	uint64_t timedOut;
+
+	StreamStats() : records(0), solved(0), unsolvable(0), invalid(0),
+			timedOut(0) {}
+};
+
+/**
+ * \brief Solves every one-line puzzle read from inFd, writing one line per
+ * puzzle to outFd.
+ *
+ * Each output line is the solution in the one-line format, "unsolvable" if the
+ * puzzle has no solution, "timed out" if its search ran into limits, or
+ * "invalid" if the line was not a valid puzzle; blank lines are skipped.
+ * Input is read in large chunks and output is written through a fixed-size
+ * buffer, so memory use is constant however long the input. Buffered output
+ * is flushed whenever the reader would otherwise block waiting for input, so
+ * results are not held back from a slow producer.
+ *
+ * If latency is not null, the time each solve takes is recorded in it.
+ */
+StreamStats runStreamMode(int inFd, int outFd,
+		const Solver::Limits & limits = Solver::Limits(),
+		LatencyHistogram * latency = nullptr);
+
+#endif /* STREAMMODE_H_ */
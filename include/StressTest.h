@@ -0,0 +1,90 @@
+/** \file StressTest.h
+ *
+ * \brief Defines the stress test, which solves random puzzles with every
+ * engine on many threads at once and checks that they all agree.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef STRESSTEST_H_
+#define STRESSTEST_H_
+
+#include <cstdint>
+#include <ostream>
+
+/**
+ * \struct StressOptions
+ * \brief What runStressTest() solves, and with how many threads.
+ */
+struct StressOptions {
+	/** \brief Number of random puzzles. */
+	uint64_t puzzles;
+
+	/** \brief Number of threads, or 0 for one per hardware thread. */
+	int threads;
+
+	/**
+	 * \brief Seed of the puzzles. Puzzle i depends only on the seed and i, so
+	 * a run can be repeated with any number of threads.
+	 */
+	uint64_t seed;
+
+	/** \brief Search nodes each solve may take before it is given up on. */
+	uint64_t maxNodes;
+
+	StressOptions() : puzzles(10000), threads(0), seed(50),
+			maxNodes(1000000) {}
+};
+
+/**
+ * \struct StressReport
+ * \brief Counts of what runStressTest() generated and found.
+ */
+struct StressReport {
+	/** \brief Puzzles with one solution. */
+	uint64_t unique;
+
+	/** \brief Puzzles with more than one solution. */
+	uint64_t multiple;
+
+	/** \brief Puzzles with no solution. */
+	uint64_t unsolvable;
+
+	/** \brief Puzzles that Board::load() finds contradicted, so that no
+	 * engine is asked to solve them. */
+	uint64_t contradicted;
+
+	/** \brief Solves run, across all the engines. */
+	uint64_t solves;
+
+	/** \brief Solves, or reference counts, given up on at the node limit. */
+	uint64_t timedOut;
+
+	/** \brief Solves whose result disagreed with the reference count or was
+	 * not a valid solution. */
+	uint64_t mismatches;
+
+	StressReport() : unique(0), multiple(0), unsolvable(0), contradicted(0),
+			solves(0), timedOut(0), mismatches(0) {}
+};
+
+/**
+ * \brief Generates random puzzles and solves each with every engine.
+ *
+ * Each puzzle is some of the cells of a random solved grid, found by the
+ * Solver with a randomized heuristic; one in eight has a given changed, so
+ * that most of those have no solution. The solutions are counted, up to two,
+ * by a plain Solver, and then the puzzle is solved by every engine of
+ * makeEngine() and by the Solver with every heuristic of makeHeuristic(),
+ * with and without restarts. Every solve must agree with the count, give a
+ * solution that verifySolution() accepts, and, for a puzzle with one
+ * solution, give that one. Each thread has its own engines, and all the
+ * threads solve at once.
+ *
+ * Each disagreement is written to log as a line naming the engine and the
+ * puzzle in the one-line format.
+ */
+StressReport runStressTest(const StressOptions & options, std::ostream & log);
+
+#endif /* STRESSTEST_H_ */
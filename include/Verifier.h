@@ -0,0 +1,58 @@
+/** \file Verifier.h
+ *
+ * \brief Defines the functions that check a completed grid against the rules
+ * and against the puzzle it is meant to solve.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef VERIFIER_H_
+#define VERIFIER_H_
+
+#include "Board.h"
+#include <cstdint>
+
+class Puzzle;
+
+/**
+ * \enum VerifyResult
+ * \brief The outcome of verifySolution().
+ *
+ * VALID: the grid is complete, obeys the rules and keeps every given.
+ * INCOMPLETE: some cell of the grid is empty or out of range.
+ * DUPLICATE: some row, column or box of the grid repeats a value.
+ * GIVEN_CHANGED: the grid is a valid solution, but not of the given puzzle.
+ */
+enum VerifyResult {
+	VALID,
+	INCOMPLETE,
+	DUPLICATE,
+	GIVEN_CHANGED
+};
+
+/**
+ * \brief Checks that solution is a completed grid that obeys the rules and
+ * agrees with every given of the puzzle.
+ *
+ * One value mask is kept per unit; as each unit has PUZZLE_SIZE cells, the
+ * grid is valid exactly when every one of the NUM_UNITS masks ends up full.
+ *
+ * \param solution NUM_CELLS values in cell order.
+ * \param givens NUM_CELLS values in cell order, 0 for an empty cell.
+ */
+VerifyResult verifySolution(const uint8_t solution[Board::NUM_CELLS],
+		const uint8_t givens[Board::NUM_CELLS]);
+
+/**
+ * \brief Returns a short description of a VerifyResult.
+ */
+const char * describe(VerifyResult result);
+
+/**
+ * \brief Copies the values of the Puzzle's Squares into grid, with 0 for an
+ * unset Square.
+ */
+void gridOf(const Puzzle & puzzle, uint8_t grid[Board::NUM_CELLS]);
+
+#endif /* VERIFIER_H_ */
@@ -0,0 +1,474 @@
+/*
+ * BatchPipeline.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "BatchPipeline.h"
+#include "Parallel.h"
+#include "PuzzleIO.h"
+#include "Solver.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+/* Spins briefly, then yields, while a stage waits on a queue. */
+class Backoff {
+public:
+	Backoff() : spins_(0) {}
+
+	void pause(){
+		if(spins_ < 64)
+			++spins_;
+		else
+			std::this_thread::yield();
+	}
+
+private:
+	int spins_;
+};
+
+/* Pops from queue, waiting while it is empty. Returns false if the pipeline
+ * is aborted first. */
+template<typename Queue>
+bool popWait(Queue & queue, uint32_t & value, QueueMetrics & metrics,
+		const std::atomic<bool> & aborted){
+	if(!queue.tryPop(value)){
+		++metrics.consumerStalls;
+		Backoff backoff;
+		while(!queue.tryPop(value)){
+			if(aborted.load(std::memory_order_relaxed))
+				return false;
+			backoff.pause();
+		}
+	}
+
+	std::size_t depth = queue.sizeApprox();
+	++metrics.samples;
+	metrics.depthSum += depth;
+	metrics.maxDepth = std::max(metrics.maxDepth, depth);
+	return true;
+}
+
+/* Pushes onto queue, waiting while it is full. Returns false if the pipeline
+ * is aborted first. */
+template<typename Queue>
+bool pushWait(Queue & queue, uint32_t value, QueueMetrics & metrics,
+		const std::atomic<bool> & aborted){
+	if(queue.tryPush(value))
+		return true;
+
+	++metrics.producerStalls;
+	Backoff backoff;
+	while(!queue.tryPush(value)){
+		if(aborted.load(std::memory_order_relaxed))
+			return false;
+		backoff.pause();
+	}
+	return true;
+}
+
+/* Writes all of text to fd and syncs it to disk. */
+void writeAndSync(int fd, const std::string & text, const std::string & path){
+	std::size_t done = 0;
+	while(done < text.size()){
+		ssize_t count = write(fd, text.data() + done, text.size() - done);
+		if(count < 0 && errno == EINTR)
+			continue;
+		if(count < 0)
+			throw std::runtime_error(errorMessage("Could not write '" + path +
+					"'"));
+		done += count;
+	}
+	if(fsync(fd) != 0)
+		throw std::runtime_error(errorMessage("Could not sync '" + path + "'"));
+}
+
+} // namespace
+
+std::string BatchCheckpoint::toString() const {
+	std::ostringstream o;
+	o << records << " " << solved << " " << unsolvable << " " << invalid << " "
+			<< timedOut << " " << nodes << " " << inputOffset << " "
+			<< outputOffset << " " << input;
+	return o.str();
+}
+
+BatchCheckpoint BatchCheckpoint::fromString(const std::string & text){
+	std::istringstream in(text);
+	BatchCheckpoint checkpoint;
+	if(!(in >> checkpoint.records >> checkpoint.solved >>
+			checkpoint.unsolvable >> checkpoint.invalid >>
+			checkpoint.timedOut >> checkpoint.nodes >>
+			checkpoint.inputOffset >> checkpoint.outputOffset) ||
+			in.get() != ' ' ||
+			checkpoint.solved + checkpoint.unsolvable + checkpoint.invalid +
+					checkpoint.timedOut != checkpoint.records)
+		throw std::invalid_argument("Invalid checkpoint '" + text + "'.");
+
+	// The rest of the line, which may have spaces in it.
+	std::getline(in, checkpoint.input);
+	return checkpoint;
+}
+
+void BatchCheckpoint::save(const std::string & path) const {
+	std::string temporary = path + ".tmp";
+	int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0)
+		throw std::runtime_error(errorMessage("Could not open '" + temporary +
+				"'"));
+	try{
+		writeAndSync(fd, toString() + "\n", temporary);
+	}
+	catch(std::exception & e){
+		close(fd);
+		throw;
+	}
+	if(close(fd) != 0 || rename(temporary.c_str(), path.c_str()) != 0)
+		throw std::runtime_error(errorMessage("Could not save '" + path +
+				"'"));
+
+	// Sync the directory too, so that the rename itself survives a crash.
+	std::size_t slash = path.rfind('/');
+	std::string directory = slash == std::string::npos ? "." :
+			slash == 0 ? "/" : path.substr(0, slash);
+	int directoryFd = open(directory.c_str(), O_RDONLY);
+	if(directoryFd >= 0){
+		fsync(directoryFd);
+		close(directoryFd);
+	}
+}
+
+BatchCheckpoint BatchCheckpoint::load(const std::string & path){
+	std::ifstream in(path.c_str());
+	if(!in)
+		throw std::runtime_error("Could not open '" + path + "'.");
+	std::string line;
+	std::getline(in, line);
+	return fromString(line);
+}
+
+void seekToCheckpoint(int inFd, int outFd, const BatchCheckpoint & checkpoint){
+	off_t outputEnd = lseek(outFd, 0, SEEK_END);
+	if(outputEnd < 0)
+		throw std::runtime_error(errorMessage("Could not seek in the output"));
+	if(static_cast<uint64_t>(outputEnd) < checkpoint.outputOffset)
+		throw std::runtime_error("The output is shorter than the checkpoint "
+				"says; it is not the output the checkpoint was made for.");
+
+	if(ftruncate(outFd, static_cast<off_t>(checkpoint.outputOffset)) != 0 ||
+			lseek(outFd, static_cast<off_t>(checkpoint.outputOffset),
+					SEEK_SET) < 0)
+		throw std::runtime_error(errorMessage("Could not cut back the output"));
+	if(lseek(inFd, static_cast<off_t>(checkpoint.inputOffset), SEEK_CUR) < 0)
+		throw std::runtime_error(errorMessage("Could not seek in the input"));
+}
+
+const uint32_t BatchPipeline::END_OF_INPUT;
+
+void QueueMetrics::merge(const QueueMetrics & other){
+	capacity = std::max(capacity, other.capacity);
+	samples += other.samples;
+	depthSum += other.depthSum;
+	maxDepth = std::max(maxDepth, other.maxDepth);
+	producerStalls += other.producerStalls;
+	consumerStalls += other.consumerStalls;
+}
+
+BatchPipeline::BatchPipeline(const Options & options) :
+		solverThreads_(resolveThreads(options.solverThreads)),
+		limits_(options.limits),
+		format_(options.format),
+		inputLimit_(options.inputLimit),
+		inputPrefix_(options.inputPrefix),
+		checkpointPath_(options.checkpointPath),
+		checkpointEvery_(std::max<uint64_t>(options.checkpointEvery, 1)),
+		latency_(options.latency),
+		slots_(std::max<std::size_t>(options.slots, 1)),
+		freeQueue_(slots_.size()),
+		// Room for a full set of slots plus one end marker per solver.
+		solveQueue_(slots_.size() + solverThreads_),
+		writeQueue_(slots_.size()),
+		readerDone_(false),
+		records_(0),
+		aborted_(false)
+{}
+
+PipelineStats BatchPipeline::run(int inFd, int outFd,
+		const BatchCheckpoint & start){
+	readerDone_ = false;
+	records_ = 0;
+	aborted_ = false;
+	error_ = std::exception_ptr();
+	stats_ = PipelineStats();
+
+	uint32_t index;
+	while(freeQueue_.tryPop(index)) {}
+	for(std::size_t i = 0; i < slots_.size(); ++i)
+		freeQueue_.tryPush(static_cast<uint32_t>(i));
+
+	std::vector<std::thread> threads;
+	threads.push_back(std::thread(&BatchPipeline::readerStage, this, inFd));
+	for(int i = 0; i < solverThreads_; ++i)
+		threads.push_back(std::thread(&BatchPipeline::solverStage, this));
+	threads.push_back(std::thread(&BatchPipeline::writerStage, this, outFd,
+			start));
+
+	for(auto & thread : threads)
+		thread.join();
+
+	if(error_)
+		std::rethrow_exception(error_);
+
+	stats_.freeQueue.capacity = freeQueue_.capacity();
+	stats_.solveQueue.capacity = solveQueue_.capacity();
+	stats_.writeQueue.capacity = writeQueue_.capacity();
+	return stats_;
+}
+
+void BatchPipeline::getQueueDepths(std::size_t & freeDepth,
+		std::size_t & solveDepth, std::size_t & writeDepth) const {
+	freeDepth = freeQueue_.sizeApprox();
+	solveDepth = solveQueue_.sizeApprox();
+	writeDepth = writeQueue_.sizeApprox();
+}
+
+int BatchPipeline::getSolverThreads() const {
+	return solverThreads_;
+}
+
+void BatchPipeline::readerStage(int inFd){
+	QueueMetrics freeMetrics;
+	QueueMetrics solveMetrics;
+
+	try{
+		CorpusReader reader(inFd, format_, inputLimit_, inputPrefix_);
+		uint8_t givens[Board::NUM_CELLS];
+		bool valid;
+		uint64_t sequence = 0;
+
+		while(reader.next(givens, valid)){
+			uint32_t index;
+			if(!popWait(freeQueue_, index, freeMetrics, aborted_))
+				return;
+
+			Slot & slot = slots_[index];
+			slot.sequence = sequence++;
+			slot.nodes = 0;
+			slot.inputEnd = reader.getOffset();
+			if(!valid)
+				slot.status = INVALID;
+			else if(!slot.board.load(givens))
+				slot.status = UNSOLVABLE;
+			else
+				slot.status = PARSED;
+
+			if(!pushWait(solveQueue_, index, solveMetrics, aborted_))
+				return;
+		}
+
+		records_.store(sequence, std::memory_order_relaxed);
+		readerDone_.store(true, std::memory_order_release);
+
+		for(int i = 0; i < solverThreads_; ++i)
+			if(!pushWait(solveQueue_, END_OF_INPUT, solveMetrics, aborted_))
+				return;
+	}
+	catch(...){
+		abort(std::current_exception());
+	}
+
+	mergeMetrics(&freeMetrics, &solveMetrics, nullptr);
+}
+
+void BatchPipeline::solverStage(){
+	QueueMetrics solveMetrics;
+	QueueMetrics writeMetrics;
+
+	try{
+		std::unique_ptr<Solver> solver(new Solver());
+		solver->setLimits(limits_);
+
+		for(;;){
+			uint32_t index;
+			if(!popWait(solveQueue_, index, solveMetrics, aborted_))
+				return;
+			if(index == END_OF_INPUT)
+				break;
+
+			Slot & slot = slots_[index];
+			if(slot.status == PARSED){
+				auto start = std::chrono::steady_clock::now();
+				Solver::Status status = solver->solve(slot.board);
+				if(latency_ != nullptr)
+					latency_->record(std::chrono::steady_clock::now() - start);
+				slot.status = status == Solver::SOLVED ? SOLVED :
+						status == Solver::UNSOLVABLE ? UNSOLVABLE : TIMED_OUT;
+				slot.nodes = solver->getStats().nodes;
+			}
+
+			if(!pushWait(writeQueue_, index, writeMetrics, aborted_))
+				return;
+		}
+	}
+	catch(...){
+		abort(std::current_exception());
+	}
+
+	mergeMetrics(nullptr, &solveMetrics, &writeMetrics);
+}
+
+void BatchPipeline::writerStage(int outFd, BatchCheckpoint progress){
+	QueueMetrics writeMetrics;
+	QueueMetrics freeMetrics;
+	uint64_t inputStart = progress.inputOffset;
+	uint64_t sinceCheckpoint = 0;
+
+	try{
+		BoundedWriter writer(outFd);
+		char out[Board::NUM_CELLS + 1];
+		out[Board::NUM_CELLS] = '\n';
+
+		/* Slots arrive in whatever order the solvers finish them. At most
+		 * slots_.size() are in flight, so sequence modulo that is a unique
+		 * place to park each one until its turn. */
+		std::vector<uint32_t> pending(slots_.size(), END_OF_INPUT);
+		uint64_t next = 0;
+
+		bool waiting = false;
+		Backoff backoff;
+
+		for(;;){
+			uint32_t index;
+			if(!writeQueue_.tryPop(index)){
+				if(readerDone_.load(std::memory_order_acquire) &&
+						next == records_.load(std::memory_order_relaxed))
+					break;
+				if(aborted_.load(std::memory_order_relaxed))
+					return;
+
+				// Nothing to do for now; let the consumer see what is done.
+				if(!waiting){
+					++writeMetrics.consumerStalls;
+					writer.flush();
+					waiting = true;
+					backoff = Backoff();
+				}
+				backoff.pause();
+				continue;
+			}
+			waiting = false;
+
+			std::size_t depth = writeQueue_.sizeApprox();
+			++writeMetrics.samples;
+			writeMetrics.depthSum += depth;
+			writeMetrics.maxDepth = std::max(writeMetrics.maxDepth, depth);
+
+			pending[slots_[index].sequence % slots_.size()] = index;
+
+			for(;;){
+				uint32_t & parked = pending[next % slots_.size()];
+				if(parked == END_OF_INPUT)
+					break;
+
+				Slot & slot = slots_[parked];
+				++progress.records;
+				progress.nodes += slot.nodes;
+				const char * line = out;
+				std::size_t length = sizeof(out);
+				switch(slot.status){
+				case SOLVED:
+					++progress.solved;
+					formatPuzzleLine(slot.board, out);
+					break;
+				case INVALID:
+					++progress.invalid;
+					line = INVALID_LINE;
+					length = strlen(INVALID_LINE);
+					break;
+				case PARSED:
+				case UNSOLVABLE:
+					++progress.unsolvable;
+					line = UNSOLVABLE_LINE;
+					length = strlen(UNSOLVABLE_LINE);
+					break;
+				case TIMED_OUT:
+					++progress.timedOut;
+					line = TIMED_OUT_LINE;
+					length = strlen(TIMED_OUT_LINE);
+					break;
+				}
+				writer.write(line, length);
+				progress.outputOffset += length;
+				progress.inputOffset = inputStart + slot.inputEnd;
+
+				/* Checkpoints are batched, as each one syncs the output to
+				 * disk. */
+				if(!checkpointPath_.empty() &&
+						++sinceCheckpoint == checkpointEvery_){
+					saveCheckpoint(writer, outFd, progress);
+					sinceCheckpoint = 0;
+				}
+
+				if(!pushWait(freeQueue_, parked, freeMetrics, aborted_))
+					return;
+				parked = END_OF_INPUT;
+				++next;
+			}
+		}
+
+		writer.flush();
+		if(!checkpointPath_.empty())
+			saveCheckpoint(writer, outFd, progress);
+	}
+	catch(...){
+		abort(std::current_exception());
+	}
+
+	mergeMetrics(&freeMetrics, nullptr, &writeMetrics);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	stats_.records = progress.records;
+	stats_.solved = progress.solved;
+	stats_.unsolvable = progress.unsolvable;
+	stats_.invalid = progress.invalid;
+	stats_.timedOut = progress.timedOut;
+	stats_.nodes = progress.nodes;
+}
+
+void BatchPipeline::saveCheckpoint(BoundedWriter & writer, int outFd,
+		const BatchCheckpoint & progress){
+	writer.flush();
+	if(fdatasync(outFd) != 0)
+		throw std::runtime_error(errorMessage("Could not sync the output"));
+	progress.save(checkpointPath_);
+}
+
+void BatchPipeline::mergeMetrics(const QueueMetrics * freeQueue,
+		const QueueMetrics * solveQueue, const QueueMetrics * writeQueue){
+	std::lock_guard<std::mutex> lock(mutex_);
+	if(freeQueue != nullptr)
+		stats_.freeQueue.merge(*freeQueue);
+	if(solveQueue != nullptr)
+		stats_.solveQueue.merge(*solveQueue);
+	if(writeQueue != nullptr)
+		stats_.writeQueue.merge(*writeQueue);
+}
+
+void BatchPipeline::abort(std::exception_ptr error){
+	std::lock_guard<std::mutex> lock(mutex_);
+	if(!error_)
+		error_ = error;
+	aborted_.store(true, std::memory_order_relaxed);
+}
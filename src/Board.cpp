@@ -0,0 +1,50 @@
+/*
+ * Board.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Board.h"
+#include "Puzzle.h"
+#include <stdexcept>
+#include <sstream>
+
+void Board::throwInvalidGiven(int value, int cell){
+	std::ostringstream o;
+	o << "Invalid given '" << value << "' for cell " << cell << ".";
+	throw std::out_of_range(o.str());
+}
+
+bool Board::load(const Puzzle & puzzle){
+	*this = Board();
+
+	for(int i = 0; i < NUM_CELLS; ++i){
+		const Square & square = puzzle(rowOf(i), colOf(i));
+		if(square.isSet()){
+			if(!assign(i, square.getValue()))
+				return false;
+		}
+		else{
+			uint16_t possible = square.getPossibleValues().getMask();
+			if(!eliminate(i, ALL_CANDIDATES & ~possible))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+std::ostream & operator<<(std::ostream & ostream, const Board & board){
+	for(int row = 0; row < Board::PUZZLE_SIZE; ++row){
+		for(int col = 0; col < Board::PUZZLE_SIZE; ++col){
+			int value = board.getValue(row * Board::PUZZLE_SIZE + col);
+			if(value == 0)
+				ostream << '#';
+			else
+				ostream << value;
+		}
+		ostream << '\n';
+	}
+	return ostream;
+}
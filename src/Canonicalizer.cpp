@@ -0,0 +1,265 @@
+/*
+ * Canonicalizer.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Canonicalizer.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+namespace {
+
+const int SIZE = Board::PUZZLE_SIZE;
+const int BOX = Board::BOX_SIZE;
+
+/* An empty cell, for comparing rows: greater than any label. */
+const uint8_t EMPTY = SIZE + 1;
+
+/* The permutations of three things. */
+const int PERMS3[6][3] = {
+	{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}
+};
+
+/* Returns whether the permutation puts the counts in non-increasing order. */
+bool isDescending(const int perm[BOX], const int counts[BOX]){
+	return counts[perm[0]] >= counts[perm[1]] &&
+			counts[perm[1]] >= counts[perm[2]];
+}
+
+uint64_t mix(uint64_t x){
+	x ^= x >> 31;
+	x *= 0x7fb5d329728ea185ULL;
+	x ^= x >> 27;
+	x *= 0x81dadef4bc2dd44dULL;
+	return x ^ (x >> 33);
+}
+
+} // namespace
+
+CanonicalKey CanonicalKey::pack(const uint8_t grid[Board::NUM_CELLS]){
+	CanonicalKey key;
+	std::fill(key.words, key.words + NUM_WORDS, 0);
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		key.words[cell / CELLS_PER_WORD] |=
+				uint64_t(grid[cell]) << (4 * (cell % CELLS_PER_WORD));
+	return key;
+}
+
+void CanonicalKey::unpack(uint8_t grid[Board::NUM_CELLS]) const {
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		grid[cell] = static_cast<uint8_t>(
+				(words[cell / CELLS_PER_WORD] >> (4 * (cell % CELLS_PER_WORD))) &
+				0xf);
+}
+
+bool CanonicalKey::operator==(const CanonicalKey & other) const {
+	return std::equal(words, words + NUM_WORDS, other.words);
+}
+
+std::size_t CanonicalKey::hash() const {
+	uint64_t h = 0;
+	for(int i = 0; i < NUM_WORDS; ++i)
+		h = mix(h ^ words[i]);
+	return static_cast<std::size_t>(h);
+}
+
+Canonicalizer::Canonicalizer() : statesSeen_(0) {}
+
+void Canonicalizer::canonicalize(const uint8_t givens[Board::NUM_CELLS],
+		uint8_t canonical[Board::NUM_CELLS]){
+	int total = 0;
+	std::fill(rowGivens_[0], rowGivens_[0] + SIZE, 0);
+	std::fill(rowGivens_[1], rowGivens_[1] + SIZE, 0);
+	for(int row = 0; row < SIZE; ++row){
+		for(int col = 0; col < SIZE; ++col){
+			uint8_t value = givens[row * SIZE + col];
+			grids_[0][row * SIZE + col] = value;
+			grids_[1][col * SIZE + row] = value;
+			if(value != 0){
+				++total;
+				++rowGivens_[0][row];
+				++rowGivens_[1][col];
+			}
+		}
+	}
+
+	std::fill(canonical, canonical + Board::NUM_CELLS, 0);
+	statesSeen_ = 0;
+	states_.clear();
+	if(total == 0)
+		return;
+
+	startStates(canonical);
+	int placed = 0;
+	for(int row = 0; ; ++row){
+		for(int col = 0; col < SIZE; ++col)
+			placed += canonical[row * SIZE + col] != 0;
+
+		// Every row after the last given is empty, whatever the transform.
+		if(placed == total || row + 1 == SIZE)
+			break;
+		extendStates(row + 1, canonical);
+	}
+}
+
+void Canonicalizer::startStates(uint8_t canonical[Board::NUM_CELLS]){
+	/* The least first row puts the fullest stacks first, so the rows to
+	 * start from are those whose stack counts, sorted, are greatest. */
+	int bestKey = -1;
+	std::pair<int, int> starts[2 * SIZE];
+	int numStarts = 0;
+	for(int t = 0; t < 2; ++t){
+		for(int row = 0; row < SIZE; ++row){
+			int counts[BOX] = {0, 0, 0};
+			for(int col = 0; col < SIZE; ++col)
+				counts[col / BOX] += grids_[t][row * SIZE + col] != 0;
+			std::sort(counts, counts + BOX, std::greater<int>());
+			int key = (counts[0] * (BOX + 1) + counts[1]) * (BOX + 1) +
+					counts[2];
+			if(key > bestKey){
+				bestKey = key;
+				numStarts = 0;
+			}
+			if(key == bestKey)
+				starts[numStarts++] = std::make_pair(t, row);
+		}
+	}
+
+	for(int i = 0; i < numStarts; ++i){
+		int t = starts[i].first;
+		int row = starts[i].second;
+		const uint8_t * cells = grids_[t] + row * SIZE;
+
+		int counts[BOX] = {0, 0, 0};
+		for(int col = 0; col < SIZE; ++col)
+			counts[col / BOX] += cells[col] != 0;
+
+		// The orders of each stack's columns that put its givens first.
+		int within[BOX][6];
+		int numWithin[BOX] = {0, 0, 0};
+		for(int stack = 0; stack < BOX; ++stack){
+			int filled[BOX];
+			for(int j = 0; j < BOX; ++j)
+				filled[j] = cells[stack * BOX + j] != 0;
+			for(int p = 0; p < 6; ++p){
+				if(isDescending(PERMS3[p], filled))
+					within[stack][numWithin[stack]++] = p;
+			}
+		}
+
+		for(const int (& stacks)[BOX] : PERMS3){
+			if(!isDescending(stacks, counts))
+				continue;
+			for(int a = 0; a < numWithin[stacks[0]]; ++a){
+				for(int b = 0; b < numWithin[stacks[1]]; ++b){
+					for(int c = 0; c < numWithin[stacks[2]]; ++c){
+						int chosen[BOX] = {within[stacks[0]][a],
+								within[stacks[1]][b], within[stacks[2]][c]};
+						addStartState(t, row, stacks, chosen);
+					}
+				}
+			}
+		}
+	}
+	statesSeen_ += states_.size();
+
+	// Every state kept gives the same first row.
+	const State & first = states_.front();
+	const uint8_t * cells = grids_[first.transposed] + first.rows[0] * SIZE;
+	for(int col = 0; col < SIZE; ++col)
+		canonical[col] = first.labels[cells[first.cols[col]]];
+}
+
+void Canonicalizer::addStartState(int t, int row, const int stacks[BOX],
+		const int within[BOX]){
+	const uint8_t * cells = grids_[t] + row * SIZE;
+	State state;
+	state.transposed = static_cast<uint8_t>(t);
+	state.numLabels = 0;
+	state.usedRows = static_cast<uint16_t>(1 << row);
+	state.rows[0] = static_cast<uint8_t>(row);
+	std::fill(state.labels, state.labels + SIZE + 1, 0);
+	for(int k = 0; k < BOX; ++k){
+		for(int j = 0; j < BOX; ++j){
+			int col = stacks[k] * BOX + PERMS3[within[k]][j];
+			state.cols[k * BOX + j] = static_cast<uint8_t>(col);
+			if(cells[col] != 0)
+				state.labels[cells[col]] = ++state.numLabels;
+		}
+	}
+	states_.push_back(state);
+}
+
+void Canonicalizer::extendStates(int row, uint8_t canonical[Board::NUM_CELLS]){
+	int rowInBand = row % BOX;
+	uint8_t best[SIZE];
+	uint8_t out[SIZE];
+	bool haveBest = false;
+	next_.clear();
+
+	for(const State & state : states_){
+		const uint8_t * grid = grids_[state.transposed];
+		int band = rowInBand == 0 ? -1 : state.rows[row - rowInBand] / BOX;
+		int emptyBands = 0;
+
+		for(int source = 0; source < SIZE; ++source){
+			int sourceBand = source / BOX;
+			if((state.usedRows >> source) & 1)
+				continue;
+			// A new band must be unused; otherwise stay in the current one.
+			if(rowInBand == 0 ?
+					((state.usedRows >> (sourceBand * BOX)) & 7) != 0 :
+					sourceBand != band)
+				continue;
+			// Empty rows of the same band are interchangeable.
+			if(rowGivens_[state.transposed][source] == 0){
+				if((emptyBands >> sourceBand) & 1)
+					continue;
+				emptyBands |= 1 << sourceBand;
+			}
+
+			++statesSeen_;
+			State extended = state;
+			int order = haveBest ? 0 : -1;
+			for(int col = 0; col < SIZE; ++col){
+				uint8_t value = grid[source * SIZE + extended.cols[col]];
+				if(value == 0)
+					out[col] = EMPTY;
+				else{
+					if(extended.labels[value] == 0)
+						extended.labels[value] = ++extended.numLabels;
+					out[col] = extended.labels[value];
+				}
+				if(order == 0 && out[col] != best[col]){
+					order = out[col] < best[col] ? -1 : 1;
+					if(order > 0)
+						break;
+				}
+			}
+			if(order > 0)
+				continue;
+			if(order < 0){
+				std::memcpy(best, out, sizeof(best));
+				haveBest = true;
+				next_.clear();
+			}
+
+			extended.rows[row] = static_cast<uint8_t>(source);
+			extended.usedRows = static_cast<uint16_t>(
+					extended.usedRows | (1 << source));
+			next_.push_back(extended);
+		}
+	}
+
+	states_.swap(next_);
+	for(int col = 0; col < SIZE; ++col)
+		canonical[row * SIZE + col] = best[col] == EMPTY ? 0 : best[col];
+}
+
+uint64_t Canonicalizer::getStates() const {
+	return statesSeen_;
+}
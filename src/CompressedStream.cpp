@@ -0,0 +1,561 @@
+/*
+ * CompressedStream.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "CompressedStream.h"
+#include "PuzzleIO.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#ifdef SUDOKU_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+const char GZIP_MAGIC[] = "\x1f\x8b";
+const char ZSTD_MAGIC[] = "\x28\xb5\x2f\xfd";
+
+const int GZIP_LEVEL = 1;
+const int ZSTD_LEVEL = 3;
+
+void checkCompressed(Compression compression){
+	if(compression == NO_COMPRESSION)
+		throw std::invalid_argument("No compression to decode or encode.");
+	if(!isCompressionAvailable(compression))
+		throw std::runtime_error(std::string("This build cannot read or write ")
+				+ getCompressionName(compression) + " files.");
+}
+
+bool endsWith(const std::string & text, const char * suffix){
+	std::size_t length = strlen(suffix);
+	return text.size() >= length &&
+			text.compare(text.size() - length, length, suffix) == 0;
+}
+
+/* Reads up to length bytes, returning 0 at the end of the file. */
+std::size_t readSome(int fd, char * data, std::size_t length,
+		const char * what){
+	for(;;){
+		ssize_t count = read(fd, data, length);
+		if(count >= 0)
+			return static_cast<std::size_t>(count);
+		if(errno != EINTR)
+			throw std::runtime_error(errorMessage(what));
+	}
+}
+
+/* The compression of a file whose first count bytes are header. */
+Compression compressionOf(const char * header, std::size_t count){
+	if(count >= 2 && memcmp(header, GZIP_MAGIC, 2) == 0)
+		return GZIP_COMPRESSION;
+	if(count >= 4 && memcmp(header, ZSTD_MAGIC, 4) == 0)
+		return ZSTD_COMPRESSION;
+	return NO_COMPRESSION;
+}
+
+void writeAll(int fd, const char * data, std::size_t length,
+		const char * what){
+	while(length > 0){
+		ssize_t count = write(fd, data, length);
+		if(count >= 0){
+			data += count;
+			length -= count;
+		}
+		else if(errno != EINTR)
+			throw std::runtime_error(errorMessage(what));
+	}
+}
+
+/* Creates a pipe with room for a whole block where the system allows it. */
+void makePipe(int & readFd, int & writeFd){
+	int fds[2];
+	if(pipe(fds) != 0)
+		throw std::runtime_error(errorMessage("Could not create a pipe"));
+	readFd = fds[0];
+	writeFd = fds[1];
+#ifdef F_SETPIPE_SZ
+	fcntl(writeFd, F_SETPIPE_SZ, static_cast<int>(COMPRESSED_BLOCK_SIZE));
+#endif
+}
+
+void closeFd(int & fd){
+	if(fd >= 0)
+		close(fd);
+	fd = -1;
+}
+
+} // namespace
+
+bool isCompressionAvailable(Compression compression){
+	switch(compression){
+	case NO_COMPRESSION:
+		return true;
+	case GZIP_COMPRESSION:
+#ifdef SUDOKU_HAVE_ZLIB
+		return true;
+#else
+		return false;
+#endif
+	case ZSTD_COMPRESSION:
+#ifdef SUDOKU_HAVE_ZSTD
+		return true;
+#else
+		return false;
+#endif
+	}
+	return false;
+}
+
+const char * getCompressionName(Compression compression){
+	switch(compression){
+	case GZIP_COMPRESSION:
+		return "gzip";
+	case ZSTD_COMPRESSION:
+		return "zstd";
+	default:
+		return "none";
+	}
+}
+
+Compression parseCompressionName(const std::string & name){
+	for(Compression compression : {NO_COMPRESSION, GZIP_COMPRESSION,
+			ZSTD_COMPRESSION}){
+		if(name == getCompressionName(compression))
+			return compression;
+	}
+	throw std::invalid_argument("Unknown compression '" + name + "'.");
+}
+
+Compression detectCompression(int fd){
+	char header[COMPRESSION_HEADER_SIZE];
+	ssize_t count;
+	do
+		count = pread(fd, header, sizeof(header), 0);
+	while(count < 0 && errno == EINTR);
+
+	return compressionOf(header, count < 0 ? 0 : count);
+}
+
+Compression readCompression(int fd, std::string & header){
+	char bytes[COMPRESSION_HEADER_SIZE];
+	std::size_t count = 0;
+	while(count < sizeof(bytes)){
+		std::size_t got = readSome(fd, bytes + count, sizeof(bytes) - count,
+				"Could not read input");
+		if(got == 0)
+			break;
+		count += got;
+	}
+	header.assign(bytes, count);
+	return compressionOf(bytes, count);
+}
+
+Compression getCompressionForPath(const std::string & path){
+	if(endsWith(path, ".gz"))
+		return GZIP_COMPRESSION;
+	if(endsWith(path, ".zst"))
+		return ZSTD_COMPRESSION;
+	return NO_COMPRESSION;
+}
+
+/* Decompresses a stream of gzip members or zstd frames, one after another. */
+class DecompressingInput::Decoder {
+public:
+	explicit Decoder(Compression compression) :
+			compression_(compression),
+			ended_(false)
+	{
+		checkCompressed(compression);
+#ifdef SUDOKU_HAVE_ZLIB
+		if(compression == GZIP_COMPRESSION){
+			memset(&zlib_, 0, sizeof(zlib_));
+			// 32 accepts either a gzip or a zlib header.
+			if(inflateInit2(&zlib_, 15 + 32) != Z_OK)
+				throw std::runtime_error("Could not start decompressing.");
+		}
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+		if(compression == ZSTD_COMPRESSION){
+			zstd_ = ZSTD_createDStream();
+			if(zstd_ == nullptr)
+				throw std::runtime_error("Could not start decompressing.");
+		}
+#endif
+	}
+
+	~Decoder(){
+#ifdef SUDOKU_HAVE_ZLIB
+		if(compression_ == GZIP_COMPRESSION)
+			inflateEnd(&zlib_);
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+		if(compression_ == ZSTD_COMPRESSION)
+			ZSTD_freeDStream(zstd_);
+#endif
+	}
+
+	/* Decodes from [in, inEnd) into [out, outEnd), moving in and out past
+	 * what was used. */
+	void decode(const char *& in, const char * inEnd, char *& out,
+			char * outEnd){
+		const char * inStart = in;
+		char * outStart = out;
+		bool ended = false;
+#ifdef SUDOKU_HAVE_ZLIB
+		if(compression_ == GZIP_COMPRESSION){
+			zlib_.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in));
+			zlib_.avail_in = static_cast<uInt>(inEnd - in);
+			zlib_.next_out = reinterpret_cast<Bytef *>(out);
+			zlib_.avail_out = static_cast<uInt>(outEnd - out);
+			int result = inflate(&zlib_, Z_NO_FLUSH);
+			if(result != Z_OK && result != Z_STREAM_END &&
+					result != Z_BUF_ERROR)
+				throw std::runtime_error(std::string("Not valid gzip data: ") +
+						(zlib_.msg != nullptr ? zlib_.msg : "unknown error") +
+						".");
+			in = reinterpret_cast<const char *>(zlib_.next_in);
+			out = reinterpret_cast<char *>(zlib_.next_out);
+
+			// Another member may follow, as from cat a.gz b.gz.
+			ended = result == Z_STREAM_END;
+			if(ended)
+				inflateReset(&zlib_);
+		}
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+		if(compression_ == ZSTD_COMPRESSION){
+			ZSTD_inBuffer input = { in,
+					static_cast<std::size_t>(inEnd - in), 0 };
+			ZSTD_outBuffer output = { out,
+					static_cast<std::size_t>(outEnd - out), 0 };
+			std::size_t result = ZSTD_decompressStream(zstd_, &output, &input);
+			if(ZSTD_isError(result))
+				throw std::runtime_error(std::string("Not valid zstd data: ") +
+						ZSTD_getErrorName(result) + ".");
+			in += input.pos;
+			out += output.pos;
+			ended = result == 0;
+		}
+#endif
+		if(in != inStart || out != outStart)
+			ended_ = ended;
+	}
+
+	/* Whether the data so far ends at the end of a member or frame. */
+	bool atStreamEnd() const {
+		return ended_;
+	}
+
+private:
+	Compression compression_;
+	bool ended_;
+#ifdef SUDOKU_HAVE_ZLIB
+	z_stream zlib_;
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+	ZSTD_DStream * zstd_;
+#endif
+};
+
+/* Compresses into one gzip member or zstd frame. */
+class CompressingOutput::Encoder {
+public:
+	explicit Encoder(Compression compression) :
+			compression_(compression)
+	{
+		checkCompressed(compression);
+#ifdef SUDOKU_HAVE_ZLIB
+		if(compression == GZIP_COMPRESSION){
+			memset(&zlib_, 0, sizeof(zlib_));
+			// 16 writes a gzip header and trailer rather than zlib's.
+			if(deflateInit2(&zlib_, GZIP_LEVEL, Z_DEFLATED, 15 + 16, 8,
+					Z_DEFAULT_STRATEGY) != Z_OK)
+				throw std::runtime_error("Could not start compressing.");
+		}
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+		if(compression == ZSTD_COMPRESSION){
+			zstd_ = ZSTD_createCCtx();
+			if(zstd_ == nullptr)
+				throw std::runtime_error("Could not start compressing.");
+			ZSTD_CCtx_setParameter(zstd_, ZSTD_c_compressionLevel, ZSTD_LEVEL);
+		}
+#endif
+	}
+
+	~Encoder(){
+#ifdef SUDOKU_HAVE_ZLIB
+		if(compression_ == GZIP_COMPRESSION)
+			deflateEnd(&zlib_);
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+		if(compression_ == ZSTD_COMPRESSION)
+			ZSTD_freeCCtx(zstd_);
+#endif
+	}
+
+	/* Encodes from [in, inEnd) into [out, outEnd), moving in and out past
+	 * what was used. With last set, the input is the end of the data, and
+	 * true is returned once the stream has been ended. */
+	bool encode(const char *& in, const char * inEnd, char *& out,
+			char * outEnd, bool last){
+		bool done = false;
+#ifdef SUDOKU_HAVE_ZLIB
+		if(compression_ == GZIP_COMPRESSION){
+			zlib_.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in));
+			zlib_.avail_in = static_cast<uInt>(inEnd - in);
+			zlib_.next_out = reinterpret_cast<Bytef *>(out);
+			zlib_.avail_out = static_cast<uInt>(outEnd - out);
+			int result = deflate(&zlib_, last ? Z_FINISH : Z_NO_FLUSH);
+			if(result == Z_STREAM_ERROR)
+				throw std::runtime_error("Could not compress the output.");
+			in = reinterpret_cast<const char *>(zlib_.next_in);
+			out = reinterpret_cast<char *>(zlib_.next_out);
+			done = result == Z_STREAM_END;
+		}
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+		if(compression_ == ZSTD_COMPRESSION){
+			ZSTD_inBuffer input = { in,
+					static_cast<std::size_t>(inEnd - in), 0 };
+			ZSTD_outBuffer output = { out,
+					static_cast<std::size_t>(outEnd - out), 0 };
+			std::size_t result = ZSTD_compressStream2(zstd_, &output, &input,
+					last ? ZSTD_e_end : ZSTD_e_continue);
+			if(ZSTD_isError(result))
+				throw std::runtime_error(std::string(
+						"Could not compress the output: ") +
+						ZSTD_getErrorName(result) + ".");
+			in += input.pos;
+			out += output.pos;
+			done = last && result == 0;
+		}
+#endif
+		return done;
+	}
+
+private:
+	Compression compression_;
+#ifdef SUDOKU_HAVE_ZLIB
+	z_stream zlib_;
+#endif
+#ifdef SUDOKU_HAVE_ZSTD
+	ZSTD_CCtx * zstd_;
+#endif
+};
+
+DecompressingInput::DecompressingInput(int fd, Compression compression,
+		const std::string & header) :
+		fd_(fd),
+		decoder_(new Decoder(compression)),
+		format_(TEXT_FORMAT),
+		input_(COMPRESSED_BLOCK_SIZE),
+		inputBegin_(0),
+		inputEnd_(0),
+		inputDone_(false),
+		output_(COMPRESSED_BLOCK_SIZE),
+		outputBegin_(0),
+		outputEnd_(0),
+		readFd_(-1),
+		writeFd_(-1)
+{
+	if(header.size() > input_.size())
+		throw std::invalid_argument("Compressed header is too long.");
+	std::copy(header.begin(), header.end(), input_.begin());
+	inputEnd_ = header.size();
+
+	// The format, from the first bytes; the header of a binary file stops
+	// here.
+	fillOutput(BINARY_HEADER_SIZE);
+	if(outputEnd_ >= BINARY_HEADER_SIZE &&
+			memcmp(&output_[0], BINARY_MAGIC, BINARY_HEADER_SIZE) == 0){
+		format_ = BINARY_FORMAT;
+		outputBegin_ = BINARY_HEADER_SIZE;
+	}
+
+	makePipe(readFd_, writeFd_);
+	try{
+		thread_ = std::thread(&DecompressingInput::run, this);
+	}
+	catch(std::exception & e){
+		closeFd(readFd_);
+		closeFd(writeFd_);
+		throw std::runtime_error("Could not start decompressing.");
+	}
+}
+
+DecompressingInput::~DecompressingInput(){
+	// A thread still writing finds the pipe closed and stops.
+	closeFd(readFd_);
+	if(thread_.joinable())
+		thread_.join();
+}
+
+int DecompressingInput::getFd() const {
+	return readFd_;
+}
+
+CorpusFormat DecompressingInput::getFormat() const {
+	return format_;
+}
+
+void DecompressingInput::finish(){
+	if(thread_.joinable())
+		thread_.join();
+	if(error_)
+		std::rethrow_exception(error_);
+}
+
+bool DecompressingInput::fillOutput(std::size_t size){
+	if(outputBegin_ > 0){
+		memmove(&output_[0], &output_[0] + outputBegin_,
+				outputEnd_ - outputBegin_);
+		outputEnd_ -= outputBegin_;
+		outputBegin_ = 0;
+	}
+
+	while(outputEnd_ < size){
+		if(inputBegin_ == inputEnd_ && !inputDone_){
+			inputBegin_ = 0;
+			inputEnd_ = readSome(fd_, &input_[0], input_.size(),
+					"Could not read compressed input");
+			inputDone_ = inputEnd_ == 0;
+		}
+
+		const char * in = &input_[0] + inputBegin_;
+		char * out = &output_[0] + outputEnd_;
+		decoder_->decode(in, &input_[0] + inputEnd_, out,
+				&output_[0] + output_.size());
+		bool progress = in != &input_[0] + inputBegin_ ||
+				out != &output_[0] + outputEnd_;
+		inputBegin_ = in - &input_[0];
+		outputEnd_ = out - &output_[0];
+
+		if(!progress && inputBegin_ == inputEnd_ && inputDone_){
+			if(!decoder_->atStreamEnd())
+				throw std::runtime_error("The compressed input is truncated.");
+			break;
+		}
+		if(!progress && inputBegin_ < inputEnd_)
+			throw std::runtime_error("Not valid compressed data.");
+	}
+	return outputBegin_ < outputEnd_;
+}
+
+void DecompressingInput::run(){
+	/* If the reader goes away early, writing to the pipe fails with EPIPE
+	 * here instead of raising SIGPIPE for the process. */
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+	try{
+		do{
+			writeAll(writeFd_, &output_[0] + outputBegin_,
+					outputEnd_ - outputBegin_,
+					"Could not pass on decompressed input");
+			outputBegin_ = outputEnd_;
+		} while(fillOutput(output_.size()));
+	}
+	catch(...){
+		error_ = std::current_exception();
+	}
+
+	// The reader sees the end of the input.
+	closeFd(writeFd_);
+}
+
+CompressingOutput::CompressingOutput(int fd, Compression compression) :
+		fd_(fd),
+		encoder_(new Encoder(compression)),
+		readFd_(-1),
+		writeFd_(-1)
+{
+	makePipe(readFd_, writeFd_);
+	try{
+		thread_ = std::thread(&CompressingOutput::run, this);
+	}
+	catch(std::exception & e){
+		closeFd(readFd_);
+		closeFd(writeFd_);
+		throw std::runtime_error("Could not start compressing.");
+	}
+}
+
+CompressingOutput::~CompressingOutput(){
+	try{
+		finish();
+	}
+	catch(std::exception & e){
+		// Nothing sensible can be done about a failed write here.
+	}
+	closeFd(readFd_);
+}
+
+int CompressingOutput::getFd() const {
+	return writeFd_;
+}
+
+void CompressingOutput::finish(){
+	// The thread sees the end of the output.
+	closeFd(writeFd_);
+	if(thread_.joinable())
+		thread_.join();
+	if(error_){
+		std::exception_ptr error = error_;
+		error_ = std::exception_ptr();
+		std::rethrow_exception(error);
+	}
+}
+
+void CompressingOutput::run(){
+	std::vector<char> input(COMPRESSED_BLOCK_SIZE);
+	std::vector<char> output(COMPRESSED_BLOCK_SIZE);
+	char * outputEnd = &output[0] + output.size();
+
+	try{
+		bool last = false;
+		while(!last){
+			std::size_t count = readSome(readFd_, &input[0], input.size(),
+					"Could not read output to compress");
+			last = count == 0;
+
+			const char * in = &input[0];
+			for(;;){
+				char * out = &output[0];
+				bool done = encoder_->encode(in, &input[0] + count, out,
+						outputEnd, last);
+				writeAll(fd_, &output[0], out - &output[0],
+						"Could not write output");
+				if(last ? done : in == &input[0] + count && out < outputEnd)
+					break;
+			}
+		}
+	}
+	catch(...){
+		error_ = std::current_exception();
+
+		/* Keep draining the pipe, so that the writer does not block, or get
+		 * SIGPIPE, before finish() reports the error. */
+		char discard[1 << 16];
+		try{
+			while(readSome(readFd_, discard, sizeof(discard), "") > 0) {}
+		}
+		catch(std::exception & e){
+			// Already failed.
+		}
+	}
+}
@@ -0,0 +1,218 @@
+/*
+ * CorpusChecker.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "CorpusChecker.h"
+#include "Parallel.h"
+#include "Puzzle.h"
+#include "PuzzleIO.h"
+#include "Verifier.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <dirent.h>
+
+namespace {
+
+/* Number of batch file lines checked together. */
+const std::size_t BLOCK_SIZE = 1 << 16;
+
+enum Outcome {
+	OK,
+	MISMATCHED,
+	MALFORMED,
+	UNPAIRED
+};
+
+/* One pair to check, and what was found. */
+struct Job {
+	std::string name;
+	std::string puzzle;
+	std::string solution;
+	Outcome outcome;
+	std::string message;
+};
+
+void finish(Job & job, VerifyResult result){
+	if(result == VALID){
+		job.outcome = OK;
+		return;
+	}
+	job.outcome = MISMATCHED;
+	job.message = describe(result);
+}
+
+/* Checks a pair of puzzle files, or just that the puzzle file can be read if
+ * it has no solution file. */
+void checkFiles(Job & job){
+	try{
+		Puzzle puzzle(job.puzzle);
+		if(job.solution.empty()){
+			job.outcome = UNPAIRED;
+			return;
+		}
+
+		Puzzle solution(job.solution);
+		uint8_t givens[Board::NUM_CELLS];
+		uint8_t grid[Board::NUM_CELLS];
+		gridOf(puzzle, givens);
+		gridOf(solution, grid);
+		finish(job, verifySolution(grid, givens));
+	}
+	catch(Puzzle::PuzzleFileException & e){
+		job.outcome = MALFORMED;
+		job.message = e.what();
+	}
+	catch(std::exception & e){
+		job.outcome = MALFORMED;
+		job.message = e.what();
+	}
+}
+
+/* Checks a batch file line, kept in job.puzzle. */
+void checkLine(Job & job){
+	const std::string & line = job.puzzle;
+	std::size_t split = line.find_first_of(" \t,");
+	std::size_t second = line.find_first_not_of(" \t,", split);
+
+	uint8_t givens[Board::NUM_CELLS];
+	uint8_t grid[Board::NUM_CELLS];
+	if(split == std::string::npos || second == std::string::npos ||
+			!parsePuzzleLine(line.data(), split, givens) ||
+			!parsePuzzleLine(line.data() + second, line.size() - second, grid)){
+		job.outcome = MALFORMED;
+		job.message = "line is not a one-line puzzle and solution";
+		return;
+	}
+
+	finish(job, verifySolution(grid, givens));
+}
+
+void tally(const std::vector<Job> & jobs, CheckReport & result,
+		std::ostream & report){
+	for(auto & job : jobs){
+		if(job.outcome == UNPAIRED){
+			++result.unpaired;
+			report << job.name << ": no solution file\n";
+			continue;
+		}
+
+		++result.checked;
+		switch(job.outcome){
+		case OK:
+			++result.valid;
+			break;
+		case MISMATCHED:
+			++result.mismatched;
+			report << job.name << ": mismatch: " << job.message << "\n";
+			break;
+		case MALFORMED:
+			++result.malformed;
+			report << job.name << ": malformed: " << job.message << "\n";
+			break;
+		case UNPAIRED:
+			break;
+		}
+	}
+}
+
+} // namespace
+
+CheckReport checkDirectory(const std::string & directory, int threads,
+		std::ostream & report){
+	DIR * dir = opendir(directory.c_str());
+	if(dir == nullptr){
+		std::ostringstream o;
+		o << "Could not read directory '" << directory << "': "
+				<< strerror(errno) << ".";
+		throw std::runtime_error(o.str());
+	}
+
+	// Puzzle files and solution files, by the part of the name before the dot.
+	std::map<std::string, std::vector<std::string> > puzzles;
+	std::map<std::string, std::string> solutions;
+
+	for(struct dirent * entry = readdir(dir); entry != nullptr;
+			entry = readdir(dir)){
+		std::string file(entry->d_name);
+		std::size_t dot = file.find('.');
+		if(file[0] == '.' || dot == std::string::npos ||
+				file.size() < 4 || file.compare(file.size() - 4, 4, ".txt") != 0)
+			continue;
+
+		std::string stem = file.substr(0, dot);
+		if(file.compare(dot, std::string::npos, ".soln.txt") == 0)
+			solutions[stem] = file;
+		else
+			puzzles[stem].push_back(file);
+	}
+	closedir(dir);
+
+	CheckReport result;
+	std::vector<Job> jobs;
+
+	for(auto & entry : puzzles){
+		std::sort(entry.second.begin(), entry.second.end());
+		auto solution = solutions.find(entry.first);
+		for(auto & file : entry.second){
+			Job job;
+			job.name = file;
+			job.puzzle = directory + "/" + file;
+			if(solution != solutions.end())
+				job.solution = directory + "/" + solution->second;
+			jobs.push_back(job);
+		}
+	}
+	for(auto & entry : solutions){
+		if(puzzles.count(entry.first) == 0){
+			++result.unpaired;
+			report << entry.second << ": no puzzle file\n";
+		}
+	}
+
+	runParallel(jobs.size(), threads,
+			[&jobs](int, std::size_t i){ checkFiles(jobs[i]); });
+	tally(jobs, result, report);
+	return result;
+}
+
+CheckReport checkBatchFile(int fd, const std::string & name, int threads,
+		std::ostream & report){
+	CheckReport result;
+	ChunkedReader reader(fd);
+	std::vector<Job> jobs;
+	const char * line;
+	std::size_t length;
+	uint64_t lineNumber = 0;
+	bool more = true;
+
+	while(more){
+		jobs.clear();
+		while(jobs.size() < BLOCK_SIZE &&
+				(more = reader.nextLine(line, length))){
+			++lineNumber;
+			if(length == 0)
+				continue;
+
+			std::ostringstream o;
+			o << name << ":" << lineNumber;
+			Job job;
+			job.name = o.str();
+			job.puzzle.assign(line, length);
+			jobs.push_back(job);
+		}
+
+		runParallel(jobs.size(), threads,
+				[&jobs](int, std::size_t i){ checkLine(jobs[i]); });
+		tally(jobs, result, report);
+	}
+
+	return result;
+}
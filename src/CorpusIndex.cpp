@@ -0,0 +1,248 @@
+/*
+ * CorpusIndex.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "CorpusIndex.h"
+#include "PuzzleIO.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const uint32_t INDEX_VERSION = 1;
+
+/* Magic, version, format, then four 64-bit fields. */
+const std::size_t INDEX_HEADER_SIZE = 8 + 4 + 4 + 4 * 8;
+
+/* Read sizes for building an index, which reads the whole file, and for
+ * locating a record, which reads at most a stride of records. */
+const std::size_t BUILD_CHUNK_SIZE = 1 << 20;
+const std::size_t LOCATE_CHUNK_SIZE = 1 << 16;
+
+/* Reads up to length bytes at offset; returns 0 at the end of the file. */
+std::size_t readAt(int fd, char * data, std::size_t length, uint64_t offset){
+	for(;;){
+		ssize_t count = pread(fd, data, length, static_cast<off_t>(offset));
+		if(count >= 0)
+			return static_cast<std::size_t>(count);
+		if(errno != EINTR)
+			throw std::runtime_error(errorMessage("Could not read puzzles"));
+	}
+}
+
+uint64_t getFileSize(int fd){
+	struct stat info;
+	if(fstat(fd, &info) != 0)
+		throw std::runtime_error(errorMessage("Could not read puzzles"));
+	return static_cast<uint64_t>(info.st_size);
+}
+
+/* Whether a line is blank as ChunkedReader returns it, without its newline
+ * and carriage return. */
+inline bool isBlank(uint64_t length, char last){
+	return length == 0 || (length == 1 && last == '\r');
+}
+
+/*
+ * Calls onRecord(offset) with the offset of each record of a text file, from
+ * the given offset on, which must be the start of a line, until onRecord()
+ * returns false or the file ends.
+ */
+template<typename OnRecord>
+void scanText(int fd, uint64_t from, std::size_t chunkSize,
+		OnRecord onRecord){
+	std::vector<char> buffer(chunkSize);
+	uint64_t position = from;
+	uint64_t lineStart = from;
+	uint64_t lineLength = 0;
+	char last = '\0';
+
+	for(;;){
+		std::size_t count = readAt(fd, &buffer[0], buffer.size(), position);
+		if(count == 0)
+			break;
+
+		const char * next = &buffer[0];
+		const char * end = next + count;
+		while(next < end){
+			const char * newline = static_cast<const char *>(
+					memchr(next, '\n', end - next));
+			const char * stop = newline != nullptr ? newline : end;
+			if(stop > next){
+				lineLength += stop - next;
+				last = stop[-1];
+			}
+			if(newline == nullptr)
+				break;
+
+			if(!isBlank(lineLength, last) && !onRecord(lineStart))
+				return;
+			lineStart = position + (newline - &buffer[0]) + 1;
+			lineLength = 0;
+			next = newline + 1;
+		}
+		position += count;
+	}
+
+	// The last line need not end with a newline.
+	if(!isBlank(lineLength, last))
+		onRecord(lineStart);
+}
+
+void put32(std::vector<char> & out, uint32_t value){
+	for(int i = 0; i < 4; ++i)
+		out.push_back(static_cast<char>(value >> (8 * i)));
+}
+
+void put64(std::vector<char> & out, uint64_t value){
+	for(int i = 0; i < 8; ++i)
+		out.push_back(static_cast<char>(value >> (8 * i)));
+}
+
+uint64_t get(const std::vector<char> & in, std::size_t at, int bytes){
+	uint64_t value = 0;
+	for(int i = 0; i < bytes; ++i)
+		value |= static_cast<uint64_t>(static_cast<uint8_t>(in[at + i])) <<
+				(8 * i);
+	return value;
+}
+
+/* First record of shard number shard, spreading the remainder over the first
+ * shards. */
+uint64_t shardStart(uint64_t records, uint64_t shard, uint64_t shards){
+	return records / shards * shard + std::min(shard, records % shards);
+}
+
+} // namespace
+
+const char INDEX_MAGIC[] = "SUDOKUIX";
+
+std::string getIndexPath(const std::string & path){
+	return path + ".idx";
+}
+
+CorpusIndex buildCorpusIndex(int fd, uint64_t stride){
+	if(stride == 0)
+		throw std::runtime_error("The index stride must be at least 1.");
+
+	CorpusIndex index;
+	index.format = detectCorpusFormat(fd);
+	index.fileSize = getFileSize(fd);
+	index.stride = stride;
+
+	if(index.format == BINARY_FORMAT){
+		// A partial record at the end is read as an invalid one.
+		uint64_t body = index.fileSize - BINARY_HEADER_SIZE;
+		index.records = (body + BINARY_RECORD_SIZE - 1) / BINARY_RECORD_SIZE;
+		for(uint64_t record = 0; record < index.records; record += stride)
+			index.offsets.push_back(
+					BINARY_HEADER_SIZE + record * BINARY_RECORD_SIZE);
+		return index;
+	}
+
+	scanText(fd, 0, BUILD_CHUNK_SIZE, [&index](uint64_t offset){
+		if(index.records % index.stride == 0)
+			index.offsets.push_back(offset);
+		++index.records;
+		return true;
+	});
+	return index;
+}
+
+void writeCorpusIndex(int fd, const CorpusIndex & index){
+	std::vector<char> out(INDEX_MAGIC, INDEX_MAGIC + 8);
+	put32(out, INDEX_VERSION);
+	put32(out, index.format == BINARY_FORMAT ? 1 : 0);
+	put64(out, index.fileSize);
+	put64(out, index.records);
+	put64(out, index.stride);
+	put64(out, index.offsets.size());
+	for(uint64_t offset : index.offsets)
+		put64(out, offset);
+
+	BoundedWriter writer(fd);
+	writer.write(&out[0], out.size());
+	writer.flush();
+}
+
+CorpusIndex readCorpusIndex(int fd){
+	std::vector<char> in;
+	char buffer[1 << 16];
+	for(;;){
+		ssize_t count = read(fd, buffer, sizeof(buffer));
+		if(count > 0)
+			in.insert(in.end(), buffer, buffer + count);
+		else if(count == 0)
+			break;
+		else if(errno != EINTR)
+			throw std::runtime_error(errorMessage("Could not read index"));
+	}
+
+	const std::runtime_error invalid("Not a valid puzzle index.");
+	if(in.size() < INDEX_HEADER_SIZE || memcmp(&in[0], INDEX_MAGIC, 8) != 0)
+		throw invalid;
+	if(get(in, 8, 4) != INDEX_VERSION)
+		throw std::runtime_error("Unsupported puzzle index version.");
+
+	CorpusIndex index;
+	uint64_t format = get(in, 12, 4);
+	index.format = format == 1 ? BINARY_FORMAT : TEXT_FORMAT;
+	index.fileSize = get(in, 16, 8);
+	index.records = get(in, 24, 8);
+	index.stride = get(in, 32, 8);
+	uint64_t count = get(in, 40, 8);
+	if(format > 1 || index.stride == 0 ||
+			count != index.records / index.stride +
+					(index.records % index.stride != 0) ||
+			(in.size() - INDEX_HEADER_SIZE) % 8 != 0 ||
+			count != (in.size() - INDEX_HEADER_SIZE) / 8)
+		throw invalid;
+
+	index.offsets.reserve(count);
+	for(uint64_t i = 0; i < count; ++i){
+		uint64_t offset = get(in, INDEX_HEADER_SIZE + i * 8, 8);
+		if(offset >= index.fileSize ||
+				(i > 0 && offset <= index.offsets.back()))
+			throw invalid;
+		index.offsets.push_back(offset);
+	}
+	return index;
+}
+
+uint64_t locateRecord(int fd, const CorpusIndex & index, uint64_t record){
+	if(record >= index.records)
+		return index.fileSize;
+	if(index.format == BINARY_FORMAT)
+		return BINARY_HEADER_SIZE + record * BINARY_RECORD_SIZE;
+
+	uint64_t skip = record % index.stride;
+	uint64_t found = index.offsets[record / index.stride];
+	scanText(fd, found, LOCATE_CHUNK_SIZE, [&found, &skip](uint64_t offset){
+		found = offset;
+		return skip-- > 0;
+	});
+	return found;
+}
+
+ShardRange locateShard(int fd, const CorpusIndex & index, uint64_t shard,
+		uint64_t shards){
+	if(shard >= shards)
+		throw std::runtime_error("No such shard.");
+	if(getFileSize(fd) != index.fileSize)
+		throw std::runtime_error(
+				"The puzzle index is out of date; build it again.");
+
+	ShardRange range;
+	range.firstRecord = shardStart(index.records, shard, shards);
+	range.endRecord = shardStart(index.records, shard + 1, shards);
+	range.beginOffset = locateRecord(fd, index, range.firstRecord);
+	range.endOffset = locateRecord(fd, index, range.endRecord);
+	return range;
+}
@@ -0,0 +1,181 @@
+/*
+ * Deduplicator.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Deduplicator.h"
+#include "Canonicalizer.h"
+#include "Parallel.h"
+#include "PuzzleIO.h"
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/* Number of lines canonicalized together. */
+const std::size_t BLOCK_SIZE = 1 << 16;
+
+/* Number of shards of the set; well above the number of threads, so that two
+ * threads rarely want the same lock. */
+const std::size_t NUM_SHARDS = 64;
+
+/* The puzzles of one class, by line number. */
+struct Group {
+	uint64_t first;
+	std::vector<uint64_t> others;
+};
+
+/* A hash set of canonical forms, split into shards with a lock each. */
+class ShardedGroupSet {
+public:
+	/* Adds the puzzle on the given line to the group of its form, and returns
+	 * the group, which stays where it is until the set is destroyed. */
+	Group * insert(const CanonicalKey & key, uint64_t line){
+		std::size_t hash = key.hash();
+		// The low bits pick the bucket within the shard.
+		Shard & shard = shards_[(hash >> 32) % NUM_SHARDS];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto inserted = shard.groups.emplace(key, Group());
+		Group & group = inserted.first->second;
+		if(inserted.second)
+			group.first = line;
+		else if(line < group.first){
+			group.others.push_back(group.first);
+			group.first = line;
+		}
+		else
+			group.others.push_back(line);
+		return &group;
+	}
+
+	/* Collects the groups with more than one puzzle, in order of their first
+	 * lines. Must not be called while puzzles are being inserted. */
+	std::vector<std::pair<const CanonicalKey *, Group *> > getDuplicates(){
+		std::vector<std::pair<const CanonicalKey *, Group *> > duplicates;
+		for(Shard & shard : shards_){
+			for(auto & entry : shard.groups){
+				if(!entry.second.others.empty())
+					duplicates.push_back(std::make_pair(&entry.first,
+							&entry.second));
+			}
+		}
+		std::sort(duplicates.begin(), duplicates.end(),
+				[](const std::pair<const CanonicalKey *, Group *> & a,
+				const std::pair<const CanonicalKey *, Group *> & b){
+			return a.second->first < b.second->first;
+		});
+		return duplicates;
+	}
+
+private:
+	struct Shard {
+		std::mutex mutex;
+		std::unordered_map<CanonicalKey, Group, CanonicalKeyHash> groups;
+	};
+
+	Shard shards_[NUM_SHARDS];
+};
+
+/* One line of the current block. */
+struct Record {
+	uint64_t line;
+	std::size_t offset;
+	std::size_t length;
+
+	/* The record's group, or null if the line is not a valid puzzle. */
+	Group * group;
+};
+
+void writeLineNumber(BoundedWriter & writer, uint64_t line){
+	std::string text = " " + std::to_string(line);
+	writer.write(text.data(), text.size());
+}
+
+} // namespace
+
+DedupReport dedupBatchFile(int inFd, int uniqueFd, int groupsFd, int threads){
+	threads = resolveThreads(threads);
+
+	DedupReport report;
+	ShardedGroupSet set;
+	std::vector<Canonicalizer> canonicalizers(threads);
+	ChunkedReader reader(inFd);
+	BoundedWriter unique(uniqueFd);
+	std::string text;
+	std::vector<Record> records;
+	const char * line;
+	std::size_t length;
+	uint64_t lineNumber = 0;
+	bool more = true;
+
+	while(more){
+		text.clear();
+		records.clear();
+		while(records.size() < BLOCK_SIZE &&
+				(more = reader.nextLine(line, length))){
+			++lineNumber;
+			if(length == 0)
+				continue;
+			Record record = {lineNumber, text.size(), length, nullptr};
+			records.push_back(record);
+			text.append(line, length);
+		}
+
+		runParallel(records.size(), threads,
+				[&](int thread, std::size_t i){
+			Record & record = records[i];
+			uint8_t givens[Board::NUM_CELLS];
+			uint8_t canonical[Board::NUM_CELLS];
+			if(!parsePuzzleLine(text.data() + record.offset, record.length,
+					givens))
+				return;
+			canonicalizers[thread].canonicalize(givens, canonical);
+			record.group = set.insert(CanonicalKey::pack(canonical),
+					record.line);
+		});
+
+		/* No later block has a smaller line number, so whether a record is
+		 * the first of its group is settled. */
+		for(const Record & record : records){
+			++report.records;
+			if(record.group == nullptr)
+				++report.invalid;
+			else if(record.group->first == record.line){
+				++report.unique;
+				unique.write(text.data() + record.offset, record.length);
+				unique.write("\n", 1);
+			}
+			else
+				++report.duplicates;
+		}
+	}
+	unique.flush();
+
+	BoundedWriter groups(groupsFd);
+	for(const auto & duplicate : set.getDuplicates()){
+		++report.groups;
+		uint8_t canonical[Board::NUM_CELLS];
+		char out[Board::NUM_CELLS];
+		duplicate.first->unpack(canonical);
+		for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+			out[cell] = canonical[cell] == 0 ? '#' :
+					static_cast<char>('0' + canonical[cell]);
+		groups.write(out, Board::NUM_CELLS);
+
+		Group & group = *duplicate.second;
+		std::sort(group.others.begin(), group.others.end());
+		writeLineNumber(groups, group.first);
+		for(uint64_t other : group.others)
+			writeLineNumber(groups, other);
+		groups.write("\n", 1);
+	}
+	groups.flush();
+
+	return report;
+}
@@ -0,0 +1,284 @@
+/*
+ * Difficulty.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Difficulty.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+/* Number of records rated together; rating takes tens of microseconds a
+ * puzzle, so this keeps every thread busy for a good while per block. */
+const std::size_t BLOCK_SIZE = 1 << 14;
+
+const char * const RATING_HEADER =
+		"# record\ttier\ttechnique\tsteps\tnodes\tbacktracks\tdepth\n";
+
+/* One record of the current block. */
+struct Record {
+	uint8_t givens[Board::NUM_CELLS];
+	bool valid;
+	DifficultyMetrics metrics;
+};
+
+/* A technique name with _ and - for spaces, as tiers and ratings write it. */
+std::string normalize(const std::string & name){
+	std::string normal(name);
+	std::replace(normal.begin(), normal.end(), ' ', '_');
+	std::replace(normal.begin(), normal.end(), '-', '_');
+	return normal;
+}
+
+Hint::Technique parseTechnique(const std::string & name){
+	for(int technique = Hint::NAKED_SINGLE; technique <= Hint::X_WING;
+			++technique){
+		Hint::Technique t = static_cast<Hint::Technique>(technique);
+		if(normalize(name) == normalize(Hint::getTechniqueName(t)))
+			return t;
+	}
+	throw std::invalid_argument("Unknown technique '" + name + "'.");
+}
+
+uint64_t parseBound(const std::string & key, const std::string & value){
+	char * end;
+	errno = 0;
+	unsigned long long bound = strtoull(value.c_str(), &end, 10);
+	if(value.empty() || *end != '\0' || errno != 0 || value[0] == '-')
+		throw std::invalid_argument("Bad " + key + " bound '" + value + "'.");
+	return bound;
+}
+
+/* Splits text at each separator. */
+std::vector<std::string> split(const std::string & text, char separator){
+	std::vector<std::string> parts;
+	std::size_t start = 0;
+	for(;;){
+		std::size_t end = text.find(separator, start);
+		parts.push_back(text.substr(start, end - start));
+		if(end == std::string::npos)
+			return parts;
+		start = end + 1;
+	}
+}
+
+/* Fills in the logical part of metrics, applying one hint at a time. */
+void solveByLogic(const uint8_t givens[Board::NUM_CELLS],
+		DifficultyMetrics & metrics){
+	uint8_t values[Board::NUM_CELLS];
+	uint16_t candidates[Board::NUM_CELLS];
+	int left = 0;
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		values[cell] = givens[cell];
+		candidates[cell] = givens[cell] != 0 ? 0 : Board::ALL_CANDIDATES;
+		left += givens[cell] == 0;
+	}
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		if(values[cell] == 0)
+			continue;
+		const int * peers = Board::getPeers(cell);
+		for(int i = 0; i < Board::NUM_PEERS; ++i)
+			candidates[peers[i]] &= ~Board::maskOf(values[cell]);
+	}
+
+	/* Every step sets a cell or removes a candidate, so there are at most as
+	 * many steps as candidates. */
+	Hint hint;
+	while(left > 0 && metrics.steps < Board::NUM_CELLS * Board::PUZZLE_SIZE &&
+			HintEngine::findHint(values, candidates, hint) &&
+			hint.technique != Hint::CONTRADICTION){
+		++metrics.steps;
+		metrics.hardest = std::max(metrics.hardest, hint.technique);
+		if(hint.cell >= 0){
+			values[hint.cell] = static_cast<uint8_t>(hint.value);
+			candidates[hint.cell] = 0;
+			--left;
+			const int * peers = Board::getPeers(hint.cell);
+			for(int i = 0; i < Board::NUM_PEERS; ++i)
+				candidates[peers[i]] &= ~Board::maskOf(hint.value);
+		}
+		else{
+			for(int cell = hint.targets.first(); cell >= 0;
+					cell = hint.targets.next(cell))
+				candidates[cell] &= ~hint.removed;
+		}
+	}
+	metrics.solvedByLogic = left == 0;
+}
+
+const char * getStatusName(DifficultyMetrics::Status status){
+	switch(status){
+	case DifficultyMetrics::RATED:
+		return "rated";
+	case DifficultyMetrics::INVALID:
+		return "invalid";
+	case DifficultyMetrics::UNSOLVABLE:
+		return "unsolvable";
+	case DifficultyMetrics::MULTIPLE:
+		return "multiple";
+	case DifficultyMetrics::TIMED_OUT:
+		return "timed-out";
+	}
+	return "unknown";
+}
+
+} // namespace
+
+const char DEFAULT_TIERS[] = "ve:technique=hidden_single,"
+		"e:technique=claiming,m:technique=x_wing,d:nodes=1000,vd";
+
+std::vector<DifficultyTier> parseTiers(const std::string & text){
+	std::vector<DifficultyTier> tiers;
+	for(const std::string & spec : split(text, ',')){
+		std::vector<std::string> fields = split(spec, ':');
+		DifficultyTier tier;
+		tier.name = fields[0];
+		if(tier.name.empty() ||
+				tier.name.find_first_of(" \t\n") != std::string::npos)
+			throw std::invalid_argument("Bad tier name '" + tier.name + "'.");
+
+		for(std::size_t i = 1; i < fields.size(); ++i){
+			std::size_t equals = fields[i].find('=');
+			std::string key = fields[i].substr(0, equals);
+			std::string value = equals == std::string::npos ? "" :
+					fields[i].substr(equals + 1);
+			if(key == "technique"){
+				tier.needsLogic = true;
+				tier.maxTechnique = parseTechnique(value);
+			}
+			else if(key == "steps")
+				tier.maxSteps = static_cast<int>(std::min<uint64_t>(
+						parseBound(key, value), INT32_MAX));
+			else if(key == "nodes")
+				tier.maxNodes = parseBound(key, value);
+			else if(key == "depth")
+				tier.maxDepth = static_cast<int>(std::min<uint64_t>(
+						parseBound(key, value), INT32_MAX));
+			else
+				throw std::invalid_argument("Unknown tier bound '" + fields[i]
+						+ "'.");
+		}
+		tiers.push_back(tier);
+	}
+	return tiers;
+}
+
+DifficultyMetrics measureDifficulty(const uint8_t givens[Board::NUM_CELLS],
+		Solver & solver){
+	DifficultyMetrics metrics;
+	Board board;
+	if(!board.load(givens)){
+		metrics.status = DifficultyMetrics::UNSOLVABLE;
+		return metrics;
+	}
+
+	uint64_t count = solver.countSolutions(board, 2);
+	const Solver::Stats & stats = solver.getStats();
+	metrics.nodes = stats.nodes;
+	metrics.backtracks = stats.backtracks;
+	metrics.depth = stats.maxDepth;
+	if(count == 2)
+		metrics.status = DifficultyMetrics::MULTIPLE;
+	else if(stats.timedOut || stats.cancelled)
+		metrics.status = DifficultyMetrics::TIMED_OUT;
+	else if(count == 0)
+		metrics.status = DifficultyMetrics::UNSOLVABLE;
+	else{
+		metrics.status = DifficultyMetrics::RATED;
+		solveByLogic(givens, metrics);
+	}
+	return metrics;
+}
+
+int findTier(const DifficultyMetrics & metrics,
+		const std::vector<DifficultyTier> & tiers){
+	for(std::size_t i = 0; i < tiers.size(); ++i){
+		const DifficultyTier & tier = tiers[i];
+		if(tier.needsLogic && (!metrics.solvedByLogic ||
+				metrics.hardest > tier.maxTechnique))
+			continue;
+		if(metrics.steps > tier.maxSteps || metrics.nodes > tier.maxNodes ||
+				metrics.depth > tier.maxDepth)
+			continue;
+		return static_cast<int>(i);
+	}
+	return -1;
+}
+
+RatingReport rateCorpus(int inFd, CorpusFormat format, int outFd,
+		const std::vector<DifficultyTier> & tiers, int threads,
+		const Solver::Limits & limits, LatencyHistogram * latency){
+	threads = resolveThreads(threads);
+
+	std::vector<std::unique_ptr<Solver> > solvers;
+	for(int i = 0; i < threads; ++i){
+		solvers.push_back(std::unique_ptr<Solver>(new Solver()));
+		solvers.back()->setLimits(limits);
+	}
+
+	RatingReport report;
+	report.tiers.assign(tiers.size(), 0);
+	CorpusReader reader(inFd, format);
+	BoundedWriter writer(outFd);
+	writer.write(RATING_HEADER, strlen(RATING_HEADER));
+	std::vector<Record> block(BLOCK_SIZE);
+	bool more = true;
+
+	while(more){
+		std::size_t count = 0;
+		while(count < block.size() &&
+				(more = reader.next(block[count].givens, block[count].valid)))
+			++count;
+
+		runParallel(count, threads, [&](int thread, std::size_t i){
+			Record & record = block[i];
+			record.metrics = DifficultyMetrics();
+			if(!record.valid)
+				return;
+			auto start = std::chrono::steady_clock::now();
+			record.metrics = measureDifficulty(record.givens, *solvers[thread]);
+			if(latency != nullptr)
+				latency->record(std::chrono::steady_clock::now() - start);
+		});
+
+		for(std::size_t i = 0; i < count; ++i){
+			const DifficultyMetrics & metrics = block[i].metrics;
+			++report.statuses[metrics.status];
+			std::string label = getStatusName(metrics.status);
+			std::string technique = "-";
+			if(metrics.status == DifficultyMetrics::RATED){
+				int tier = findTier(metrics, tiers);
+				if(tier < 0){
+					++report.untiered;
+					label = "untiered";
+				}
+				else{
+					++report.tiers[tier];
+					label = tiers[tier].name;
+				}
+				technique = metrics.solvedByLogic ?
+						normalize(Hint::getTechniqueName(metrics.hardest)) :
+						"search";
+			}
+
+			std::string line = std::to_string(report.records++) + "\t" +
+					label + "\t" + technique + "\t" +
+					std::to_string(metrics.steps) + "\t" +
+					std::to_string(metrics.nodes) + "\t" +
+					std::to_string(metrics.backtracks) + "\t" +
+					std::to_string(metrics.depth) + "\n";
+			writer.write(line.data(), line.size());
+		}
+	}
+	writer.flush();
+	return report;
+}
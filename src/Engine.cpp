@@ -0,0 +1,91 @@
+/*
+ * Engine.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Engine.h"
+#include "SatSolver.h"
+
+namespace {
+
+/* The Solver, as it is. */
+class BacktrackEngine : public Engine {
+public:
+	BacktrackEngine() : solver_(new Solver()) {}
+
+	Solver::Status solve(Board & board){
+		return solver_->solve(board);
+	}
+
+	void setLimits(const Solver::Limits & limits){
+		solver_->setLimits(limits);
+	}
+
+	uint64_t getNodes() const {
+		return solver_->getStats().nodes;
+	}
+
+	std::string getName() const { return "backtrack"; }
+
+private:
+	std::unique_ptr<Solver> solver_;
+};
+
+/* Solves the Board as a CNF formula, decoding the model into the solution. */
+class SatEngine : public Engine {
+public:
+	Solver::Status solve(Board & board){
+		solver_.load(encodeSudoku(board));
+		CdclSolver::Result result = solver_.solve(limits_);
+		if(result == CdclSolver::UNSATISFIABLE)
+			return Solver::UNSOLVABLE;
+		if(result == CdclSolver::UNKNOWN){
+			return limits_.cancel != nullptr && limits_.cancel->load() ?
+					Solver::CANCELLED : Solver::TIMED_OUT;
+		}
+
+		Board solution = board;
+		for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+			for(int value = 1; value <= Board::PUZZLE_SIZE; ++value){
+				if(solver_.getValue(getSatVariable(cell, value)) &&
+						!solution.assign(cell, value))
+					return Solver::UNSOLVABLE;
+			}
+		}
+		board = solution;
+		return Solver::SOLVED;
+	}
+
+	void setLimits(const Solver::Limits & limits){
+		limits_ = limits;
+	}
+
+	uint64_t getNodes() const {
+		return solver_.getStats().decisions;
+	}
+
+	std::string getName() const { return "sat"; }
+
+private:
+	CdclSolver solver_;
+	Solver::Limits limits_;
+};
+
+const char * const ENGINE_NAMES[] = {"backtrack", "sat", nullptr};
+
+} // namespace
+
+const char * const * getEngineNames(){
+	return ENGINE_NAMES;
+}
+
+std::unique_ptr<Engine> makeEngine(const std::string & name){
+	std::unique_ptr<Engine> engine;
+	if(name == "backtrack")
+		engine.reset(new BacktrackEngine());
+	else if(name == "sat")
+		engine.reset(new SatEngine());
+	return engine;
+}
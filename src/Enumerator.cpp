@@ -0,0 +1,224 @@
+/*
+ * Enumerator.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Enumerator.h"
+#include "Propagator.h"
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/* The clock is read once every this many nodes; a node takes well under a
+ * microsecond, so the run overshoots its budget by very little. */
+const uint64_t TIME_CHECK_NODES = 256;
+
+void throwMismatch(){
+	throw std::invalid_argument("Checkpoint does not fit the puzzle.");
+}
+
+} // namespace
+
+std::string Enumerator::Checkpoint::toString() const {
+	std::string text = heuristic + " " + std::to_string(solutions) + " ";
+	if(finished)
+		text += "done";
+	else if(path.empty())
+		text += "start";
+	else{
+		for(uint8_t next : path)
+			text += static_cast<char>('0' + next);
+	}
+	return text;
+}
+
+Enumerator::Checkpoint Enumerator::Checkpoint::fromString(
+		const std::string & text){
+	std::istringstream in(text);
+	Checkpoint checkpoint;
+	std::string pathText;
+	std::string rest;
+	if(!(in >> checkpoint.heuristic >> checkpoint.solutions >> pathText) ||
+			in >> rest)
+		throw std::invalid_argument("Invalid checkpoint '" + text + "'.");
+
+	if(pathText == "done")
+		checkpoint.finished = true;
+	else if(pathText != "start"){
+		for(char c : pathText){
+			if(c < '0' || c > '9')
+				throw std::invalid_argument("Invalid checkpoint '" + text +
+						"'.");
+			checkpoint.path.push_back(static_cast<uint8_t>(c - '0'));
+		}
+	}
+
+	return checkpoint;
+}
+
+Enumerator::Enumerator(const Options & options) :
+		options_(options),
+		heuristic_(makeHeuristic("mrv"))
+{}
+
+void Enumerator::setHeuristic(std::unique_ptr<Heuristic> heuristic){
+	heuristic_ = heuristic ? std::move(heuristic) : makeHeuristic("mrv");
+}
+
+Enumerator::Status Enumerator::enumerate(const Board & board,
+		const Callback & callback){
+	return resume(board, Checkpoint(), callback);
+}
+
+Enumerator::Status Enumerator::resume(const Board & board,
+		const Checkpoint & checkpoint, const Callback & callback){
+	std::string heuristic = heuristic_->getName();
+	if(!checkpoint.path.empty() && checkpoint.heuristic != heuristic)
+		throw std::invalid_argument("Checkpoint was made with heuristic '" +
+				checkpoint.heuristic + "', not '" + heuristic + "'.");
+	if(checkpoint.path.size() > static_cast<std::size_t>(Board::NUM_CELLS))
+		throwMismatch();
+
+	// checkpoint may be checkpoint_ itself.
+	std::vector<uint8_t> path = checkpoint.path;
+	checkpoint_ = checkpoint;
+	checkpoint_.heuristic = heuristic;
+	stats_ = Stats();
+
+	if(checkpoint_.finished)
+		return EXHAUSTED;
+	if(options_.limit == 0)
+		return LIMIT_REACHED;
+
+	Status status = EXHAUSTED;
+	int depth = start(board, path, callback, status);
+	if(depth >= 0)
+		status = run(depth, callback);
+
+	// A search over in start() has nothing left to resume, even if stopped.
+	checkpoint_.path.clear();
+	checkpoint_.finished = status == EXHAUSTED || depth < 0;
+	if(!checkpoint_.finished){
+		for(int i = 0; i <= depth; ++i)
+			checkpoint_.path.push_back(static_cast<uint8_t>(frames_[i].next));
+	}
+	return status;
+}
+
+int Enumerator::start(const Board & board, const std::vector<uint8_t> & path,
+		const Callback & callback, Status & status){
+	stats_.nodes = 1;
+	frames_[0].board = board;
+	if(!Propagator::propagate(frames_[0].board)){
+		if(!path.empty())
+			throwMismatch();
+		return -1;
+	}
+
+	if(frames_[0].board.isSolved()){
+		if(!path.empty())
+			throwMismatch();
+		++stats_.solutions;
+		++checkpoint_.solutions;
+		if(!callback(frames_[0].board))
+			status = STOPPED;
+		return -1;
+	}
+
+	frames_[0].board.refreshBuckets();
+	heuristic_->chooseBranch(frames_[0].board, frames_[0].branch);
+	frames_[0].next = 0;
+	if(path.empty())
+		return 0;
+
+	/* Go back down the path: every level but the last is inside the
+	 * alternative before its next one. */
+	for(int depth = 0; ; ++depth){
+		Frame & frame = frames_[depth];
+		if(path[depth] > frame.branch.count)
+			throwMismatch();
+		frame.next = path[depth];
+		if(depth + 1 == static_cast<int>(path.size()))
+			return depth;
+
+		if(frame.next == 0)
+			throwMismatch();
+		int alternative = frame.next - 1;
+		Frame & next = frames_[depth + 1];
+		next.board = frame.board;
+		++stats_.nodes;
+
+		if(!next.board.assign(frame.branch.cells[alternative],
+				frame.branch.values[alternative]) ||
+				!Propagator::propagate(next.board) || next.board.isSolved())
+			throwMismatch();
+
+		next.board.refreshBuckets();
+		heuristic_->chooseBranch(next.board, next.branch);
+	}
+}
+
+Enumerator::Status Enumerator::run(int & depth, const Callback & callback){
+	typedef std::chrono::steady_clock Clock;
+	bool timed = options_.timeBudget != Clock::duration::zero();
+	Clock::time_point deadline;
+	if(timed)
+		deadline = Clock::now() + options_.timeBudget;
+	uint64_t found = 0;
+
+	/* On stopping, depth is left at the deepest level still to finish, so
+	 * the levels up to it make the checkpoint. */
+	while(depth >= 0){
+		Frame & frame = frames_[depth];
+
+		// Every alternative of this level has been tried; go back up.
+		if(frame.next == frame.branch.count){
+			--depth;
+			continue;
+		}
+
+		if(found == options_.limit)
+			return LIMIT_REACHED;
+		if(timed && stats_.nodes % TIME_CHECK_NODES == 0 &&
+				Clock::now() >= deadline)
+			return OUT_OF_TIME;
+
+		int alternative = frame.next++;
+		Frame & next = frames_[depth + 1];
+		next.board = frame.board;
+		++stats_.nodes;
+
+		if(!next.board.assign(frame.branch.cells[alternative],
+				frame.branch.values[alternative]) ||
+				!Propagator::propagate(next.board))
+			continue;
+
+		if(next.board.isSolved()){
+			++found;
+			++stats_.solutions;
+			++checkpoint_.solutions;
+			if(!callback(next.board))
+				return STOPPED;
+			continue;
+		}
+
+		next.board.refreshBuckets();
+		heuristic_->chooseBranch(next.board, next.branch);
+		next.next = 0;
+		++depth;
+	}
+
+	return EXHAUSTED;
+}
+
+const Enumerator::Checkpoint & Enumerator::getCheckpoint() const {
+	return checkpoint_;
+}
+
+const Enumerator::Stats & Enumerator::getStats() const {
+	return stats_;
+}
@@ -0,0 +1,235 @@
+/*
+ * Heuristics.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Heuristics.h"
+#include "Propagator.h"
+#include <utility>
+
+void Branch::setCell(const Board & board, int cell){
+	count = 0;
+	uint16_t candidates = board.getCandidates(cell);
+	while(candidates != 0){
+		cells[count] = cell;
+		values[count] = static_cast<uint8_t>(Board::lowestValue(candidates));
+		++count;
+		candidates &= candidates - 1;
+	}
+}
+
+void Branch::setUnitValue(const Board & board, int unit, int value){
+	count = 0;
+	const int * unitCells = Board::getUnit(unit);
+	for(int i = 0; i < Board::PUZZLE_SIZE; ++i){
+		if(board.getCandidates(unitCells[i]) & Board::maskOf(value)){
+			cells[count] = unitCells[i];
+			values[count] = static_cast<uint8_t>(value);
+			++count;
+		}
+	}
+}
+
+namespace {
+
+/* The first unset cell, as a naive backtracker would choose. */
+class IndexHeuristic : public Heuristic {
+public:
+	void chooseBranch(const Board & board, Branch & branch){
+		int cell = 0;
+		while(board.getValue(cell) != 0)
+			++cell;
+		branch.setCell(board, cell);
+	}
+
+	std::string getName() const { return "index"; }
+};
+
+/* Minimum remaining values, from the Board's candidate-count buckets. */
+class MrvHeuristic : public Heuristic {
+public:
+	void chooseBranch(const Board & board, Branch & branch){
+		branch.setCell(board, board.findFewestCandidates());
+	}
+
+	std::string getName() const { return "mrv"; }
+};
+
+/* Minimum remaining values, breaking ties by the number of unset peers. */
+class DegreeHeuristic : public Heuristic {
+public:
+	void chooseBranch(const Board & board, Branch & branch){
+		branch.setCell(board, chooseCell(board));
+	}
+
+	std::string getName() const { return "degree"; }
+
+protected:
+	static int chooseCell(const Board & board){
+		int count = 2;
+		while(board.getCellsWithCount(count).isEmpty())
+			++count;
+
+		const CellSet & cells = board.getCellsWithCount(count);
+		int best = -1;
+		int bestDegree = -1;
+		for(int cell = cells.first(); cell >= 0; cell = cells.next(cell)){
+			const int * peers = Board::getPeers(cell);
+			int degree = 0;
+			for(int i = 0; i < Board::NUM_PEERS; ++i)
+				degree += board.getValue(peers[i]) == 0;
+			if(degree > bestDegree){
+				best = cell;
+				bestDegree = degree;
+			}
+		}
+		return best;
+	}
+};
+
+/* As DegreeHeuristic, but branches on a value with two places left in a unit
+ * when the chosen cell has more than two candidates. */
+class UnitHeuristic : public DegreeHeuristic {
+public:
+	void chooseBranch(const Board & board, Branch & branch){
+		int cell = chooseCell(board);
+		if(Board::countCandidates(board.getCandidates(cell)) > 2){
+			uint16_t masks[Board::PUZZLE_SIZE];
+			for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+				uint16_t placed = Propagator::gatherUnit(board, unit, masks);
+				uint16_t twice = scanUnit(masks).exactlyTwice & ~placed;
+				if(twice != 0){
+					branch.setUnitValue(board, unit, Board::lowestValue(twice));
+					return;
+				}
+			}
+		}
+		branch.setCell(board, cell);
+	}
+
+	std::string getName() const { return "unit"; }
+};
+
+/* Least constraining value: reorders another heuristic's alternatives so that
+ * those removing the fewest candidates from peers come first. */
+class LcvHeuristic : public Heuristic {
+public:
+	explicit LcvHeuristic(std::unique_ptr<Heuristic> inner) :
+			inner_(std::move(inner)) {}
+
+	void chooseBranch(const Board & board, Branch & branch){
+		inner_->chooseBranch(board, branch);
+
+		int cost[Board::PUZZLE_SIZE];
+		for(int i = 0; i < branch.count; ++i){
+			const int * peers = Board::getPeers(branch.cells[i]);
+			uint16_t mask = Board::maskOf(branch.values[i]);
+			cost[i] = 0;
+			for(int j = 0; j < Board::NUM_PEERS; ++j)
+				cost[i] += (board.getCandidates(peers[j]) & mask) != 0;
+		}
+
+		// Insertion sort, which is stable and quick for so few alternatives.
+		for(int i = 1; i < branch.count; ++i){
+			int c = cost[i];
+			int cell = branch.cells[i];
+			uint8_t value = branch.values[i];
+			int j = i;
+			for(; j > 0 && cost[j - 1] > c; --j){
+				cost[j] = cost[j - 1];
+				branch.cells[j] = branch.cells[j - 1];
+				branch.values[j] = branch.values[j - 1];
+			}
+			cost[j] = c;
+			branch.cells[j] = cell;
+			branch.values[j] = value;
+		}
+	}
+
+	void restart(uint64_t seed){ inner_->restart(seed); }
+
+	std::string getName() const { return inner_->getName() + "+lcv"; }
+
+private:
+	std::unique_ptr<Heuristic> inner_;
+};
+
+/* Shuffles another heuristic's alternatives, seeded anew on each restart. */
+class RandomHeuristic : public Heuristic {
+public:
+	explicit RandomHeuristic(std::unique_ptr<Heuristic> inner) :
+			inner_(std::move(inner)), state_(DEFAULT_SEED) {}
+
+	void chooseBranch(const Board & board, Branch & branch){
+		inner_->chooseBranch(board, branch);
+
+		for(int i = branch.count - 1; i > 0; --i){
+			int j = static_cast<int>(nextRandom() % (i + 1));
+			std::swap(branch.cells[i], branch.cells[j]);
+			std::swap(branch.values[i], branch.values[j]);
+		}
+	}
+
+	void restart(uint64_t seed){
+		state_ = seed != 0 ? seed : uint64_t(DEFAULT_SEED);
+		inner_->restart(seed);
+	}
+
+	std::string getName() const { return inner_->getName() + "+random"; }
+
+private:
+	static const uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ull;
+
+	// xorshift64*: small and fast, which is all a shuffle needs.
+	uint64_t nextRandom(){
+		state_ ^= state_ >> 12;
+		state_ ^= state_ << 25;
+		state_ ^= state_ >> 27;
+		return state_ * 0x2545F4914F6CDD1Dull;
+	}
+
+	std::unique_ptr<Heuristic> inner_;
+	uint64_t state_;
+};
+
+const char * const HEURISTIC_NAMES[] = {
+	"index", "mrv", "degree", "unit", "mrv+lcv", "degree+lcv", "unit+lcv",
+	"degree+random", nullptr
+};
+
+} // namespace
+
+const char * const * getHeuristicNames(){
+	return HEURISTIC_NAMES;
+}
+
+std::unique_ptr<Heuristic> makeHeuristic(const std::string & name){
+	std::string base = name.substr(0, name.find('+'));
+	std::string modifiers = base.size() < name.size() ?
+			name.substr(base.size()) : std::string();
+
+	std::unique_ptr<Heuristic> heuristic;
+	if(base == "index")
+		heuristic.reset(new IndexHeuristic());
+	else if(base == "mrv")
+		heuristic.reset(new MrvHeuristic());
+	else if(base == "degree")
+		heuristic.reset(new DegreeHeuristic());
+	else if(base == "unit")
+		heuristic.reset(new UnitHeuristic());
+	else
+		return nullptr;
+
+	if(modifiers.compare(0, 4, "+lcv") == 0){
+		heuristic.reset(new LcvHeuristic(std::move(heuristic)));
+		modifiers.erase(0, 4);
+	}
+	if(modifiers == "+random")
+		heuristic.reset(new RandomHeuristic(std::move(heuristic)));
+	else if(!modifiers.empty())
+		return nullptr;
+
+	return heuristic;
+}
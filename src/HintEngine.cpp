@@ -0,0 +1,488 @@
+/*
+ * HintEngine.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "HintEngine.h"
+#include "Propagator.h"
+#include "Puzzle.h"
+
+namespace {
+
+const int SIZE = Board::PUZZLE_SIZE;
+const int BOX = Board::BOX_SIZE;
+const int FIRST_COL_UNIT = SIZE;
+const int FIRST_BOX_UNIT = 2 * SIZE;
+
+/* The grid as the techniques see it: set cells have no candidates, and the
+ * values placed in each unit are gathered once. */
+struct Grid {
+	uint16_t masks[Board::NUM_CELLS];
+	uint16_t placed[Board::NUM_UNITS];
+};
+
+void startHint(Hint & hint, Hint::Technique technique, int unit){
+	hint.technique = technique;
+	hint.unit = unit;
+	hint.cell = -1;
+	hint.value = 0;
+	hint.numCells = 0;
+	hint.targets = CellSet();
+	hint.removed = 0;
+}
+
+void addCell(Hint & hint, int cell){
+	int i = hint.numCells++;
+	for(; i > 0 && hint.cells[i - 1] > cell; --i)
+		hint.cells[i] = hint.cells[i - 1];
+	hint.cells[i] = static_cast<uint8_t>(cell);
+}
+
+void setSingle(Hint & hint, Hint::Technique technique, int unit, int cell,
+		int value){
+	startHint(hint, technique, unit);
+	hint.cell = cell;
+	hint.value = value;
+	addCell(hint, cell);
+}
+
+/* Adds to targets the cells of the unit, other than those in skip, that have
+ * any of the values in mask. Returns whether it added any. */
+bool collectTargets(const Grid & grid, int unit, const CellSet & skip,
+		uint16_t mask, CellSet & targets){
+	bool any = false;
+	const int * cells = Board::getUnit(unit);
+	for(int i = 0; i < SIZE; ++i){
+		int cell = cells[i];
+		if(!skip.contains(cell) && (grid.masks[cell] & mask) != 0){
+			targets.insert(cell);
+			any = true;
+		}
+	}
+	return any;
+}
+
+bool findContradiction(const uint8_t values[Board::NUM_CELLS],
+		const Grid & grid, Hint & hint){
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		if(values[cell] == 0 && grid.masks[cell] == 0){
+			setSingle(hint, Hint::CONTRADICTION, -1, cell, 0);
+			return true;
+		}
+	}
+
+	for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+		const int * cells = Board::getUnit(unit);
+		uint16_t seen = 0;
+		uint16_t candidates = 0;
+		for(int i = 0; i < SIZE; ++i){
+			int cell = cells[i];
+			candidates |= grid.masks[cell];
+			if(values[cell] == 0)
+				continue;
+
+			// A value placed twice in the unit.
+			uint16_t mask = Board::maskOf(values[cell]);
+			if((seen & mask) != 0){
+				startHint(hint, Hint::CONTRADICTION, unit);
+				hint.value = values[cell];
+				for(int j = 0; j <= i; ++j){
+					if(values[cells[j]] == values[cell])
+						addCell(hint, cells[j]);
+				}
+				return true;
+			}
+			seen |= mask;
+		}
+
+		// A value with no place left in the unit.
+		uint16_t missing = Board::ALL_CANDIDATES & ~(seen | candidates);
+		if(missing != 0){
+			startHint(hint, Hint::CONTRADICTION, unit);
+			hint.value = Board::lowestValue(missing);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool findNakedSingle(const Grid & grid, Hint & hint){
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		uint16_t mask = grid.masks[cell];
+		if(mask != 0 && (mask & (mask - 1)) == 0){
+			setSingle(hint, Hint::NAKED_SINGLE, -1, cell,
+					Board::lowestValue(mask));
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Boxes first, as a hidden single in a box is the easiest to spot. */
+bool findHiddenSingle(const Grid & grid, Hint & hint){
+	for(int i = 0; i < Board::NUM_UNITS; ++i){
+		int unit = (i + FIRST_BOX_UNIT) % Board::NUM_UNITS;
+		const int * cells = Board::getUnit(unit);
+		uint16_t masks[SIZE];
+		for(int j = 0; j < SIZE; ++j)
+			masks[j] = grid.masks[cells[j]];
+
+		uint16_t singles = scanUnit(masks).exactlyOnce & ~grid.placed[unit];
+		if(singles == 0)
+			continue;
+
+		int value = Board::lowestValue(singles);
+		uint16_t mask = Board::maskOf(value);
+		for(int j = 0; j < SIZE; ++j){
+			if((masks[j] & mask) != 0){
+				setSingle(hint, Hint::HIDDEN_SINGLE, unit, cells[j], value);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/* Returns the cells of the unit that have the value in mask as a candidate,
+ * adding them to hint too if it is not null. */
+CellSet cellsWith(const Grid & grid, int unit, uint16_t mask, Hint * hint){
+	CellSet cells;
+	const int * unitCells = Board::getUnit(unit);
+	for(int i = 0; i < SIZE; ++i){
+		if((grid.masks[unitCells[i]] & mask) != 0){
+			cells.insert(unitCells[i]);
+			if(hint != nullptr)
+				addCell(*hint, unitCells[i]);
+		}
+	}
+	return cells;
+}
+
+/* Returns the values that are candidates of only one of the three masks. */
+uint16_t onlyIn(const uint16_t masks[BOX], int i){
+	return masks[i] & ~(masks[(i + 1) % BOX] | masks[(i + 2) % BOX]);
+}
+
+bool findPointing(const Grid & grid, Hint & hint){
+	for(int box = 0; box < SIZE; ++box){
+		int unit = FIRST_BOX_UNIT + box;
+		const int * cells = Board::getUnit(unit);
+
+		// Candidates of each row and column of the box.
+		uint16_t rows[BOX] = {0, 0, 0};
+		uint16_t cols[BOX] = {0, 0, 0};
+		for(int i = 0; i < SIZE; ++i){
+			rows[i / BOX] |= grid.masks[cells[i]];
+			cols[i % BOX] |= grid.masks[cells[i]];
+		}
+
+		for(int i = 0; i < 2 * BOX; ++i){
+			bool isRow = i < BOX;
+			int line = isRow ? Board::rowOf(cells[i * BOX]) :
+					FIRST_COL_UNIT + Board::colOf(cells[i - BOX]);
+			uint16_t confined = isRow ? onlyIn(rows, i) : onlyIn(cols, i - BOX);
+			for(; confined != 0; confined &= confined - 1){
+				uint16_t mask = static_cast<uint16_t>(confined & -confined);
+				CellSet inBox = cellsWith(grid, unit, mask, nullptr);
+				CellSet targets;
+				if(collectTargets(grid, line, inBox, mask, targets)){
+					startHint(hint, Hint::POINTING, unit);
+					hint.value = Board::lowestValue(mask);
+					cellsWith(grid, unit, mask, &hint);
+					hint.targets = targets;
+					hint.removed = mask;
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool findClaiming(const Grid & grid, Hint & hint){
+	for(int unit = 0; unit < FIRST_BOX_UNIT; ++unit){
+		const int * cells = Board::getUnit(unit);
+
+		// A line's cells come in box order, three to a box.
+		uint16_t segments[BOX] = {0, 0, 0};
+		for(int i = 0; i < SIZE; ++i)
+			segments[i / BOX] |= grid.masks[cells[i]];
+
+		for(int i = 0; i < BOX; ++i){
+			int box = FIRST_BOX_UNIT + Board::boxOf(cells[i * BOX]);
+			for(uint16_t confined = onlyIn(segments, i); confined != 0;
+					confined &= confined - 1){
+				uint16_t mask = static_cast<uint16_t>(confined & -confined);
+				CellSet inLine = cellsWith(grid, unit, mask, nullptr);
+				CellSet targets;
+				if(collectTargets(grid, box, inLine, mask, targets)){
+					startHint(hint, Hint::CLAIMING, unit);
+					hint.value = Board::lowestValue(mask);
+					cellsWith(grid, unit, mask, &hint);
+					hint.targets = targets;
+					hint.removed = mask;
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+/* Checks whether the given cells of a unit have between them as many
+ * candidates as there are cells, and other cells of the unit have some of
+ * them. */
+bool checkNakedSubset(const Grid & grid, int unit, const int * subset,
+		int count, Hint::Technique technique, Hint & hint){
+	uint16_t mask = 0;
+	CellSet cells;
+	for(int i = 0; i < count; ++i){
+		mask |= grid.masks[subset[i]];
+		cells.insert(subset[i]);
+	}
+	if(Board::countCandidates(mask) != count)
+		return false;
+
+	CellSet targets;
+	if(!collectTargets(grid, unit, cells, mask, targets))
+		return false;
+
+	startHint(hint, technique, unit);
+	for(int i = 0; i < count; ++i)
+		addCell(hint, subset[i]);
+	hint.targets = targets;
+	hint.removed = mask;
+	return true;
+}
+
+bool findNakedPair(const Grid & grid, Hint & hint){
+	for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+		const int * cells = Board::getUnit(unit);
+		for(int a = 0; a < SIZE; ++a){
+			if(Board::countCandidates(grid.masks[cells[a]]) != 2)
+				continue;
+			for(int b = a + 1; b < SIZE; ++b){
+				int subset[2] = {cells[a], cells[b]};
+				if(grid.masks[cells[b]] == grid.masks[cells[a]] &&
+						checkNakedSubset(grid, unit, subset, 2,
+						Hint::NAKED_PAIR, hint))
+					return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool findNakedTriple(const Grid & grid, Hint & hint){
+	for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+		const int * cells = Board::getUnit(unit);
+
+		// Cells with two or three candidates.
+		int members[SIZE];
+		int numMembers = 0;
+		for(int i = 0; i < SIZE; ++i){
+			int count = Board::countCandidates(grid.masks[cells[i]]);
+			if(count == 2 || count == 3)
+				members[numMembers++] = cells[i];
+		}
+
+		for(int a = 0; a < numMembers; ++a){
+			for(int b = a + 1; b < numMembers; ++b){
+				for(int c = b + 1; c < numMembers; ++c){
+					int subset[3] = {members[a], members[b], members[c]};
+					if(checkNakedSubset(grid, unit, subset, 3,
+							Hint::NAKED_TRIPLE, hint))
+						return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool findHiddenPair(const Grid & grid, Hint & hint){
+	for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+		const int * cells = Board::getUnit(unit);
+		uint16_t masks[SIZE];
+		for(int i = 0; i < SIZE; ++i)
+			masks[i] = grid.masks[cells[i]];
+		uint16_t twice = scanUnit(masks).exactlyTwice & ~grid.placed[unit];
+
+		// The two places of each value, as bits of the unit's positions.
+		uint16_t places[SIZE + 1] = {};
+		for(int i = 0; i < SIZE; ++i){
+			for(uint16_t mask = masks[i] & twice; mask != 0; mask &= mask - 1)
+				places[Board::lowestValue(mask)] |= uint16_t(1) << i;
+		}
+
+		for(int v = 1; v <= SIZE; ++v){
+			if(places[v] == 0)
+				continue;
+			for(int w = v + 1; w <= SIZE; ++w){
+				if(places[w] != places[v])
+					continue;
+
+				uint16_t pair = Board::maskOf(v) | Board::maskOf(w);
+				int first = __builtin_ctz(places[v]);
+				int second = __builtin_ctz(places[v] & (places[v] - 1));
+				if(((masks[first] | masks[second]) & ~pair) == 0)
+					continue;
+
+				startHint(hint, Hint::HIDDEN_PAIR, unit);
+				addCell(hint, cells[first]);
+				addCell(hint, cells[second]);
+				hint.targets.insert(cells[first]);
+				hint.targets.insert(cells[second]);
+				hint.removed = Board::ALL_CANDIDATES & ~pair;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool findXWing(const Grid & grid, Hint & hint){
+	for(int value = 1; value <= SIZE; ++value){
+		uint16_t mask = Board::maskOf(value);
+
+		// Rows first, then columns.
+		for(int first = 0; first < FIRST_BOX_UNIT; first += SIZE){
+			uint16_t places[SIZE];
+			for(int line = 0; line < SIZE; ++line){
+				const int * cells = Board::getUnit(first + line);
+				places[line] = 0;
+				for(int i = 0; i < SIZE; ++i){
+					if((grid.masks[cells[i]] & mask) != 0)
+						places[line] |= uint16_t(1) << i;
+				}
+			}
+
+			for(int a = 0; a < SIZE; ++a){
+				if(Board::countCandidates(places[a]) != 2)
+					continue;
+				for(int b = a + 1; b < SIZE; ++b){
+					if(places[b] != places[a])
+						continue;
+
+					// The crossing lines, less the two lines of the wing.
+					const int * lineA = Board::getUnit(first + a);
+					const int * lineB = Board::getUnit(first + b);
+					CellSet corners;
+					int cross = (first + SIZE) % FIRST_BOX_UNIT;
+					CellSet targets;
+					bool any = false;
+					for(uint16_t p = places[a]; p != 0; p &= p - 1){
+						int i = __builtin_ctz(p);
+						corners.insert(lineA[i]);
+						corners.insert(lineB[i]);
+					}
+					for(uint16_t p = places[a]; p != 0; p &= p - 1){
+						if(collectTargets(grid, cross + __builtin_ctz(p),
+								corners, mask, targets))
+							any = true;
+					}
+					if(!any)
+						continue;
+
+					startHint(hint, Hint::X_WING, -1);
+					hint.value = value;
+					for(int cell = corners.first(); cell >= 0;
+							cell = corners.next(cell))
+						addCell(hint, cell);
+					hint.targets = targets;
+					hint.removed = mask;
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+} // namespace
+
+const char * Hint::getTechniqueName(Technique technique){
+	switch(technique){
+	case CONTRADICTION:
+		return "contradiction";
+	case NAKED_SINGLE:
+		return "naked single";
+	case HIDDEN_SINGLE:
+		return "hidden single";
+	case POINTING:
+		return "pointing";
+	case CLAIMING:
+		return "claiming";
+	case NAKED_PAIR:
+		return "naked pair";
+	case HIDDEN_PAIR:
+		return "hidden pair";
+	case NAKED_TRIPLE:
+		return "naked triple";
+	case X_WING:
+		return "x-wing";
+	}
+	return "unknown";
+}
+
+bool HintEngine::findHint(const uint8_t values[Board::NUM_CELLS],
+		const uint16_t candidates[Board::NUM_CELLS], Hint & hint){
+	Grid grid;
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		grid.masks[cell] = values[cell] != 0 ? 0 :
+				candidates[cell] & Board::ALL_CANDIDATES;
+	for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+		const int * cells = Board::getUnit(unit);
+		grid.placed[unit] = 0;
+		for(int i = 0; i < SIZE; ++i){
+			if(values[cells[i]] != 0)
+				grid.placed[unit] |= Board::maskOf(values[cells[i]]);
+		}
+	}
+
+	return findContradiction(values, grid, hint) ||
+			findNakedSingle(grid, hint) ||
+			findHiddenSingle(grid, hint) ||
+			findPointing(grid, hint) ||
+			findClaiming(grid, hint) ||
+			findNakedPair(grid, hint) ||
+			findHiddenPair(grid, hint) ||
+			findNakedTriple(grid, hint) ||
+			findXWing(grid, hint);
+}
+
+bool HintEngine::findHint(const Puzzle & puzzle, Hint & hint){
+	uint8_t values[Board::NUM_CELLS];
+	uint16_t candidates[Board::NUM_CELLS];
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		const Square & square = puzzle(Board::rowOf(cell), Board::colOf(cell));
+		values[cell] = static_cast<uint8_t>(square.isSet() ?
+				square.getValue() : 0);
+		candidates[cell] = square.isSet() ? 0 :
+				square.getPossibleValues().getMask();
+	}
+
+	// The Squares need not have had their peers' values removed yet.
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		if(values[cell] == 0)
+			continue;
+		const int * peers = Board::getPeers(cell);
+		for(int i = 0; i < Board::NUM_PEERS; ++i)
+			candidates[peers[i]] &= ~Board::maskOf(values[cell]);
+	}
+
+	return findHint(values, candidates, hint);
+}
+
+bool HintEngine::findHint(const Board & board, Hint & hint){
+	uint8_t values[Board::NUM_CELLS];
+	uint16_t candidates[Board::NUM_CELLS];
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		values[cell] = static_cast<uint8_t>(board.getValue(cell));
+		candidates[cell] = board.getCandidates(cell);
+	}
+	return findHint(values, candidates, hint);
+}
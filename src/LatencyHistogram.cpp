@@ -0,0 +1,225 @@
+/*
+ * LatencyHistogram.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+const int LatencyHistogram::SUB_BUCKETS;
+const int LatencyHistogram::BUCKETS;
+
+namespace {
+
+// log2(SUB_BUCKETS).
+const int SUB_BUCKET_BITS = 6;
+
+static_assert(1 << SUB_BUCKET_BITS == LatencyHistogram::SUB_BUCKETS,
+		"SUB_BUCKET_BITS does not match SUB_BUCKETS.");
+
+/* The quantiles reported, with their names. */
+const struct {
+	const char * name;
+	double quantile;
+} QUANTILES[] = {
+	{"p50", 0.5},
+	{"p90", 0.9},
+	{"p99", 0.99},
+	{"p999", 0.999}
+};
+
+/* A duration with three significant figures and a unit. */
+std::string formatDuration(uint64_t nanos){
+	const char * units[] = {"ns", "us", "ms", "s"};
+	double value = static_cast<double>(nanos);
+	int unit = 0;
+	while(value >= 1000 && unit < 3){
+		value /= 1000;
+		++unit;
+	}
+	char text[32];
+	snprintf(text, sizeof(text), unit == 0 ? "%.0f %s" :
+			value < 10 ? "%.2f %s" : value < 100 ? "%.1f %s" : "%.0f %s",
+			value, units[unit]);
+	return text;
+}
+
+double getRate(uint64_t count, double seconds){
+	return seconds > 0 ? count / seconds : 0;
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram() :
+		counts_(new std::atomic<uint64_t>[BUCKETS]()),
+		total_(0),
+		max_(0)
+{}
+
+void LatencyHistogram::record(uint64_t nanos){
+	counts_[getBucket(nanos)].fetch_add(1, std::memory_order_relaxed);
+	total_.fetch_add(nanos, std::memory_order_relaxed);
+	uint64_t max = max_.load(std::memory_order_relaxed);
+	while(nanos > max && !max_.compare_exchange_weak(max, nanos,
+			std::memory_order_relaxed))
+		;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram & other){
+	for(int i = 0; i < BUCKETS; ++i){
+		uint64_t count = other.counts_[i].load(std::memory_order_relaxed);
+		if(count != 0)
+			counts_[i].fetch_add(count, std::memory_order_relaxed);
+	}
+	total_.fetch_add(other.total_.load(std::memory_order_relaxed),
+			std::memory_order_relaxed);
+	uint64_t otherMax = other.getMax();
+	uint64_t max = max_.load(std::memory_order_relaxed);
+	while(otherMax > max && !max_.compare_exchange_weak(max, otherMax,
+			std::memory_order_relaxed))
+		;
+}
+
+uint64_t LatencyHistogram::getCount() const {
+	uint64_t count = 0;
+	for(int i = 0; i < BUCKETS; ++i)
+		count += counts_[i].load(std::memory_order_relaxed);
+	return count;
+}
+
+double LatencyHistogram::getMean() const {
+	uint64_t count = getCount();
+	return count == 0 ? 0 :
+			static_cast<double>(total_.load(std::memory_order_relaxed)) /
+			count;
+}
+
+uint64_t LatencyHistogram::getMax() const {
+	return max_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getQuantile(double quantile) const {
+	uint64_t count = getCount();
+	if(count == 0)
+		return 0;
+
+	// The rank of the duration wanted, counting from 1.
+	uint64_t rank = static_cast<uint64_t>(std::ceil(quantile * count));
+	rank = std::max<uint64_t>(1, std::min(rank, count));
+	uint64_t seen = 0;
+	for(int i = 0; i < BUCKETS; ++i){
+		seen += counts_[i].load(std::memory_order_relaxed);
+		if(seen >= rank)
+			return std::min(getBucketTop(i), getMax());
+	}
+	// Recording since the count was taken; the max is still an upper bound.
+	return getMax();
+}
+
+std::string LatencyHistogram::formatSummary(double seconds) const {
+	uint64_t count = getCount();
+	char rate[32];
+	snprintf(rate, sizeof(rate), "%.0f", getRate(count, seconds));
+	std::string summary = std::to_string(count) + " puzzles, " + rate +
+			" puzzles/s; latency";
+	for(const auto & quantile : QUANTILES)
+		summary += std::string(" ") + quantile.name + " " +
+				formatDuration(getQuantile(quantile.quantile)) + ",";
+	return summary + " max " + formatDuration(getMax());
+}
+
+std::string LatencyHistogram::formatJson(double seconds) const {
+	uint64_t count = getCount();
+	char numbers[128];
+	snprintf(numbers, sizeof(numbers), "\"seconds\": %.6f, "
+			"\"puzzles_per_second\": %.3f, \"mean_ns\": %.1f",
+			seconds, getRate(count, seconds), getMean());
+
+	std::string json = "{\"count\": " + std::to_string(count) + ", " +
+			numbers;
+	for(const auto & quantile : QUANTILES)
+		json += std::string(", \"") + quantile.name + "_ns\": " +
+				std::to_string(getQuantile(quantile.quantile));
+	json += ", \"max_ns\": " + std::to_string(getMax()) + ", \"buckets\": [";
+
+	const char * separator = "";
+	for(int i = 0; i < BUCKETS; ++i){
+		uint64_t bucketCount = counts_[i].load(std::memory_order_relaxed);
+		if(bucketCount == 0)
+			continue;
+		json += std::string(separator) + "[" + std::to_string(getBucketTop(i))
+				+ ", " + std::to_string(bucketCount) + "]";
+		separator = ", ";
+	}
+	return json + "]}";
+}
+
+int LatencyHistogram::getBucket(uint64_t nanos){
+	if(nanos < 2 * SUB_BUCKETS)
+		return static_cast<int>(nanos);
+	// Shifted down so it lies in [SUB_BUCKETS, 2 * SUB_BUCKETS).
+	int shift = 63 - __builtin_clzll(nanos) - SUB_BUCKET_BITS;
+	return shift * SUB_BUCKETS + static_cast<int>(nanos >> shift);
+}
+
+uint64_t LatencyHistogram::getBucketTop(int bucket){
+	if(bucket < 2 * SUB_BUCKETS)
+		return static_cast<uint64_t>(bucket);
+	int shift = bucket / SUB_BUCKETS - 1;
+	uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS + SUB_BUCKETS);
+	// For the last bucket this wraps round to the largest uint64_t.
+	return ((sub + 1) << shift) - 1;
+}
+
+LatencyReporter::LatencyReporter(const LatencyHistogram & histogram,
+		std::ostream & out, std::chrono::milliseconds interval) :
+		histogram_(histogram),
+		out_(out),
+		interval_(interval),
+		start_(std::chrono::steady_clock::now()),
+		stopping_(false)
+{
+	if(interval_.count() > 0)
+		thread_ = std::thread(&LatencyReporter::run, this);
+}
+
+LatencyReporter::~LatencyReporter(){
+	stop();
+}
+
+void LatencyReporter::stop(){
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	wake_.notify_all();
+	if(thread_.joinable())
+		thread_.join();
+}
+
+double LatencyReporter::getSeconds() const {
+	return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start_).count();
+}
+
+void LatencyReporter::run(){
+	std::unique_lock<std::mutex> lock(mutex_);
+	auto next = start_ + interval_;
+	uint64_t lastCount = 0;
+	double lastSeconds = 0;
+	while(!wake_.wait_until(lock, next, [this]{ return stopping_; })){
+		double seconds = getSeconds();
+		uint64_t count = histogram_.getCount();
+		char prefix[64];
+		snprintf(prefix, sizeof(prefix), "[%.1f s, %.0f puzzles/s now] ",
+				seconds, getRate(count - lastCount, seconds - lastSeconds));
+		out_ << prefix << histogram_.formatSummary(seconds) << std::endl;
+		lastCount = count;
+		lastSeconds = seconds;
+		next += interval_;
+	}
+}
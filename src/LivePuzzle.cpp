@@ -0,0 +1,61 @@
+/*
+ * LivePuzzle.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "LivePuzzle.h"
+#include "Puzzle.h"
+#include <sstream>
+#include <stdexcept>
+
+LivePuzzle::LivePuzzle(const Puzzle & puzzle){
+	if(!board_.load(puzzle))
+		throw std::invalid_argument("The puzzle contradicts itself.");
+	board_.refreshBuckets();
+}
+
+LivePuzzle::LivePuzzle(const Board & board) : board_(board) {
+	board_.refreshBuckets();
+}
+
+bool LivePuzzle::applyMove(int row, int col, int value, CandidateDiff & diff){
+	diff.count = 0;
+	if(row < 0 || row >= Board::PUZZLE_SIZE || col < 0 ||
+			col >= Board::PUZZLE_SIZE || value < 1 ||
+			value > Board::PUZZLE_SIZE){
+		std::ostringstream o;
+		o << "Invalid move of " << value << " to (" << row << ", " << col
+				<< ").";
+		throw std::out_of_range(o.str());
+	}
+
+	// A failed assignment leaves the Board undefined, so it is done on a copy.
+	Board next(board_);
+	if(!next.assign(row * Board::PUZZLE_SIZE + col, value))
+		return false;
+
+	const CellSet & changed = next.getChangedCells();
+	for(int cell = changed.first(); cell >= 0; cell = changed.next(cell)){
+		CandidateChange & change = diff.changes[diff.count++];
+		change.cell = static_cast<uint8_t>(cell);
+		change.mask = next.getCandidates(cell);
+	}
+
+	next.refreshBuckets();
+	board_ = next;
+	return true;
+}
+
+void LivePuzzle::getSnapshot(CandidateDiff & snapshot) const {
+	snapshot.count = Board::NUM_CELLS;
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		snapshot.changes[cell].cell = static_cast<uint8_t>(cell);
+		snapshot.changes[cell].mask = board_.getCandidates(cell);
+	}
+}
+
+const Board & LivePuzzle::getBoard() const {
+	return board_;
+}
@@ -0,0 +1,37 @@
+/*
+ * Parallel.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+int resolveThreads(int requested){
+	if(requested > 0)
+		return requested;
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void runParallel(std::size_t count, int threads,
+		const std::function<void(int, std::size_t)> & work){
+	threads = static_cast<int>(std::min<std::size_t>(resolveThreads(threads),
+			count));
+
+	std::atomic<std::size_t> next(0);
+	auto worker = [&next, count, &work](int thread){
+		for(std::size_t i = next++; i < count; i = next++)
+			work(thread, i);
+	};
+
+	std::vector<std::thread> pool;
+	for(int i = 1; i < threads; ++i)
+		pool.push_back(std::thread(worker, i));
+	worker(0);
+	for(auto & thread : pool)
+		thread.join();
+}
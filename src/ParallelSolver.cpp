@@ -0,0 +1,203 @@
+/*
+ * ParallelSolver.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "ParallelSolver.h"
+#include "Parallel.h"
+#include "Propagator.h"
+#include <algorithm>
+#include <thread>
+
+ParallelSolver::ParallelSolver(const Options & options) :
+		threads_(resolveThreads(options.threads)),
+		options_(options),
+		splitHeuristic_(makeHeuristic("mrv")),
+		queues_(threads_),
+		firstSolved_(0),
+		solutions_(0)
+{
+	for(int i = 0; i < threads_; ++i)
+		solvers_.push_back(std::unique_ptr<Solver>(new Solver()));
+}
+
+Solver::Status ParallelSolver::solve(Board & board){
+	if(!split(board))
+		return Solver::UNSOLVABLE;
+
+	runWorkers([this](int thread, WorkerStats & stats){
+		Solver & solver = *solvers_[thread];
+		std::size_t task;
+		while(nextTask(thread, task, stats)){
+			if(task > firstSolved_.load(std::memory_order_acquire)){
+				++stats.cancelledTasks;
+				continue;
+			}
+
+			Solver::Status status = solver.solve(tasks_[task],
+					cancelled_[task]);
+			stats.nodes += solver.getStats().nodes;
+			if(status == Solver::SOLVED)
+				solvedTask(task);
+			else if(status == Solver::CANCELLED)
+				++stats.cancelledTasks;
+		}
+	});
+
+	std::size_t first = firstSolved_.load();
+	if(first == tasks_.size())
+		return Solver::UNSOLVABLE;
+	board = tasks_[first];
+	return Solver::SOLVED;
+}
+
+uint64_t ParallelSolver::countSolutions(const Board & board, uint64_t limit){
+	if(limit == 0 || !split(board))
+		return 0;
+
+	runWorkers([this, limit](int thread, WorkerStats & stats){
+		Solver & solver = *solvers_[thread];
+		std::size_t task;
+		while(nextTask(thread, task, stats)){
+			if(cancelled_[task].load(std::memory_order_relaxed)){
+				++stats.cancelledTasks;
+				continue;
+			}
+
+			uint64_t found = solver.countSolutions(tasks_[task], limit,
+					nullptr, &cancelled_[task]);
+			stats.nodes += solver.getStats().nodes;
+			if(solver.getStats().cancelled){
+				++stats.cancelledTasks;
+				continue;
+			}
+
+			/* Only finished tasks are counted, so the total can reach limit
+			 * only if the puzzle really has that many solutions. */
+			if(solutions_.fetch_add(found) + found >= limit)
+				for(std::size_t i = 0; i < tasks_.size(); ++i)
+					cancelled_[i].store(true, std::memory_order_relaxed);
+		}
+	});
+
+	return std::min(solutions_.load(), limit);
+}
+
+const ParallelSolver::Stats & ParallelSolver::getStats() const {
+	return stats_;
+}
+
+int ParallelSolver::getThreads() const {
+	return threads_;
+}
+
+bool ParallelSolver::split(const Board & root){
+	stats_ = Stats();
+	stats_.nodes = 1;
+	tasks_.clear();
+	solutions_ = 0;
+
+	Board start(root);
+	if(Propagator::propagate(start))
+		tasks_.push_back(start);
+
+	// Expanding each level in order keeps the tasks in depth-first order.
+	std::size_t wanted = static_cast<std::size_t>(threads_) *
+			std::max(options_.tasksPerThread, 1);
+	std::vector<Board> next;
+	while(tasks_.size() < wanted && stats_.splitDepth < options_.maxSplitDepth){
+		bool expanded = false;
+		next.clear();
+
+		for(Board & board : tasks_){
+			if(board.isSolved()){
+				next.push_back(board);
+				continue;
+			}
+
+			expanded = true;
+			Branch branch;
+			board.refreshBuckets();
+			splitHeuristic_->chooseBranch(board, branch);
+			for(int i = 0; i < branch.count; ++i){
+				Board child(board);
+				++stats_.nodes;
+				if(child.assign(branch.cells[i], branch.values[i]) &&
+						Propagator::propagate(child))
+					next.push_back(child);
+			}
+		}
+
+		if(!expanded)
+			break;
+		tasks_.swap(next);
+		++stats_.splitDepth;
+	}
+
+	stats_.tasks = tasks_.size();
+	firstSolved_ = tasks_.size();
+	cancelled_.reset(new std::atomic<bool>[tasks_.size()]);
+	for(std::size_t i = 0; i < tasks_.size(); ++i)
+		cancelled_[i].store(false, std::memory_order_relaxed);
+
+	for(int i = 0; i < threads_; ++i)
+		queues_[i].tasks.clear();
+	for(std::size_t i = 0; i < tasks_.size(); ++i)
+		queues_[i % threads_].tasks.push_back(i);
+
+	return !tasks_.empty();
+}
+
+bool ParallelSolver::nextTask(int thread, std::size_t & task,
+		WorkerStats & stats){
+	{
+		std::lock_guard<std::mutex> lock(queues_[thread].mutex);
+		std::deque<std::size_t> & own = queues_[thread].tasks;
+		if(!own.empty()){
+			task = own.front();
+			own.pop_front();
+			return true;
+		}
+	}
+
+	// No tasks are added once a search starts, so one empty sweep is final.
+	for(int i = 1; i < threads_; ++i){
+		TaskQueue & victim = queues_[(thread + i) % threads_];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if(!victim.tasks.empty()){
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			++stats.steals;
+			return true;
+		}
+	}
+	return false;
+}
+
+template<typename Worker>
+void ParallelSolver::runWorkers(Worker worker){
+	std::vector<WorkerStats> workerStats(threads_, WorkerStats());
+
+	std::vector<std::thread> threads;
+	for(int i = 1; i < threads_; ++i)
+		threads.push_back(std::thread(worker, i, std::ref(workerStats[i])));
+	worker(0, workerStats[0]);
+	for(auto & thread : threads)
+		thread.join();
+
+	for(const WorkerStats & stats : workerStats){
+		stats_.nodes += stats.nodes;
+		stats_.cancelledTasks += stats.cancelledTasks;
+		stats_.steals += stats.steals;
+	}
+}
+
+void ParallelSolver::solvedTask(std::size_t task){
+	std::size_t first = firstSolved_.load();
+	while(task < first && !firstSolved_.compare_exchange_weak(first, task)) {}
+
+	for(std::size_t i = task + 1; i < tasks_.size(); ++i)
+		cancelled_[i].store(true, std::memory_order_relaxed);
+}
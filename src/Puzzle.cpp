@@ -9,6 +9,8 @@
 #include <stdexcept>
 #include <fstream>
 #include <sstream>
+#include <cctype>
+#include <cstdio>
 #include <cstring>
 
 Puzzle::PuzzleFileException::PuzzleFileException(
@@ -22,29 +24,17 @@ Puzzle::PuzzleFileException::PuzzleFileException(
 		length_(length),
 		invalidValue_(invalidValue)
 {
-	// Zero out whatMessage (will be constructed when what() is called.
-	for(auto & cha : whatMessage_)
-		cha = '\0';
-
-	// Zero out the rest as well.
+	// Zero out the strings, so each is null-terminated however it is set.
 	for(auto & cha : line_)
 		cha = '\0';
 
 	for(auto & cha : filename_)
 		cha = '\0';
 
-	/* In all cases, we want to set the filename; restrict it to the size of
-	 * our fileName_ member. */
-	if(filename != nullptr){
-		int fileNameLength = strlen(filename);
-		// Last char is for null character.
-		strncpy(filename_, filename,
-				fileNameLength>(STR_LEN-1) ? (STR_LEN-1) : fileNameLength);
-	}
-	else{
-		strcpy(filename_, "Filename not provided correctly.");
-	}
-
+	/* In all cases, we want to set the filename; snprintf() restricts it to
+	 * the size of our fileName_ member, leaving room for the null character. */
+	snprintf(filename_, STR_LEN, "%s", filename != nullptr ? filename :
+			"Filename not provided correctly.");
 
 	switch(reason_){
 	case TOO_FEW_LINES:
@@ -58,17 +48,12 @@ Puzzle::PuzzleFileException::PuzzleFileException(
 		// For INVALID_LINE_LENGTH, need to set length (done in member
 		// initialisation), and  for INVALID_VALUE, need to set need to set
 		// invalid value (also done in member initialisation).
-		if(line != nullptr){
-			int lineLength = strlen(line);
-			// Restrict to line_'s size, last char is the null character,
-			strncpy(line_, line,
-					lineLength>(STR_LEN-1) ? (STR_LEN-1) : lineLength);
-		}
-		else{
-			strcpy(line_, "Line not provided correctly.");
-		}
+		snprintf(line_, STR_LEN, "%s", line != nullptr ? line :
+				"Line not provided correctly.");
 		break;
 	}
+
+	formatMessage();
 }
 
 Puzzle::PuzzleFileException Puzzle::PuzzleFileException::tooFewLines(
@@ -89,45 +74,36 @@ Puzzle::PuzzleFileException::invalidValue(
 	return PuzzleFileException(INVALID_VALUE, filename, line, 0, invalidValue);
 }
 
-const char * Puzzle::PuzzleFileException::what(){
-
-	// whatMessage is initialised to all \0's in the constructor, and
-	// constructed here. If its string length is non-zero, then then what() has
-	// already been called and there's no point in constructing the string
-	// again.
-	if(strlen(whatMessage_) != 0)
-		return whatMessage_;
-
-	strcat(whatMessage_, "The file '");
-	strcat(whatMessage_, filename_);
-	strcat(whatMessage_, "' ");
+const char * Puzzle::PuzzleFileException::what() const throw(){
+	return whatMessage_;
+}
 
+void Puzzle::PuzzleFileException::formatMessage(){
+	/* Every write is bounded by the buffer, which is large enough for the
+	 * longest filename and line anyway. */
 	switch(reason_){
 	case TOO_FEW_LINES:
-		strcat(whatMessage_, " had too few lines for a valid Sudoku puzzle.");
+		snprintf(whatMessage_, sizeof(whatMessage_), "The file '%s' had too "
+				"few lines for a valid Sudoku puzzle.", filename_);
 		break;
 
 	case INVALID_LINE_LENGTH:
-		strcat(whatMessage_, "had the line '");
-		strcat(whatMessage_, line_);
-		strcat(whatMessage_, "of length ");
-		char size[10];
-		snprintf(size, 9, "%d", length_);
-		strcat(whatMessage_, size);
-		strcat(whatMessage_, ".");
+		snprintf(whatMessage_, sizeof(whatMessage_), "The file '%s' had the "
+				"line '%s' of length %d.", filename_, line_, length_);
 		break;
 
 	case INVALID_VALUE:
-		strcat(whatMessage_, "had the line '");
-		strcat(whatMessage_, line_);
-		strcat(whatMessage_, "' which contained the invalid value of '");
-		char badValue[2];
-		snprintf(badValue, 1, "%c", invalidValue_);
-		strcat(whatMessage_, badValue);
-		strcat(whatMessage_, ".");
+		// A value that cannot be printed, a null character say, is given in
+		// hexadecimal instead, so it cannot cut the message short.
+		char value[8];
+		snprintf(value, sizeof(value),
+				isprint(static_cast<unsigned char>(invalidValue_)) ? "'%c'" :
+				"0x%02x", static_cast<unsigned char>(invalidValue_));
+		snprintf(whatMessage_, sizeof(whatMessage_), "The file '%s' had the "
+				"line '%s' which contained the invalid value of %s.",
+				filename_, line_, value);
+		break;
 	}
-
-	return whatMessage_;
 }
 
 Puzzle::PuzzleFileException::PuzzleFileException(
@@ -137,9 +113,7 @@ Puzzle::PuzzleFileException::PuzzleFileException(
 					length_(other.length_),
 					invalidValue_(other.invalidValue_)
 {
-	// Zero out whatMessage (will be constructed when what() is called.
-	for(auto & cha : whatMessage_)
-		cha = '\0';
+	memcpy(whatMessage_, other.whatMessage_, sizeof(whatMessage_));
 
 	for(int i = 0; i < STR_LEN; ++i)
 		filename_[i] = other.filename_[i];
@@ -151,9 +125,7 @@ Puzzle::PuzzleFileException::PuzzleFileException(
 Puzzle::PuzzleFileException &
 Puzzle::PuzzleFileException::operator=(
 		const PuzzleFileException & other){
-	// whatMessage is constructed when what() is called.
-	for(auto & cha : whatMessage_)
-		cha = '\0';
+	memcpy(whatMessage_, other.whatMessage_, sizeof(whatMessage_));
 
 	reason_ = other.reason_;
 	length_ = other.length_;
@@ -277,15 +249,6 @@ Puzzle::Puzzle(const std::string & filename) :
 	}
 }
 
-Puzzle::Puzzle(const Puzzle & other) :
-				// squares_ initialised below.
-				solved_(other.solved_),
-				numLeftToSolve_(other.numLeftToSolve_)
-{
-	for(int i = 0; i < NUM_SQUARES; ++i)
-		squares_[i] = other.squares_[i];
-}
-
 bool Puzzle::isSolved() const {
 	return solved_;
 }
@@ -301,16 +264,3 @@ const Square & Puzzle::operator()(int row, int col) const {
 
 	return squares_[row*PUZZLE_SIZE + col];
 }
-
-Puzzle & Puzzle::operator=(const Puzzle & other){
-	// Handle self-assignment.
-	if(this==&other)
-		return *this;
-
-	solved_ = other.solved_;
-	numLeftToSolve_ = other.numLeftToSolve_;
-	for(int i = 0; i < NUM_SQUARES; ++i)
-		squares_[i] = other.squares_[i];
-
-	return *this;
-}
@@ -0,0 +1,340 @@
+/*
+ * PuzzleIO.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "PuzzleIO.h"
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+
+namespace {
+
+/* Marks ChunkedReader::newline_ as not yet found. */
+const std::size_t NO_NEWLINE = static_cast<std::size_t>(-1);
+
+} // namespace
+
+std::string errorMessage(const std::string & what){
+	std::ostringstream o;
+	o << what << ": " << strerror(errno) << ".";
+	return o.str();
+}
+
+const char UNSOLVABLE_LINE[] = "unsolvable\n";
+const char INVALID_LINE[] = "invalid\n";
+const char TIMED_OUT_LINE[] = "timed out\n";
+const char BINARY_MAGIC[] = "SUDOKUB1";
+
+bool parsePuzzleLine(const char * line, std::size_t length,
+		uint8_t givens[Board::NUM_CELLS]){
+	if(length > 0 && line[length - 1] == '\r')
+		--length;
+
+	if(length != static_cast<std::size_t>(Board::NUM_CELLS))
+		return false;
+
+	for(int i = 0; i < Board::NUM_CELLS; ++i){
+		char character = line[i];
+		if(character == '#' || character == '.' || character == '0')
+			givens[i] = 0;
+		else if(character >= '1' && character <= '0' + Board::PUZZLE_SIZE)
+			givens[i] = static_cast<uint8_t>(character - '0');
+		else
+			return false;
+	}
+
+	return true;
+}
+
+void packPuzzleRecord(const uint8_t givens[Board::NUM_CELLS],
+		uint8_t record[BINARY_RECORD_SIZE]){
+	memset(record, 0, BINARY_RECORD_SIZE);
+	for(int i = 0; i < Board::NUM_CELLS; ++i)
+		record[i / 2] |= static_cast<uint8_t>(givens[i] << (i % 2 * 4));
+}
+
+bool unpackPuzzleRecord(const uint8_t record[BINARY_RECORD_SIZE],
+		uint8_t givens[Board::NUM_CELLS]){
+	for(int i = 0; i < Board::NUM_CELLS; ++i){
+		givens[i] = (record[i / 2] >> (i % 2 * 4)) & 0xf;
+		if(givens[i] > Board::PUZZLE_SIZE)
+			return false;
+	}
+
+	// The unused high bits of the last byte.
+	return Board::NUM_CELLS % 2 == 0 ||
+			(record[BINARY_RECORD_SIZE - 1] & 0xf0) == 0;
+}
+
+CorpusFormat detectCorpusFormat(int fd){
+	char header[BINARY_HEADER_SIZE];
+	ssize_t count;
+	do
+		count = pread(fd, header, BINARY_HEADER_SIZE, 0);
+	while(count < 0 && errno == EINTR);
+
+	return count == static_cast<ssize_t>(BINARY_HEADER_SIZE) &&
+			memcmp(header, BINARY_MAGIC, BINARY_HEADER_SIZE) == 0 ?
+			BINARY_FORMAT : TEXT_FORMAT;
+}
+
+void formatPuzzleLine(const Board & board, char out[Board::NUM_CELLS]){
+	for(int i = 0; i < Board::NUM_CELLS; ++i){
+		int value = board.getValue(i);
+		out[i] = value == 0 ? '#' : static_cast<char>('0' + value);
+	}
+}
+
+ChunkedReader::ChunkedReader(int fd, std::size_t chunkSize, uint64_t limit) :
+		fd_(fd),
+		buffer_(chunkSize),
+		begin_(0),
+		end_(0),
+		newline_(NO_NEWLINE),
+		eof_(false),
+		bytesRead_(0),
+		limit_(limit)
+{
+	if(chunkSize == 0)
+		throw std::invalid_argument("ChunkedReader needs a non-empty buffer.");
+}
+
+void ChunkedReader::prepend(const std::string & bytes){
+	if(bytesRead_ != 0 || bytes.size() > buffer_.size() ||
+			bytes.size() > limit_)
+		throw std::invalid_argument("Cannot prepend to the input.");
+	std::copy(bytes.begin(), bytes.end(), buffer_.begin());
+	end_ = bytes.size();
+	bytesRead_ = bytes.size();
+}
+
+bool ChunkedReader::hasBufferedLine(){
+	if(newline_ != NO_NEWLINE)
+		return true;
+
+	const void * found = memchr(&buffer_[0] + begin_, '\n', end_ - begin_);
+	if(found != nullptr){
+		newline_ = static_cast<const char *>(found) - &buffer_[0];
+		return true;
+	}
+
+	// The last line of the input need not end with a newline.
+	return eof_ && begin_ < end_;
+}
+
+bool ChunkedReader::nextLine(const char *& line, std::size_t & length){
+	for(;;){
+		if(hasBufferedLine()){
+			std::size_t lineEnd = newline_ == NO_NEWLINE ? end_ : newline_;
+			line = &buffer_[0] + begin_;
+			length = lineEnd - begin_;
+			begin_ = newline_ == NO_NEWLINE ? end_ : newline_ + 1;
+			newline_ = NO_NEWLINE;
+			if(length > 0 && line[length - 1] == '\r')
+				--length;
+			return true;
+		}
+
+		if(eof_)
+			return false;
+
+		/* A full buffer without a newline: keep what we have of the line in the
+		 * spare buffer, and read on to its end before returning it, so that
+		 * getBytesConsumed() is never part way through a line. */
+		if(begin_ == 0 && end_ == buffer_.size()){
+			spare_.resize(buffer_.size());
+			buffer_.swap(spare_);
+			begin_ = end_ = 0;
+			for(;;){
+				const void * found = memchr(&buffer_[0] + begin_, '\n',
+						end_ - begin_);
+				if(found != nullptr){
+					begin_ = static_cast<const char *>(found) - &buffer_[0] + 1;
+					break;
+				}
+				begin_ = end_;
+				if(!fill())
+					break;
+			}
+			line = &spare_[0];
+			length = spare_.size();
+			return true;
+		}
+
+		fill();
+	}
+}
+
+bool ChunkedReader::nextBlock(const char *& data, std::size_t size,
+		std::size_t & length){
+	if(size > buffer_.size())
+		throw std::invalid_argument("Block is larger than the chunk size.");
+
+	while(end_ - begin_ < size && !eof_)
+		fill();
+
+	if(begin_ == end_)
+		return false;
+
+	data = &buffer_[0] + begin_;
+	length = std::min(size, end_ - begin_);
+	begin_ += length;
+	newline_ = NO_NEWLINE;
+	return true;
+}
+
+uint64_t ChunkedReader::getBytesRead() const {
+	return bytesRead_;
+}
+
+uint64_t ChunkedReader::getBytesConsumed() const {
+	return bytesRead_ - (end_ - begin_);
+}
+
+bool ChunkedReader::fill(){
+	if(begin_ > 0){
+		memmove(&buffer_[0], &buffer_[0] + begin_, end_ - begin_);
+		end_ -= begin_;
+		begin_ = 0;
+	}
+
+	for(;;){
+		std::size_t space = buffer_.size() - end_;
+		if(limit_ - bytesRead_ < space)
+			space = static_cast<std::size_t>(limit_ - bytesRead_);
+		if(space == 0 && bytesRead_ == limit_){
+			eof_ = true;
+			return false;
+		}
+
+		/* Take whatever is available rather than waiting for a full chunk, so
+		 * that the first puzzles of a slow producer are solved straight
+		 * away. */
+		ssize_t count = read(fd_, &buffer_[0] + end_, space);
+		if(count > 0){
+			end_ += count;
+			bytesRead_ += count;
+			return true;
+		}
+		if(count == 0){
+			eof_ = true;
+			return false;
+		}
+		if(errno == EINTR)
+			continue;
+		if(errno == EAGAIN || errno == EWOULDBLOCK){
+			struct pollfd pfd = { fd_, POLLIN, 0 };
+			poll(&pfd, 1, -1);
+			continue;
+		}
+		throw std::runtime_error(errorMessage("Could not read input"));
+	}
+}
+
+CorpusReader::CorpusReader(int fd, CorpusFormat format, uint64_t limit,
+		const std::string & prefix) :
+		format_(format),
+		reader_(fd, ChunkedReader::DEFAULT_CHUNK_SIZE, limit)
+{
+	if(!prefix.empty())
+		reader_.prepend(prefix);
+}
+
+bool CorpusReader::next(uint8_t givens[Board::NUM_CELLS], bool & valid){
+	const char * data;
+	std::size_t length;
+
+	if(format_ == BINARY_FORMAT){
+		if(!reader_.nextBlock(data, BINARY_RECORD_SIZE, length))
+			return false;
+		valid = length == BINARY_RECORD_SIZE && unpackPuzzleRecord(
+				reinterpret_cast<const uint8_t *>(data), givens);
+		return true;
+	}
+
+	do{
+		if(!reader_.nextLine(data, length))
+			return false;
+	} while(length == 0);
+
+	valid = parsePuzzleLine(data, length, givens);
+	return true;
+}
+
+uint64_t CorpusReader::getOffset() const {
+	return reader_.getBytesConsumed();
+}
+
+BoundedWriter::BoundedWriter(int fd, std::size_t capacity) :
+		fd_(fd),
+		buffer_(capacity),
+		size_(0)
+{
+	if(capacity == 0)
+		throw std::invalid_argument("BoundedWriter needs a non-empty buffer.");
+}
+
+BoundedWriter::~BoundedWriter(){
+	try{
+		flush();
+	}
+	catch(std::exception & e){
+		// Nothing sensible can be done about a failed write here.
+	}
+}
+
+void BoundedWriter::write(const char * data, std::size_t length){
+	if(size_ + length > buffer_.size())
+		flush();
+
+	// Too big to ever buffer; hand it straight over.
+	if(length > buffer_.size()){
+		writeAll(data, length);
+		return;
+	}
+
+	memcpy(&buffer_[0] + size_, data, length);
+	size_ += length;
+}
+
+void BoundedWriter::flush(){
+	if(size_ == 0)
+		return;
+
+	// Empty the buffer first, so a failed write is not retried by the
+	// destructor.
+	std::size_t size = size_;
+	size_ = 0;
+	writeAll(&buffer_[0], size);
+}
+
+std::size_t BoundedWriter::getBufferedSize() const {
+	return size_;
+}
+
+void BoundedWriter::writeAll(const char * data, std::size_t length){
+	while(length > 0){
+		ssize_t count = ::write(fd_, data, length);
+		if(count >= 0){
+			data += count;
+			length -= count;
+			continue;
+		}
+		if(errno == EINTR)
+			continue;
+		if(errno == EAGAIN || errno == EWOULDBLOCK){
+			// Non-blocking output: wait for the consumer to catch up.
+			struct pollfd pfd = { fd_, POLLOUT, 0 };
+			poll(&pfd, 1, -1);
+			continue;
+		}
+		throw std::runtime_error(errorMessage("Could not write output"));
+	}
+}
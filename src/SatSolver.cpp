@@ -0,0 +1,404 @@
+/*
+ * SatSolver.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "SatSolver.h"
+#include "Puzzle.h"
+#include <algorithm>
+#include <ostream>
+
+namespace {
+
+const int SIZE = Board::PUZZLE_SIZE;
+
+/* Conflicts before the first restart; later ones follow the Luby sequence. */
+const uint64_t RESTART_CONFLICTS = 100;
+
+/* Activities decay by this factor after each conflict. */
+const double ACTIVITY_DECAY = 0.95;
+
+/* Activities are scaled down once one passes this. */
+const double ACTIVITY_LIMIT = 1e100;
+
+/* Adds clauses saying that the cells hold different values, and, if there
+ * are PUZZLE_SIZE of them, every value. */
+void encodeUnit(Cnf & cnf, const int * cells, int count){
+	for(int value = 1; value <= SIZE; ++value){
+		if(count == SIZE){
+			std::vector<int> somewhere;
+			for(int i = 0; i < count; ++i)
+				somewhere.push_back(getSatVariable(cells[i], value));
+			cnf.clauses.push_back(somewhere);
+		}
+		for(int i = 0; i < count; ++i){
+			for(int j = i + 1; j < count; ++j)
+				cnf.clauses.push_back({-getSatVariable(cells[i], value),
+						-getSatVariable(cells[j], value)});
+		}
+	}
+}
+
+/* Encodes the rules of the grid, given a value (0 if unset) and candidates
+ * for each cell. */
+Cnf encodeCells(const int values[Board::NUM_CELLS],
+		const uint16_t candidates[Board::NUM_CELLS],
+		const std::vector<std::vector<int> > & extraUnits){
+	Cnf cnf;
+	cnf.numVars = Board::NUM_CELLS * SIZE;
+
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		std::vector<int> someValue;
+		for(int value = 1; value <= SIZE; ++value)
+			someValue.push_back(getSatVariable(cell, value));
+		cnf.clauses.push_back(someValue);
+		for(int value = 1; value <= SIZE; ++value){
+			for(int other = value + 1; other <= SIZE; ++other)
+				cnf.clauses.push_back({-getSatVariable(cell, value),
+						-getSatVariable(cell, other)});
+		}
+
+		if(values[cell] != 0)
+			cnf.clauses.push_back({getSatVariable(cell, values[cell])});
+		else{
+			for(int value = 1; value <= SIZE; ++value){
+				if((candidates[cell] & Board::maskOf(value)) == 0)
+					cnf.clauses.push_back({-getSatVariable(cell, value)});
+			}
+		}
+	}
+
+	for(int unit = 0; unit < Board::NUM_UNITS; ++unit)
+		encodeUnit(cnf, Board::getUnit(unit), SIZE);
+	for(const std::vector<int> & unit : extraUnits)
+		encodeUnit(cnf, unit.data(), static_cast<int>(unit.size()));
+
+	return cnf;
+}
+
+} // namespace
+
+void Cnf::writeDimacs(std::ostream & out) const {
+	out << "p cnf " << numVars << ' ' << clauses.size() << '\n';
+	for(const std::vector<int> & clause : clauses){
+		for(int lit : clause)
+			out << lit << ' ';
+		out << "0\n";
+	}
+}
+
+std::vector<std::vector<int> > getDiagonalUnits(){
+	std::vector<std::vector<int> > units(2);
+	for(int i = 0; i < SIZE; ++i){
+		units[0].push_back(i * SIZE + i);
+		units[1].push_back(i * SIZE + SIZE - 1 - i);
+	}
+	return units;
+}
+
+Cnf encodeSudoku(const Board & board,
+		const std::vector<std::vector<int> > & extraUnits){
+	int values[Board::NUM_CELLS];
+	uint16_t candidates[Board::NUM_CELLS];
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		values[cell] = board.getValue(cell);
+		candidates[cell] = board.getCandidates(cell);
+	}
+	return encodeCells(values, candidates, extraUnits);
+}
+
+Cnf encodeSudoku(const Puzzle & puzzle,
+		const std::vector<std::vector<int> > & extraUnits){
+	int values[Board::NUM_CELLS];
+	uint16_t candidates[Board::NUM_CELLS];
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		const Square & square = puzzle(Board::rowOf(cell), Board::colOf(cell));
+		values[cell] = square.isSet() ? square.getValue() : 0;
+		candidates[cell] = square.getPossibleValues().getMask();
+	}
+	return encodeCells(values, candidates, extraUnits);
+}
+
+CdclSolver::CdclSolver() :
+		numVars_(0),
+		emptyClause_(false),
+		activityIncrement_(1.0),
+		propagated_(0)
+{}
+
+void CdclSolver::load(const Cnf & cnf){
+	numVars_ = cnf.numVars;
+	emptyClause_ = false;
+	clauses_.clear();
+	watches_.assign(2 * numVars_, std::vector<int>());
+	units_.clear();
+	values_.assign(numVars_, -1);
+	phases_.assign(numVars_, 0);
+	levels_.assign(numVars_, 0);
+	reasons_.assign(numVars_, -1);
+	activity_.assign(numVars_, 0.0);
+	activityIncrement_ = 1.0;
+	seen_.assign(numVars_, 0);
+	trail_.clear();
+	trailLimits_.clear();
+	propagated_ = 0;
+
+	std::vector<int> lits;
+	for(const std::vector<int> & clause : cnf.clauses){
+		lits.clear();
+		bool tautology = false;
+		for(int lit : clause){
+			int internal = lit > 0 ? 2 * (lit - 1) : 2 * (-lit - 1) + 1;
+			if(std::find(lits.begin(), lits.end(), internal ^ 1) != lits.end())
+				tautology = true;
+			if(std::find(lits.begin(), lits.end(), internal) == lits.end())
+				lits.push_back(internal);
+		}
+		if(tautology)
+			continue;
+		if(lits.empty())
+			emptyClause_ = true;
+		else if(lits.size() == 1)
+			units_.push_back(lits[0]);
+		else
+			addClause(lits);
+	}
+}
+
+CdclSolver::Result CdclSolver::solve(const Solver::Limits & limits){
+	typedef std::chrono::steady_clock Clock;
+	stats_ = Stats();
+	cancelUntil(0);
+	trail_.clear();
+	propagated_ = 0;
+	std::fill(values_.begin(), values_.end(), -1);
+	if(emptyClause_)
+		return UNSATISFIABLE;
+
+	for(int lit : units_){
+		if(valueOf(lit) == 0)
+			return UNSATISFIABLE;
+		if(valueOf(lit) < 0)
+			enqueue(lit, -1);
+	}
+
+	bool timed = limits.timeBudget != Clock::duration::zero();
+	Clock::time_point deadline;
+	if(timed)
+		deadline = Clock::now() + limits.timeBudget;
+	uint64_t checkInterval = std::max<uint64_t>(limits.checkInterval, 1);
+	uint64_t restartAt = RESTART_CONFLICTS * luby(0);
+	uint64_t conflictsSinceRestart = 0;
+
+	for(;;){
+		int conflict = propagate();
+		if(conflict >= 0){
+			++stats_.conflicts;
+			++conflictsSinceRestart;
+			if(trailLimits_.empty())
+				return UNSATISFIABLE;
+
+			int level = analyze(conflict);
+			cancelUntil(level);
+			if(learnt_.size() == 1)
+				enqueue(learnt_[0], -1);
+			else
+				enqueue(learnt_[0], addClause(learnt_));
+			activityIncrement_ /= ACTIVITY_DECAY;
+			continue;
+		}
+
+		if(conflictsSinceRestart >= restartAt){
+			++stats_.restarts;
+			conflictsSinceRestart = 0;
+			restartAt = RESTART_CONFLICTS * luby(stats_.restarts);
+			cancelUntil(0);
+		}
+
+		int var = pickVariable();
+		if(var < 0)
+			return SATISFIABLE;
+
+		if(stats_.decisions >= limits.maxNodes)
+			return UNKNOWN;
+		if(stats_.decisions % checkInterval == 0 &&
+				((limits.cancel != nullptr && limits.cancel->load()) ||
+				(timed && Clock::now() >= deadline)))
+			return UNKNOWN;
+
+		++stats_.decisions;
+		trailLimits_.push_back(static_cast<int>(trail_.size()));
+		enqueue(2 * var + (phases_[var] ? 0 : 1), -1);
+	}
+}
+
+bool CdclSolver::getValue(int var) const {
+	return values_[var - 1] == 1;
+}
+
+const CdclSolver::Stats & CdclSolver::getStats() const {
+	return stats_;
+}
+
+int CdclSolver::valueOf(int lit) const {
+	int8_t value = values_[lit >> 1];
+	return value < 0 ? -1 : value ^ (lit & 1);
+}
+
+int CdclSolver::addClause(const std::vector<int> & lits){
+	int index = static_cast<int>(clauses_.size());
+	clauses_.push_back(lits);
+	watches_[lits[0]].push_back(index);
+	watches_[lits[1]].push_back(index);
+	return index;
+}
+
+void CdclSolver::enqueue(int lit, int reason){
+	int var = lit >> 1;
+	values_[var] = static_cast<int8_t>((lit & 1) ^ 1);
+	levels_[var] = static_cast<int>(trailLimits_.size());
+	reasons_[var] = reason;
+	trail_.push_back(lit);
+	if(reason >= 0)
+		++stats_.propagations;
+}
+
+int CdclSolver::propagate(){
+	while(propagated_ < trail_.size()){
+		int falseLit = trail_[propagated_++] ^ 1;
+		std::vector<int> & watching = watches_[falseLit];
+		std::size_t kept = 0;
+
+		for(std::size_t i = 0; i < watching.size(); ++i){
+			int index = watching[i];
+			std::vector<int> & clause = clauses_[index];
+			if(clause[0] == falseLit)
+				std::swap(clause[0], clause[1]);
+
+			// Satisfied by the other watch.
+			if(valueOf(clause[0]) == 1){
+				watching[kept++] = index;
+				continue;
+			}
+
+			// Move the watch to a literal that is not false.
+			bool moved = false;
+			for(std::size_t k = 2; k < clause.size(); ++k){
+				if(valueOf(clause[k]) != 0){
+					std::swap(clause[1], clause[k]);
+					watches_[clause[1]].push_back(index);
+					moved = true;
+					break;
+				}
+			}
+			if(moved)
+				continue;
+
+			watching[kept++] = index;
+			if(valueOf(clause[0]) == 0){
+				for(++i; i < watching.size(); ++i)
+					watching[kept++] = watching[i];
+				watching.resize(kept);
+				return index;
+			}
+			enqueue(clause[0], index);
+		}
+		watching.resize(kept);
+	}
+	return -1;
+}
+
+int CdclSolver::analyze(int conflict){
+	int currentLevel = static_cast<int>(trailLimits_.size());
+	learnt_.clear();
+	learnt_.push_back(-1);
+
+	int pending = 0;
+	int lit = -1;
+	int position = static_cast<int>(trail_.size()) - 1;
+	int index = conflict;
+	do{
+		const std::vector<int> & clause = clauses_[index];
+		// The first literal of a reason is the one it implied.
+		for(std::size_t k = lit < 0 ? 0 : 1; k < clause.size(); ++k){
+			int var = clause[k] >> 1;
+			if(seen_[var] || levels_[var] == 0)
+				continue;
+			seen_[var] = 1;
+			bumpActivity(var);
+			if(levels_[var] == currentLevel)
+				++pending;
+			else
+				learnt_.push_back(clause[k]);
+		}
+
+		while(!seen_[trail_[position] >> 1])
+			--position;
+		lit = trail_[position--];
+		index = reasons_[lit >> 1];
+		seen_[lit >> 1] = 0;
+		--pending;
+	} while(pending > 0);
+	learnt_[0] = lit ^ 1;
+
+	// Jump back to the highest level among the rest, which is watched.
+	int level = 0;
+	for(std::size_t k = 1; k < learnt_.size(); ++k){
+		seen_[learnt_[k] >> 1] = 0;
+		if(levels_[learnt_[k] >> 1] > level){
+			level = levels_[learnt_[k] >> 1];
+			std::swap(learnt_[1], learnt_[k]);
+		}
+	}
+	return level;
+}
+
+void CdclSolver::cancelUntil(int level){
+	if(static_cast<int>(trailLimits_.size()) <= level)
+		return;
+	std::size_t start = trailLimits_[level];
+	for(std::size_t i = start; i < trail_.size(); ++i){
+		int var = trail_[i] >> 1;
+		phases_[var] = values_[var];
+		values_[var] = -1;
+	}
+	trail_.resize(start);
+	trailLimits_.resize(level);
+	propagated_ = start;
+}
+
+int CdclSolver::pickVariable() const {
+	int best = -1;
+	for(int var = 0; var < numVars_; ++var){
+		if(values_[var] < 0 && (best < 0 || activity_[var] > activity_[best]))
+			best = var;
+	}
+	return best;
+}
+
+void CdclSolver::bumpActivity(int var){
+	activity_[var] += activityIncrement_;
+	if(activity_[var] > ACTIVITY_LIMIT){
+		for(double & activity : activity_)
+			activity /= ACTIVITY_LIMIT;
+		activityIncrement_ /= ACTIVITY_LIMIT;
+	}
+}
+
+uint64_t CdclSolver::luby(uint64_t index){
+	// Find the finished subsequence index falls in, then recurse into it.
+	uint64_t size = 1;
+	int power = 0;
+	while(size < index + 1){
+		size = 2 * size + 1;
+		++power;
+	}
+	while(size - 1 != index){
+		size = (size - 1) / 2;
+		--power;
+		index %= size;
+	}
+	return uint64_t(1) << power;
+}
@@ -0,0 +1,158 @@
+/*
+ * SolutionCache.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "SolutionCache.h"
+#include <algorithm>
+#include <cstring>
+
+const int SolutionCache::SHARDS;
+const std::size_t SolutionCache::DEFAULT_MAX_BYTES;
+
+SolutionCache::SolutionCache(std::size_t maxBytes,
+		const Solver::Limits & limits) :
+		limits_(limits),
+		shardCapacity_(std::max<std::size_t>(
+				maxBytes / getSessionBytes() / SHARDS, 1)),
+		shards_(new Shard[SHARDS])
+{}
+
+SolutionCache::Verdict SolutionCache::check(uint64_t session,
+		const uint8_t givens[Board::NUM_CELLS], const Board & board){
+	uint8_t solution[Board::NUM_CELLS];
+	switch(lookup(session, givens, solution)){
+	case UNIQUE:
+		for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+			int value = board.getValue(cell);
+			if(value != 0 && value != solution[cell])
+				return INCONSISTENT;
+		}
+		return CONSISTENT;
+	case NO_SOLUTION:
+		return INCONSISTENT;
+	default:
+		return UNKNOWN;
+	}
+}
+
+SolutionCache::Uniqueness SolutionCache::lookup(uint64_t session,
+		const uint8_t givens[Board::NUM_CELLS], uint8_t * solution){
+	Shard & shard = getShard(session);
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto found = shard.index.find(session);
+		if(found == shard.index.end())
+			++shard.stats.misses;
+		else if(memcmp(found->second->givens, givens, Board::NUM_CELLS) == 0){
+			++shard.stats.hits;
+			shard.entries.splice(shard.entries.begin(), shard.entries,
+					found->second);
+			const Entry & entry = shard.entries.front();
+			if(solution != nullptr && entry.uniqueness == UNIQUE)
+				memcpy(solution, entry.solution, Board::NUM_CELLS);
+			return entry.uniqueness;
+		}
+		else{
+			// The session has moved on to other givens.
+			++shard.stats.invalidations;
+			shard.entries.erase(found->second);
+			shard.index.erase(found);
+		}
+	}
+
+	/* Solved with no lock held; if another thread solves the same session
+	 * meanwhile, the later result replaces the earlier. */
+	Entry entry;
+	entry.session = session;
+	memcpy(entry.givens, givens, Board::NUM_CELLS);
+	solve(entry);
+	if(solution != nullptr && entry.uniqueness == UNIQUE)
+		memcpy(solution, entry.solution, Board::NUM_CELLS);
+
+	// A search cut short by the Limits may yet decide on a later try.
+	if(entry.uniqueness == UNDECIDED)
+		return UNDECIDED;
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto found = shard.index.find(session);
+	if(found != shard.index.end()){
+		shard.entries.erase(found->second);
+		shard.index.erase(found);
+	}
+	shard.entries.push_front(entry);
+	shard.index[session] = shard.entries.begin();
+
+	while(shard.entries.size() > shardCapacity_){
+		shard.index.erase(shard.entries.back().session);
+		shard.entries.pop_back();
+		++shard.stats.evictions;
+	}
+	return entry.uniqueness;
+}
+
+void SolutionCache::endSession(uint64_t session){
+	Shard & shard = getShard(session);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto found = shard.index.find(session);
+	if(found != shard.index.end()){
+		shard.entries.erase(found->second);
+		shard.index.erase(found);
+	}
+}
+
+SolutionCache::Stats SolutionCache::getStats() const {
+	Stats total;
+	for(int i = 0; i < SHARDS; ++i){
+		const Shard & shard = shards_[i];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		total.hits += shard.stats.hits;
+		total.misses += shard.stats.misses;
+		total.invalidations += shard.stats.invalidations;
+		total.evictions += shard.stats.evictions;
+		total.sessions += shard.entries.size();
+	}
+	return total;
+}
+
+std::size_t SolutionCache::getSessionBytes(){
+	/* The list node holds the Entry and two pointers; the map node holds its
+	 * value and a next pointer, and has a bucket pointing at it. Each node
+	 * also costs about two pointers of allocator header. */
+	return sizeof(Entry) + 2 * sizeof(void *) +
+			sizeof(std::pair<const uint64_t, std::list<Entry>::iterator>) +
+			2 * sizeof(void *) + 2 * 2 * sizeof(void *);
+}
+
+SolutionCache::Shard & SolutionCache::getShard(uint64_t session){
+	// Session identifiers are often consecutive, so they are mixed first.
+	uint64_t mixed = session * 0x9e3779b97f4a7c15ull;
+	return shards_[(mixed >> 32) % SHARDS];
+}
+
+void SolutionCache::solve(Entry & entry) const {
+	memset(entry.solution, 0, Board::NUM_CELLS);
+	Board board;
+	if(!board.load(entry.givens)){
+		entry.uniqueness = NO_SOLUTION;
+		return;
+	}
+
+	std::unique_ptr<Solver> solver(new Solver());
+	solver->setLimits(limits_);
+	Board first;
+	uint64_t count = solver->countSolutions(board, 2, &first);
+	if(count == 2)
+		entry.uniqueness = MULTIPLE_SOLUTIONS;
+	else if(solver->getStats().timedOut || solver->getStats().cancelled)
+		entry.uniqueness = UNDECIDED;
+	else if(count == 0)
+		entry.uniqueness = NO_SOLUTION;
+	else{
+		entry.uniqueness = UNIQUE;
+		for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+			entry.solution[cell] = static_cast<uint8_t>(first.getValue(cell));
+	}
+}
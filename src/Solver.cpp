@@ -0,0 +1,194 @@
+/*
+ * Solver.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Solver.h"
+#include "Propagator.h"
+#include <chrono>
+#include <utility>
+
+Solver::Solver() :
+		heuristic_(makeHeuristic("mrv")),
+		restartNodes_(0),
+		restartSeed_(0)
+{}
+
+void Solver::setHeuristic(std::unique_ptr<Heuristic> heuristic){
+	heuristic_ = heuristic ? std::move(heuristic) : makeHeuristic("mrv");
+}
+
+Heuristic & Solver::getHeuristic() const {
+	return *heuristic_;
+}
+
+void Solver::setRestarts(uint64_t firstNodes, uint64_t seed){
+	restartNodes_ = firstNodes;
+	restartSeed_ = seed;
+}
+
+void Solver::setLimits(const Limits & limits){
+	limits_ = limits;
+	if(limits_.checkInterval == 0)
+		limits_.checkInterval = 1;
+}
+
+const Solver::Limits & Solver::getLimits() const {
+	return limits_;
+}
+
+Solver::Status Solver::solve(Board & board){
+	return solveWithRestarts(board, nullptr);
+}
+
+Solver::Status Solver::solve(Board & board, const std::atomic<bool> & cancel){
+	return solveWithRestarts(board, &cancel);
+}
+
+uint64_t Solver::countSolutions(const Board & board, uint64_t limit,
+		Board * firstSolution, const std::atomic<bool> * cancel){
+	startCall();
+	bool hitNodeLimit;
+	return limit == 0 ? 0 : search(board, limit, firstSolution, cancel,
+			UINT64_MAX, hitNodeLimit);
+}
+
+Solver::Status Solver::solveWithRestarts(Board & board,
+		const std::atomic<bool> * cancel){
+	startCall();
+	uint64_t nodeLimit = restartNodes_ != 0 ? restartNodes_ : UINT64_MAX;
+	Board solution;
+
+	for(uint64_t attempt = 0; ; ++attempt){
+		if(restartNodes_ != 0)
+			heuristic_->restart(restartSeed_ + attempt * 0x9E3779B97F4A7C15ull);
+
+		bool hitNodeLimit;
+		if(search(board, 1, &solution, cancel, nodeLimit, hitNodeLimit) != 0){
+			board = solution;
+			return SOLVED;
+		}
+		if(stats_.cancelled)
+			return CANCELLED;
+		if(stats_.timedOut)
+			return TIMED_OUT;
+		if(!hitNodeLimit)
+			return UNSOLVABLE;
+
+		++stats_.restarts;
+		nodeLimit = nodeLimit > UINT64_MAX / 2 ? UINT64_MAX : nodeLimit * 2;
+	}
+}
+
+void Solver::startCall(){
+	stats_ = Stats();
+	if(limits_.timeBudget != std::chrono::steady_clock::duration::zero())
+		deadline_ = std::chrono::steady_clock::now() + limits_.timeBudget;
+}
+
+uint64_t Solver::search(const Board & board, uint64_t limit,
+		Board * firstSolution, const std::atomic<bool> * cancel,
+		uint64_t nodeLimit, bool & hitNodeLimit){
+	hitNodeLimit = false;
+	uint64_t nodes = 1;
+	uint64_t found = 0;
+
+	/* What is left of the node limit after any earlier restarts; the clock
+	 * and the limits' cancel flag are only looked at every checkInterval
+	 * nodes, as reading the clock costs about as much as a node. */
+	uint64_t nodeBudget = limits_.maxNodes > stats_.nodes ?
+			limits_.maxNodes - stats_.nodes : 0;
+	bool timed =
+			limits_.timeBudget != std::chrono::steady_clock::duration::zero();
+	bool checking = timed || limits_.cancel != nullptr;
+	uint64_t nextCheck = limits_.checkInterval;
+
+	frames_[0].board = board;
+	if(!Propagator::propagate(frames_[0].board)){
+		stats_.nodes += nodes;
+		return 0;
+	}
+
+	if(frames_[0].board.isSolved()){
+		stats_.nodes += nodes;
+		if(firstSolution != nullptr)
+			*firstSolution = frames_[0].board;
+		return 1;
+	}
+
+	frames_[0].board.refreshBuckets();
+	heuristic_->chooseBranch(frames_[0].board, frames_[0].branch);
+	frames_[0].next = 0;
+
+	int depth = 0;
+	while(depth >= 0){
+		Frame & frame = frames_[depth];
+
+		// Every alternative of this level has been tried; go back up.
+		if(frame.next == frame.branch.count){
+			--depth;
+			continue;
+		}
+
+		if(cancel != nullptr && cancel->load(std::memory_order_relaxed)){
+			stats_.cancelled = true;
+			break;
+		}
+		if(nodes == nodeLimit){
+			hitNodeLimit = true;
+			break;
+		}
+		if(nodes >= nodeBudget){
+			stats_.timedOut = true;
+			break;
+		}
+		if(checking && nodes >= nextCheck){
+			nextCheck = nodes + limits_.checkInterval;
+			if(limits_.cancel != nullptr &&
+					limits_.cancel->load(std::memory_order_relaxed)){
+				stats_.cancelled = true;
+				break;
+			}
+			if(timed && std::chrono::steady_clock::now() >= deadline_){
+				stats_.timedOut = true;
+				break;
+			}
+		}
+
+		int alternative = frame.next++;
+		Frame & next = frames_[depth + 1];
+		next.board = frame.board;
+		++nodes;
+
+		if(!next.board.assign(frame.branch.cells[alternative],
+				frame.branch.values[alternative]) ||
+				!Propagator::propagate(next.board)){
+			++stats_.backtracks;
+			continue;
+		}
+
+		if(next.board.isSolved()){
+			if(found == 0 && firstSolution != nullptr)
+				*firstSolution = next.board;
+			if(++found == limit)
+				break;
+			continue;
+		}
+
+		next.board.refreshBuckets();
+		heuristic_->chooseBranch(next.board, next.branch);
+		next.next = 0;
+		++depth;
+		if(depth > stats_.maxDepth)
+			stats_.maxDepth = depth;
+	}
+
+	stats_.nodes += nodes;
+	return found;
+}
+
+const Solver::Stats & Solver::getStats() const {
+	return stats_;
+}
@@ -9,32 +9,34 @@
 #include <sstream>
 #include "Square.h"
 
+namespace {
+
+/* Mask of a single value, and of every value from 1 to PUZZLE_SIZE. */
+inline uint16_t maskOf(int value){
+	return static_cast<uint16_t>(1u << (value - 1));
+}
+
+const uint16_t ALL_VALUES = (1u << Square::PUZZLE_SIZE) - 1;
+
+} // namespace
+
 Square::Square(int row, int col, int value) :
-	row_(row), col_(col), isSet_(true), value_(value), possibleValues_({value})
+	row_(row), col_(col), isSet_(true), value_(value), possibleValues_(0)
 {
 	checkThrowCoordinate(row, ROW);
 	checkThrowCoordinate(col, COL);
 	checkThrowValue(value);
+	possibleValues_ = maskOf(value);
 }
 
 Square::Square(int row, int col) :
-		row_(row), col_(col), isSet_(false), value_(-1), possibleValues_()
+		row_(row), col_(col), isSet_(false), value_(-1),
+		possibleValues_(ALL_VALUES)
 {
 	checkThrowCoordinate(row, ROW);
 	checkThrowCoordinate(col, COL);
-
-	for(int i = 1; i<=PUZZLE_SIZE; i++){
-		auto ret = possibleValues_.insert(i);
-		if(!ret.second)
-			throw std::runtime_error("Couldn't insert values into set?");
-	}
 }
 
-Square::Square(const Square & other) :
-		row_(other.row_), col_(other.col_), isSet_(other.isSet_),
-		value_(other.value_), possibleValues_(other.possibleValues_)
-{}
-
 bool Square::setValue(int newValue){
 	checkThrowValue(newValue);
 
@@ -43,16 +45,12 @@ bool Square::setValue(int newValue){
 		return false;
 
 	// Can't set a square if the given value isn't allowed.
-	if(possibleValues_.count(newValue) == 0)
+	if((possibleValues_ & maskOf(newValue)) == 0)
 		return false;
 
 	value_ = newValue;
 	isSet_ = true;
-	possibleValues_.clear();
-
-	auto ret = possibleValues_.insert(value_);
-	if(!ret.second)
-		throw std::runtime_error("Could not insert new value into set?");
+	possibleValues_ = maskOf(newValue);
 
 	return true;
 }
@@ -91,73 +89,89 @@ int Square::getValue() const {
 	return value_;
 }
 
-std::set<int> Square::getPossibleValues() const {
-	return possibleValues_;
+CandidateView Square::getPossibleValues() const {
+	return CandidateView(possibleValues_);
+}
+
+bool Square::restrictValue(int value){
+
+	// Check that potential restrict-ee is valid.
+	checkThrowValue(value);
+
+	/* If the value was already not possible for this square, there's no point
+	 * in further processing _this_ value in the list. */
+	if((possibleValues_ & maskOf(value)) == 0)
+		return false;
+	possibleValues_ &= ~maskOf(value);
+
+	/* If there's only one possible value left, then that must be this
+	 * Square's value; set this square appropriately. */
+	if((possibleValues_ & (possibleValues_ - 1)) == 0){
+		value_ = __builtin_ctz(possibleValues_) + 1;
+		isSet_ = true;
+		return true;
+	}
+
+	return false;
 }
 
-bool Square::restrictValues(std::set<int> vals){
+bool Square::restrictValues(const std::set<int> & vals){
 	// If this square is already set, then there's no point in continuing.
 	if(isSet_)
 		return false;
 
-	for(auto & x: vals){
+	for(int x : vals){
+		if(restrictValue(x))
+			return true;
+	}
 
-		// Check that potential restrict-ee is valid.
-		checkThrowValue(x);
+	return false;
+}
 
-		/* std::set::erase() returns the number of elements erased. If 0 was
-		 * returned, then the value was already not possible for this square,
-		 * so there's no point in further processing _this_ value in the
-		 * list. */
-		if(possibleValues_.erase(x) == 0)
-			continue;
+bool Square::restrictValues(std::initializer_list<int> vals){
+	return restrictValues(vals.begin(), vals.size());
+}
+
+bool Square::restrictValues(const int * vals, std::size_t count){
+	if(isSet_)
+		return false;
 
-		/* If there's only one possible value left, then that must be this
-		 * Square's value; set this square appropriately and return. */
-		if(possibleValues_.size() == 1){
-			value_ = *(possibleValues_.begin());
-			isSet_ = true;
+	for(std::size_t i = 0; i < count; ++i){
+		if(restrictValue(vals[i]))
 			return true;
-		}
 	}
 
 	return false;
 }
 
-Square & Square::operator=(const Square & other){
+bool Square::restrictValues(CandidateView vals){
+	if(isSet_)
+		return false;
 
-	// Handle self-assignment.
-	if(this==&other)
-		return *this;
+	for(int x : vals){
+		if(restrictValue(x))
+			return true;
+	}
 
-	this->row_ = other.row_;
-	this->col_ = other.col_;
-	this->isSet_ = other.isSet_;
-	this->value_ = other.value_;
-	this->possibleValues_ = other.possibleValues_;
-	return *this;
+	return false;
 }
 
-void Square::checkThrowCoordinate(int coord, rowcol rc){
-	if(coord < 0 || coord >= PUZZLE_SIZE){
-		std::ostringstream o;
-		o << "Invalid ";
-		if(rc == ROW)
-			o << "row";
-		else
-			o << "col";
+void Square::throwInvalidCoordinate(int coord, rowcol rc){
+	std::ostringstream o;
+	o << "Invalid ";
+	if(rc == ROW)
+		o << "row";
+	else
+		o << "col";
 
-		o << " '" << coord << "' supplied.";
-		throw std::out_of_range(o.str());
-	}
+	o << " '" << coord << "' supplied.";
+	throw std::out_of_range(o.str());
 }
 
-void Square::checkThrowValue(int value){
-	if(value < 1 || value > PUZZLE_SIZE){
-		std::ostringstream o;
-		o << "Invalid value '" << value << "' supplied.";
-		throw std::out_of_range(o.str());
-	}
+void Square::throwInvalidValue(int value){
+	std::ostringstream o;
+	o << "Invalid value '" << value << "' supplied.";
+	throw std::out_of_range(o.str());
 }
 
 std::string Square::toString() const {
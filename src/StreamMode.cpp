@@ -0,0 +1,75 @@
+/*
+ * StreamMode.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "StreamMode.h"
+#include "PuzzleIO.h"
+#include "Solver.h"
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+StreamStats runStreamMode(int inFd, int outFd,
+		const Solver::Limits & limits, LatencyHistogram * latency){
+	StreamStats stats;
+	ChunkedReader reader(inFd);
+	BoundedWriter writer(outFd);
+
+	// The search stack is too big to comfortably live on the stack.
+	std::unique_ptr<Solver> solver(new Solver());
+	solver->setLimits(limits);
+
+	Board board;
+	uint8_t givens[Board::NUM_CELLS];
+	char out[Board::NUM_CELLS + 1];
+	out[Board::NUM_CELLS] = '\n';
+
+	const char * line;
+	std::size_t length;
+
+	for(;;){
+		// About to wait on the producer; let the consumer have what is done.
+		if(!reader.hasBufferedLine())
+			writer.flush();
+
+		if(!reader.nextLine(line, length))
+			break;
+
+		if(length == 0)
+			continue;
+
+		++stats.records;
+
+		if(!parsePuzzleLine(line, length, givens)){
+			++stats.invalid;
+			writer.write(INVALID_LINE, strlen(INVALID_LINE));
+			continue;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		Solver::Status status = board.load(givens) ?
+				solver->solve(board) : Solver::UNSOLVABLE;
+		if(latency != nullptr)
+			latency->record(std::chrono::steady_clock::now() - start);
+		if(status == Solver::TIMED_OUT || status == Solver::CANCELLED){
+			++stats.timedOut;
+			writer.write(TIMED_OUT_LINE, strlen(TIMED_OUT_LINE));
+			continue;
+		}
+		if(status != Solver::SOLVED){
+			++stats.unsolvable;
+			writer.write(UNSOLVABLE_LINE, strlen(UNSOLVABLE_LINE));
+			continue;
+		}
+
+		++stats.solved;
+		formatPuzzleLine(board, out);
+		writer.write(out, sizeof(out));
+	}
+
+	writer.flush();
+	return stats;
+}
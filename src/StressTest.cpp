@@ -0,0 +1,259 @@
+/*
+ * StressTest.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "StressTest.h"
+#include "Board.h"
+#include "Engine.h"
+#include "Heuristics.h"
+#include "Parallel.h"
+#include "Solver.h"
+#include "Verifier.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/* Heuristic the solved grids are found with. */
+const char GRID_HEURISTIC[] = "mrv+random";
+
+/* Fewest and most givens a puzzle is given. Random givens seldom leave one
+ * solution below about 30, so the range gives puzzles of both kinds. */
+const int MIN_GIVENS = 24;
+const int MAX_GIVENS = 48;
+
+/* Nodes before the first restart, when restarts are on. */
+const uint64_t FIRST_RESTART = 64;
+
+/* The Solver with a given heuristic, and restarts if firstRestart is not 0. */
+class HeuristicEngine : public Engine {
+public:
+	HeuristicEngine(const std::string & heuristic, uint64_t firstRestart,
+			uint64_t seed) :
+			solver_(new Solver()),
+			name_("backtrack/" + heuristic)
+	{
+		solver_->setHeuristic(makeHeuristic(heuristic));
+		if(firstRestart != 0){
+			solver_->setRestarts(firstRestart, seed);
+			name_ += "/restarts";
+		}
+	}
+
+	Solver::Status solve(Board & board){
+		return solver_->solve(board);
+	}
+
+	void setLimits(const Solver::Limits & limits){
+		solver_->setLimits(limits);
+	}
+
+	uint64_t getNodes() const {
+		return solver_->getStats().nodes;
+	}
+
+	std::string getName() const { return name_; }
+
+private:
+	std::unique_ptr<Solver> solver_;
+
+	std::string name_;
+};
+
+/* What one thread solves with. */
+struct Worker {
+	/* Finds the solved grids. */
+	std::unique_ptr<Solver> generator;
+
+	/* Counts the solutions, as the reference. */
+	std::unique_ptr<Solver> counter;
+
+	std::vector<std::unique_ptr<Engine> > engines;
+
+	StressReport report;
+};
+
+std::unique_ptr<Worker> makeWorker(const Solver::Limits & limits,
+		uint64_t seed){
+	std::unique_ptr<Worker> worker(new Worker());
+	worker->generator.reset(new Solver());
+	worker->generator->setHeuristic(makeHeuristic(GRID_HEURISTIC));
+	worker->counter.reset(new Solver());
+	worker->counter->setLimits(limits);
+
+	for(const char * const * name = getEngineNames(); *name != nullptr; ++name)
+		worker->engines.push_back(makeEngine(*name));
+	for(const char * const * name = getHeuristicNames(); *name != nullptr;
+			++name)
+		worker->engines.push_back(std::unique_ptr<Engine>(
+				new HeuristicEngine(*name, 0, seed)));
+	worker->engines.push_back(std::unique_ptr<Engine>(
+			new HeuristicEngine("degree+random", FIRST_RESTART, seed)));
+	for(auto & engine : worker->engines)
+		engine->setLimits(limits);
+	return worker;
+}
+
+/* Fills givens with puzzle i of the seed, returning whether a given was
+ * changed from the solved grid, which is put in grid. */
+bool makePuzzle(uint64_t seed, uint64_t i, Solver & generator,
+		uint8_t grid[Board::NUM_CELLS], uint8_t givens[Board::NUM_CELLS]){
+	std::seed_seq sequence{seed >> 32, seed, i >> 32, i};
+	std::mt19937_64 random(sequence);
+
+	Board board;
+	generator.getHeuristic().restart(random());
+	generator.solve(board);
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		grid[cell] = static_cast<uint8_t>(board.getValue(cell));
+
+	int cells[Board::NUM_CELLS];
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		cells[cell] = cell;
+	std::shuffle(cells, cells + Board::NUM_CELLS, random);
+	int count = std::uniform_int_distribution<int>(MIN_GIVENS,
+			MAX_GIVENS)(random);
+	std::fill(givens, givens + Board::NUM_CELLS, 0);
+	for(int k = 0; k < count; ++k)
+		givens[cells[k]] = grid[cells[k]];
+
+	if(random() % 8 != 0)
+		return false;
+
+	/* A value that no peer has as a given, if there is one, so that the
+	 * puzzle is not contradicted outright and the engines have to search to
+	 * find it has no solution. */
+	int cell = cells[random() % count];
+	uint16_t used = Board::maskOf(givens[cell]);
+	const int * peers = Board::getPeers(cell);
+	for(int k = 0; k < Board::NUM_PEERS; ++k)
+		if(givens[peers[k]] != 0)
+			used |= Board::maskOf(givens[peers[k]]);
+	std::vector<uint8_t> values;
+	for(int value = 1; value <= Board::PUZZLE_SIZE; ++value)
+		if((used & Board::maskOf(value)) == 0)
+			values.push_back(static_cast<uint8_t>(value));
+	givens[cell] = values.empty() ?
+			static_cast<uint8_t>(givens[cell] % Board::PUZZLE_SIZE + 1) :
+			values[random() % values.size()];
+	return true;
+}
+
+void getValues(const Board & board, uint8_t values[Board::NUM_CELLS]){
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		values[cell] = static_cast<uint8_t>(board.getValue(cell));
+}
+
+std::string formatGivens(const uint8_t givens[Board::NUM_CELLS]){
+	std::string line(Board::NUM_CELLS, '.');
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		if(givens[cell] != 0)
+			line[cell] = static_cast<char>('0' + givens[cell]);
+	return line;
+}
+
+} // namespace
+
+StressReport runStressTest(const StressOptions & options, std::ostream & log){
+	int threads = resolveThreads(options.threads);
+	Solver::Limits limits;
+	limits.maxNodes = options.maxNodes;
+
+	std::vector<std::unique_ptr<Worker> > workers;
+	for(int thread = 0; thread < threads; ++thread)
+		workers.push_back(makeWorker(limits, options.seed + thread));
+
+	std::mutex logMutex;
+	runParallel(options.puzzles, threads, [&](int thread, std::size_t i){
+		Worker & worker = *workers[thread];
+		StressReport & report = worker.report;
+		uint8_t grid[Board::NUM_CELLS];
+		uint8_t givens[Board::NUM_CELLS];
+		bool changed = makePuzzle(options.seed, i, *worker.generator, grid,
+				givens);
+
+		auto mismatch = [&](const std::string & engine,
+				const std::string & what){
+			++report.mismatches;
+			std::lock_guard<std::mutex> lock(logMutex);
+			log << "Puzzle " << i << " " << formatGivens(givens) << ": "
+					<< engine << " " << what << "." << std::endl;
+		};
+
+		Board puzzle;
+		if(!puzzle.load(givens)){
+			if(!changed)
+				mismatch("load", "rejected the givens of a solved grid");
+			++report.contradicted;
+			return;
+		}
+
+		Board first;
+		uint64_t count = worker.counter->countSolutions(puzzle, 2, &first);
+		if(worker.counter->getStats().timedOut){
+			++report.timedOut;
+			return;
+		}
+		uint8_t solution[Board::NUM_CELLS];
+		getValues(first, solution);
+		if(count == 0)
+			++report.unsolvable;
+		else if(count == 1)
+			++report.unique;
+		else
+			++report.multiple;
+		if(!changed && (count == 0 || (count == 1 &&
+				!std::equal(solution, solution + Board::NUM_CELLS, grid))))
+			mismatch("countSolutions", "lost the grid the puzzle came from");
+
+		for(auto & engine : worker.engines){
+			Board board = puzzle;
+			Solver::Status status = engine->solve(board);
+			++report.solves;
+			if(status == Solver::TIMED_OUT){
+				++report.timedOut;
+				continue;
+			}
+			if((status == Solver::SOLVED) != (count > 0)){
+				mismatch(engine->getName(), status == Solver::SOLVED ?
+						"solved a puzzle with no solution" :
+						"found no solution to a puzzle with " +
+						std::to_string(count));
+				continue;
+			}
+			if(status != Solver::SOLVED)
+				continue;
+
+			uint8_t values[Board::NUM_CELLS];
+			getValues(board, values);
+			VerifyResult result = verifySolution(values, givens);
+			if(result != VALID)
+				mismatch(engine->getName(), std::string("gave a solution "
+						"that is not valid: ") + describe(result));
+			else if(count == 1 &&
+					!std::equal(values, values + Board::NUM_CELLS, solution))
+				mismatch(engine->getName(), "gave another solution to a "
+						"puzzle with one");
+		}
+	});
+
+	StressReport total;
+	for(const auto & worker : workers){
+		const StressReport & report = worker->report;
+		total.unique += report.unique;
+		total.multiple += report.multiple;
+		total.unsolvable += report.unsolvable;
+		total.contradicted += report.contradicted;
+		total.solves += report.solves;
+		total.timedOut += report.timedOut;
+		total.mismatches += report.mismatches;
+	}
+	return total;
+}
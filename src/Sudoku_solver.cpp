@@ -5,22 +5,1059 @@
  *      Author: alex
  */
 #include <iostream>
+#include <fstream>
+#include <iomanip>
 #include <string>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "Puzzle.h"
+#include "Solver.h"
+#include "ParallelSolver.h"
+#include "Enumerator.h"
+#include "HintEngine.h"
+#include "PuzzleIO.h"
+#include "StreamMode.h"
+#include "BatchPipeline.h"
+#include "CompressedStream.h"
+#include "CorpusChecker.h"
+#include "CorpusIndex.h"
+#include "Deduplicator.h"
+#include "Difficulty.h"
+#include "Engine.h"
+#include "LatencyHistogram.h"
+#include "SatSolver.h"
+#include "StressTest.h"
 
-extern void testSquare();
-extern void testPuzzle();
+static void printUsage(const char * program){
+	std::cerr << "Usage:\n"
+			<< "  " << program << " <puzzle file> [--engine backtrack|sat]\n"
+			<< "      Solve the puzzle in the file and print the solution.\n"
+			<< "  " << program << " --dimacs <puzzle file> [--diagonals]\n"
+			<< "      Print the puzzle as CNF in DIMACS format; --diagonals "
+			"adds the X-Sudoku\n"
+			<< "      rule that each diagonal holds every value.\n"
+			<< "  " << program << " --parallel <puzzle file> [--threads N] "
+			"[--count LIMIT]\n"
+			<< "      Solve one hard puzzle with N threads, or count its "
+			"solutions up to LIMIT.\n"
+			<< "  " << program << " --enumerate <puzzle file> [--limit N] "
+			"[--seconds S]\n"
+			<< "      [--checkpoint FILE]\n"
+			<< "      Print each solution on its own line, stopping after N "
+			"or S seconds; the\n"
+			<< "      checkpoint file, if given, is resumed from and updated.\n"
+			<< "  " << program << " --hint <puzzle file>\n"
+			<< "      Print the next logical step for the puzzle, as far as "
+			"it is filled in.\n"
+			<< "  " << program << " --stream [--max-ms MS] [--max-nodes N] "
+			"[--report-every S]\n"
+			<< "      [--latency-json FILE]\n"
+			<< "      Solve one-line puzzles from stdin as they arrive, "
+			"writing one line per\n"
+			<< "      puzzle to stdout.\n"
+			<< "  " << program << " --batch <input> <output> [--threads N] "
+			"[--slots N]\n"
+			<< "      [--max-ms MS] [--max-nodes N] [--shard I/N] "
+			"[--checkpoint FILE]\n"
+			<< "      [--checkpoint-every N] [--resume] "
+			"[--compress gzip|zstd|none]\n"
+			<< "      [--report-every S] [--latency-json FILE]\n"
+			<< "      Solve a file of one-line or binary puzzles with a reader, "
+			"N solver and a\n"
+			<< "      writer thread; '-' is stdin or stdout. Queue metrics go "
+			"to stderr.\n"
+			<< "      A puzzle that takes more than MS milliseconds or N search "
+			"nodes is\n"
+			<< "      given up on and written as 'timed out'. --shard solves "
+			"only the I-th of N\n"
+			<< "      even runs of records, counting from 0, found with the "
+			"input's index.\n"
+			<< "      --checkpoint saves progress every N records (default "
+			"100000) once the\n"
+			<< "      output is synced; --resume carries on from it, cutting "
+			"the output back to\n"
+			<< "      the checkpoint and appending.\n"
+			<< "      gzip and zstd input is decompressed on its own thread; "
+			"the output is\n"
+			<< "      compressed as --compress says, or as its name ends in "
+			".gz or .zst.\n"
+			<< "  " << program << " --index <input> [--every M]\n"
+			<< "      Write the index that --shard needs to <input>.idx, "
+			"with the offset of\n"
+			<< "      every M-th record (default "
+			<< DEFAULT_INDEX_STRIDE << ").\n"
+			<< "  " << program << " --pack <input> <output>\n"
+			<< "      Convert one-line puzzles to the binary format, 41 bytes "
+			"a puzzle,\n"
+			<< "      dropping invalid lines.\n"
+			<< "  " << program << " --verify <directory|batch file> "
+			"[--threads N]\n"
+			<< "      Check puzzle/solution pairs: NNN.*.txt against "
+			"NNN.soln.txt in a\n"
+			<< "      directory, or lines of '<puzzle> <solution>' in a batch "
+			"file.\n"
+			<< "  " << program << " --dedup <input> <unique output> "
+			"<groups output> [--threads N]\n"
+			<< "      Drop puzzles isomorphic to an earlier one, writing the "
+			"groups of\n"
+			<< "      isomorphic puzzles, by line number, to the groups "
+			"output.\n"
+			<< "  " << program << " --rate <input> <output> [--threads N] "
+			"[--tiers LIST]\n"
+			<< "      [--max-ms MS] [--max-nodes N] [--report-every S] "
+			"[--latency-json FILE]\n"
+			<< "      Rate every puzzle by the techniques and search it takes, "
+			"writing its tier\n"
+			<< "      and metrics, one line per record. LIST is tiers, easiest "
+			"first; the\n"
+			<< "      default is:\n"
+			<< "      " << DEFAULT_TIERS << "\n"
+			<< "  " << program << " --stress [--puzzles N] [--threads N] "
+			"[--seed S]\n"
+			<< "      Solve N random puzzles (default 10000) with every engine "
+			"and heuristic on\n"
+			<< "      N threads at once, checking that they all agree; exits "
+			"with 1 if not.\n"
+			<< "--stream, --batch and --rate end with the p50, p90, p99, "
+			"p999 and max time a\n"
+			<< "puzzle took and the puzzles per second; --report-every "
+			"prints them every S\n"
+			<< "seconds as well, and --latency-json writes the whole "
+			"histogram to FILE.\n"
+			<< "Tests are in Sudoku_tests and benchmarks in Sudoku_bench."
+			<< std::endl;
+}
 
-int main(int argc, char * argv[]){
+/* Loads the puzzle file into board. Returns 0 on success, or the exit code
+ * having printed why not. */
+static int loadFile(const std::string & filename, Board & board){
+	try{
+		Puzzle puzzle(filename);
+		if(!board.load(puzzle)){
+			std::cout << "The puzzle has no solution." << std::endl;
+			return 1;
+		}
+	}
+	catch(Puzzle::PuzzleFileException & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+	return 0;
+}
+
+static int dimacs(int argc, char * argv[]){
+	bool diagonals = argc == 4 && std::string(argv[3]) == "--diagonals";
+	if(argc != 3 && !diagonals){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	try{
+		Cnf cnf = encodeSudoku(Puzzle(argv[2]), diagonals ?
+				getDiagonalUnits() : std::vector<std::vector<int> >());
+		cnf.writeDimacs(std::cout);
+		std::cout.flush();
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+	return std::cout ? 0 : 2;
+}
+
+/* Writes a cell as r<row>c<col>, counting from 1. */
+static void printCell(int cell){
+	std::cout << 'r' << Board::rowOf(cell) + 1 << 'c' << Board::colOf(cell) + 1;
+}
+
+static int hint(int argc, char * argv[]){
+	if(argc != 3){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	Hint hint;
+	try{
+		if(!HintEngine::findHint(Puzzle(argv[2]), hint)){
+			std::cout << "No hint: the puzzle is solved or needs search."
+					<< std::endl;
+			return 1;
+		}
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+
+	std::cout << Hint::getTechniqueName(hint.technique) << ": ";
+	if(hint.technique == Hint::CONTRADICTION){
+		for(int i = 0; i < hint.numCells; ++i){
+			printCell(hint.cells[i]);
+			std::cout << ' ';
+		}
+		if(hint.value != 0)
+			std::cout << "value " << hint.value << ' ';
+		if(hint.unit >= 0)
+			std::cout << "in unit " << hint.unit << ' ';
+		std::cout << "cannot be right." << std::endl;
+		return 1;
+	}
+
+	if(hint.cell >= 0){
+		std::cout << "set ";
+		printCell(hint.cell);
+		std::cout << " to " << hint.value << std::endl;
+		return 0;
+	}
+
+	std::cout << "remove";
+	for(int value = 1; value <= Board::PUZZLE_SIZE; ++value){
+		if((hint.removed & Board::maskOf(value)) != 0)
+			std::cout << ' ' << value;
+	}
+	std::cout << " from";
+	for(int cell = hint.targets.first(); cell >= 0;
+			cell = hint.targets.next(cell)){
+		std::cout << ' ';
+		printCell(cell);
+	}
+	std::cout << " (pattern:";
+	for(int i = 0; i < hint.numCells; ++i){
+		std::cout << ' ';
+		printCell(hint.cells[i]);
+	}
+	std::cout << ")" << std::endl;
+	return 0;
+}
+
+static int solveFile(const std::string & filename,
+		const std::string & engineName){
+	std::unique_ptr<Engine> engine = makeEngine(engineName);
+	if(!engine){
+		std::cerr << "Unknown engine '" << engineName << "'." << std::endl;
+		return 2;
+	}
+
+	Board board;
+	int loaded = loadFile(filename, board);
+	if(loaded != 0)
+		return loaded;
+
+	if(engine->solve(board) != Solver::SOLVED){
+		std::cout << "The puzzle has no solution." << std::endl;
+		return 1;
+	}
+
+	std::cout << board;
+	return 0;
+}
+
+static int parallel(int argc, char * argv[]){
+	if(argc < 3){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	ParallelSolver::Options options;
+	uint64_t countLimit = 0;
+	for(int i = 3; i < argc; ++i){
+		std::string option(argv[i]);
+		if(option == "--threads" && i + 1 < argc)
+			options.threads = atoi(argv[++i]);
+		else if(option == "--count" && i + 1 < argc)
+			countLimit = strtoull(argv[++i], nullptr, 10);
+		else{
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	Board board;
+	int loaded = loadFile(argv[2], board);
+	if(loaded != 0)
+		return loaded;
+
+	ParallelSolver solver(options);
+	int result = 0;
+	if(countLimit > 0){
+		uint64_t count = solver.countSolutions(board, countLimit);
+		std::cout << count << (count == countLimit ? " or more" : "")
+				<< " solutions." << std::endl;
+		result = count == 0 ? 1 : 0;
+	}
+	else if(solver.solve(board) == Solver::SOLVED)
+		std::cout << board;
+	else{
+		std::cout << "The puzzle has no solution." << std::endl;
+		result = 1;
+	}
+
+	const ParallelSolver::Stats & stats = solver.getStats();
+	std::cerr << stats.nodes << " search nodes in " << stats.tasks
+			<< " tasks split at depth " << stats.splitDepth << "; "
+			<< stats.steals << " stolen, " << stats.cancelledTasks
+			<< " cancelled; " << solver.getThreads() << " threads."
+			<< std::endl;
+	return result;
+}
 
-	if(argc==2 && std::string(argv[1])=="testSquare")
-		testSquare();
-	else if(argc == 2 && std::string(argv[1])=="testPuzzle")
-		testPuzzle();
+static int enumerate(int argc, char * argv[]){
+	if(argc < 3){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	Enumerator::Options options;
+	std::string checkpointFile;
+	for(int i = 3; i < argc; ++i){
+		std::string option(argv[i]);
+		if(option == "--limit" && i + 1 < argc)
+			options.limit = strtoull(argv[++i], nullptr, 10);
+		else if(option == "--seconds" && i + 1 < argc)
+			options.timeBudget = std::chrono::duration_cast<
+					std::chrono::steady_clock::duration>(
+					std::chrono::duration<double>(atof(argv[++i])));
+		else if(option == "--checkpoint" && i + 1 < argc)
+			checkpointFile = argv[++i];
+		else{
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	Board board;
+	int loaded = loadFile(argv[2], board);
+	if(loaded != 0)
+		return loaded;
+
+	std::unique_ptr<Enumerator> enumerator(new Enumerator(options));
+	Enumerator::Status status;
+	try{
+		Enumerator::Checkpoint checkpoint;
+		std::ifstream in(checkpointFile.c_str());
+		std::string line;
+		if(!checkpointFile.empty() && std::getline(in, line))
+			checkpoint = Enumerator::Checkpoint::fromString(line);
+
+		status = enumerator->resume(board, checkpoint,
+				[](const Board & solution){
+			char out[Board::NUM_CELLS + 1];
+			formatPuzzleLine(solution, out);
+			out[Board::NUM_CELLS] = '\n';
+			std::cout.write(out, sizeof(out));
+			return true;
+		});
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+	std::cout.flush();
+
+	const Enumerator::Checkpoint & checkpoint = enumerator->getCheckpoint();
+	if(!checkpointFile.empty()){
+		std::ofstream out(checkpointFile.c_str());
+		out << checkpoint.toString() << std::endl;
+		if(!out){
+			std::cerr << "Could not write '" << checkpointFile << "'."
+					<< std::endl;
+			return 2;
+		}
+	}
+
+	static const char * ENDINGS[] = {"all found", "limit reached",
+			"out of time", "stopped"};
+	std::cerr << enumerator->getStats().solutions << " solutions ("
+			<< checkpoint.solutions << " in all), "
+			<< enumerator->getStats().nodes << " search nodes; "
+			<< ENDINGS[status] << "." << std::endl;
+	return checkpoint.solutions == 0 && status == Enumerator::EXHAUSTED ? 1 : 0;
+}
+
+/* Parses --max-ms or --max-nodes and its value at argv[i] into limits,
+ * advancing i past them. Returns false if argv[i] is neither. */
+static bool parseLimit(int argc, char * argv[], int & i,
+		Solver::Limits & limits){
+	std::string option(argv[i]);
+	if(i + 1 >= argc)
+		return false;
+	if(option == "--max-ms")
+		limits.timeBudget = std::chrono::milliseconds(atoll(argv[++i]));
+	else if(option == "--max-nodes")
+		limits.maxNodes = strtoull(argv[++i], nullptr, 10);
+	else
+		return false;
+	return true;
+}
+
+/* How the modes that solve many puzzles report the time each takes. */
+struct LatencyOptions {
+	/* Interval between progress lines on stderr, or zero for none. */
+	std::chrono::milliseconds reportEvery;
+
+	/* File to write the histogram to as JSON, or empty for none. */
+	std::string jsonPath;
+
+	LatencyOptions() : reportEvery(0) {}
+};
+
+/* Parses --report-every or --latency-json and its value at argv[i] into
+ * options, advancing i past them. Returns false if argv[i] is neither. */
+static bool parseLatencyOption(int argc, char * argv[], int & i,
+		LatencyOptions & options){
+	std::string option(argv[i]);
+	if(i + 1 >= argc)
+		return false;
+	if(option == "--report-every")
+		options.reportEvery = std::chrono::milliseconds(
+				static_cast<long long>(atof(argv[++i]) * 1000));
+	else if(option == "--latency-json")
+		options.jsonPath = argv[++i];
 	else
-		std::cout << "Nothing to see yet!" << std::endl;
+		return false;
+	return true;
+}
+
+/* Prints the latency summary of a run that took the given seconds, and writes
+ * the histogram as JSON if asked to. Returns false, having printed why, if the
+ * JSON could not be written. */
+static bool reportLatency(const LatencyHistogram & latency, double seconds,
+		const LatencyOptions & options){
+	std::cerr << latency.formatSummary(seconds) << std::endl;
+	if(options.jsonPath.empty())
+		return true;
+
+	std::ofstream json(options.jsonPath);
+	json << latency.formatJson(seconds) << "\n";
+	json.close();
+	if(!json){
+		std::cerr << "Could not write '" << options.jsonPath << "'."
+				<< std::endl;
+		return false;
+	}
+	return true;
+}
+
+static int streamStdin(int argc, char * argv[]){
+	Solver::Limits limits;
+	LatencyOptions latencyOptions;
+	for(int i = 2; i < argc; ++i){
+		if(!parseLimit(argc, argv, i, limits) &&
+				!parseLatencyOption(argc, argv, i, latencyOptions)){
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	LatencyHistogram latency;
+	LatencyReporter reporter(latency, std::cerr, latencyOptions.reportEvery);
+	try{
+		StreamStats stats = runStreamMode(STDIN_FILENO, STDOUT_FILENO,
+				limits, &latency);
+		reporter.stop();
+		std::cerr << stats.records << " puzzles: " << stats.solved
+				<< " solved, " << stats.unsolvable << " unsolvable, "
+				<< stats.invalid << " invalid, " << stats.timedOut
+				<< " timed out." << std::endl;
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+	return reportLatency(latency, reporter.getSeconds(), latencyOptions) ?
+			0 : 2;
+}
+
+/* Opens path for reading or writing, with '-' meaning stdin or stdout.
+ * Returns -1, having printed why, on failure. */
+static int openPath(const std::string & path, bool forWriting){
+	if(path == "-")
+		return forWriting ? STDOUT_FILENO : STDIN_FILENO;
+
+	int fd = forWriting ?
+			open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) :
+			open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		std::cerr << "Could not open '" << path << "': " << strerror(errno)
+				<< "." << std::endl;
+	return fd;
+}
+
+static void printQueueMetrics(const char * name, const QueueMetrics & metrics){
+	std::cerr << std::left << std::setw(8) << name << std::right
+			<< std::setw(10) << metrics.capacity
+			<< std::setw(12) << std::fixed << std::setprecision(1)
+			<< metrics.getAverageDepth()
+			<< std::setw(12) << metrics.maxDepth
+			<< std::setw(17) << metrics.producerStalls
+			<< std::setw(17) << metrics.consumerStalls << "\n";
+}
+
+/* Parses a shard as I/N, with I less than N. */
+static bool parseShard(const char * text, uint64_t & shard, uint64_t & shards){
+	char * slash;
+	shard = strtoull(text, &slash, 10);
+	if(slash == text || *slash != '/')
+		return false;
+	char * end;
+	shards = strtoull(slash + 1, &end, 10);
+	return end != slash + 1 && *end == '\0' && shard < shards;
+}
 
+/*
+ * Positions in at the first record to solve and sets the format and byte limit
+ * of options to match: the whole input, or the shard found with the input's
+ * index. Returns false, having printed why, on failure.
+ */
+static bool selectInput(int in, const std::string & path, bool sharded,
+		uint64_t shard, uint64_t shards, BatchPipeline::Options & options){
+	if(!sharded){
+		if(in == STDIN_FILENO)
+			return true;
+		options.format = detectCorpusFormat(in);
+		if(options.format == BINARY_FORMAT)
+			lseek(in, BINARY_HEADER_SIZE, SEEK_SET);
+		return true;
+	}
+
+	if(in == STDIN_FILENO){
+		std::cerr << "--shard needs an input file with an index." << std::endl;
+		return false;
+	}
+	int indexFd = open(getIndexPath(path).c_str(), O_RDONLY);
+	if(indexFd < 0){
+		std::cerr << "Could not open '" << getIndexPath(path) << "': "
+				<< strerror(errno) << "; build it with --index." << std::endl;
+		return false;
+	}
+	CorpusIndex index;
+	try{
+		index = readCorpusIndex(indexFd);
+	}
+	catch(std::exception & e){
+		close(indexFd);
+		throw;
+	}
+	close(indexFd);
+
+	ShardRange range = locateShard(in, index, shard, shards);
+	std::cerr << "Shard " << shard << "/" << shards << ": records "
+			<< range.firstRecord << " to " << range.endRecord << " of "
+			<< index.records << ".\n";
+	if(lseek(in, static_cast<off_t>(range.beginOffset), SEEK_SET) < 0)
+		throw std::runtime_error("Could not seek to the shard.");
+	options.format = index.format;
+	options.inputLimit = range.endOffset - range.beginOffset;
+	return true;
+}
+
+static int batch(int argc, char * argv[]){
+	if(argc < 4){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	BatchPipeline::Options options;
+	LatencyOptions latencyOptions;
+	bool sharded = false;
+	uint64_t shard = 0;
+	uint64_t shards = 0;
+	bool resume = false;
+	Compression outputCompression = getCompressionForPath(argv[3]);
+	for(int i = 4; i < argc; ++i){
+		std::string option(argv[i]);
+		if(option == "--threads" && i + 1 < argc)
+			options.solverThreads = atoi(argv[++i]);
+		else if(option == "--compress" && i + 1 < argc){
+			try{
+				outputCompression = parseCompressionName(argv[++i]);
+			}
+			catch(std::invalid_argument & e){
+				std::cerr << e.what() << std::endl;
+				return 2;
+			}
+		}
+		else if(option == "--checkpoint" && i + 1 < argc)
+			options.checkpointPath = argv[++i];
+		else if(option == "--checkpoint-every" && i + 1 < argc)
+			options.checkpointEvery = strtoull(argv[++i], nullptr, 10);
+		else if(option == "--resume")
+			resume = true;
+		else if(option == "--slots" && i + 1 < argc)
+			options.slots = strtoul(argv[++i], nullptr, 10);
+		else if(option == "--shard" && i + 1 < argc &&
+				parseShard(argv[i + 1], shard, shards)){
+			sharded = true;
+			++i;
+		}
+		else if(!parseLimit(argc, argv, i, options.limits) &&
+				!parseLatencyOption(argc, argv, i, latencyOptions)){
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	if((resume && options.checkpointPath.empty()) ||
+			(!options.checkpointPath.empty() && std::string(argv[3]) == "-")){
+		std::cerr << "--resume needs --checkpoint, and checkpoints need an "
+				"output file." << std::endl;
+		return 2;
+	}
+
+	// A checkpoint is only resumed for the same input and shard.
+	BatchCheckpoint start;
+	start.input = argv[2];
+	if(sharded)
+		start.input += " shard " + std::to_string(shard) + "/" +
+				std::to_string(shards);
+	bool resuming = resume && access(options.checkpointPath.c_str(), F_OK) == 0;
+	if(resuming){
+		try{
+			std::string input = start.input;
+			start = BatchCheckpoint::load(options.checkpointPath);
+			if(start.input != input){
+				std::cerr << "The checkpoint is for '" << start.input
+						<< "', not '" << input << "'." << std::endl;
+				return 2;
+			}
+		}
+		catch(std::exception & e){
+			std::cerr << e.what() << std::endl;
+			return 2;
+		}
+	}
+
+	int in = openPath(argv[2], false);
+	if(in < 0)
+		return 2;
+	int out = resuming ? open(argv[3], O_WRONLY | O_CREAT, 0644) :
+			openPath(argv[3], true);
+	if(out < 0){
+		if(resuming)
+			std::cerr << "Could not open '" << argv[3] << "': "
+					<< strerror(errno) << "." << std::endl;
+		return 2;
+	}
+
+	/* A pipe cannot be read from the start again, so the bytes read from it
+	 * to find its compression are passed on. */
+	std::string inputHeader;
+	Compression inputCompression;
+	try{
+		inputCompression = lseek(in, 0, SEEK_CUR) < 0 ?
+				readCompression(in, inputHeader) : detectCompression(in);
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+
+	/* Compressed files cannot be seeked in, so neither sharded nor resumed;
+	 * and a compressed output cannot be synced up to a checkpoint. */
+	if((inputCompression != NO_COMPRESSION ||
+			outputCompression != NO_COMPRESSION) &&
+			(sharded || !options.checkpointPath.empty())){
+		std::cerr << "--shard and --checkpoint need uncompressed files."
+				<< std::endl;
+		return 2;
+	}
+
+	try{
+		std::unique_ptr<DecompressingInput> decompressor;
+		std::unique_ptr<CompressingOutput> compressor;
+		int pipelineIn = in;
+		int pipelineOut = out;
+		if(inputCompression != NO_COMPRESSION){
+			decompressor.reset(new DecompressingInput(in, inputCompression,
+					inputHeader));
+			options.format = decompressor->getFormat();
+			pipelineIn = decompressor->getFd();
+		}
+		else{
+			options.inputPrefix = inputHeader;
+			if(!selectInput(in, argv[2], sharded, shard, shards, options))
+				return 2;
+		}
+		if(outputCompression != NO_COMPRESSION){
+			compressor.reset(new CompressingOutput(out, outputCompression));
+			pipelineOut = compressor->getFd();
+		}
+		if(resuming){
+			seekToCheckpoint(in, out, start);
+			if(options.inputLimit != ChunkedReader::NO_LIMIT)
+				options.inputLimit -= start.inputOffset;
+			std::cerr << "Resuming after " << start.records << " puzzles.\n";
+		}
+		LatencyHistogram latency;
+		options.latency = &latency;
+		LatencyReporter reporter(latency, std::cerr,
+				latencyOptions.reportEvery);
+		BatchPipeline pipeline(options);
+		PipelineStats stats = pipeline.run(pipelineIn, pipelineOut, start);
+		if(decompressor)
+			decompressor->finish();
+		if(compressor)
+			compressor->finish();
+		reporter.stop();
+
+		std::cerr << stats.records << " puzzles: " << stats.solved
+				<< " solved, " << stats.unsolvable << " unsolvable, "
+				<< stats.invalid << " invalid, " << stats.timedOut
+				<< " timed out; " << stats.nodes
+				<< " search nodes, " << pipeline.getSolverThreads()
+				<< " solver threads.\n";
+		std::cerr << "queue     capacity   avg depth   max depth"
+				"  producer stalls  consumer stalls\n";
+		printQueueMetrics("free", stats.freeQueue);
+		printQueueMetrics("solve", stats.solveQueue);
+		printQueueMetrics("write", stats.writeQueue);
+		if(!reportLatency(latency, reporter.getSeconds(), latencyOptions))
+			return 2;
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+
+	if(in != STDIN_FILENO)
+		close(in);
+	if(out != STDOUT_FILENO && close(out) != 0){
+		std::cerr << "Could not write '" << argv[3] << "': "
+				<< strerror(errno) << "." << std::endl;
+		return 2;
+	}
+	return 0;
+}
+
+static int buildIndex(int argc, char * argv[]){
+	uint64_t stride = DEFAULT_INDEX_STRIDE;
+	if(argc == 5 && std::string(argv[3]) == "--every")
+		stride = strtoull(argv[4], nullptr, 10);
+	else if(argc != 3){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	std::string path(argv[2]);
+	int in = openPath(path, false);
+	if(in < 0)
+		return 2;
+
+	try{
+		CorpusIndex index = buildCorpusIndex(in, stride);
+		close(in);
+		int out = openPath(getIndexPath(path), true);
+		if(out < 0)
+			return 2;
+		writeCorpusIndex(out, index);
+		if(close(out) != 0){
+			std::cerr << "Could not write '" << getIndexPath(path) << "': "
+					<< strerror(errno) << "." << std::endl;
+			return 2;
+		}
+		std::cerr << index.records << " records, "
+				<< (index.format == BINARY_FORMAT ? "binary" : "text")
+				<< ", indexed every " << index.stride << " in '"
+				<< getIndexPath(path) << "'." << std::endl;
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+	return 0;
+}
+
+static int packPuzzles(int argc, char * argv[]){
+	if(argc != 4){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	int in = openPath(argv[2], false);
+	if(in < 0)
+		return 2;
+	int out = openPath(argv[3], true);
+	if(out < 0)
+		return 2;
+
+	uint64_t packed = 0;
+	uint64_t invalid = 0;
+	try{
+		CorpusReader reader(in, TEXT_FORMAT);
+		BoundedWriter writer(out);
+		writer.write(BINARY_MAGIC, BINARY_HEADER_SIZE);
+
+		uint8_t givens[Board::NUM_CELLS];
+		uint8_t record[BINARY_RECORD_SIZE];
+		bool valid;
+		while(reader.next(givens, valid)){
+			if(!valid){
+				++invalid;
+				continue;
+			}
+			packPuzzleRecord(givens, record);
+			writer.write(reinterpret_cast<const char *>(record),
+					BINARY_RECORD_SIZE);
+			++packed;
+		}
+		writer.flush();
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+
+	if(in != STDIN_FILENO)
+		close(in);
+	if(out != STDOUT_FILENO && close(out) != 0){
+		std::cerr << "Could not write '" << argv[3] << "': "
+				<< strerror(errno) << "." << std::endl;
+		return 2;
+	}
+	std::cerr << packed << " puzzles packed, " << invalid
+			<< " invalid lines dropped." << std::endl;
 	return 0;
 }
 
+static int dedup(int argc, char * argv[]){
+	if(argc != 5 && !(argc == 7 && std::string(argv[5]) == "--threads")){
+		printUsage(argv[0]);
+		return 2;
+	}
+	int threads = argc == 7 ? atoi(argv[6]) : 0;
+
+	int in = openPath(argv[2], false);
+	if(in < 0)
+		return 2;
+	int unique = openPath(argv[3], true);
+	if(unique < 0)
+		return 2;
+	int groups = openPath(argv[4], true);
+	if(groups < 0)
+		return 2;
 
+	try{
+		DedupReport report = dedupBatchFile(in, unique, groups, threads);
+		std::cerr << report.records << " puzzles: " << report.unique
+				<< " unique, " << report.duplicates << " duplicates in "
+				<< report.groups << " groups, " << report.invalid
+				<< " invalid." << std::endl;
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
 
+	if(in != STDIN_FILENO)
+		close(in);
+	for(int i = 3; i <= 4; ++i){
+		int fd = i == 3 ? unique : groups;
+		if(fd != STDOUT_FILENO && close(fd) != 0){
+			std::cerr << "Could not write '" << argv[i] << "': "
+					<< strerror(errno) << "." << std::endl;
+			return 2;
+		}
+	}
+	return 0;
+}
+
+static int rate(int argc, char * argv[]){
+	if(argc < 4){
+		printUsage(argv[0]);
+		return 2;
+	}
+	int threads = 0;
+	std::string tierList(DEFAULT_TIERS);
+	Solver::Limits limits;
+	LatencyOptions latencyOptions;
+	for(int i = 4; i < argc; ++i){
+		std::string option(argv[i]);
+		if(option == "--threads" && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if(option == "--tiers" && i + 1 < argc)
+			tierList = argv[++i];
+		else if(!parseLimit(argc, argv, i, limits) &&
+				!parseLatencyOption(argc, argv, i, latencyOptions)){
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	std::vector<DifficultyTier> tiers;
+	try{
+		tiers = parseTiers(tierList);
+	}
+	catch(std::invalid_argument & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+
+	int in = openPath(argv[2], false);
+	if(in < 0)
+		return 2;
+	int out = openPath(argv[3], true);
+	if(out < 0)
+		return 2;
+
+	try{
+		CorpusFormat format = TEXT_FORMAT;
+		if(in != STDIN_FILENO){
+			format = detectCorpusFormat(in);
+			if(format == BINARY_FORMAT)
+				lseek(in, BINARY_HEADER_SIZE, SEEK_SET);
+		}
+		LatencyHistogram latency;
+		LatencyReporter reporter(latency, std::cerr,
+				latencyOptions.reportEvery);
+		RatingReport report = rateCorpus(in, format, out, tiers, threads,
+				limits, &latency);
+		reporter.stop();
+
+		std::cerr << report.records << " puzzles:";
+		for(std::size_t i = 0; i < tiers.size(); ++i)
+			std::cerr << " " << report.tiers[i] << " " << tiers[i].name << ",";
+		std::cerr << " " << report.untiered << " untiered; "
+				<< report.statuses[DifficultyMetrics::INVALID] << " invalid, "
+				<< report.statuses[DifficultyMetrics::UNSOLVABLE]
+				<< " unsolvable, "
+				<< report.statuses[DifficultyMetrics::MULTIPLE]
+				<< " with several solutions, "
+				<< report.statuses[DifficultyMetrics::TIMED_OUT]
+				<< " timed out." << std::endl;
+		if(!reportLatency(latency, reporter.getSeconds(), latencyOptions))
+			return 2;
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+
+	if(in != STDIN_FILENO)
+		close(in);
+	if(out != STDOUT_FILENO && close(out) != 0){
+		std::cerr << "Could not write '" << argv[3] << "': "
+				<< strerror(errno) << "." << std::endl;
+		return 2;
+	}
+	return 0;
+}
+
+static int stress(int argc, char * argv[]){
+	StressOptions options;
+	for(int i = 2; i < argc; ++i){
+		std::string option(argv[i]);
+		if(option == "--puzzles" && i + 1 < argc)
+			options.puzzles = strtoull(argv[++i], nullptr, 10);
+		else if(option == "--threads" && i + 1 < argc)
+			options.threads = atoi(argv[++i]);
+		else if(option == "--seed" && i + 1 < argc)
+			options.seed = strtoull(argv[++i], nullptr, 10);
+		else{
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	StressReport report = runStressTest(options, std::cerr);
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	std::cout << options.puzzles << " puzzles: " << report.unique
+			<< " with one solution, " << report.multiple << " with several, "
+			<< report.unsolvable << " unsolvable, " << report.contradicted
+			<< " contradicted.\n" << report.solves << " solves in "
+			<< std::fixed << std::setprecision(1) << seconds << " s, "
+			<< report.timedOut << " timed out; " << report.mismatches
+			<< " mismatches." << std::endl;
+	return report.mismatches == 0 ? 0 : 1;
+}
+
+static int verify(int argc, char * argv[]){
+	if(argc != 3 && !(argc == 5 && std::string(argv[3]) == "--threads")){
+		printUsage(argv[0]);
+		return 2;
+	}
+	int threads = argc == 5 ? atoi(argv[4]) : 0;
+	std::string path(argv[2]);
+
+	CheckReport report;
+	try{
+		struct stat info;
+		if(stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode))
+			report = checkDirectory(path, threads, std::cout);
+		else{
+			int in = openPath(path, false);
+			if(in < 0)
+				return 2;
+			report = checkBatchFile(in, path, threads, std::cout);
+			if(in != STDIN_FILENO)
+				close(in);
+		}
+	}
+	catch(std::exception & e){
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+
+	std::cout << report.checked << " pairs checked: " << report.valid
+			<< " valid, " << report.mismatched << " mismatched, "
+			<< report.malformed << " malformed; " << report.unpaired
+			<< " unpaired files." << std::endl;
+	return report.allValid() ? 0 : 1;
+}
+
+int main(int argc, char * argv[]){
+
+	if(argc < 2){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	std::string arg(argv[1]);
+
+	if(arg == "--batch")
+		return batch(argc, argv);
+	if(arg == "--verify")
+		return verify(argc, argv);
+	if(arg == "--dedup")
+		return dedup(argc, argv);
+	if(arg == "--rate")
+		return rate(argc, argv);
+	if(arg == "--stress")
+		return stress(argc, argv);
+	if(arg == "--index")
+		return buildIndex(argc, argv);
+	if(arg == "--pack")
+		return packPuzzles(argc, argv);
+	if(arg == "--parallel")
+		return parallel(argc, argv);
+	if(arg == "--enumerate")
+		return enumerate(argc, argv);
+	if(arg == "--hint")
+		return hint(argc, argv);
+
+	if(arg == "--stream")
+		return streamStdin(argc, argv);
+
+	if(arg == "--dimacs")
+		return dimacs(argc, argv);
+
+	if(argc == 4 && std::string(argv[2]) == "--engine")
+		return solveFile(arg, argv[3]);
+	if(argc != 2){
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	return solveFile(arg, "backtrack");
+}
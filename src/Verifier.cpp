@@ -0,0 +1,68 @@
+/*
+ * Verifier.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Verifier.h"
+#include "Puzzle.h"
+
+VerifyResult verifySolution(const uint8_t solution[Board::NUM_CELLS],
+		const uint8_t givens[Board::NUM_CELLS]){
+	uint16_t rows[Board::PUZZLE_SIZE] = {};
+	uint16_t cols[Board::PUZZLE_SIZE] = {};
+	uint16_t boxes[Board::PUZZLE_SIZE] = {};
+	bool outOfRange = false;
+	bool changed = false;
+
+	// No early exits; bad grids are rare, and a straight loop is cheaper.
+	for(int row = 0, cell = 0; row < Board::PUZZLE_SIZE; ++row){
+		for(int col = 0; col < Board::PUZZLE_SIZE; ++col, ++cell){
+			unsigned value = solution[cell];
+			outOfRange |= value - 1 >= static_cast<unsigned>(Board::PUZZLE_SIZE);
+
+			// Out of range values are caught above; keep the shift in range.
+			uint16_t bit = static_cast<uint16_t>(1u << ((value - 1) & 15));
+			rows[row] |= bit;
+			cols[col] |= bit;
+			boxes[(row / Board::BOX_SIZE) * Board::BOX_SIZE +
+					col / Board::BOX_SIZE] |= bit;
+
+			changed |= givens[cell] != 0 && givens[cell] != value;
+		}
+	}
+
+	if(outOfRange)
+		return INCOMPLETE;
+
+	uint16_t all = Board::ALL_CANDIDATES;
+	for(int i = 0; i < Board::PUZZLE_SIZE; ++i)
+		all &= rows[i] & cols[i] & boxes[i];
+	if(all != Board::ALL_CANDIDATES)
+		return DUPLICATE;
+
+	return changed ? GIVEN_CHANGED : VALID;
+}
+
+const char * describe(VerifyResult result){
+	switch(result){
+	case VALID:
+		return "valid";
+	case INCOMPLETE:
+		return "solution is incomplete";
+	case DUPLICATE:
+		return "solution repeats a value in a row, column or box";
+	case GIVEN_CHANGED:
+		return "solution does not match the puzzle's givens";
+	}
+	return "unknown result";
+}
+
+void gridOf(const Puzzle & puzzle, uint8_t grid[Board::NUM_CELLS]){
+	for(int i = 0; i < Board::NUM_CELLS; ++i){
+		const Square & square = puzzle(Board::rowOf(i), Board::colOf(i));
+		grid[i] = square.isSet() ?
+				static_cast<uint8_t>(square.getValue()) : 0;
+	}
+}
@@ -0,0 +1,95 @@
+/** \file TestUtil.h
+ *
+ * \brief Fixtures shared by the test suites: puzzles with known answers, and
+ * helpers for temporary files and one-line puzzles.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#ifndef TESTUTIL_H_
+#define TESTUTIL_H_
+
+#include "Board.h"
+#include "PuzzleIO.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+// puzzles/720.d.txt and puzzles/720.soln.txt, on one line each.
+const char * const PUZZLE_720 =
+		"#3#9#6#7#1#######2#4#####1##81###35#####3#####94###82##5#####6#7"
+		"#######5#6#8#3#9#";
+const char * const SOLUTION_720 =
+		"238916574176584932945327618681492357527638149394175826859741263"
+		"713269485462853791";
+
+// puzzles/720.d.txt with its first five givens removed, which leaves it with
+// SPARSE_720_SOLUTIONS solutions.
+const char * const SPARSE_720 =
+		"#################2#4#####1##81###35#####3#####94###82##5#####6#7"
+		"#######5#6#8#3#9#";
+const uint64_t SPARSE_720_SOLUTIONS = 47749;
+
+// A puzzle that needs a few hundred search nodes.
+const char * const HARD_PUZZLE =
+		"4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2"
+		".....1.4......";
+
+// HARD_PUZZLE with a 1 that is not in its solution added in the fourth cell:
+// it loads, but only a search finds that it has no solution.
+const char * const UNSOLVABLE_PUZZLE =
+		"4..1..8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2"
+		".....1.4......";
+
+/* Writes the given string to a temporary file and returns its descriptor,
+ * positioned at the start. */
+inline int tempFileWith(const std::string & contents){
+	FILE * file = tmpfile();
+	assert(file != nullptr && "Could not create temporary file?");
+	int fd = dup(fileno(file));
+	fclose(file);
+	ssize_t written = write(fd, contents.data(), contents.size());
+	assert(written == static_cast<ssize_t>(contents.size()) &&
+			"Could not write temporary file?");
+	lseek(fd, 0, SEEK_SET);
+	return fd;
+}
+
+/* Reads a file from its start to its end; a pipe, which cannot seek, is read
+ * from where it is. */
+inline std::string readAll(int fd){
+	lseek(fd, 0, SEEK_SET);
+	std::string contents;
+	char buffer[4096];
+	ssize_t count;
+	while((count = read(fd, buffer, sizeof(buffer))) > 0)
+		contents.append(buffer, count);
+	return contents;
+}
+
+/* Parses a one-line puzzle, which must be valid, into givens. */
+inline void parseLine(const char * line, uint8_t givens[Board::NUM_CELLS]){
+	assert(parsePuzzleLine(line, strlen(line), givens) &&
+			"Could not parse puzzle?");
+}
+
+/* Loads a one-line puzzle, which must be valid, into a Board. */
+inline Board loadLine(const char * line){
+	uint8_t givens[Board::NUM_CELLS];
+	Board board;
+	parseLine(line, givens);
+	assert(board.load(givens) && "Could not load puzzle?");
+	return board;
+}
+
+/* Returns the Board in the one-line format. */
+inline std::string formatBoard(const Board & board){
+	char out[Board::NUM_CELLS];
+	formatPuzzleLine(board, out);
+	return std::string(out, Board::NUM_CELLS);
+}
+
+#endif /* TESTUTIL_H_ */
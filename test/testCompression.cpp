@@ -0,0 +1,333 @@
+/**
+ * \file testCompression.cpp
+ *
+ * Test code for classes DecompressingInput and CompressingOutput.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "BatchPipeline.h"
+#include "CompressedStream.h"
+#include "StreamMode.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testCompression();
+static void testCompressionNames();
+static void testRoundTrip(Compression compression);
+static void testBadInput(Compression compression);
+static void testCompressedPipeline(Compression compression);
+static void testPipedInput(Compression compression);
+
+void testCompression(){
+	cout << "\n***Testing compressed input and output.***\n" << endl;
+
+	testCompressionNames();
+	testPipedInput(NO_COMPRESSION);
+	for(Compression compression : {GZIP_COMPRESSION, ZSTD_COMPRESSION}){
+		if(!isCompressionAvailable(compression)){
+			cout << "\n" << getCompressionName(compression)
+					<< " was not built in; not tested." << endl;
+			continue;
+		}
+		testRoundTrip(compression);
+		testBadInput(compression);
+		testCompressedPipeline(compression);
+		testPipedInput(compression);
+	}
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+/* Writes contents, which must fit in a pipe's buffer, to a new pipe and
+ * returns the end to read it from. */
+static int pipeWith(const std::string & contents){
+	int fds[2];
+	assert(pipe(fds) == 0 && "Could not create pipe?");
+	ssize_t written = write(fds[1], contents.data(), contents.size());
+	assert(written == static_cast<ssize_t>(contents.size()) &&
+			"Could not write pipe?");
+	close(fds[1]);
+	return fds[0];
+}
+
+/* Compresses contents into a new temporary file, positioned at its start. */
+static int compressedFileWith(const std::string & contents,
+		Compression compression){
+	int fd = tempFileWith("");
+	CompressingOutput output(fd, compression);
+	// In pieces, as a writer would.
+	for(std::size_t done = 0; done < contents.size(); done += 10000){
+		std::size_t length = std::min<std::size_t>(10000,
+				contents.size() - done);
+		ssize_t written = write(output.getFd(), contents.data() + done,
+				length);
+		assert(written == static_cast<ssize_t>(length) &&
+				"Could not write to the compressor?");
+	}
+	output.finish();
+	lseek(fd, 0, SEEK_SET);
+	return fd;
+}
+
+/* Lines of digits, several blocks long and only mildly compressible. */
+static std::string randomText(std::size_t size){
+	std::mt19937 random(47);
+	std::string text;
+	while(text.size() < size){
+		text += static_cast<char>('0' + random() % 10);
+		if(random() % 80 == 0)
+			text += '\n';
+	}
+	return text;
+}
+
+static void testCompressionNames(){
+	cout << "\n***Testing compression names.***" << endl;
+
+	assert(getCompressionForPath("a.txt.gz") == GZIP_COMPRESSION &&
+			getCompressionForPath("a.zst") == ZSTD_COMPRESSION &&
+			getCompressionForPath("a.txt") == NO_COMPRESSION &&
+			getCompressionForPath("gz") == NO_COMPRESSION &&
+			"Wrong compression for path?");
+	for(Compression compression : {NO_COMPRESSION, GZIP_COMPRESSION,
+			ZSTD_COMPRESSION})
+		assert(parseCompressionName(getCompressionName(compression)) ==
+				compression && "Name does not round trip?");
+	try{
+		parseCompressionName("bzip2");
+		assert(false && "Parsed an unknown compression?");
+	}
+	catch(std::invalid_argument & e){
+		// All good.
+	}
+
+	int fd = tempFileWith("1234");
+	assert(detectCompression(fd) == NO_COMPRESSION &&
+			"Compression detected in plain text?");
+	close(fd);
+
+	cout << "No problems!" << endl;
+}
+
+static void testRoundTrip(Compression compression){
+	cout << "\n***Testing a " << getCompressionName(compression)
+			<< " round trip.***" << endl;
+
+	std::string text = randomText(3 * COMPRESSED_BLOCK_SIZE + 12345);
+	int fd = compressedFileWith(text, compression);
+	assert(detectCompression(fd) == compression && "Compression not detected?");
+
+	DecompressingInput input(fd, compression);
+	assert(input.getFormat() == TEXT_FORMAT && "Text taken for binary?");
+	assert(readAll(input.getFd()) == text && "Text does not round trip?");
+	input.finish();
+	close(fd);
+
+	// A binary file comes out without its header.
+	std::string binary = std::string(BINARY_MAGIC) + text.substr(0, 4100);
+	fd = compressedFileWith(binary, compression);
+	DecompressingInput binaryInput(fd, compression);
+	assert(binaryInput.getFormat() == BINARY_FORMAT &&
+			"Binary format not detected?");
+	assert(readAll(binaryInput.getFd()) == binary.substr(BINARY_HEADER_SIZE) &&
+			"Header not skipped?");
+	binaryInput.finish();
+	close(fd);
+
+	// Empty, and two streams one after the other.
+	fd = compressedFileWith("", compression);
+	DecompressingInput empty(fd, compression);
+	assert(readAll(empty.getFd()).empty() && "Output from nothing?");
+	empty.finish();
+	close(fd);
+
+	int first = compressedFileWith("first\n", compression);
+	int second = compressedFileWith("second\n", compression);
+	fd = tempFileWith(readAll(first) + readAll(second));
+	DecompressingInput joined(fd, compression);
+	assert(readAll(joined.getFd()) == "first\nsecond\n" &&
+			"Second stream not read?");
+	joined.finish();
+	close(fd);
+	close(first);
+	close(second);
+
+	cout << "No problems!" << endl;
+}
+
+static void testBadInput(Compression compression){
+	cout << "\n***Testing bad " << getCompressionName(compression)
+			<< " input.***" << endl;
+
+	std::string text = randomText(2 * COMPRESSED_BLOCK_SIZE);
+	int fd = compressedFileWith(text, compression);
+	std::string compressed = readAll(fd);
+	close(fd);
+
+	// Cut short: what there is comes through, then finish() complains.
+	fd = tempFileWith(compressed.substr(0, compressed.size() / 2));
+	DecompressingInput truncated(fd, compression);
+	std::string partial = readAll(truncated.getFd());
+	assert(partial.size() < text.size() &&
+			text.compare(0, partial.size(), partial) == 0 &&
+			"Wrong output from truncated input?");
+	try{
+		truncated.finish();
+		assert(false && "Truncated input accepted?");
+	}
+	catch(std::runtime_error & e){
+		// All good.
+	}
+	close(fd);
+
+	// Garbage after the magic number.
+	std::string garbage = compressed.substr(0, 4) + std::string(100, '\x55');
+	fd = tempFileWith(garbage);
+	try{
+		DecompressingInput input(fd, compression);
+		readAll(input.getFd());
+		input.finish();
+		assert(false && "Garbage accepted?");
+	}
+	catch(std::runtime_error & e){
+		// All good.
+	}
+	close(fd);
+
+	// Not reading to the end must not leave the thread stuck.
+	fd = tempFileWith(compressed);
+	{
+		DecompressingInput input(fd, compression);
+		char buffer[100];
+		ssize_t count = read(input.getFd(), buffer, sizeof(buffer));
+		assert(count > 0 && "Nothing to read?");
+	}
+	close(fd);
+
+	cout << "No problems!" << endl;
+}
+
+static void testCompressedPipeline(Compression compression){
+	cout << "\n***Testing BatchPipeline with "
+			<< getCompressionName(compression)
+			<< " files.***" << endl;
+
+	// puzzles/719.ve.txt, and a line that is not a puzzle.
+	std::string input;
+	for(int i = 0; i < 300; ++i){
+		input += "#59##6##11#75#####34#721####85###9#2##3#5#4##9#2###31####834"
+				"#59#####91#78##1##24#\n";
+		if(i % 10 == 0)
+			input += "not a puzzle\n";
+	}
+
+	int streamIn = tempFileWith(input);
+	int streamOut = tempFileWith("");
+	runStreamMode(streamIn, streamOut);
+	std::string expected = readAll(streamOut);
+	close(streamIn);
+	close(streamOut);
+
+	int in = compressedFileWith(input, compression);
+	int out = tempFileWith("");
+	{
+		DecompressingInput decompressor(in, compression);
+		CompressingOutput compressor(out, compression);
+		BatchPipeline::Options options;
+		options.solverThreads = 2;
+		options.format = decompressor.getFormat();
+		BatchPipeline pipeline(options);
+		PipelineStats stats = pipeline.run(decompressor.getFd(),
+				compressor.getFd());
+		decompressor.finish();
+		compressor.finish();
+		assert(stats.records == 330 && "Wrong record count?");
+	}
+
+	lseek(out, 0, SEEK_SET);
+	assert(detectCompression(out) == compression && "Output not compressed?");
+	DecompressingInput result(out, compression);
+	assert(readAll(result.getFd()) == expected &&
+			"Output differs from stream mode?");
+	result.finish();
+	close(in);
+	close(out);
+
+	cout << "No problems!" << endl;
+}
+
+static void testPipedInput(Compression compression){
+	cout << "\n***Testing BatchPipeline with "
+			<< getCompressionName(compression)
+			<< " input from a pipe.***" << endl;
+
+	// puzzles/719.ve.txt, and a line that is not a puzzle.
+	std::string input;
+	for(int i = 0; i < 20; ++i)
+		input += "#59##6##11#75#####34#721####85###9#2##3#5#4##9#2###31####834"
+				"#59#####91#78##1##24#\n";
+	input += "not a puzzle\n";
+
+	int streamIn = tempFileWith(input);
+	int streamOut = tempFileWith("");
+	runStreamMode(streamIn, streamOut);
+	std::string expected = readAll(streamOut);
+	close(streamIn);
+	close(streamOut);
+
+	std::string contents = input;
+	if(compression != NO_COMPRESSION){
+		int fd = compressedFileWith(input, compression);
+		contents = readAll(fd);
+		close(fd);
+	}
+
+	// The start of a pipe cannot be read again, so its header is read and
+	// passed on.
+	int in = pipeWith(contents);
+	assert(detectCompression(in) == NO_COMPRESSION &&
+			"Read the start of a pipe again?");
+	std::string header;
+	assert(readCompression(in, header) == compression &&
+			header == contents.substr(0, COMPRESSION_HEADER_SIZE) &&
+			"Wrong compression of a pipe?");
+
+	BatchPipeline::Options options;
+	std::unique_ptr<DecompressingInput> decompressor;
+	int pipelineIn = in;
+	if(compression != NO_COMPRESSION){
+		decompressor.reset(new DecompressingInput(in, compression, header));
+		pipelineIn = decompressor->getFd();
+	}
+	else
+		options.inputPrefix = header;
+	int out = tempFileWith("");
+	BatchPipeline pipeline(options);
+	PipelineStats stats = pipeline.run(pipelineIn, out);
+	if(decompressor)
+		decompressor->finish();
+	assert(stats.records == 21 && stats.invalid == 1 &&
+			readAll(out) == expected && "Piped output differs?");
+	close(in);
+	close(out);
+
+	// A pipe shorter than a header.
+	in = pipeWith("ab");
+	assert(readCompression(in, header) == NO_COMPRESSION && header == "ab" &&
+			"Wrong header of a short pipe?");
+	close(in);
+
+	cout << "No problems!" << endl;
+}
@@ -0,0 +1,285 @@
+/**
+ * \file testCorpusIndex.cpp
+ *
+ * Test code for the binary puzzle format, class CorpusReader and the corpus
+ * index.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "BatchPipeline.h"
+#include "CorpusIndex.h"
+#include "PuzzleIO.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testCorpusIndex();
+static void testBinaryFormat();
+static void testTextIndex();
+static void testBinaryIndex();
+static void testIndexFile();
+
+void testCorpusIndex(){
+	cout << "\n***Testing the corpus index.***\n" << endl;
+
+	testBinaryFormat();
+	testTextIndex();
+	testBinaryIndex();
+	testIndexFile();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+/* A random puzzle line, valid or not. */
+static std::string randomLine(std::mt19937 & random){
+	std::string line(Board::NUM_CELLS, '.');
+	for(char & cell : line){
+		if(random() % 4 == 0)
+			cell = static_cast<char>('1' + random() % Board::PUZZLE_SIZE);
+	}
+	if(random() % 10 == 0)
+		line[random() % Board::NUM_CELLS] = 'x';
+	return line;
+}
+
+/* The records of a whole file, or of the bytes [begin, end) of it. */
+static std::vector<std::string> readRecords(int fd, CorpusFormat format,
+		uint64_t begin = 0, uint64_t end = ChunkedReader::NO_LIMIT){
+	lseek(fd, static_cast<off_t>(begin), SEEK_SET);
+	CorpusReader reader(fd, format, end == ChunkedReader::NO_LIMIT ?
+			end : end - begin);
+	std::vector<std::string> records;
+	uint8_t givens[Board::NUM_CELLS];
+	bool valid;
+	while(reader.next(givens, valid)){
+		std::string record("invalid");
+		if(valid){
+			record.clear();
+			for(uint8_t given : givens)
+				record += static_cast<char>('0' + given);
+		}
+		records.push_back(record);
+	}
+	return records;
+}
+
+static void testBinaryFormat(){
+	cout << "\n***Testing the binary format.***" << endl;
+
+	std::mt19937 random(43);
+	uint8_t givens[Board::NUM_CELLS];
+	uint8_t back[Board::NUM_CELLS];
+	uint8_t record[BINARY_RECORD_SIZE];
+	for(int round = 0; round < 100; ++round){
+		for(uint8_t & given : givens)
+			given = static_cast<uint8_t>(random() % (Board::PUZZLE_SIZE + 1));
+		packPuzzleRecord(givens, record);
+		assert(unpackPuzzleRecord(record, back) &&
+				memcmp(givens, back, sizeof(givens)) == 0 &&
+				"Record does not round trip?");
+	}
+	assert(BINARY_RECORD_SIZE == 41 && "Wrong record size?");
+
+	// Values past PUZZLE_SIZE, and the unused bits, are rejected.
+	record[3] = 0xa0;
+	assert(!unpackPuzzleRecord(record, back) && "Value 10 accepted?");
+	packPuzzleRecord(givens, record);
+	record[BINARY_RECORD_SIZE - 1] |= 0x10;
+	assert(!unpackPuzzleRecord(record, back) && "Padding accepted?");
+
+	int text = tempFileWith("123");
+	int binary = tempFileWith(std::string(BINARY_MAGIC) + "x");
+	assert(detectCorpusFormat(text) == TEXT_FORMAT &&
+			detectCorpusFormat(binary) == BINARY_FORMAT &&
+			"Format not detected?");
+	close(text);
+	close(binary);
+
+	cout << "No problems!" << endl;
+}
+
+static void testTextIndex(){
+	cout << "\n***Testing the index of a text file.***" << endl;
+
+	// Blank lines, carriage returns, and no newline at the end.
+	std::mt19937 random(44);
+	std::string contents("\n");
+	for(int i = 0; i < 500; ++i){
+		contents += randomLine(random);
+		contents += i % 7 == 0 ? "\r\n" : "\n";
+		if(i % 11 == 0)
+			contents += i % 2 == 0 ? "\n" : "\r\n";
+	}
+	contents += randomLine(random);
+	int fd = tempFileWith(contents);
+	std::vector<std::string> all = readRecords(fd, TEXT_FORMAT);
+	assert(all.size() == 501 && "Wrong number of records?");
+
+	for(uint64_t stride : {1, 3, 64, 1000}){
+		CorpusIndex index = buildCorpusIndex(fd, stride);
+		assert(index.format == TEXT_FORMAT && index.records == all.size() &&
+				index.fileSize == contents.size() &&
+				index.offsets.size() == (all.size() + stride - 1) / stride &&
+				"Wrong index?");
+
+		// Each record, read from where it is located.
+		for(uint64_t record = 0; record < all.size(); record += 5){
+			uint64_t offset = locateRecord(fd, index, record);
+			assert(readRecords(fd, TEXT_FORMAT, offset)[0] == all[record] &&
+					"Wrong record located?");
+		}
+		assert(locateRecord(fd, index, all.size()) == contents.size() &&
+				"End not at end of file?");
+
+		// Shards cover every record once, in order.
+		for(uint64_t shards : {1, 2, 7, 600}){
+			std::vector<std::string> joined;
+			for(uint64_t shard = 0; shard < shards; ++shard){
+				ShardRange range = locateShard(fd, index, shard, shards);
+				std::vector<std::string> part = readRecords(fd, TEXT_FORMAT,
+						range.beginOffset, range.endOffset);
+				assert(part.size() == range.endRecord - range.firstRecord &&
+						range.endRecord - range.firstRecord <=
+								all.size() / shards + 1 &&
+						"Uneven shard?");
+				joined.insert(joined.end(), part.begin(), part.end());
+			}
+			assert(joined == all && "Shards do not cover the file?");
+		}
+	}
+
+	// An index for a file that has since changed is refused.
+	CorpusIndex index = buildCorpusIndex(fd, 10);
+	ssize_t written = write(fd, "\n", 1);
+	assert(written == 1 && "Could not append?");
+	try{
+		locateShard(fd, index, 0, 2);
+		assert(false && "Stale index used?");
+	}
+	catch(std::runtime_error & e){
+		// All good.
+	}
+	close(fd);
+
+	cout << "No problems!" << endl;
+}
+
+static void testBinaryIndex(){
+	cout << "\n***Testing the index of a binary file.***" << endl;
+
+	std::mt19937 random(45);
+	std::string contents(BINARY_MAGIC, BINARY_HEADER_SIZE);
+	uint8_t givens[Board::NUM_CELLS];
+	uint8_t record[BINARY_RECORD_SIZE];
+	std::vector<std::string> expected;
+	for(int i = 0; i < 300; ++i){
+		std::string line = randomLine(random);
+		if(!parsePuzzleLine(line.data(), line.size(), givens))
+			continue;
+		packPuzzleRecord(givens, record);
+		contents.append(reinterpret_cast<char *>(record), BINARY_RECORD_SIZE);
+		for(char & cell : line)
+			cell = cell == '.' ? '0' : cell;
+		expected.push_back(line);
+	}
+	// A partial record at the end reads as invalid.
+	contents += "\x11\x11";
+	expected.push_back("invalid");
+
+	int fd = tempFileWith(contents);
+	assert(readRecords(fd, BINARY_FORMAT, BINARY_HEADER_SIZE) == expected &&
+			"Wrong records read?");
+
+	CorpusIndex index = buildCorpusIndex(fd, 16);
+	assert(index.format == BINARY_FORMAT && index.records == expected.size() &&
+			"Wrong binary index?");
+	std::vector<std::string> joined;
+	for(uint64_t shard = 0; shard < 4; ++shard){
+		ShardRange range = locateShard(fd, index, shard, 4);
+		std::vector<std::string> part = readRecords(fd, BINARY_FORMAT,
+				range.beginOffset, range.endOffset);
+		joined.insert(joined.end(), part.begin(), part.end());
+	}
+	assert(joined == expected && "Binary shards do not cover the file?");
+
+	// The pipeline reads binary shards as well.
+	ShardRange range = locateShard(fd, index, 1, 4);
+	lseek(fd, static_cast<off_t>(range.beginOffset), SEEK_SET);
+	BatchPipeline::Options options;
+	options.solverThreads = 2;
+	options.format = BINARY_FORMAT;
+	options.inputLimit = range.endOffset - range.beginOffset;
+	BatchPipeline pipeline(options);
+	int out = tempFileWith("");
+	PipelineStats stats = pipeline.run(fd, out);
+	assert(stats.records == range.endRecord - range.firstRecord &&
+			"Pipeline read past the shard?");
+	close(out);
+	close(fd);
+
+	cout << "No problems!" << endl;
+}
+
+static void testIndexFile(){
+	cout << "\n***Testing the index file.***" << endl;
+
+	std::string contents;
+	std::mt19937 random(46);
+	for(int i = 0; i < 100; ++i)
+		contents += randomLine(random) + "\n";
+	int fd = tempFileWith(contents);
+	CorpusIndex index = buildCorpusIndex(fd, 8);
+
+	int indexFd = tempFileWith("");
+	writeCorpusIndex(indexFd, index);
+	std::string bytes = readAll(indexFd);
+	assert(bytes.compare(0, 8, INDEX_MAGIC) == 0 &&
+			bytes.size() == 48 + 8 * index.offsets.size() &&
+			"Wrong index file?");
+
+	lseek(indexFd, 0, SEEK_SET);
+	CorpusIndex back = readCorpusIndex(indexFd);
+	assert(back.format == index.format && back.fileSize == index.fileSize &&
+			back.records == index.records && back.stride == index.stride &&
+			back.offsets == index.offsets && "Index does not round trip?");
+	close(indexFd);
+
+	// Truncated, or damaged, files are refused.
+	for(std::size_t length : {std::size_t(0), std::size_t(20),
+			bytes.size() - 1}){
+		indexFd = tempFileWith(bytes.substr(0, length));
+		try{
+			readCorpusIndex(indexFd);
+			assert(false && "Read a truncated index?");
+		}
+		catch(std::runtime_error & e){
+			// All good.
+		}
+		close(indexFd);
+	}
+	std::string damaged(bytes);
+	damaged.replace(56, 8, damaged.substr(48, 8));
+	indexFd = tempFileWith(damaged);
+	try{
+		readCorpusIndex(indexFd);
+		assert(false && "Read offsets out of order?");
+	}
+	catch(std::runtime_error & e){
+		// All good.
+	}
+	close(indexFd);
+	close(fd);
+
+	cout << "No problems!" << endl;
+}
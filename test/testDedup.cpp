@@ -0,0 +1,190 @@
+/**
+ * \file testDedup.cpp
+ *
+ * Test code for class Canonicalizer and dedupBatchFile().
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Canonicalizer.h"
+#include "Deduplicator.h"
+#include "PuzzleIO.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testDedup();
+static void testCanonicalForm();
+static void testDedupBatchFile();
+
+void testDedup(){
+	cout << "\n***Testing symmetry deduplication.***\n" << endl;
+
+	testCanonicalForm();
+	testDedupBatchFile();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+/* Applies a random member of the symmetry group to a grid. */
+static void transform(const uint8_t in[Board::NUM_CELLS],
+		uint8_t out[Board::NUM_CELLS], std::mt19937 & random){
+	const int SIZE = Board::PUZZLE_SIZE;
+	const int BOX = Board::BOX_SIZE;
+	int bands[BOX] = {0, 1, 2};
+	int stacks[BOX] = {0, 1, 2};
+	std::shuffle(bands, bands + BOX, random);
+	std::shuffle(stacks, stacks + BOX, random);
+
+	int rows[SIZE];
+	int cols[SIZE];
+	for(int i = 0; i < BOX; ++i){
+		int within[BOX] = {0, 1, 2};
+		std::shuffle(within, within + BOX, random);
+		for(int j = 0; j < BOX; ++j)
+			rows[i * BOX + j] = bands[i] * BOX + within[j];
+		std::shuffle(within, within + BOX, random);
+		for(int j = 0; j < BOX; ++j)
+			cols[i * BOX + j] = stacks[i] * BOX + within[j];
+	}
+
+	uint8_t labels[SIZE + 1] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	std::shuffle(labels + 1, labels + SIZE + 1, random);
+	bool transposed = random() % 2 == 1;
+
+	for(int row = 0; row < SIZE; ++row){
+		for(int col = 0; col < SIZE; ++col){
+			int source = rows[row] * SIZE + cols[col];
+			if(transposed)
+				source = cols[col] * SIZE + rows[row];
+			out[row * SIZE + col] = labels[in[source]];
+		}
+	}
+}
+
+static bool sameGrid(const uint8_t a[Board::NUM_CELLS],
+		const uint8_t b[Board::NUM_CELLS]){
+	return std::equal(a, a + Board::NUM_CELLS, b);
+}
+
+static void testCanonicalForm(){
+	cout << "\n***Testing Canonicalizer::canonicalize().***" << endl;
+
+	Canonicalizer canonicalizer;
+	std::mt19937 random(720);
+	const char * puzzles[] = {PUZZLE_720, HARD_PUZZLE};
+	uint8_t forms[2][Board::NUM_CELLS];
+
+	for(int p = 0; p < 2; ++p){
+		uint8_t givens[Board::NUM_CELLS];
+		parseLine(puzzles[p], givens);
+		canonicalizer.canonicalize(givens, forms[p]);
+
+		// Same givens, relabelled from 1 in reading order.
+		int count = 0;
+		int seen = 0;
+		for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+			count += (givens[cell] != 0) - (forms[p][cell] != 0);
+			if(forms[p][cell] > seen){
+				assert(forms[p][cell] == seen + 1 && "Labels out of order?");
+				seen = forms[p][cell];
+			}
+		}
+		assert(count == 0 && "Canonical form has other givens?");
+
+		// Every image of the puzzle has the same form.
+		for(int i = 0; i < 200; ++i){
+			uint8_t image[Board::NUM_CELLS];
+			uint8_t form[Board::NUM_CELLS];
+			transform(givens, image, random);
+			canonicalizer.canonicalize(image, form);
+			assert(sameGrid(form, forms[p]) && "Image has another form?");
+			assert(canonicalizer.getStates() < 100000 &&
+					"Search not pruned?");
+		}
+
+		// The form is its own form.
+		uint8_t again[Board::NUM_CELLS];
+		canonicalizer.canonicalize(forms[p], again);
+		assert(sameGrid(again, forms[p]) && "Form of form differs?");
+	}
+	assert(!sameGrid(forms[0], forms[1]) && "Different puzzles, same form?");
+
+	// An empty grid, and one with a single given.
+	uint8_t empty[Board::NUM_CELLS] = {};
+	uint8_t form[Board::NUM_CELLS];
+	canonicalizer.canonicalize(empty, form);
+	assert(sameGrid(form, empty) && "Empty grid not empty?");
+	empty[40] = 7;
+	canonicalizer.canonicalize(empty, form);
+	assert(form[0] == 1 && std::count(form, form + Board::NUM_CELLS, 0) ==
+			Board::NUM_CELLS - 1 && "Wrong form of one given?");
+
+	// Packed keys round-trip and compare.
+	CanonicalKey key = CanonicalKey::pack(forms[0]);
+	uint8_t unpacked[Board::NUM_CELLS];
+	key.unpack(unpacked);
+	assert(sameGrid(unpacked, forms[0]) && "Key did not round-trip?");
+	assert(!(key == CanonicalKey::pack(forms[1])) && "Keys equal?");
+
+	cout << "No problems!" << endl;
+}
+
+static std::string imageOf(const char * puzzle, std::mt19937 & random){
+	uint8_t givens[Board::NUM_CELLS];
+	uint8_t image[Board::NUM_CELLS];
+	parseLine(puzzle, givens);
+	transform(givens, image, random);
+	std::string line;
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		line += image[cell] == 0 ? '.' : static_cast<char>('0' + image[cell]);
+	return line;
+}
+
+static void testDedupBatchFile(){
+	cout << "\n***Testing dedupBatchFile().***" << endl;
+
+	std::mt19937 random(17);
+	std::string input = std::string(PUZZLE_720) + "\n" +
+			imageOf(PUZZLE_720, random) + "\n" +
+			HARD_PUZZLE + "\n" +
+			"not a puzzle\n" +
+			"\n" +
+			imageOf(HARD_PUZZLE, random) + "\n" +
+			PUZZLE_720 + "\n";
+
+	// Threads from one to more than there are lines give the same output.
+	for(int threads : {1, 3, 16}){
+		int in = tempFileWith(input);
+		int unique = tempFileWith("");
+		int groups = tempFileWith("");
+		DedupReport report = dedupBatchFile(in, unique, groups, threads);
+
+		assert(report.records == 6 && report.invalid == 1 &&
+				report.unique == 2 && report.duplicates == 3 &&
+				report.groups == 2 && "Wrong counts?");
+		assert(readAll(unique) == std::string(PUZZLE_720) + "\n" +
+				HARD_PUZZLE + "\n" && "Wrong unique puzzles?");
+
+		std::string text = readAll(groups);
+		std::size_t newline = text.find('\n');
+		assert(newline != std::string::npos &&
+				text.substr(Board::NUM_CELLS, newline - Board::NUM_CELLS) ==
+				" 1 2 7" && text.substr(newline + 1 + Board::NUM_CELLS) ==
+				" 3 6\n" && "Wrong groups?");
+
+		close(in);
+		close(unique);
+		close(groups);
+	}
+
+	cout << "No problems!" << endl;
+}
@@ -0,0 +1,204 @@
+/**
+ * \file testDifficulty.cpp
+ *
+ * Test code for measureDifficulty(), the difficulty tiers and rateCorpus().
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Difficulty.h"
+#include "PuzzleIO.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testDifficulty();
+static void testParseTiers();
+static void testMeasureDifficulty();
+static void testRateCorpus();
+
+// puzzles/719.ve.txt, puzzles/721.ve.txt, puzzles/720.d.txt and
+// puzzles/722.d.txt, on one line each.
+static const char * const LABELLED[][2] = {
+	{"#59##6##11#75#####34#721####85###9#2##3#5#4##9#2###31####834#59#####91"
+			"#78##1##24#", "ve"},
+	{"73#25###1######7#3#8##76#####81#9##41#4###6#29##5#21#####71##2#3#7###"
+			"###5###98#17", "ve"},
+	{"#3#9#6#7#1#######2#4#####1##81###35#####3#####94###82##5#####6#7#####"
+			"##5#6#8#3#9#", "d"},
+	{"##5###3#####735###8###1###6#6#####2##87###53##1#####8#7###4###1###391"
+			"#####9###4##", "d"}
+};
+
+// From bench/hard.txt; no technique the HintEngine knows applies to it.
+static const char * SEARCH_PUZZLE =
+		"1.......2.9.4...5...6...7...5.9.3.......7.......85..4.7.....6...3..."
+		"9.8...2.....1";
+
+void testDifficulty(){
+	cout << "\n***Testing difficulty ratings.***\n" << endl;
+
+	testParseTiers();
+	testMeasureDifficulty();
+	testRateCorpus();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+static void testParseTiers(){
+	cout << "\n***Testing tier parsing.***" << endl;
+
+	std::vector<DifficultyTier> tiers = parseTiers(DEFAULT_TIERS);
+	assert(tiers.size() == 5 && tiers[0].name == "ve" &&
+			tiers[4].name == "vd" && "Wrong default tiers?");
+	assert(tiers[0].needsLogic && tiers[0].maxTechnique == Hint::HIDDEN_SINGLE
+			&& "Wrong first tier?");
+	assert(tiers[2].maxTechnique == Hint::X_WING && "x_wing not parsed?");
+	assert(!tiers[3].needsLogic && tiers[3].maxNodes == 1000 &&
+			"Wrong node bound?");
+	assert(!tiers[4].needsLogic && tiers[4].maxNodes == UINT64_MAX &&
+			"Last tier bounded?");
+
+	tiers = parseTiers("a:technique=naked-pair:steps=40:depth=3");
+	assert(tiers.size() == 1 && tiers[0].maxTechnique == Hint::NAKED_PAIR &&
+			tiers[0].maxSteps == 40 && tiers[0].maxDepth == 3 &&
+			"Bounds not parsed?");
+
+	const char * bad[] = {"", "a,", ":nodes=1", "a b", "a:nodes", "a:nodes=",
+			"a:nodes=-1", "a:nodes=1x", "a:technique=swordfish",
+			"a:technique=contradiction", "a:colour=red"};
+	for(const char * text : bad){
+		try{
+			parseTiers(text);
+			assert(false && "Bad tier list accepted?");
+		}
+		catch(std::invalid_argument & e){
+			// All good.
+		}
+	}
+
+	cout << "No problems!" << endl;
+}
+
+static void testMeasureDifficulty(){
+	cout << "\n***Testing measureDifficulty().***" << endl;
+
+	std::unique_ptr<Solver> solver(new Solver());
+	std::vector<DifficultyTier> labels = parseTiers(
+			"ve:technique=hidden_single,d");
+	uint8_t givens[Board::NUM_CELLS];
+
+	for(const auto & labelled : LABELLED){
+		parseLine(labelled[0], givens);
+		DifficultyMetrics metrics = measureDifficulty(givens, *solver);
+		assert(metrics.status == DifficultyMetrics::RATED &&
+				metrics.solvedByLogic && "Labelled puzzle not rated?");
+		assert(metrics.steps > 0 && metrics.nodes > 0 && "No metrics?");
+		assert(labels[findTier(metrics, labels)].name == labelled[1] &&
+				"Rating differs from the file name?");
+	}
+
+	parseLine(SEARCH_PUZZLE, givens);
+	DifficultyMetrics hard = measureDifficulty(givens, *solver);
+	assert(hard.status == DifficultyMetrics::RATED && !hard.solvedByLogic &&
+			hard.backtracks > 0 && hard.depth > 0 &&
+			"Hard puzzle solved by logic?");
+	std::vector<DifficultyTier> tiers = parseTiers(DEFAULT_TIERS);
+	assert(findTier(hard, tiers) >= 3 && "Hard puzzle in a logic tier?");
+	assert(findTier(hard, parseTiers("a:technique=x_wing,b:nodes=1")) == -1 &&
+			"Hard puzzle in a tier it is beyond?");
+
+	// An empty grid, a clash of givens, and a search cut short.
+	memset(givens, 0, sizeof(givens));
+	assert(measureDifficulty(givens, *solver).status ==
+			DifficultyMetrics::MULTIPLE && "Empty grid rated?");
+	givens[0] = givens[1] = 5;
+	assert(measureDifficulty(givens, *solver).status ==
+			DifficultyMetrics::UNSOLVABLE && "Clash rated?");
+	Solver::Limits limits;
+	limits.maxNodes = 1;
+	solver->setLimits(limits);
+	parseLine(SEARCH_PUZZLE, givens);
+	assert(measureDifficulty(givens, *solver).status ==
+			DifficultyMetrics::TIMED_OUT && "Node limit ignored?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testRateCorpus(){
+	cout << "\n***Testing rateCorpus().***" << endl;
+
+	std::string input;
+	for(int i = 0; i < 50; ++i){
+		input += LABELLED[i % 4][0];
+		input += i % 7 == 0 ? "\nnot a puzzle\n" : "\n";
+	}
+	input += std::string(SEARCH_PUZZLE) + "\n";
+	std::vector<DifficultyTier> tiers = parseTiers(
+			"ve:technique=hidden_single,d:technique=x_wing");
+
+	int in = tempFileWith(input);
+	int out = tempFileWith("");
+	RatingReport report = rateCorpus(in, TEXT_FORMAT, out, tiers, 1);
+	std::string expected = readAll(out);
+	close(in);
+	close(out);
+
+	assert(report.records == 59 &&
+			report.statuses[DifficultyMetrics::INVALID] == 8 &&
+			report.statuses[DifficultyMetrics::RATED] == 51 &&
+			report.tiers[0] == 26 && report.tiers[1] == 24 &&
+			report.untiered == 1 && "Wrong counts?");
+	assert(expected.compare(0, 2, "# ") == 0 && "No header?");
+	assert(expected.find("\n0\tve\tnaked_single\t") != std::string::npos &&
+			expected.find("\n1\tinvalid\t-\t0\t0\t0\t0\n") !=
+					std::string::npos &&
+			expected.find("\n58\tuntiered\tsearch\t") != std::string::npos &&
+			"Wrong lines?");
+
+	// More threads, and the same puzzles packed, give the same lines.
+	in = tempFileWith(input);
+	out = tempFileWith("");
+	rateCorpus(in, TEXT_FORMAT, out, tiers, 4);
+	assert(readAll(out) == expected && "Threads change the output?");
+	close(in);
+	close(out);
+
+	std::string text;
+	std::string binary;
+	uint8_t givens[Board::NUM_CELLS];
+	uint8_t record[BINARY_RECORD_SIZE];
+	for(const auto & labelled : LABELLED){
+		text += std::string(labelled[0]) + "\n";
+		parseLine(labelled[0], givens);
+		packPuzzleRecord(givens, record);
+		binary.append(reinterpret_cast<const char *>(record),
+				BINARY_RECORD_SIZE);
+	}
+	in = tempFileWith(text);
+	out = tempFileWith("");
+	rateCorpus(in, TEXT_FORMAT, out, tiers, 1);
+	expected = readAll(out);
+	close(in);
+	close(out);
+
+	in = tempFileWith(binary);
+	out = tempFileWith("");
+	report = rateCorpus(in, BINARY_FORMAT, out, tiers, 2);
+	assert(report.records == 4 && report.tiers[0] == 2 &&
+			report.tiers[1] == 2 && "Wrong binary counts?");
+	assert(readAll(out) == expected && "Binary ratings differ?");
+	close(in);
+	close(out);
+
+	cout << "No problems!" << endl;
+}
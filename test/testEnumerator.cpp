@@ -0,0 +1,249 @@
+/**
+ * \file testEnumerator.cpp
+ *
+ * Test code for class Enumerator.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Enumerator.h"
+#include "Solver.h"
+#include "PuzzleIO.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+void testEnumerator();
+static void testEnumerateAll();
+static void testEnumerateLimit();
+static void testResume();
+static void testTimeBudget();
+static void testCheckpointText();
+
+void testEnumerator(){
+	cout << "\n***Testing class Enumerator.***\n" << endl;
+
+	testEnumerateAll();
+	testEnumerateLimit();
+	testResume();
+	testTimeBudget();
+	testCheckpointText();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+/* Appends each solution to lines, in the one-line format. */
+static Enumerator::Callback collectInto(std::vector<std::string> & lines){
+	return [&lines](const Board & solution){
+		lines.push_back(formatBoard(solution));
+		return true;
+	};
+}
+
+static void testEnumerateAll(){
+	cout << "\n***Testing Enumerator::enumerate().***" << endl;
+
+	std::unique_ptr<Enumerator> enumerator(new Enumerator());
+	std::vector<std::string> lines;
+	assert(enumerator->enumerate(loadLine(PUZZLE_720), collectInto(lines)) ==
+			Enumerator::EXHAUSTED && "Unique puzzle not exhausted?");
+	assert(lines.size() == 1 && lines[0] == SOLUTION_720 &&
+			"Wrong solution of unique puzzle?");
+	assert(enumerator->getCheckpoint().finished &&
+			enumerator->getCheckpoint().solutions == 1 &&
+			"Wrong checkpoint after exhausting?");
+
+	// Every solution, in the order the Solver counts them.
+	lines.clear();
+	Board sparse = loadLine(SPARSE_720);
+	assert(enumerator->enumerate(sparse, collectInto(lines)) ==
+			Enumerator::EXHAUSTED && "Sparse puzzle not exhausted?");
+	assert(lines.size() == SPARSE_720_SOLUTIONS &&
+			enumerator->getStats().solutions == SPARSE_720_SOLUTIONS &&
+			"Wrong number of solutions?");
+	std::unique_ptr<Solver> solver(new Solver());
+	Board first;
+	solver->countSolutions(sparse, 1, &first);
+	assert(lines[0] == formatBoard(first) && "Different first solution?");
+
+	// No solutions.
+	lines.clear();
+	assert(enumerator->enumerate(loadLine(UNSOLVABLE_PUZZLE),
+			collectInto(lines)) == Enumerator::EXHAUSTED && lines.empty() &&
+			enumerator->getStats().nodes > 1 &&
+			"Solutions of an unsolvable puzzle?");
+
+	// The callback can stop the run.
+	uint64_t calls = 0;
+	assert(enumerator->enumerate(sparse, [&calls](const Board &){
+		return ++calls < 3;
+	}) == Enumerator::STOPPED && calls == 3 && "Callback did not stop?");
+
+	// Even at a board solved before any search.
+	calls = 0;
+	Board solved = loadLine(SOLUTION_720);
+	assert(enumerator->enumerate(solved, [&calls](const Board &){
+		++calls;
+		return false;
+	}) == Enumerator::STOPPED && calls == 1 &&
+			enumerator->getCheckpoint().finished &&
+			"Callback did not stop at a solved board?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testEnumerateLimit(){
+	cout << "\n***Testing Enumerator::enumerateInto() and limits.***" << endl;
+
+	Enumerator::Options options;
+	options.limit = 5;
+	std::unique_ptr<Enumerator> enumerator(new Enumerator(options));
+
+	std::vector<Board> boards;
+	assert(enumerator->enumerateInto(loadLine(SPARSE_720),
+			std::back_inserter(boards)) == Enumerator::LIMIT_REACHED &&
+			"Limit not reached?");
+	assert(boards.size() == 5 && "Wrong number of solutions?");
+	for(const Board & board : boards)
+		assert(board.isSolved() && "Unsolved solution?");
+	assert(!enumerator->getCheckpoint().finished &&
+			!enumerator->getCheckpoint().path.empty() &&
+			"No checkpoint at the limit?");
+
+	// A limit that is not reached.
+	boards.clear();
+	assert(enumerator->enumerateInto(loadLine(PUZZLE_720),
+			std::back_inserter(boards)) == Enumerator::EXHAUSTED &&
+			boards.size() == 1 && "Limit reached on a unique puzzle?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testResume(){
+	cout << "\n***Testing Enumerator::resume().***" << endl;
+
+	Board sparse = loadLine(SPARSE_720);
+	std::unique_ptr<Enumerator> whole(new Enumerator());
+	std::vector<std::string> expected;
+	whole->enumerate(sparse, collectInto(expected));
+
+	/* Runs of 1000 solutions, each resumed from the text of the last one's
+	 * checkpoint, find the same solutions in the same order. */
+	Enumerator::Options options;
+	options.limit = 1000;
+	std::unique_ptr<Enumerator> enumerator(new Enumerator(options));
+	std::vector<std::string> lines;
+	Enumerator::Checkpoint checkpoint;
+	int runs = 0;
+	for(;;){
+		Enumerator::Status status = enumerator->resume(sparse, checkpoint,
+				collectInto(lines));
+		++runs;
+		checkpoint = Enumerator::Checkpoint::fromString(
+				enumerator->getCheckpoint().toString());
+		assert(checkpoint.solutions == lines.size() &&
+				"Checkpoint lost count of solutions?");
+		if(status == Enumerator::EXHAUSTED)
+			break;
+		assert(status == Enumerator::LIMIT_REACHED && "Wrong status?");
+	}
+	assert(runs == 48 && "Wrong number of runs?");
+	assert(lines == expected && "Resumed runs found other solutions?");
+
+	// A finished checkpoint finds nothing more.
+	lines.clear();
+	assert(enumerator->resume(sparse, checkpoint, collectInto(lines)) ==
+			Enumerator::EXHAUSTED && lines.empty() &&
+			"Resumed a finished checkpoint?");
+
+	// A checkpoint from another heuristic, or another puzzle, is rejected.
+	enumerator->enumerate(sparse, collectInto(lines));
+	checkpoint = enumerator->getCheckpoint();
+	std::unique_ptr<Enumerator> other(new Enumerator(options));
+	other->setHeuristic(makeHeuristic("index"));
+	bool threw = false;
+	try{
+		other->resume(sparse, checkpoint, collectInto(lines));
+	}
+	catch(std::invalid_argument & e){
+		threw = true;
+	}
+	assert(threw && "Resumed with another heuristic?");
+
+	threw = false;
+	try{
+		enumerator->resume(loadLine(PUZZLE_720), checkpoint,
+				collectInto(lines));
+	}
+	catch(std::invalid_argument & e){
+		threw = true;
+	}
+	assert(threw && "Resumed another puzzle?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testTimeBudget(){
+	cout << "\n***Testing Enumerator time budget.***" << endl;
+
+	Enumerator::Options options;
+	options.timeBudget = std::chrono::nanoseconds(1);
+	std::unique_ptr<Enumerator> enumerator(new Enumerator(options));
+	Board sparse = loadLine(SPARSE_720);
+
+	std::vector<std::string> lines;
+	assert(enumerator->enumerate(sparse, collectInto(lines)) ==
+			Enumerator::OUT_OF_TIME && "Time budget ignored?");
+	assert(lines.size() < SPARSE_720_SOLUTIONS && "Found every solution?");
+
+	// Resuming without a budget finds the rest.
+	Enumerator::Checkpoint checkpoint = enumerator->getCheckpoint();
+	std::unique_ptr<Enumerator> unlimited(new Enumerator());
+	assert(unlimited->resume(sparse, checkpoint, collectInto(lines)) ==
+			Enumerator::EXHAUSTED && lines.size() == SPARSE_720_SOLUTIONS &&
+			"Resumed run did not find the rest?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testCheckpointText(){
+	cout << "\n***Testing Enumerator::Checkpoint text.***" << endl;
+
+	Enumerator::Checkpoint checkpoint;
+	checkpoint.heuristic = "mrv";
+	checkpoint.solutions = 12;
+	checkpoint.path = {3, 1, 0, 9};
+	assert(checkpoint.toString() == "mrv 12 3109" && "Wrong text?");
+
+	Enumerator::Checkpoint parsed =
+			Enumerator::Checkpoint::fromString("degree+lcv 7 done");
+	assert(parsed.heuristic == "degree+lcv" && parsed.solutions == 7 &&
+			parsed.finished && parsed.path.empty() && "Wrong parse?");
+	parsed = Enumerator::Checkpoint::fromString("mrv 0 start");
+	assert(!parsed.finished && parsed.path.empty() && "Wrong parse?");
+
+	const char * invalid[] = {"", "mrv", "mrv x start", "mrv 1 12a",
+			"mrv 1 start extra"};
+	for(const char * text : invalid){
+		bool threw = false;
+		try{
+			Enumerator::Checkpoint::fromString(text);
+		}
+		catch(std::invalid_argument & e){
+			threw = true;
+		}
+		assert(threw && "Parsed an invalid checkpoint?");
+	}
+
+	cout << "No problems!" << endl;
+}
@@ -0,0 +1,267 @@
+/**
+ * \file testHintEngine.cpp
+ *
+ * Test code for class HintEngine.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "HintEngine.h"
+#include "Puzzle.h"
+#include "PuzzleIO.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testHintEngine();
+static void testTechniques();
+static void testContradictions();
+static void testSolveWithHints();
+static void testPuzzleHint();
+
+void testHintEngine(){
+	cout << "\n***Testing class HintEngine.***\n" << endl;
+
+	testTechniques();
+	testContradictions();
+	testSolveWithHints();
+	testPuzzleHint();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+/* An empty grid, on which each test removes candidates to make a pattern. */
+struct TestGrid {
+	uint8_t values[Board::NUM_CELLS];
+	uint16_t candidates[Board::NUM_CELLS];
+
+	TestGrid() {
+		for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+			values[cell] = 0;
+			candidates[cell] = Board::ALL_CANDIDATES;
+		}
+	}
+
+	void remove(int value, std::initializer_list<int> cells){
+		for(int cell : cells)
+			candidates[cell] &= ~Board::maskOf(value);
+	}
+
+	bool findHint(Hint & hint) const {
+		return HintEngine::findHint(values, candidates, hint);
+	}
+};
+
+static CellSet cellSet(std::initializer_list<int> cells){
+	CellSet set;
+	for(int cell : cells)
+		set.insert(cell);
+	return set;
+}
+
+static bool sameCells(const CellSet & a, const CellSet & b){
+	return a.words[0] == b.words[0] && a.words[1] == b.words[1];
+}
+
+static void testTechniques(){
+	cout << "\n***Testing each technique.***" << endl;
+
+	Hint hint;
+	assert(!TestGrid().findHint(hint) && "Hint on an empty grid?");
+
+	TestGrid grid;
+	grid.candidates[10] = Board::maskOf(3);
+	assert(grid.findHint(hint) && hint.technique == Hint::NAKED_SINGLE &&
+			hint.cell == 10 && hint.value == 3 && "No naked single?");
+	assert(std::string(Hint::getTechniqueName(hint.technique)) ==
+			"naked single" && "Wrong name?");
+
+	// 4 has one place in box 0, which is found before row 0 or column 0.
+	grid = TestGrid();
+	grid.remove(4, {1, 2, 9, 10, 11, 18, 19, 20});
+	assert(grid.findHint(hint) && hint.technique == Hint::HIDDEN_SINGLE &&
+			hint.unit == 2 * Board::PUZZLE_SIZE && hint.cell == 0 &&
+			hint.value == 4 && "No hidden single?");
+
+	// 5 is only in row 0 of box 0, so it goes from the rest of row 0.
+	grid = TestGrid();
+	grid.remove(5, {9, 10, 11, 18, 19, 20});
+	assert(grid.findHint(hint) && hint.technique == Hint::POINTING &&
+			hint.unit == 2 * Board::PUZZLE_SIZE && hint.value == 5 &&
+			"No pointing?");
+	assert(hint.numCells == 3 && hint.cells[0] == 0 && hint.cells[2] == 2 &&
+			sameCells(hint.targets, cellSet({3, 4, 5, 6, 7, 8})) &&
+			hint.removed == Board::maskOf(5) && "Wrong pointing?");
+
+	// 6 is only in box 0 of row 0, so it goes from the rest of box 0.
+	grid = TestGrid();
+	grid.remove(6, {3, 4, 5, 6, 7, 8});
+	assert(grid.findHint(hint) && hint.technique == Hint::CLAIMING &&
+			hint.unit == 0 && hint.value == 6 &&
+			sameCells(hint.targets, cellSet({9, 10, 11, 18, 19, 20})) &&
+			"No claiming?");
+
+	// Cells 0 and 1 can only be 1 or 2.
+	grid = TestGrid();
+	grid.candidates[0] = grid.candidates[1] =
+			Board::maskOf(1) | Board::maskOf(2);
+	assert(grid.findHint(hint) && hint.technique == Hint::NAKED_PAIR &&
+			hint.unit == 0 && hint.numCells == 2 && hint.cells[0] == 0 &&
+			hint.cells[1] == 1 &&
+			sameCells(hint.targets, cellSet({2, 3, 4, 5, 6, 7, 8})) &&
+			hint.removed == (Board::maskOf(1) | Board::maskOf(2)) &&
+			"No naked pair?");
+
+	// 7 and 8 can only go in cells 0 and 3 of row 0.
+	grid = TestGrid();
+	grid.remove(7, {1, 2, 4, 5, 6, 7, 8});
+	grid.remove(8, {1, 2, 4, 5, 6, 7, 8});
+	assert(grid.findHint(hint) && hint.technique == Hint::HIDDEN_PAIR &&
+			hint.unit == 0 && sameCells(hint.targets, cellSet({0, 3})) &&
+			hint.removed == (Board::ALL_CANDIDATES &
+			~(Board::maskOf(7) | Board::maskOf(8))) && "No hidden pair?");
+
+	// Cells 0, 3 and 6 can only be 1, 2 or 3.
+	grid = TestGrid();
+	grid.candidates[0] = Board::maskOf(1) | Board::maskOf(2);
+	grid.candidates[3] = Board::maskOf(2) | Board::maskOf(3);
+	grid.candidates[6] = Board::maskOf(1) | Board::maskOf(3);
+	assert(grid.findHint(hint) && hint.technique == Hint::NAKED_TRIPLE &&
+			hint.unit == 0 && hint.numCells == 3 && hint.cells[1] == 3 &&
+			sameCells(hint.targets, cellSet({1, 2, 4, 5, 7, 8})) &&
+			"No naked triple?");
+
+	// 9 can only go in columns 1 and 7 of rows 0 and 4.
+	grid = TestGrid();
+	grid.remove(9, {0, 2, 3, 4, 5, 6, 8, 36, 38, 39, 40, 41, 42, 44});
+	assert(grid.findHint(hint) && hint.technique == Hint::X_WING &&
+			hint.unit == -1 && hint.value == 9 && "No x-wing?");
+	assert(hint.numCells == 4 && hint.cells[0] == 1 && hint.cells[1] == 7 &&
+			hint.cells[2] == 37 && hint.cells[3] == 43 && "Wrong corners?");
+	assert(sameCells(hint.targets, cellSet({10, 19, 28, 46, 55, 64, 73,
+			16, 25, 34, 52, 61, 70, 79})) && "Wrong x-wing targets?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testContradictions(){
+	cout << "\n***Testing contradictions.***" << endl;
+
+	Hint hint;
+	TestGrid grid;
+	grid.candidates[40] = 0;
+	assert(grid.findHint(hint) && hint.technique == Hint::CONTRADICTION &&
+			hint.cell == 40 && "Cell with no candidates missed?");
+
+	grid = TestGrid();
+	grid.values[0] = grid.values[8] = 3;
+	assert(grid.findHint(hint) && hint.technique == Hint::CONTRADICTION &&
+			hint.unit == 0 && hint.value == 3 && hint.numCells == 2 &&
+			"Value placed twice missed?");
+
+	grid = TestGrid();
+	grid.remove(2, {0, 1, 2, 3, 4, 5, 6, 7, 8});
+	assert(grid.findHint(hint) && hint.technique == Hint::CONTRADICTION &&
+			hint.unit == 0 && hint.value == 2 && "Value with no place missed?");
+
+	cout << "No problems!" << endl;
+}
+
+/* Applies hints to a grid until none is left. Returns the number of hints. */
+static int solveWithHints(uint8_t values[Board::NUM_CELLS],
+		uint16_t candidates[Board::NUM_CELLS]){
+	Hint hint;
+	int hints = 0;
+	while(HintEngine::findHint(values, candidates, hint)){
+		assert(hint.technique != Hint::CONTRADICTION &&
+				"Hints led to a contradiction?");
+		++hints;
+		if(hint.cell >= 0){
+			values[hint.cell] = static_cast<uint8_t>(hint.value);
+			const int * peers = Board::getPeers(hint.cell);
+			for(int i = 0; i < Board::NUM_PEERS; ++i)
+				candidates[peers[i]] &= ~Board::maskOf(hint.value);
+			continue;
+		}
+		for(int cell = hint.targets.first(); cell >= 0;
+				cell = hint.targets.next(cell))
+			candidates[cell] &= ~hint.removed;
+	}
+	return hints;
+}
+
+static void testSolveWithHints(){
+	cout << "\n***Testing solving by hints alone.***" << endl;
+
+	// From the givens, with each cell's candidates less its peers' values.
+	uint8_t givens[Board::NUM_CELLS];
+	assert(parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720), givens) &&
+			"Could not parse puzzle?");
+	uint8_t values[Board::NUM_CELLS];
+	uint16_t candidates[Board::NUM_CELLS];
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		values[cell] = givens[cell];
+		candidates[cell] = Board::ALL_CANDIDATES;
+	}
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		if(givens[cell] == 0)
+			continue;
+		const int * peers = Board::getPeers(cell);
+		for(int i = 0; i < Board::NUM_PEERS; ++i)
+			candidates[peers[i]] &= ~Board::maskOf(givens[cell]);
+	}
+
+	int hints = solveWithHints(values, candidates);
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		assert(values[cell] == SOLUTION_720[cell] - '0' &&
+				"Hints led to a wrong solution?");
+	assert(hints >= Board::NUM_CELLS - 26 && "Too few hints?");
+
+	// A Board has its naked singles set already; it gets the same solution.
+	Board board;
+	assert(board.load(givens) && "Could not load puzzle?");
+	Hint hint;
+	assert(HintEngine::findHint(board, hint) &&
+			hint.technique != Hint::NAKED_SINGLE &&
+			hint.technique != Hint::CONTRADICTION && "Wrong hint for Board?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testPuzzleHint(){
+	cout << "\n***Testing HintEngine::findHint() on a Puzzle.***" << endl;
+
+	char path[] = "/tmp/testHintEngineXXXXXX";
+	int fd = mkstemp(path);
+	assert(fd >= 0 && "Could not create temporary file?");
+	std::string text;
+	for(int row = 0; row < Board::PUZZLE_SIZE; ++row)
+		text.append(PUZZLE_720 + row * Board::PUZZLE_SIZE,
+				Board::PUZZLE_SIZE).append("\n");
+	ssize_t written = write(fd, text.data(), text.size());
+	assert(written == static_cast<ssize_t>(text.size()) &&
+			"Could not write temporary file?");
+	close(fd);
+	Puzzle puzzle(path);
+	unlink(path);
+
+	// The unset Squares start with every value possible.
+	Hint fromPuzzle;
+	assert(HintEngine::findHint(puzzle, fromPuzzle) &&
+			fromPuzzle.technique != Hint::CONTRADICTION && "No hint?");
+	assert(fromPuzzle.cell >= 0 &&
+			fromPuzzle.value == SOLUTION_720[fromPuzzle.cell] - '0' &&
+			"Wrong first hint?");
+
+	cout << "No problems!" << endl;
+}
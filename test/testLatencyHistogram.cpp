@@ -0,0 +1,169 @@
+/**
+ * \file testLatencyHistogram.cpp
+ *
+ * Test code for class LatencyHistogram.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "LatencyHistogram.h"
+#include "StreamMode.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testLatencyHistogram();
+static void testBuckets();
+static void testQuantiles();
+static void testConcurrentRecording();
+static void testReports();
+
+void testLatencyHistogram(){
+	cout << "\n***Testing latency histograms.***\n" << endl;
+
+	testBuckets();
+	testQuantiles();
+	testConcurrentRecording();
+	testReports();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+static void testBuckets(){
+	cout << "\n***Testing bucket bounds.***" << endl;
+
+	// Every bucket starts just after the one before it ends.
+	uint64_t bottom = 0;
+	for(int bucket = 0; bucket < LatencyHistogram::BUCKETS; ++bucket){
+		uint64_t top = LatencyHistogram::getBucketTop(bucket);
+		assert(top >= bottom && "Bucket tops out of order?");
+		assert(LatencyHistogram::getBucket(bottom) == bucket &&
+				LatencyHistogram::getBucket(top) == bucket &&
+				"Bucket does not hold its own bounds?");
+		assert((bottom < 2 * LatencyHistogram::SUB_BUCKETS ||
+				top - bottom <= bottom / LatencyHistogram::SUB_BUCKETS) &&
+				"Bucket too wide?");
+		if(bucket + 1 < LatencyHistogram::BUCKETS)
+			bottom = top + 1;
+	}
+	assert(LatencyHistogram::getBucketTop(LatencyHistogram::BUCKETS - 1) ==
+			UINT64_MAX && "Largest duration has no bucket?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testQuantiles(){
+	cout << "\n***Testing quantiles.***" << endl;
+
+	LatencyHistogram empty;
+	assert(empty.getCount() == 0 && empty.getQuantile(0.5) == 0 &&
+			empty.getMax() == 0 && empty.getMean() == 0 &&
+			"Empty histogram not empty?");
+
+	// Durations of 1 to 100000 ns, in a random order.
+	std::vector<uint64_t> durations;
+	for(uint64_t nanos = 1; nanos <= 100000; ++nanos)
+		durations.push_back(nanos);
+	std::shuffle(durations.begin(), durations.end(), std::mt19937(48));
+	LatencyHistogram histogram;
+	for(uint64_t nanos : durations)
+		histogram.record(nanos);
+
+	assert(histogram.getCount() == 100000 && histogram.getMax() == 100000 &&
+			histogram.getMean() == 50000.5 && "Wrong count, max or mean?");
+	for(double quantile : {0.5, 0.9, 0.99, 0.999}){
+		double exact = quantile * 100000;
+		double found = static_cast<double>(histogram.getQuantile(quantile));
+		assert(found >= exact &&
+				found <= exact * (1 + 1.0 / LatencyHistogram::SUB_BUCKETS) &&
+				"Quantile out of the bucket's error?");
+	}
+	assert(histogram.getQuantile(1) == 100000 &&
+			histogram.getQuantile(0) == 1 && "Wrong extremes?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testConcurrentRecording(){
+	cout << "\n***Testing recording from many threads.***" << endl;
+
+	const int THREADS = 4;
+	const int PER_THREAD = 100000;
+	LatencyHistogram shared;
+	std::vector<std::unique_ptr<LatencyHistogram> > own;
+	std::vector<std::thread> threads;
+	for(int i = 0; i < THREADS; ++i){
+		own.push_back(std::unique_ptr<LatencyHistogram>(
+				new LatencyHistogram()));
+		LatencyHistogram * mine = own.back().get();
+		threads.push_back(std::thread([&shared, mine, i]{
+			for(int j = 0; j < PER_THREAD; ++j){
+				uint64_t nanos = static_cast<uint64_t>(j) * (i + 1);
+				shared.record(nanos);
+				mine->record(nanos);
+			}
+		}));
+	}
+	for(auto & thread : threads)
+		thread.join();
+
+	LatencyHistogram merged;
+	for(auto & histogram : own)
+		merged.merge(*histogram);
+	assert(shared.getCount() == THREADS * PER_THREAD &&
+			merged.getCount() == shared.getCount() && "Durations lost?");
+	assert(shared.getMax() == uint64_t(PER_THREAD - 1) * THREADS &&
+			merged.getMax() == shared.getMax() && "Wrong max?");
+	assert(merged.getMean() == shared.getMean() &&
+			merged.formatJson(1) == shared.formatJson(1) &&
+			"Merged histogram differs?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testReports(){
+	cout << "\n***Testing latency reports.***" << endl;
+
+	LatencyHistogram histogram;
+	histogram.record(1500);
+	histogram.record(2500000);
+	std::string summary = histogram.formatSummary(2);
+	assert(summary.compare(0, 24, "2 puzzles, 1 puzzles/s; ") == 0 &&
+			summary.find("p50 1.50 us") != std::string::npos &&
+			summary.find("max 2.50 ms") != std::string::npos &&
+			"Wrong summary?");
+	std::string json = histogram.formatJson(2);
+	assert(json.compare(0, 12, "{\"count\": 2,") == 0 &&
+			json.find("\"puzzles_per_second\": 1.000") != std::string::npos &&
+			json.find("\"max_ns\": 2500000") != std::string::npos &&
+			json.find("[1503, 1]") != std::string::npos &&
+			json.compare(json.size() - 2, 2, "]}") == 0 && "Wrong JSON?");
+
+	// Stream mode records a duration for each puzzle it solves.
+	const std::string input =
+			"#59##6##11#75#####34#721####85###9#2##3#5#4##9#2###31####834#59"
+			"#####91#78##1##24#\nnot a puzzle\n"
+			"1.......2.9.4...5...6...7...5.9.3.......7.......85..4.7.....6..."
+			"3...9.8...2.....1\n";
+	int in = tempFileWith(input);
+	int out = tempFileWith("");
+	LatencyHistogram latency;
+	runStreamMode(in, out, Solver::Limits(), &latency);
+	assert(latency.getCount() == 2 && latency.getMax() > 0 &&
+			"Solves not recorded?");
+	close(in);
+	close(out);
+
+	cout << "No problems!" << endl;
+}
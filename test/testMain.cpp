@@ -0,0 +1,79 @@
+/**
+ * \file testMain.cpp
+ *
+ * Entry point of the test executable: runs one test suite by name, or all of
+ * them. A failed test aborts, so the exit status says whether they passed.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include <iostream>
+#include <string>
+
+extern void testSquare();
+extern void testPuzzle();
+extern void testSolver();
+extern void testPipeline();
+extern void testVerifier();
+extern void testParallel();
+extern void testEnumerator();
+extern void testHintEngine();
+extern void testDedup();
+extern void testSat();
+extern void testCorpusIndex();
+extern void testCompression();
+extern void testDifficulty();
+extern void testLatencyHistogram();
+extern void testStress();
+
+namespace {
+
+struct Suite {
+	const char * name;
+	void (*run)();
+};
+
+const Suite SUITES[] = {
+	{"testSquare", testSquare},
+	{"testPuzzle", testPuzzle},
+	{"testSolver", testSolver},
+	{"testPipeline", testPipeline},
+	{"testVerifier", testVerifier},
+	{"testParallel", testParallel},
+	{"testEnumerator", testEnumerator},
+	{"testHintEngine", testHintEngine},
+	{"testDedup", testDedup},
+	{"testSat", testSat},
+	{"testCorpusIndex", testCorpusIndex},
+	{"testCompression", testCompression},
+	{"testDifficulty", testDifficulty},
+	{"testLatencyHistogram", testLatencyHistogram},
+	{"testStress", testStress}
+};
+
+} // namespace
+
+int main(int argc, char * argv[]){
+	if(argc == 1){
+		for(const Suite & suite : SUITES)
+			suite.run();
+		return 0;
+	}
+
+	if(argc == 2){
+		for(const Suite & suite : SUITES){
+			if(argv[1] == std::string(suite.name)){
+				suite.run();
+				return 0;
+			}
+		}
+	}
+
+	std::cerr << "Usage: " << argv[0] << " [suite]\n"
+			<< "  Runs the named test suite, or every suite. The suites are:\n";
+	for(const Suite & suite : SUITES)
+		std::cerr << "  " << suite.name << "\n";
+	std::cerr << std::flush;
+	return 2;
+}
@@ -0,0 +1,150 @@
+/**
+ * \file testParallel.cpp
+ *
+ * Test code for class ParallelSolver and Solver::countSolutions().
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "ParallelSolver.h"
+#include "PuzzleIO.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <string>
+
+using std::cout;
+using std::endl;
+
+void testParallel();
+static void testCountSolutions();
+static void testParallelSolve();
+static void testParallelCount();
+static void testParallelUnsolvable();
+
+static const int THREAD_COUNTS[] = {1, 2, 3, 8};
+
+void testParallel(){
+	cout << "\n***Testing class ParallelSolver.***\n" << endl;
+
+	testCountSolutions();
+	testParallelSolve();
+	testParallelCount();
+	testParallelUnsolvable();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+static ParallelSolver::Options optionsFor(int threads){
+	ParallelSolver::Options options;
+	options.threads = threads;
+	return options;
+}
+
+static void testCountSolutions(){
+	cout << "\n***Testing Solver::countSolutions().***" << endl;
+
+	std::unique_ptr<Solver> solver(new Solver());
+	Board first;
+	assert(solver->countSolutions(loadLine(PUZZLE_720), 10, &first) == 1 &&
+			"Unique puzzle has more than one solution?");
+	assert(formatBoard(first) == SOLUTION_720 && "Wrong solution counted?");
+
+	Board sparse = loadLine(SPARSE_720);
+	uint64_t total = solver->countSolutions(sparse, 1000000, &first);
+	assert(total == SPARSE_720_SOLUTIONS && "Wrong sparse solution count?");
+	assert(solver->countSolutions(sparse, total - 1) == total - 1 &&
+			"Count did not stop at the limit?");
+	assert(solver->countSolutions(sparse, 0) == 0 && "Counted with no limit?");
+
+	Board solved(sparse);
+	assert(solver->solve(solved) == Solver::SOLVED &&
+			formatBoard(solved) == formatBoard(first) &&
+			"solve() and countSolutions() disagree on the first solution?");
+
+	std::atomic<bool> cancel(true);
+	Board cancelled(sparse);
+	assert(solver->solve(cancelled, cancel) == Solver::CANCELLED &&
+			"Cancelled search did not stop?");
+	assert(formatBoard(cancelled) == formatBoard(sparse) &&
+			"Cancelled search changed the board?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testParallelSolve(){
+	cout << "\n***Testing ParallelSolver::solve().***" << endl;
+
+	std::unique_ptr<Solver> solver(new Solver());
+	Board expected = loadLine(SPARSE_720);
+	assert(solver->solve(expected) == Solver::SOLVED && "Could not solve?");
+
+	for(int threads : THREAD_COUNTS){
+		ParallelSolver parallel(optionsFor(threads));
+
+		Board board = loadLine(PUZZLE_720);
+		assert(parallel.solve(board) == Solver::SOLVED &&
+				formatBoard(board) == SOLUTION_720 &&
+				"Parallel solve of 720 wrong?");
+
+		// The first solution of a puzzle with several is the sequential one.
+		for(int run = 0; run < 3; ++run){
+			board = loadLine(SPARSE_720);
+			assert(parallel.solve(board) == Solver::SOLVED &&
+					formatBoard(board) == formatBoard(expected) &&
+					"Parallel solve not the sequential solution?");
+		}
+		assert(parallel.getStats().tasks > 1 && "Tree was not split?");
+
+		// An empty board splits to the full depth limit.
+		Board empty;
+		assert(parallel.solve(empty) == Solver::SOLVED && empty.isSolved() &&
+				"Could not fill an empty board?");
+	}
+
+	cout << "No problems!" << endl;
+}
+
+static void testParallelCount(){
+	cout << "\n***Testing ParallelSolver::countSolutions().***" << endl;
+
+	std::unique_ptr<Solver> solver(new Solver());
+	Board sparse = loadLine(SPARSE_720);
+	uint64_t total = solver->countSolutions(sparse, 1000000);
+
+	for(int threads : THREAD_COUNTS){
+		ParallelSolver parallel(optionsFor(threads));
+		for(int run = 0; run < 3; ++run){
+			assert(parallel.countSolutions(sparse, 1000000) == total &&
+					"Parallel count differs from sequential count?");
+			assert(parallel.countSolutions(sparse, total / 2) == total / 2 &&
+					"Parallel count did not stop at the limit?");
+		}
+		assert(parallel.countSolutions(loadLine(PUZZLE_720), 10) == 1 &&
+				"Unique puzzle counted wrongly?");
+		assert(parallel.countSolutions(Board(), 5000) == 5000 &&
+				"Empty board count did not stop at the limit?");
+	}
+
+	cout << "No problems!" << endl;
+}
+
+static void testParallelUnsolvable(){
+	cout << "\n***Testing ParallelSolver on an unsolvable puzzle.***" << endl;
+
+	// Consistent givens that only a search finds have no solution.
+	Board board = loadLine(UNSOLVABLE_PUZZLE);
+	for(int threads : THREAD_COUNTS){
+		ParallelSolver parallel(optionsFor(threads));
+		Board copy(board);
+		assert(parallel.solve(copy) == Solver::UNSOLVABLE &&
+				"Solved an unsolvable puzzle?");
+		assert(parallel.countSolutions(board, 10) == 0 &&
+				"Counted solutions of an unsolvable puzzle?");
+	}
+
+	cout << "No problems!" << endl;
+}
@@ -0,0 +1,395 @@
+/**
+ * \file testPipeline.cpp
+ *
+ * Test code for the ring buffers and class BatchPipeline.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "RingBuffer.h"
+#include "BatchPipeline.h"
+#include "StreamMode.h"
+#include "TestUtil.h"
+#include <atomic>
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testPipeline();
+static void testSpscRing();
+static void testMpmcRing();
+static void testPipelineOutput();
+static void testPipelineEmptyInput();
+static void testPipelineCheckpoint();
+static void testPipelineResumeLongLine();
+
+// puzzles/719.ve.txt, puzzles/722.d.txt and puzzles/730.d.txt on one line each.
+static const char * PUZZLES[] = {
+	"#59##6##11#75#####34#721####85###9#2##3#5#4##9#2###31####834#59#####91#7"
+	"8##1##24#",
+	"##5###3#####735###8###1###6#6#####2##87###53##1#####8#7###4###1###391###"
+	"##9###4##",
+	"#9##8##5#5###9###4###6#7#####9###1##42##6##95##1###8#####3#5###6###4###3"
+	"#1##2##7#"
+};
+
+void testPipeline(){
+	cout << "\n***Testing the ring buffers and class BatchPipeline.***\n"
+			<< endl;
+
+	testSpscRing();
+	testMpmcRing();
+	testPipelineOutput();
+	testPipelineEmptyInput();
+	testPipelineCheckpoint();
+	testPipelineResumeLongLine();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+static void testSpscRing(){
+	cout << "\n***Testing SpscRing.***" << endl;
+
+	SpscRing<int> ring(3);
+	assert(ring.capacity() == 4 && "Capacity not rounded up?");
+
+	int value;
+	assert(!ring.tryPop(value) && "Popped from an empty ring?");
+	for(int i = 0; i < 4; ++i)
+		assert(ring.tryPush(i) && "Could not push into a ring with room?");
+	assert(!ring.tryPush(4) && "Pushed into a full ring?");
+	assert(ring.sizeApprox() == 4 && "Wrong size?");
+
+	for(int i = 0; i < 4; ++i)
+		assert(ring.tryPop(value) && value == i && "Wrong value popped?");
+	assert(!ring.tryPop(value) && "Popped from an empty ring?");
+
+	// One producer, one consumer; everything arrives, in order.
+	const int count = 100000;
+	SpscRing<int> shared(16);
+	std::thread producer([&shared, count](){
+		for(int i = 0; i < count; ++i)
+			while(!shared.tryPush(i))
+				std::this_thread::yield();
+	});
+	for(int i = 0; i < count; ++i){
+		while(!shared.tryPop(value))
+			std::this_thread::yield();
+		assert(value == i && "Values arrived out of order?");
+	}
+	producer.join();
+
+	cout << "No problems!" << endl;
+}
+
+static void testMpmcRing(){
+	cout << "\n***Testing MpmcRing.***" << endl;
+
+	MpmcRing<int> ring(2);
+	int value;
+	assert(ring.tryPush(1) && ring.tryPush(2) && "Could not push?");
+	assert(!ring.tryPush(3) && "Pushed into a full ring?");
+	assert(ring.tryPop(value) && value == 1 && "Wrong value popped?");
+	assert(ring.tryPush(3) && "Could not push after a pop?");
+	assert(ring.tryPop(value) && value == 2 && "Wrong value popped?");
+	assert(ring.tryPop(value) && value == 3 && "Wrong value popped?");
+	assert(!ring.tryPop(value) && "Popped from an empty ring?");
+
+	// Several producers and consumers; every value arrives exactly once.
+	const int perProducer = 20000;
+	const int producers = 3;
+	const int consumers = 3;
+	MpmcRing<int> shared(8);
+	const int total = producers * perProducer;
+	std::vector<long long> sums(consumers, 0);
+	std::atomic<int> consumed(0);
+	std::vector<std::thread> threads;
+
+	for(int p = 0; p < producers; ++p){
+		threads.push_back(std::thread([&shared, p, perProducer](){
+			for(int i = 0; i < perProducer; ++i)
+				while(!shared.tryPush(p * perProducer + i))
+					std::this_thread::yield();
+		}));
+	}
+	for(int c = 0; c < consumers; ++c){
+		threads.push_back(std::thread([&shared, &sums, &consumed, c, total](){
+			int popped;
+			while(consumed.load() < total){
+				if(shared.tryPop(popped)){
+					sums[c] += popped;
+					++consumed;
+				}
+				else
+					std::this_thread::yield();
+			}
+		}));
+	}
+	for(auto & thread : threads)
+		thread.join();
+
+	long long sum = 0;
+	for(auto consumerSum : sums)
+		sum += consumerSum;
+	long long n = total;
+	assert(sum == n * (n - 1) / 2 && "Values lost or duplicated?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testPipelineOutput(){
+	cout << "\n***Testing BatchPipeline output against the stream mode.***"
+			<< endl;
+
+	std::string input;
+	for(int i = 0; i < 200; ++i){
+		input += PUZZLES[i % 3];
+		input += "\n";
+		if(i % 17 == 0)
+			input += "not a puzzle\n\n";
+		if(i % 23 == 0)
+			input += std::string(Board::NUM_CELLS - 2, '#') + "11\n";
+	}
+
+	int streamIn = tempFileWith(input);
+	int streamOut = tempFileWith("");
+	StreamStats streamStats = runStreamMode(streamIn, streamOut);
+	std::string expected = readAll(streamOut);
+
+	// Few slots and several solvers, so results finish out of order.
+	BatchPipeline::Options options;
+	options.solverThreads = 3;
+	options.slots = 4;
+	BatchPipeline pipeline(options);
+
+	for(int run = 0; run < 2; ++run){
+		int in = tempFileWith(input);
+		int out = tempFileWith("");
+		PipelineStats stats = pipeline.run(in, out);
+
+		assert(readAll(out) == expected && "Output differs from stream mode?");
+		assert(stats.records == streamStats.records && "Wrong record count?");
+		assert(stats.solved == streamStats.solved && "Wrong solved count?");
+		assert(stats.invalid == streamStats.invalid && "Wrong invalid count?");
+		assert(stats.unsolvable == streamStats.unsolvable &&
+				"Wrong unsolvable count?");
+		assert(stats.solveQueue.samples == stats.records + 3 &&
+				"Solve queue not sampled on every pop?");
+		assert(stats.writeQueue.samples == stats.records &&
+				"Write queue not sampled on every pop?");
+		assert(stats.solveQueue.maxDepth <= stats.solveQueue.capacity &&
+				"Depth larger than capacity?");
+
+		close(in);
+		close(out);
+	}
+
+	close(streamIn);
+	close(streamOut);
+
+	// With a node limit, the same puzzles time out in both modes.
+	options.limits.maxNodes = 1;
+	BatchPipeline limited(options);
+	streamIn = tempFileWith(input);
+	streamOut = tempFileWith("");
+	streamStats = runStreamMode(streamIn, streamOut, options.limits);
+	int in = tempFileWith(input);
+	int out = tempFileWith("");
+	PipelineStats stats = limited.run(in, out);
+	assert(readAll(out) == readAll(streamOut) &&
+			"Output with limits differs from stream mode?");
+	assert(stats.timedOut == streamStats.timedOut && stats.timedOut > 0 &&
+			"Wrong timed out count?");
+
+	close(in);
+	close(out);
+	close(streamIn);
+	close(streamOut);
+
+	cout << "No problems!" << endl;
+}
+
+static void testPipelineEmptyInput(){
+	cout << "\n***Testing BatchPipeline with empty input.***" << endl;
+
+	int in = tempFileWith("");
+	int out = tempFileWith("");
+	BatchPipeline pipeline;
+	PipelineStats stats = pipeline.run(in, out);
+	assert(stats.records == 0 && "Records from empty input?");
+	assert(readAll(out).empty() && "Output from empty input?");
+	close(in);
+	close(out);
+
+	cout << "No problems!" << endl;
+}
+
+static void testPipelineCheckpoint(){
+	cout << "\n***Testing BatchPipeline checkpoints.***" << endl;
+
+	BatchCheckpoint checkpoint;
+	checkpoint.records = 10;
+	checkpoint.solved = 6;
+	checkpoint.unsolvable = 1;
+	checkpoint.invalid = 2;
+	checkpoint.timedOut = 1;
+	checkpoint.nodes = 1234;
+	checkpoint.inputOffset = 820;
+	checkpoint.outputOffset = 830;
+	checkpoint.input = "puzzles with spaces.txt";
+	BatchCheckpoint back = BatchCheckpoint::fromString(checkpoint.toString());
+	assert(back.toString() == checkpoint.toString() &&
+			back.input == checkpoint.input && "Checkpoint does not round trip?");
+	for(const char * bad : {"", "1 2 3", "10 6 1 2 0 1234 820 830 x",
+			"10 6 1 2 1 1234 820 830"}){
+		try{
+			BatchCheckpoint::fromString(bad);
+			assert(false && "Parsed a bad checkpoint?");
+		}
+		catch(std::invalid_argument & e){
+			// All good.
+		}
+	}
+
+	std::string input;
+	std::string prefix;
+	for(int i = 0; i < 120; ++i){
+		input += PUZZLES[i % 3];
+		input += "\n";
+		if(i % 13 == 0)
+			input += "not a puzzle\n";
+		if(i == 70)
+			prefix = input;
+	}
+
+	int streamIn = tempFileWith(input);
+	int streamOut = tempFileWith("");
+	StreamStats streamStats = runStreamMode(streamIn, streamOut);
+	std::string expected = readAll(streamOut);
+	close(streamIn);
+	close(streamOut);
+
+	char path[] = "/tmp/testPipelineXXXXXX";
+	int pathFd = mkstemp(path);
+	assert(pathFd >= 0 && "Could not create checkpoint file?");
+	close(pathFd);
+
+	// A run that stops part way, as if killed, with output past its last
+	// checkpoint.
+	BatchPipeline::Options options;
+	options.solverThreads = 2;
+	options.checkpointPath = path;
+	options.checkpointEvery = 16;
+	BatchPipeline first(options);
+	int in = tempFileWith(prefix);
+	int out = tempFileWith("");
+	BatchCheckpoint start;
+	start.input = "puzzles";
+	first.run(in, out, start);
+	close(in);
+	checkpoint = BatchCheckpoint::load(path);
+	assert(checkpoint.inputOffset == prefix.size() &&
+			checkpoint.input == "puzzles" &&
+			"Final checkpoint does not cover the input?");
+	ssize_t written = write(out, "garbage", 7);
+	assert(written == 7 && "Could not append?");
+
+	// Resuming cuts the garbage off and finishes the input.
+	in = tempFileWith(input);
+	seekToCheckpoint(in, out, checkpoint);
+	BatchPipeline second(options);
+	PipelineStats stats = second.run(in, out, checkpoint);
+	assert(readAll(out) == expected && "Resumed output differs?");
+	assert(stats.records == streamStats.records &&
+			stats.solved == streamStats.solved &&
+			stats.invalid == streamStats.invalid &&
+			"Resumed counts are not cumulative?");
+	checkpoint = BatchCheckpoint::load(path);
+	assert(checkpoint.records == streamStats.records &&
+			checkpoint.inputOffset == input.size() &&
+			"Wrong final checkpoint?");
+	close(in);
+
+	// Output shorter than the checkpoint is refused.
+	in = tempFileWith(input);
+	int shortOut = tempFileWith("short");
+	try{
+		seekToCheckpoint(in, shortOut, checkpoint);
+		assert(false && "Resumed against the wrong output?");
+	}
+	catch(std::runtime_error & e){
+		// All good.
+	}
+	close(in);
+	close(shortOut);
+	close(out);
+	unlink(path);
+
+	cout << "No problems!" << endl;
+}
+
+static void testPipelineResumeLongLine(){
+	cout << "\n***Testing a BatchPipeline resume after an over-long line.***"
+			<< endl;
+
+	// The long line is one invalid record, and a checkpoint just after it
+	// must not resume part way through it.
+	std::string prefix;
+	for(int i = 0; i < 3; ++i)
+		prefix += std::string(PUZZLES[i]) + "\n";
+	prefix += std::string(ChunkedReader::DEFAULT_CHUNK_SIZE + 1000, '#') +
+			"\n";
+	std::string input = prefix;
+	for(int i = 0; i < 3; ++i)
+		input += std::string(PUZZLES[i]) + "\n";
+
+	int streamIn = tempFileWith(input);
+	int streamOut = tempFileWith("");
+	StreamStats streamStats = runStreamMode(streamIn, streamOut);
+	std::string expected = readAll(streamOut);
+	close(streamIn);
+	close(streamOut);
+	assert(streamStats.records == 7 && streamStats.invalid == 1 &&
+			"Long line not one invalid record?");
+
+	char path[] = "/tmp/testPipelineXXXXXX";
+	int pathFd = mkstemp(path);
+	assert(pathFd >= 0 && "Could not create checkpoint file?");
+	close(pathFd);
+
+	BatchPipeline::Options options;
+	options.checkpointPath = path;
+	options.checkpointEvery = 1;
+	BatchPipeline first(options);
+	int in = tempFileWith(prefix);
+	int out = tempFileWith("");
+	first.run(in, out);
+	close(in);
+	BatchCheckpoint checkpoint = BatchCheckpoint::load(path);
+	assert(checkpoint.inputOffset == prefix.size() &&
+			"Checkpoint inside the long line?");
+
+	in = tempFileWith(input);
+	seekToCheckpoint(in, out, checkpoint);
+	BatchPipeline second(options);
+	PipelineStats stats = second.run(in, out, checkpoint);
+	assert(readAll(out) == expected && "Resumed output differs?");
+	assert(stats.records == streamStats.records &&
+			stats.invalid == streamStats.invalid &&
+			"Tail of the long line read as a record?");
+	close(in);
+	close(out);
+	unlink(path);
+
+	cout << "No problems!" << endl;
+}
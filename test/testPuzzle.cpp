@@ -8,19 +8,23 @@
 #include "Puzzle.h"
 #include <iostream>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
 
 using std::cout;
 using std::endl;
 
 void testPuzzle();
 static void testDefaultCtor();
+static void testFileException();
 
 void testPuzzle(){
 	cout << "***Testing class Puzzle. ***\n" << endl;
 
 	testDefaultCtor();
-
-
+	testFileException();
 
 	cout << "\n***All done!***" << endl;
 }
@@ -51,5 +55,64 @@ void testDefaultCtor(){
 	cout << "\n*** No problems!" << endl;
 }
 
+/* Writes contents to a new temporary file and returns its name. */
+static std::string tempPathWith(const std::string & contents){
+	char name[] = "/tmp/testPuzzleXXXXXX";
+	int fd = mkstemp(name);
+	assert(fd >= 0 && "Could not create temporary file?");
+	ssize_t written = write(fd, contents.data(), contents.size());
+	assert(written == static_cast<ssize_t>(contents.size()) &&
+			"Could not write temporary file?");
+	close(fd);
+	return name;
+}
+
+/* The message of the PuzzleFileException thrown by loading contents. */
+static std::string loadError(const std::string & contents){
+	std::string filename = tempPathWith(contents);
+	std::string message;
+	try{
+		Puzzle puzzle(filename);
+	}
+	catch(const Puzzle::PuzzleFileException & e){
+		// Copies keep the message, and the base class's what() gives it.
+		Puzzle::PuzzleFileException copy(e);
+		const std::exception & base = copy;
+		assert(strcmp(base.what(), e.what()) == 0 && "Message not copied?");
+		message = e.what();
+	}
+	unlink(filename.c_str());
+	assert(!message.empty() && "No exception thrown?");
+	return message;
+}
+
+void testFileException(){
+	cout << "\n***Testing file exceptions.***\n" << endl;
+
+	const std::string row = "#########\n";
+	std::string message = loadError(row + row + "#########");
+	assert(message.find("' had too few lines for a valid Sudoku puzzle.") !=
+			std::string::npos && "Wrong too few lines message?");
+
+	message = loadError(row + "##12\n");
+	assert(message.find("had the line '##12' of length 4.") !=
+			std::string::npos && "Wrong line length message?");
+
+	message = loadError(row + "###x#####\n");
+	assert(message.find("had the line '###x#####' which contained the "
+			"invalid value of 'x'.") != std::string::npos &&
+			"Wrong invalid value message?");
 
+	message = loadError(row + std::string("###\0#####\n", 10));
+	assert(message.find("invalid value of 0x00.") != std::string::npos &&
+			"Unprintable value not in hexadecimal?");
 
+	// A line longer than the exception keeps is cut short, not overrun.
+	std::string longLine(200, '#');
+	message = loadError(longLine + "\n");
+	assert(message.find("' of length 200.") != std::string::npos &&
+			message.find(longLine) == std::string::npos &&
+			"Long line not truncated?");
+
+	cout << "\n*** No problems!" << endl;
+}
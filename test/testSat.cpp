@@ -0,0 +1,224 @@
+/**
+ * \file testSat.cpp
+ *
+ * Test code for the CNF encoding, class CdclSolver and the engines.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Engine.h"
+#include "SatSolver.h"
+#include "PuzzleIO.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+void testSat();
+static void testCdclSolver();
+static void testEncoding();
+static void testEngines();
+
+void testSat(){
+	cout << "\n***Testing the SAT encoding and solver.***\n" << endl;
+
+	testCdclSolver();
+	testEncoding();
+	testEngines();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+static bool satisfies(const CdclSolver & solver, const Cnf & cnf){
+	for(const std::vector<int> & clause : cnf.clauses){
+		bool satisfied = false;
+		for(int lit : clause)
+			satisfied = satisfied || solver.getValue(lit > 0 ? lit : -lit) ==
+					(lit > 0);
+		if(!satisfied)
+			return false;
+	}
+	return true;
+}
+
+/* Pigeons into holes, each pigeon in some hole and no two in one. */
+static Cnf pigeonhole(int pigeons, int holes){
+	Cnf cnf;
+	cnf.numVars = pigeons * holes;
+	for(int p = 0; p < pigeons; ++p){
+		std::vector<int> somewhere;
+		for(int h = 0; h < holes; ++h)
+			somewhere.push_back(p * holes + h + 1);
+		cnf.clauses.push_back(somewhere);
+	}
+	for(int h = 0; h < holes; ++h){
+		for(int p = 0; p < pigeons; ++p){
+			for(int q = p + 1; q < pigeons; ++q)
+				cnf.clauses.push_back({-(p * holes + h + 1),
+						-(q * holes + h + 1)});
+		}
+	}
+	return cnf;
+}
+
+static void testCdclSolver(){
+	cout << "\n***Testing class CdclSolver.***" << endl;
+
+	CdclSolver solver;
+	Cnf cnf;
+	cnf.numVars = 3;
+	cnf.clauses = {{1}, {-1, 2}, {-2, 3}};
+	solver.load(cnf);
+	assert(solver.solve() == CdclSolver::SATISFIABLE &&
+			solver.getValue(1) && solver.getValue(2) && solver.getValue(3) &&
+			"Implications not followed?");
+
+	cnf.clauses.push_back({-3});
+	solver.load(cnf);
+	assert(solver.solve() == CdclSolver::UNSATISFIABLE &&
+			"Contradiction missed?");
+
+	cnf.clauses = {{1, -1}, {}};
+	solver.load(cnf);
+	assert(solver.solve() == CdclSolver::UNSATISFIABLE &&
+			"Empty clause missed?");
+
+	// Needs real search, and learning to finish quickly.
+	solver.load(pigeonhole(7, 6));
+	assert(solver.solve() == CdclSolver::UNSATISFIABLE &&
+			solver.getStats().conflicts > 0 && "Pigeonhole satisfied?");
+	cnf = pigeonhole(6, 6);
+	solver.load(cnf);
+	assert(solver.solve() == CdclSolver::SATISFIABLE && satisfies(solver, cnf) &&
+			"Pigeons not placed?");
+
+	// Random 3-SAT under the threshold, with its model checked.
+	std::mt19937 random(41);
+	for(int round = 0; round < 20; ++round){
+		cnf = Cnf();
+		cnf.numVars = 60;
+		for(int i = 0; i < 200; ++i){
+			std::vector<int> clause;
+			for(int k = 0; k < 3; ++k){
+				int var = static_cast<int>(random() % cnf.numVars) + 1;
+				clause.push_back(random() % 2 ? var : -var);
+			}
+			cnf.clauses.push_back(clause);
+		}
+		solver.load(cnf);
+		CdclSolver::Result result = solver.solve();
+		assert(result != CdclSolver::UNKNOWN && "No answer?");
+		if(result == CdclSolver::SATISFIABLE)
+			assert(satisfies(solver, cnf) && "Model does not satisfy?");
+	}
+
+	// Limits.
+	Solver::Limits limits;
+	limits.maxNodes = 1;
+	solver.load(pigeonhole(8, 7));
+	assert(solver.solve(limits) == CdclSolver::UNKNOWN &&
+			solver.getStats().decisions == 1 && "Node limit ignored?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testEncoding(){
+	cout << "\n***Testing encodeSudoku() and DIMACS.***" << endl;
+
+	Cnf cnf = encodeSudoku(Board());
+	// Each cell: one value of nine, no two. Each unit and value: some cell,
+	// no two.
+	std::size_t rules = Board::NUM_CELLS * (1 + 36) +
+			Board::NUM_UNITS * Board::PUZZLE_SIZE * (1 + 36);
+	assert(cnf.numVars == 729 && cnf.clauses.size() == rules &&
+			"Wrong size of empty grid?");
+
+	std::ostringstream out;
+	cnf.clauses.resize(2);
+	cnf.writeDimacs(out);
+	assert(out.str().compare(0, 18, "p cnf 729 2\n1 2 3 ") == 0 &&
+			out.str().back() == '\n' && "Wrong DIMACS?");
+
+	// The 720 puzzle: its givens fixed, and its solution the only model.
+	Board board = loadLine(PUZZLE_720);
+	cnf = encodeSudoku(board);
+	CdclSolver solver;
+	solver.load(cnf);
+	assert(solver.solve() == CdclSolver::SATISFIABLE && satisfies(solver, cnf) &&
+			"720 not satisfiable?");
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		assert(solver.getValue(getSatVariable(cell,
+				SOLUTION_720[cell] - '0')) && "Model is not the solution?");
+
+	// X-Sudoku: an empty grid whose diagonals hold every value.
+	std::vector<std::vector<int> > diagonals = getDiagonalUnits();
+	cnf = encodeSudoku(Board(), diagonals);
+	solver.load(cnf);
+	assert(solver.solve() == CdclSolver::SATISFIABLE && "No X-Sudoku?");
+	for(const std::vector<int> & diagonal : diagonals){
+		uint16_t seen = 0;
+		for(int cell : diagonal){
+			for(int value = 1; value <= Board::PUZZLE_SIZE; ++value){
+				if(solver.getValue(getSatVariable(cell, value)))
+					seen |= Board::maskOf(value);
+			}
+		}
+		assert(seen == Board::ALL_CANDIDATES && "Diagonal repeats a value?");
+	}
+
+	cout << "No problems!" << endl;
+}
+
+static void testEngines(){
+	cout << "\n***Testing the engines.***" << endl;
+
+	assert(makeEngine("no such engine") == nullptr && "Made unknown engine?");
+
+	std::unique_ptr<Solver> solver(new Solver());
+	Board hard = loadLine(HARD_PUZZLE);
+	Board expected = hard;
+	assert(solver->solve(expected) == Solver::SOLVED && "Hard not solved?");
+
+	for(const char * const * name = getEngineNames(); *name != nullptr;
+			++name){
+		std::unique_ptr<Engine> engine = makeEngine(*name);
+		assert(engine && engine->getName() == *name && "Wrong engine?");
+
+		Board board = loadLine(PUZZLE_720);
+		assert(engine->solve(board) == Solver::SOLVED &&
+				formatBoard(board) == SOLUTION_720 && "Wrong 720 solution?");
+
+		board = hard;
+		assert(engine->solve(board) == Solver::SOLVED &&
+				formatBoard(board) == formatBoard(expected) &&
+				engine->getNodes() > 0 && "Wrong hard solution?");
+
+		// A Board that loads, but has no solution.
+		uint8_t noSolution[Board::NUM_CELLS] = {1, 2, 3, 4, 5, 6, 7, 8, 0};
+		noSolution[8 + 4 * Board::PUZZLE_SIZE] = 9;
+		if(board.load(noSolution)){
+			Board before = board;
+			assert(engine->solve(board) == Solver::UNSOLVABLE &&
+					formatBoard(board) == formatBoard(before) &&
+					"Solved an unsolvable puzzle?");
+		}
+
+		Solver::Limits limits;
+		limits.maxNodes = 1;
+		engine->setLimits(limits);
+		board = hard;
+		assert(engine->solve(board) == Solver::TIMED_OUT &&
+				"Engine ignored limits?");
+	}
+
+	cout << "No problems!" << endl;
+}
@@ -0,0 +1,792 @@
+/**
+ * \file testSolver.cpp
+ *
+ * Test code for class Board, class Solver and the streaming mode.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Board.h"
+#include "Solver.h"
+#include "PuzzleIO.h"
+#include "Propagator.h"
+#include "Heuristics.h"
+#include "StreamMode.h"
+#include "LivePuzzle.h"
+#include "SolutionCache.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testSolver();
+static void testBoardTables();
+static void testBoardAssign();
+static void testParseFormat();
+static void testScanUnit();
+static void testPropagate();
+static void testBuckets();
+static void testHeuristics();
+static void testSolve();
+static void testUnsolvable();
+static void testSolveConstant();
+static void testLimits();
+static void testLivePuzzle();
+static void testSolutionCache();
+static void testChunkedReader();
+static void testStreamMode();
+
+/**
+ * \brief Loads a puzzle line (# or . for an empty cell), solves it with
+ * Solver::solveConstant() and returns whether the result is solution, which
+ * may be null for a puzzle that has no solution. Givens that do not load
+ * never match, so that a null solution is only met by a search.
+ */
+static constexpr bool solvesTo(const char * puzzle, const char * solution){
+	uint8_t givens[Board::NUM_CELLS] = {};
+	for(int i = 0; i < Board::NUM_CELLS; ++i)
+		givens[i] = puzzle[i] >= '1' && puzzle[i] <= '9' ? puzzle[i] - '0' : 0;
+
+	Board board;
+	if(!board.load(givens))
+		return false;
+	if(Solver::solveConstant(board) != Solver::SOLVED)
+		return solution == nullptr;
+	if(solution == nullptr)
+		return false;
+
+	for(int i = 0; i < Board::NUM_CELLS; ++i)
+		if(board.getValue(i) != solution[i] - '0')
+			return false;
+	return true;
+}
+
+/* Fixtures solved by the compiler; a change that stops the Board, Propagator
+ * or search from being constexpr breaks the build here. */
+static_assert(Board::getPeers(80)[Board::NUM_PEERS - 1] == 79,
+		"Peer table not built at compile time?");
+static_assert(solvesTo(
+		"#3#9#6#7#1#######2#4#####1##81###35#####3#####94###82##5#####6#7"
+		"#######5#6#8#3#9#",
+		"238916574176584932945327618681492357527638149394175826859741263"
+		"713269485462853791"), "Wrong compile-time solution for 720?");
+static_assert(solvesTo(
+		"4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2"
+		".....1.4......",
+		"417369825632158947958724316825437169791586432346912758289643571"
+		"573291684164875293"), "Wrong compile-time solution for hard puzzle?");
+// UNSOLVABLE_PUZZLE, which loads but has no solution.
+static_assert(solvesTo(
+		"4..1..8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2"
+		".....1.4......", nullptr),
+		"Compile-time solve of an unsolvable puzzle?");
+
+void testSolver(){
+	cout << "\n***Testing class Board and class Solver.***\n" << endl;
+
+	testBoardTables();
+	testBoardAssign();
+	testParseFormat();
+	testScanUnit();
+	testPropagate();
+	testBuckets();
+	testHeuristics();
+	testSolve();
+	testUnsolvable();
+	testSolveConstant();
+	testLimits();
+	testLivePuzzle();
+	testSolutionCache();
+	testChunkedReader();
+	testStreamMode();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+static void testBoardTables(){
+	cout << "\n***Testing unit and peer tables.***" << endl;
+
+	for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+		const int * cells = Board::getUnit(unit);
+		for(int i = 0; i < Board::PUZZLE_SIZE; ++i){
+			int cell = cells[i];
+			if(unit < Board::PUZZLE_SIZE)
+				assert(Board::rowOf(cell) == unit && "Row unit wrong?");
+			else if(unit < 2 * Board::PUZZLE_SIZE)
+				assert(Board::colOf(cell) == unit - Board::PUZZLE_SIZE &&
+						"Column unit wrong?");
+			else
+				assert(Board::boxOf(cell) == unit - 2 * Board::PUZZLE_SIZE &&
+						"Box unit wrong?");
+		}
+	}
+
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		const int * peers = Board::getPeers(cell);
+		for(int i = 0; i < Board::NUM_PEERS; ++i){
+			int peer = peers[i];
+			assert(peer != cell && "Cell is its own peer?");
+			assert((Board::rowOf(peer) == Board::rowOf(cell) ||
+					Board::colOf(peer) == Board::colOf(cell) ||
+					Board::boxOf(peer) == Board::boxOf(cell)) &&
+					"Peer does not share a unit?");
+		}
+	}
+
+	cout << "No problems!" << endl;
+}
+
+static void testBoardAssign(){
+	cout << "\n***Testing Board::assign() and Board::eliminate().***" << endl;
+
+	Board board;
+	assert(board.getNumLeftToSolve() == Board::NUM_CELLS &&
+			"Empty board has cells set?");
+
+	assert(board.assign(0, 5) && "Could not assign to an empty board?");
+	assert(board.getValue(0) == 5 && "Value not set?");
+	assert(board.getCandidates(0) == Board::maskOf(5) &&
+			"Candidates not restricted to the value?");
+	assert(board.getNumLeftToSolve() == Board::NUM_CELLS - 1 &&
+			"numLeftToSolve not updated?");
+
+	const int * peers = Board::getPeers(0);
+	for(int i = 0; i < Board::NUM_PEERS; ++i)
+		assert((board.getCandidates(peers[i]) & Board::maskOf(5)) == 0 &&
+				"Value not removed from a peer?");
+
+	// Assigning the same value again is fine, a different one is not.
+	assert(board.assign(0, 5) && "Re-assigning same value failed?");
+	Board copy(board);
+	assert(!copy.assign(0, 4) && "Assigned a second value to a cell?");
+
+	// A peer of cell 0 can no longer be 5.
+	copy = board;
+	assert(!copy.assign(1, 5) && "Assigned a value already used by a peer?");
+
+	// Leaving a cell with one candidate sets it.
+	copy = board;
+	assert(copy.eliminate(80, Board::ALL_CANDIDATES & ~Board::maskOf(3)) &&
+			"Elimination failed?");
+	assert(copy.getValue(80) == 3 && "Single candidate did not set cell?");
+
+	// Removing every candidate is a contradiction.
+	copy = board;
+	assert(!copy.eliminate(80, Board::ALL_CANDIDATES) &&
+			"Removing all candidates was not a contradiction?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testParseFormat(){
+	cout << "\n***Testing the one-line puzzle format.***" << endl;
+
+	uint8_t givens[Board::NUM_CELLS];
+	assert(parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720), givens) &&
+			"Could not parse valid puzzle?");
+	assert(givens[0] == 0 && givens[1] == 3 && "Givens parsed wrongly?");
+
+	std::string dotted(PUZZLE_720);
+	for(auto & character : dotted)
+		if(character == '#')
+			character = '.';
+	dotted += '\r';
+	uint8_t dottedGivens[Board::NUM_CELLS];
+	assert(parsePuzzleLine(dotted.c_str(), dotted.size(), dottedGivens) &&
+			"Could not parse dotted puzzle?");
+	assert(memcmp(givens, dottedGivens, sizeof(givens)) == 0 &&
+			"Dotted puzzle parsed differently?");
+
+	assert(!parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720) - 1, givens) &&
+			"Parsed a short line?");
+	std::string bad(PUZZLE_720);
+	bad[10] = 'x';
+	assert(!parsePuzzleLine(bad.c_str(), bad.size(), givens) &&
+			"Parsed a line with an invalid character?");
+
+	Board board;
+	assert(parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720), givens) &&
+			board.load(givens) && "Could not load puzzle?");
+	char out[Board::NUM_CELLS];
+	formatPuzzleLine(board, out);
+	for(int i = 0; i < Board::NUM_CELLS; ++i)
+		if(givens[i] != 0)
+			assert(out[i] == PUZZLE_720[i] && "Given not formatted?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testScanUnit(){
+	cout << "\n***Testing scanUnit().***" << endl;
+
+	// 1 in one cell, 2 in two, 3 in three, 4 in all; 9 nowhere.
+	uint16_t masks[Board::PUZZLE_SIZE];
+	for(int i = 0; i < Board::PUZZLE_SIZE; ++i){
+		masks[i] = Board::maskOf(4);
+		if(i < 1)
+			masks[i] |= Board::maskOf(1);
+		if(i < 2)
+			masks[i] |= Board::maskOf(2);
+		if(i < 3)
+			masks[i] |= Board::maskOf(3);
+	}
+
+	UnitScan scan = scanUnit(masks);
+	assert(scan.atLeastOnce == (Board::maskOf(1) | Board::maskOf(2) |
+			Board::maskOf(3) | Board::maskOf(4)) && "atLeastOnce wrong?");
+	assert(scan.exactlyOnce == Board::maskOf(1) && "exactlyOnce wrong?");
+	assert(scan.exactlyTwice == Board::maskOf(2) && "exactlyTwice wrong?");
+
+	// Checked against counting, for the units of a real puzzle.
+	uint8_t givens[Board::NUM_CELLS];
+	Board board;
+	assert(parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720), givens) &&
+			board.load(givens) && "Could not load puzzle?");
+	for(int unit = 0; unit < Board::NUM_UNITS; ++unit){
+		Propagator::gatherUnit(board, unit, masks);
+		scan = scanUnit(masks);
+		for(int value = 1; value <= Board::PUZZLE_SIZE; ++value){
+			int count = 0;
+			for(int i = 0; i < Board::PUZZLE_SIZE; ++i)
+				if(masks[i] & Board::maskOf(value))
+					++count;
+			assert(((scan.exactlyOnce & Board::maskOf(value)) != 0) ==
+					(count == 1) && "exactlyOnce disagrees with count?");
+			assert(((scan.exactlyTwice & Board::maskOf(value)) != 0) ==
+					(count == 2) && "exactlyTwice disagrees with count?");
+		}
+	}
+
+	cout << "No problems!" << endl;
+}
+
+static void testPropagate(){
+	cout << "\n***Testing Propagator::propagate().***" << endl;
+
+	// Only cell 3 of the first row can still be 5.
+	Board board;
+	for(int col = 0; col < Board::PUZZLE_SIZE; ++col)
+		if(col != 3)
+			assert(board.eliminate(col, Board::maskOf(5)) &&
+					"Elimination failed?");
+	uint16_t missing;
+	assert(Propagator::findHiddenSingles(board, 0, missing) ==
+			Board::maskOf(5) && missing == 0 && "Hidden single not found?");
+	assert(Propagator::propagate(board) && "Propagation failed?");
+	assert(board.getValue(3) == 5 && "Hidden single not placed?");
+
+	// No cell of the first row can be 5.
+	Board stuck;
+	for(int col = 0; col < Board::PUZZLE_SIZE; ++col)
+		stuck.eliminate(col, Board::maskOf(5));
+	assert(!Propagator::propagate(stuck) &&
+			"Value with no place in a unit not a contradiction?");
+
+	// Singles alone solve puzzles/720.d.txt.
+	uint8_t givens[Board::NUM_CELLS];
+	assert(parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720), givens) &&
+			board.load(givens) && "Could not load puzzle?");
+	assert(Propagator::propagate(board) && "Propagation failed?");
+	if(board.isSolved()){
+		char out[Board::NUM_CELLS];
+		formatPuzzleLine(board, out);
+		assert(std::string(out, Board::NUM_CELLS) == SOLUTION_720 &&
+				"Propagation solved to the wrong grid?");
+	}
+
+	cout << "No problems!" << endl;
+}
+
+static void testBuckets(){
+	cout << "\n***Testing the candidate-count buckets.***" << endl;
+
+	uint8_t givens[Board::NUM_CELLS];
+	Board board;
+	assert(parsePuzzleLine(HARD_PUZZLE, strlen(HARD_PUZZLE), givens) &&
+			board.load(givens) && "Could not load puzzle?");
+
+	for(int step = 0; step < 3; ++step){
+		board.refreshBuckets();
+
+		int fewest = -1;
+		for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+			int count = Board::countCandidates(board.getCandidates(cell));
+			for(int bucket = 2; bucket <= Board::PUZZLE_SIZE; ++bucket)
+				assert(board.getCellsWithCount(bucket).contains(cell) ==
+						(board.getValue(cell) == 0 && count == bucket) &&
+						"Cell in the wrong bucket?");
+			if(board.getValue(cell) == 0 && (fewest < 0 || count <
+					Board::countCandidates(board.getCandidates(fewest))))
+				fewest = cell;
+		}
+		assert(board.findFewestCandidates() == fewest &&
+				"Wrong cell with the fewest candidates?");
+
+		// Remove a candidate for the next round; a contradiction ends it.
+		uint16_t candidates = board.getCandidates(fewest);
+		if(!board.eliminate(fewest, candidates & -candidates))
+			break;
+	}
+
+	CellSet cells;
+	cells.insert(3);
+	cells.insert(64);
+	cells.insert(80);
+	assert(cells.first() == 3 && cells.next(3) == 64 && cells.next(64) == 80 &&
+			cells.next(80) == -1 && "CellSet iteration wrong?");
+	cells.erase(64);
+	assert(!cells.contains(64) && cells.next(3) == 80 &&
+			"CellSet erase wrong?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testHeuristics(){
+	cout << "\n***Testing the search heuristics.***" << endl;
+
+	assert(makeHeuristic("nonsense") == nullptr && "Made unknown heuristic?");
+	assert(makeHeuristic("mrv+random+lcv") == nullptr &&
+			"Made heuristic with modifiers out of order?");
+
+	uint8_t givens[Board::NUM_CELLS];
+	Board hard;
+	assert(parsePuzzleLine(HARD_PUZZLE, strlen(HARD_PUZZLE), givens) &&
+			hard.load(givens) && "Could not load puzzle?");
+
+	std::unique_ptr<Solver> solver(new Solver());
+	Board expected(hard);
+	assert(solver->solve(expected) == Solver::SOLVED && "Could not solve?");
+	char expectedLine[Board::NUM_CELLS];
+	formatPuzzleLine(expected, expectedLine);
+
+	for(const char * const * name = getHeuristicNames(); *name != nullptr;
+			++name){
+		std::unique_ptr<Heuristic> heuristic = makeHeuristic(*name);
+		assert(heuristic && heuristic->getName() == *name &&
+				"Heuristic name does not round trip?");
+
+		// Every alternative of a Branch places a value that is a candidate.
+		Branch branch;
+		hard.refreshBuckets();
+		heuristic->chooseBranch(hard, branch);
+		assert(branch.count >= 2 && "Branch with fewer than two choices?");
+		for(int i = 0; i < branch.count; ++i)
+			assert(hard.getCandidates(branch.cells[i]) &
+					Board::maskOf(branch.values[i]) &&
+					"Branch alternative is not a candidate?");
+
+		// The puzzle has one solution, so every heuristic must find it.
+		solver->setHeuristic(std::move(heuristic));
+		Board board(hard);
+		assert(solver->solve(board) == Solver::SOLVED && "Could not solve?");
+		char line[Board::NUM_CELLS];
+		formatPuzzleLine(board, line);
+		assert(memcmp(line, expectedLine, sizeof(line)) == 0 &&
+				"Heuristic found a different solution?");
+	}
+
+	// With a tiny node limit, restarts must happen and still succeed.
+	solver->setHeuristic(makeHeuristic("degree+random"));
+	solver->setRestarts(4, 1);
+	Board board(hard);
+	assert(solver->solve(board) == Solver::SOLVED &&
+			solver->getStats().restarts > 0 && "Restarts did not happen?");
+	char line[Board::NUM_CELLS];
+	formatPuzzleLine(board, line);
+	assert(memcmp(line, expectedLine, sizeof(line)) == 0 &&
+			"Restarted search found a different solution?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testSolve(){
+	cout << "\n***Testing Solver::solve().***" << endl;
+
+	uint8_t givens[Board::NUM_CELLS];
+	assert(parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720), givens) &&
+			"Could not parse puzzle?");
+
+	Board board;
+	assert(board.load(givens) && "Could not load puzzle?");
+
+	std::unique_ptr<Solver> solver(new Solver());
+	assert(solver->solve(board) == Solver::SOLVED && "Could not solve?");
+	assert(board.isSolved() && "Solved board is not solved?");
+
+	char out[Board::NUM_CELLS];
+	formatPuzzleLine(board, out);
+	assert(std::string(out, Board::NUM_CELLS) == SOLUTION_720 &&
+			"Wrong solution?");
+	assert(solver->getStats().nodes >= 1 && "No nodes counted?");
+
+	// The empty board has solutions too.
+	Board empty;
+	assert(solver->solve(empty) == Solver::SOLVED &&
+			"Could not solve empty board?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testUnsolvable(){
+	cout << "\n***Testing unsolvable puzzles.***" << endl;
+
+	uint8_t givens[Board::NUM_CELLS] = {};
+	Board board;
+
+	// Two 1s in the first row.
+	givens[0] = 1;
+	givens[8] = 1;
+	assert(!board.load(givens) && "Loaded contradictory givens?");
+
+	// Consistent givens that still have no solution.
+	board = loadLine(UNSOLVABLE_PUZZLE);
+	std::unique_ptr<Solver> solver(new Solver());
+	assert(solver->solve(board) == Solver::UNSOLVABLE &&
+			"Solved an unsolvable puzzle?");
+	assert(solver->getStats().nodes > 1 && "Refuted without a search?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testSolveConstant(){
+	cout << "\n***Testing Solver::solveConstant().***" << endl;
+
+	// The same search at run time, against the Solver.
+	assert(solvesTo(PUZZLE_720, SOLUTION_720) && "Wrong solution for 720?");
+
+	uint8_t givens[Board::NUM_CELLS];
+	assert(parsePuzzleLine(HARD_PUZZLE, strlen(HARD_PUZZLE), givens) &&
+			"Could not parse puzzle?");
+	Board fromSolver;
+	Board fromConstant;
+	assert(fromSolver.load(givens) && fromConstant.load(givens) &&
+			"Could not load puzzle?");
+	std::unique_ptr<Solver> solver(new Solver());
+	assert(solver->solve(fromSolver) == Solver::SOLVED &&
+			Solver::solveConstant(fromConstant) == Solver::SOLVED &&
+			"Could not solve?");
+	for(int i = 0; i < Board::NUM_CELLS; ++i)
+		assert(fromSolver.getValue(i) == fromConstant.getValue(i) &&
+				"Different solutions?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testLimits(){
+	cout << "\n***Testing Solver::setLimits().***" << endl;
+
+	uint8_t givens[Board::NUM_CELLS];
+	assert(parsePuzzleLine(HARD_PUZZLE, strlen(HARD_PUZZLE), givens) &&
+			"Could not parse puzzle?");
+	Board hard;
+	assert(hard.load(givens) && "Could not load puzzle?");
+	std::unique_ptr<Solver> solver(new Solver());
+
+	// A node limit stops the search where it is, and keeps its counters.
+	Solver::Limits limits;
+	limits.maxNodes = 10;
+	solver->setLimits(limits);
+	Board board(hard);
+	assert(solver->solve(board) == Solver::TIMED_OUT && "Node limit ignored?");
+	assert(solver->getStats().timedOut && !solver->getStats().cancelled &&
+			solver->getStats().nodes == 10 && "Wrong partial stats?");
+	assert(!board.isSolved() &&
+			board.getNumLeftToSolve() == hard.getNumLeftToSolve() &&
+			"Board changed by a timed out search?");
+
+	// It counts the nodes of every restart.
+	solver->setRestarts(4, 1);
+	assert(solver->solve(board) == Solver::TIMED_OUT &&
+			solver->getStats().nodes == 10 &&
+			solver->getStats().restarts > 0 && "Restarts not counted?");
+	solver->setRestarts(0, 0);
+
+	// A time budget, with the clock read on every node.
+	limits = Solver::Limits();
+	limits.timeBudget = std::chrono::nanoseconds(1);
+	limits.checkInterval = 1;
+	solver->setLimits(limits);
+	assert(solver->solve(board) == Solver::TIMED_OUT && "Time limit ignored?");
+	assert(solver->countSolutions(board, 2) < 2 &&
+			solver->getStats().timedOut && "Count not timed out?");
+
+	// The limits' cancel flag.
+	std::atomic<bool> cancel(true);
+	limits = Solver::Limits();
+	limits.cancel = &cancel;
+	limits.checkInterval = 1;
+	solver->setLimits(limits);
+	assert(solver->solve(board) == Solver::CANCELLED &&
+			solver->getStats().cancelled && "Cancel flag ignored?");
+
+	// Limits that are not reached change nothing.
+	cancel = false;
+	limits.maxNodes = 100000;
+	limits.timeBudget = std::chrono::seconds(60);
+	solver->setLimits(limits);
+	assert(solver->solve(board) == Solver::SOLVED && "Could not solve?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testLivePuzzle(){
+	cout << "\n***Testing class LivePuzzle.***" << endl;
+
+	// On an empty grid, a move changes its cell and the cell's peers.
+	LivePuzzle live((Board()));
+	CandidateDiff diff;
+	assert(live.applyMove(0, 0, 5, diff) && "Could not move?");
+	assert(diff.count == 1 + Board::NUM_PEERS && "Wrong number of changes?");
+	assert(diff.changes[0].cell == 0 &&
+			diff.changes[0].mask == Board::maskOf(5) && "Wrong change?");
+	for(int i = 1; i < diff.count; ++i){
+		assert(diff.changes[i].cell > diff.changes[i - 1].cell &&
+				"Changes not in cell order?");
+		assert(diff.changes[i].mask ==
+				(Board::ALL_CANDIDATES & ~Board::maskOf(5)) &&
+				"Wrong peer mask?");
+	}
+
+	// A move that is not possible changes nothing.
+	assert(!live.applyMove(0, 1, 5, diff) && diff.count == 0 &&
+			"Made an impossible move?");
+	assert(live.getBoard().getCandidates(1) ==
+			(Board::ALL_CANDIDATES & ~Board::maskOf(5)) &&
+			"Impossible move changed the grid?");
+	bool threw = false;
+	try{
+		live.applyMove(0, 9, 1, diff);
+	}
+	catch(std::out_of_range & e){
+		threw = true;
+	}
+	assert(threw && "Move off the grid?");
+
+	/* Filling in the 720 puzzle with its solution: each diff holds exactly
+	 * the cells whose masks differ from the previous snapshot. */
+	uint8_t givens[Board::NUM_CELLS];
+	assert(parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720), givens) &&
+			"Could not parse puzzle?");
+	Board board;
+	assert(board.load(givens) && "Could not load puzzle?");
+	LivePuzzle puzzle(board);
+	CandidateDiff before;
+	CandidateDiff after;
+	puzzle.getSnapshot(before);
+	assert(before.count == Board::NUM_CELLS && "Incomplete snapshot?");
+
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell){
+		assert(puzzle.applyMove(Board::rowOf(cell), Board::colOf(cell),
+				SOLUTION_720[cell] - '0', diff) && "Solution move failed?");
+		puzzle.getSnapshot(after);
+
+		int changes = 0;
+		for(int i = 0; i < Board::NUM_CELLS; ++i){
+			if(after.changes[i].mask == before.changes[i].mask)
+				continue;
+			assert(changes < diff.count &&
+					diff.changes[changes].cell == i &&
+					diff.changes[changes].mask == after.changes[i].mask &&
+					"Diff does not match the snapshots?");
+			++changes;
+		}
+		assert(changes == diff.count && "Diff has unchanged cells?");
+		before = after;
+	}
+	assert(puzzle.getBoard().isSolved() && "Not solved by its solution?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testSolutionCache(){
+	cout << "\n***Testing class SolutionCache.***" << endl;
+
+	// Two sessions per shard.
+	SolutionCache cache(SolutionCache::getSessionBytes() *
+			SolutionCache::SHARDS * 2);
+	uint8_t givens[Board::NUM_CELLS];
+	parseLine(PUZZLE_720, givens);
+	Board board;
+	assert(board.load(givens) && "Could not load puzzle?");
+	LivePuzzle live(board);
+
+	// Right moves stay consistent, and only the first check solves.
+	CandidateDiff diff;
+	for(int cell = 0; cell < Board::NUM_CELLS; cell += 7){
+		live.applyMove(Board::rowOf(cell), Board::colOf(cell),
+				SOLUTION_720[cell] - '0', diff);
+		assert(cache.check(1, givens, live.getBoard()) ==
+				SolutionCache::CONSISTENT && "Right move inconsistent?");
+	}
+	SolutionCache::Stats stats = cache.getStats();
+	assert(stats.misses == 1 && stats.hits == 11 && stats.sessions == 1 &&
+			"Solved more than once?");
+	uint8_t solution[Board::NUM_CELLS];
+	assert(cache.lookup(1, givens, solution) == SolutionCache::UNIQUE &&
+			"Not unique?");
+	for(int cell = 0; cell < Board::NUM_CELLS; ++cell)
+		assert(solution[cell] == SOLUTION_720[cell] - '0' &&
+				"Wrong solution kept?");
+
+	// New givens for the session are solved again.
+	uint8_t hard[Board::NUM_CELLS];
+	parseLine(HARD_PUZZLE, hard);
+	assert(board.load(hard) && "Could not load hard puzzle?");
+	assert(cache.check(1, hard, board) == SolutionCache::CONSISTENT &&
+			cache.getStats().invalidations == 1 && "Stale solution used?");
+
+	// A move the candidates allow, but that is not the solution's.
+	assert(cache.lookup(1, hard, solution) == SolutionCache::UNIQUE &&
+			"Hard puzzle not unique?");
+	bool wrongMove = false;
+	for(int cell = 0; cell < Board::NUM_CELLS && !wrongMove; ++cell){
+		for(int value = 1; value <= Board::PUZZLE_SIZE && !wrongMove; ++value){
+			LivePuzzle next(board);
+			wrongMove = value != solution[cell] && board.getValue(cell) == 0 &&
+					next.applyMove(Board::rowOf(cell), Board::colOf(cell),
+							value, diff);
+			if(wrongMove)
+				assert(cache.check(1, hard, next.getBoard()) ==
+						SolutionCache::INCONSISTENT &&
+						"Wrong move consistent?");
+		}
+	}
+	assert(wrongMove && "No wrong move to try?");
+
+	// Puzzles with no solution, and with many.
+	uint8_t unsolvable[Board::NUM_CELLS] = {1, 2, 3, 4, 5, 6, 7, 8};
+	unsolvable[Board::NUM_CELLS - 1] = 9;
+	unsolvable[Board::PUZZLE_SIZE * 4] = 9;
+	assert(cache.lookup(2, unsolvable) == SolutionCache::NO_SOLUTION &&
+			cache.check(2, unsolvable, Board()) ==
+					SolutionCache::INCONSISTENT && "Unsolvable consistent?");
+	uint8_t empty[Board::NUM_CELLS] = {};
+	assert(cache.lookup(3, empty) == SolutionCache::MULTIPLE_SOLUTIONS &&
+			cache.check(3, empty, Board()) == SolutionCache::UNKNOWN &&
+			"Empty grid has a unique solution?");
+
+	// Within limits that are too tight to tell.
+	Solver::Limits limits;
+	limits.maxNodes = 1;
+	SolutionCache limited(SolutionCache::DEFAULT_MAX_BYTES, limits);
+	assert(limited.lookup(1, hard) == SolutionCache::UNDECIDED &&
+			"Decided within one node?");
+	assert(limited.lookup(1, hard) == SolutionCache::UNDECIDED &&
+			limited.getStats().misses == 2 &&
+			limited.getStats().sessions == 0 && "Undecided result kept?");
+
+	// The memory bound holds with many sessions.
+	for(uint64_t session = 100; session < 300; ++session)
+		cache.check(session, givens, live.getBoard());
+	stats = cache.getStats();
+	assert(stats.sessions <= 2 * SolutionCache::SHARDS &&
+			stats.evictions >= 200 - 2 * SolutionCache::SHARDS &&
+			"Memory bound exceeded?");
+	cache.endSession(299);
+	assert(cache.getStats().sessions == stats.sessions - 1 &&
+			"Session not ended?");
+
+	// Sessions checked from several threads at once.
+	SolutionCache shared;
+	std::vector<std::thread> threads;
+	for(int t = 0; t < 4; ++t){
+		threads.push_back(std::thread([&shared, &givens, &live, t](){
+			for(int i = 0; i < 200; ++i)
+				assert(shared.check(t * 1000 + i % 20, givens,
+						live.getBoard()) == SolutionCache::CONSISTENT &&
+						"Inconsistent from a thread?");
+		}));
+	}
+	for(std::thread & thread : threads)
+		thread.join();
+	stats = shared.getStats();
+	assert(stats.hits + stats.misses == 800 && stats.misses == 80 &&
+			stats.sessions == 80 && "Wrong counts from threads?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testChunkedReader(){
+	cout << "\n***Testing ChunkedReader.***" << endl;
+
+	int fd = tempFileWith("one\r\ntwo\n\nthis line is too long\nlast");
+	ChunkedReader reader(fd, 8);
+	const char * line;
+	std::size_t length;
+
+	assert(reader.nextLine(line, length) &&
+			std::string(line, length) == "one" && "First line wrong?");
+	assert(reader.nextLine(line, length) &&
+			std::string(line, length) == "two" && "Second line wrong?");
+	assert(reader.nextLine(line, length) && length == 0 &&
+			"Blank line wrong?");
+	assert(reader.nextLine(line, length) &&
+			std::string(line, length) == "this lin" &&
+			"Long line not truncated?");
+	assert(reader.getBytesConsumed() == 32 &&
+			"Long line not consumed to its newline?");
+	assert(reader.nextLine(line, length) &&
+			std::string(line, length) == "last" && "Last line wrong?");
+	assert(!reader.nextLine(line, length) && "Read past the end?");
+	close(fd);
+
+	cout << "No problems!" << endl;
+}
+
+static void testStreamMode(){
+	cout << "\n***Testing runStreamMode().***" << endl;
+
+	std::string input;
+	input += PUZZLE_720;
+	input += "\n\nnot a puzzle\n";
+	input += std::string(Board::NUM_CELLS - 2, '#') + "11\n";
+	input += PUZZLE_720;
+
+	int in = tempFileWith(input);
+	int out = tempFileWith("");
+
+	StreamStats stats = runStreamMode(in, out);
+	assert(stats.records == 4 && "Wrong number of records?");
+	assert(stats.solved == 2 && "Wrong number solved?");
+	assert(stats.invalid == 1 && "Wrong number invalid?");
+	assert(stats.unsolvable == 1 && "Wrong number unsolvable?");
+
+	std::string expected;
+	expected += SOLUTION_720;
+	expected += "\ninvalid\nunsolvable\n";
+	expected += SOLUTION_720;
+	expected += "\n";
+	assert(readAll(out) == expected && "Wrong output?");
+
+	close(in);
+	close(out);
+
+	// The 720 puzzle takes three nodes, the hard puzzle many more.
+	in = tempFileWith(std::string(HARD_PUZZLE) + "\n" + PUZZLE_720 + "\n");
+	out = tempFileWith("");
+	Solver::Limits limits;
+	limits.maxNodes = 10;
+	stats = runStreamMode(in, out, limits);
+	assert(stats.timedOut == 1 && stats.solved == 1 &&
+			"Wrong number timed out?");
+	assert(readAll(out) == std::string("timed out\n") + SOLUTION_720 + "\n" &&
+			"Wrong output with limits?");
+
+	close(in);
+	close(out);
+
+	cout << "No problems!" << endl;
+}
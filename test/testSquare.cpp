@@ -13,6 +13,8 @@
 #include <stdexcept>
 #include <vector>
 #include <sstream>
+#include <set>
+#include <utility>
 
 using std::cout;
 using std::endl;
@@ -27,6 +29,7 @@ static void testSetRow();
 static void testSetCol();
 static void testRestrictValues();
 static void testToString();
+static void testCandidateView();
 
 
 void testSquare(){
@@ -41,6 +44,7 @@ void testSquare(){
 	testSetCol();
 	testRestrictValues();
 	testToString();
+	testCandidateView();
 
 	cout << "\n*** All done! ***" << endl;
 }
@@ -418,6 +422,17 @@ static void testRestrictValues(){
 	// Ret value: true if square changed to set, false otherwise or if Square
 	// was already set.
 
+	// The other overloads behave the same.
+	const int lowValues[] = {1, 2, 3, 4, 5, 6, 7};
+	Square fromArray(0,0);
+	assert(!fromArray.restrictValues(lowValues, 7) && !fromArray.isSet() &&
+			fromArray.getPossibleValues() == std::set<int>({8, 9}) &&
+			"Array restriction wrong?");
+	assert(fromArray.restrictValues(CandidateView(1 << 7)) &&
+			fromArray.getValue() == 9 && "View restriction wrong?");
+	assert(!fromArray.restrictValues({9}) && fromArray.getValue() == 9 &&
+			"Restricted a set Square?");
+
 	cout << "No problems!"<< endl;
 }
 
@@ -443,3 +458,32 @@ static void testToString(){
 
 	cout << "No problems!"<< endl;
 }
+
+static void testCandidateView(){
+	cout << "\n***Testing CandidateView.***" << endl;
+
+	Square square(0,0);
+	square.restrictValues({2, 5, 7});
+	CandidateView view = square.getPossibleValues();
+	assert(view.size() == 6 && !view.empty() && view.contains(1) &&
+			!view.contains(2) && !view.contains(0) && !view.contains(17) &&
+			"Wrong view?");
+
+	std::vector<int> values(view.begin(), view.end());
+	assert(values == std::vector<int>({1, 3, 4, 6, 8, 9}) &&
+			"Values out of order?");
+	std::set<int> copy = view;
+	assert(copy == view && view == copy && view != std::set<int>({1, 3}) &&
+			view != std::set<int>({1, 3, 4, 6, 8, 9, 10}) &&
+			"Wrong comparison with std::set?");
+
+	// Moved Squares keep everything.
+	Square moved(std::move(square));
+	assert(moved.getPossibleValues() == view && "Move lost values?");
+	Square assigned(8,8,1);
+	assigned = std::move(moved);
+	assert(assigned.getPossibleValues() == view && !assigned.isSet() &&
+			"Move assignment lost values?");
+
+	cout << "No problems!"<< endl;
+}
@@ -0,0 +1,75 @@
+/**
+ * \file testStress.cpp
+ *
+ * Test code for the stress test of the engines.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "StressTest.h"
+#include <iostream>
+#include <cassert>
+#include <sstream>
+
+using std::cout;
+using std::endl;
+
+void testStress();
+static void testEnginesAgree();
+static void testRepeatable();
+
+void testStress(){
+	cout << "\n***Testing the stress test.***\n" << endl;
+
+	testEnginesAgree();
+	testRepeatable();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+static void testEnginesAgree(){
+	cout << "\n***Testing every engine agrees on random puzzles.***" << endl;
+
+	StressOptions options;
+	options.puzzles = 300;
+	options.threads = 4;
+	std::ostringstream log;
+	StressReport report = runStressTest(options, log);
+	assert(report.mismatches == 0 && log.str().empty() &&
+			"Engines disagree?");
+	assert(report.unique > 0 && report.multiple > 0 &&
+			report.unsolvable + report.contradicted > 0 &&
+			"Not every kind of puzzle generated?");
+	assert(report.unique + report.multiple + report.unsolvable +
+			report.contradicted == options.puzzles && "Puzzles lost?");
+	assert(report.solves % (report.unique + report.multiple +
+			report.unsolvable) == 0 && "Not every engine run on every puzzle?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testRepeatable(){
+	cout << "\n***Testing the puzzles depend only on the seed.***" << endl;
+
+	StressOptions options;
+	options.puzzles = 100;
+	options.seed = 7;
+	std::ostringstream log;
+	options.threads = 1;
+	StressReport one = runStressTest(options, log);
+	options.threads = 3;
+	StressReport three = runStressTest(options, log);
+	assert(one.unique == three.unique && one.multiple == three.multiple &&
+			one.unsolvable == three.unsolvable &&
+			one.contradicted == three.contradicted &&
+			one.solves == three.solves && "Threads change the puzzles?");
+
+	options.seed = 8;
+	StressReport other = runStressTest(options, log);
+	assert((other.unique != one.unique || other.multiple != one.multiple ||
+			other.unsolvable != one.unsolvable) &&
+			"Seed does not change the puzzles?");
+
+	cout << "No problems!" << endl;
+}
@@ -0,0 +1,168 @@
+/**
+ * \file testVerifier.cpp
+ *
+ * Test code for verifySolution() and the corpus checker.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Alexander Senior.
+ */
+
+#include "Verifier.h"
+#include "CorpusChecker.h"
+#include "PuzzleIO.h"
+#include "TestUtil.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void testVerifier();
+static void testVerifySolution();
+static void testCheckDirectory();
+static void testCheckBatchFile();
+
+void testVerifier(){
+	cout << "\n***Testing verifySolution() and the corpus checker.***\n"
+			<< endl;
+
+	testVerifySolution();
+	testCheckDirectory();
+	testCheckBatchFile();
+
+	cout << "\n*** All done! ***" << endl;
+}
+
+/* Writes a one-line puzzle as a puzzle file of PUZZLE_SIZE lines, dropping
+ * the last skipLines lines. */
+static void writePuzzleFile(const std::string & path, const std::string & line,
+		int skipLines = 0){
+	std::ofstream file(path);
+	for(int row = 0; row < Board::PUZZLE_SIZE - skipLines; ++row)
+		file << line.substr(row * Board::PUZZLE_SIZE, Board::PUZZLE_SIZE)
+				<< "\n";
+}
+
+static void testVerifySolution(){
+	cout << "\n***Testing verifySolution().***" << endl;
+
+	uint8_t givens[Board::NUM_CELLS];
+	uint8_t grid[Board::NUM_CELLS];
+	assert(parsePuzzleLine(PUZZLE_720, strlen(PUZZLE_720), givens) &&
+			parsePuzzleLine(SOLUTION_720, strlen(SOLUTION_720), grid) &&
+			"Could not parse?");
+
+	assert(verifySolution(grid, givens) == VALID && "Solution not valid?");
+
+	uint8_t none[Board::NUM_CELLS] = {};
+	assert(verifySolution(grid, none) == VALID &&
+			"Solution of the empty puzzle not valid?");
+
+	// Swapping two values in a row keeps it full but breaks the columns.
+	uint8_t swapped[Board::NUM_CELLS];
+	memcpy(swapped, grid, sizeof(grid));
+	std::swap(swapped[0], swapped[2]);
+	assert(verifySolution(swapped, none) == DUPLICATE &&
+			"Swapped values not caught?");
+
+	uint8_t incomplete[Board::NUM_CELLS];
+	memcpy(incomplete, grid, sizeof(grid));
+	incomplete[40] = 0;
+	assert(verifySolution(incomplete, givens) == INCOMPLETE &&
+			"Empty cell not caught?");
+	incomplete[40] = Board::PUZZLE_SIZE + 1;
+	assert(verifySolution(incomplete, givens) == INCOMPLETE &&
+			"Out of range value not caught?");
+
+	// Relabelling 1 and 2 everywhere gives another valid grid, which breaks
+	// the puzzle's givens.
+	uint8_t relabelled[Board::NUM_CELLS];
+	for(int i = 0; i < Board::NUM_CELLS; ++i)
+		relabelled[i] = grid[i] == 1 ? 2 : grid[i] == 2 ? 1 : grid[i];
+	assert(verifySolution(relabelled, none) == VALID &&
+			"Relabelled grid not valid?");
+	assert(verifySolution(relabelled, givens) == GIVEN_CHANGED &&
+			"Changed givens not caught?");
+
+	cout << "No problems!" << endl;
+}
+
+static void testCheckDirectory(){
+	cout << "\n***Testing checkDirectory().***" << endl;
+
+	char directory[] = "/tmp/testVerifierXXXXXX";
+	assert(mkdtemp(directory) != nullptr && "Could not create directory?");
+	std::string dir(directory);
+
+	std::string bad(SOLUTION_720);
+	std::swap(bad[0], bad[2]);
+
+	writePuzzleFile(dir + "/1.d.txt", PUZZLE_720);
+	writePuzzleFile(dir + "/1.soln.txt", SOLUTION_720);
+	writePuzzleFile(dir + "/2.ve.txt", PUZZLE_720);
+	writePuzzleFile(dir + "/2.soln.txt", bad);
+	writePuzzleFile(dir + "/3.ve.txt", PUZZLE_720, 1);
+	writePuzzleFile(dir + "/3.soln.txt", SOLUTION_720);
+	writePuzzleFile(dir + "/4.d.txt", PUZZLE_720);
+	writePuzzleFile(dir + "/5.soln.txt", SOLUTION_720);
+	writePuzzleFile(dir + "/6.ve.txt", PUZZLE_720, 1);
+
+	std::ostringstream report;
+	CheckReport result = checkDirectory(dir, 2, report);
+	assert(result.checked == 4 && "Wrong number of pairs checked?");
+	assert(result.valid == 1 && "Wrong number valid?");
+	assert(result.mismatched == 1 && "Mismatch not reported?");
+	assert(result.malformed == 2 && "Short files not reported?");
+	assert(result.unpaired == 2 && "Unpaired files not reported?");
+	assert(!result.allValid() && "All valid with problems?");
+	assert(report.str().find("2.ve.txt: mismatch") != std::string::npos &&
+			"Mismatch not in report?");
+	assert(report.str().find("3.ve.txt: malformed") != std::string::npos &&
+			"Short file not in report?");
+	assert(report.str().find("6.ve.txt: malformed") != std::string::npos &&
+			"Short file without a solution not in report?");
+
+	const char * files[] = {"1.d.txt", "1.soln.txt", "2.ve.txt", "2.soln.txt",
+			"3.ve.txt", "3.soln.txt", "4.d.txt", "5.soln.txt", "6.ve.txt"};
+	for(auto file : files)
+		unlink((dir + "/" + file).c_str());
+	rmdir(directory);
+
+	cout << "No problems!" << endl;
+}
+
+static void testCheckBatchFile(){
+	cout << "\n***Testing checkBatchFile().***" << endl;
+
+	std::string bad(SOLUTION_720);
+	std::swap(bad[0], bad[2]);
+
+	std::string contents;
+	contents += std::string(PUZZLE_720) + " " + SOLUTION_720 + "\n";
+	contents += "\n";
+	contents += std::string(PUZZLE_720) + "," + bad + "\n";
+	contents += std::string(PUZZLE_720) + "\n";
+
+	int fd = tempFileWith(contents);
+	std::ostringstream report;
+	CheckReport result = checkBatchFile(fd, "batch", 2, report);
+	close(fd);
+
+	assert(result.checked == 3 && "Wrong number of pairs checked?");
+	assert(result.valid == 1 && "Wrong number valid?");
+	assert(result.mismatched == 1 && "Mismatch not reported?");
+	assert(result.malformed == 1 && "Malformed line not reported?");
+	assert(report.str().find("batch:3: mismatch") != std::string::npos &&
+			"Mismatch not reported with its line number?");
+	assert(report.str().find("batch:4: malformed") != std::string::npos &&
+			"Malformed line not reported with its line number?");
+
+	cout << "No problems!" << endl;
+}